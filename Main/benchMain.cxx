@@ -0,0 +1,167 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   Main/benchMain.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <boost/tuple/tuple.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Exception.h"
+#include "MersenneTwister.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "InputControl.h"
+#include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "surfIndex.h"
+#include "objectRegister.h"
+#include "MainProcess.h"
+#include "BenchFunc.h"
+#include "benchSurface.h"
+#include "benchObject.h"
+#include "benchModel.h"
+
+MTRand RNG(12345UL);
+
+namespace ELog 
+{
+  ELog::OutputLog<EReport> EM;
+  ELog::OutputLog<FileReport> FM("Spectrum.log");
+  ELog::OutputLog<FileReport> RN("Renumber.txt");   ///< Renumber
+  ELog::OutputLog<StreamReport> CellM;
+}
+
+int startBench(const int,const int);
+
+int
+main(int argc,char* argv[])
+  /*!
+    Run the benchmarks:
+     benchMain [-o out] [-r ref] [-t tol] [-n repeat] [-s scale] sect extra
+    Section/extra of -1 runs all. The results are written
+    to the out file and compared with the reference file.
+    \return number of regressions
+  */
+{
+  ELog::RegMethod RControl("","main");
+  mainSystem::activateLogging(RControl);
+
+  std::vector<std::string> Names;  
+  InputControl::mainVector(argc,argv,Names);
+
+  std::string OutName;
+  std::string RefName;
+  double tol(1.5);
+  int nRepeat(5);
+  double scale(1.0);
+  InputControl::flagVExtract(Names,"o","output",OutName);
+  InputControl::flagVExtract(Names,"r","reference",RefName);
+  InputControl::flagVExtract(Names,"t","tol",tol);
+  InputControl::flagVExtract(Names,"n","repeat",nRepeat);
+  InputControl::flagVExtract(Names,"s","scale",scale);
+  if (!InputControl::flagExtract(Names,"v","verbose"))
+    ELog::EM.setActive(4);
+
+  int section(0);
+  int extra(0);
+  if (!Names.empty())
+    StrFunc::convert(Names[0],section);
+  if (Names.size()>1)
+    StrFunc::convert(Names[1],extra);
+
+  int retVal(0);
+  try
+    {
+      BenchFunc& BF=BenchFunc::Instance();
+      BF.setRepeat(static_cast<size_t>(std::max(nRepeat,1)));
+      BF.setScale(scale);
+      
+      retVal=startBench(section,extra);
+      if (!OutName.empty())
+	{
+	  std::ofstream OX(OutName.c_str());
+	  BF.write(OX);
+	}
+      if (!retVal && !RefName.empty())
+	retVal=BF.checkReference(RefName,tol,std::cout);
+    }
+  catch (ColErr::ExBase& A)
+    {
+      ELog::EM<<"EXCEPTION FAILURE :: "
+	      <<A.what()<<ELog::endCrit;
+      retVal= -1;
+    }
+
+  ModelSupport::objectRegister::Instance().reset();
+  ModelSupport::surfIndex::Instance().reset();
+  return retVal;
+}
+
+int
+startBench(const int section,const int extra)
+  /*!
+    Processes the benchmarks
+    \param section :: Section to run [-1 for all]
+    \param extra :: Benchmark in section [-1 for all]
+    \return 0 on success / -ve on failure
+  */
+{
+  if (section==0)
+    {
+      std::cout<<"Bench :: Surface       (1)"<<std::endl;
+      std::cout<<"Bench :: Object        (2)"<<std::endl;
+      std::cout<<"Bench :: Model         (3)"<<std::endl;
+      return 0;
+    }
+
+  int retVal(0);
+  if (section==1 || section<0)
+    {
+      benchSurface A;
+      retVal=A.applyBench(extra);
+    }
+  if (!retVal && (section==2 || section<0))
+    {
+      benchObject A;
+      retVal=A.applyBench(extra);
+    }
+  if (!retVal && (section==3 || section<0))
+    {
+      benchModel A;
+      retVal=A.applyBench(extra);
+    }
+  return retVal;
+}
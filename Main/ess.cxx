@@ -41,6 +41,7 @@
 #include "RegMethod.h"
 #include "GTKreport.h"
 #include "OutputLog.h"
+#include "BuildProfile.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "surfRegister.h"
@@ -104,6 +105,7 @@
 #include "TallySelector.h"
 #include "World.h"
 #include "makeESS.h"
+#include "paramScan.h"
 
 MTRand RNG(12345UL);
 
@@ -117,6 +119,88 @@ namespace ELog
 }
 ///\endcond STATIC
 
+static int
+buildModel(Simulation& System,mainSystem::inputParam& IParam,
+	   essSystem::makeESS& ESSObj)
+  /*!
+    Build the model up to the master rotation
+    \param System :: Simulation
+    \param IParam :: Input parameters
+    \param ESSObj :: ESS builder
+    \return tally renumber work flag
+  */
+{
+  System.resetAll();
+
+  ELog::ProfilePhase PBuild("build");
+  World::createOuterObjects(System);
+  ESSObj.build(&System,IParam);
+
+  SDef::sourceSelection(System,IParam);
+  PBuild.end();
+
+  ELog::ProfilePhase PComp("removeComplements");
+  System.removeComplements();
+  PComp.end();
+  ELog::ProfilePhase PDead("removeDeadSurfaces");
+  System.removeDeadSurfaces(0);         
+  PDead.end();
+
+  ModelSupport::setDefaultPhysics(System,IParam);
+  ELog::ProfilePhase PTally("tallySelection");
+  const int renumCellWork=tallySelection(System,IParam);
+  PTally.end();
+  ELog::ProfilePhase PRot("masterRotation");
+  System.masterRotation();
+  return renumCellWork;
+}
+
+static void
+finishModel(Simulation& System,mainSystem::inputParam& IParam,
+	    const int renumCellWork)
+  /*!
+    Complete the physics/tallies after the master rotation
+    \param System :: Simulation
+    \param IParam :: Input parameters
+    \param renumCellWork :: tally renumber work flag
+  */
+{
+  if (IParam.flag("endf"))
+    System.setENDF7();
+  createMeshTally(IParam,&System);
+
+  SimProcess::importanceSim(System,IParam);
+  SimProcess::inputPatternSim(System,IParam); // energy cut etc
+
+  ELog::ProfilePhase PRenum("renumber");
+  if (renumCellWork)
+    tallyRenumberWork(System,IParam);
+  tallyModification(System,IParam);
+
+  if (IParam.flag("cinder"))
+    System.setForCinder();
+  return;
+}
+
+static int
+scanDeck(Simulation& System,mainSystem::inputParam& IParam,
+	 const std::string& DeckName)
+  /*!
+    Build and write one deck of a parameter scan
+    \param System :: Simulation
+    \param IParam :: Input parameters
+    \param DeckName :: Output file
+    \return 0 on success
+  */
+{
+  essSystem::makeESS ESSObj;
+  const int renumCellWork=buildModel(System,IParam,ESSObj);
+  finishModel(System,IParam,renumCellWork);
+  System.prepareWrite();
+  System.write(DeckName);
+  return 0;
+}
+
 int 
 main(int argc,char* argv[])
 {
@@ -140,14 +224,28 @@ main(int argc,char* argv[])
   if (!SimPtr) return -1;
 
   // The big variable setting
+  ELog::ProfilePhase PVar("variables");
   setVariable::EssVariables(SimPtr->getDataBase());
   InputModifications(SimPtr,IParam,Names);
+  PVar.end();
   
   // Definitions section 
   int MCIndex(0);
   const int multi=IParam.getValue<int>("multi");
   try
     {
+      mainSystem::paramScan PScan;
+      if (mainSystem::createScan(PScan,IParam,RNG))
+	{
+	  const std::string Manifest(Oname+".manifest");
+	  PScan.readManifest(Manifest);
+	  exitFlag=PScan.run(*SimPtr,IParam,Oname,&scanDeck,Manifest);
+	  delete SimPtr;
+	  ModelSupport::objectRegister::Instance().reset();
+	  ModelSupport::surfIndex::Instance().reset();
+	  return exitFlag;
+	}
+
       while(MCIndex<multi)
 	{
 	  if (MCIndex)
@@ -160,45 +258,22 @@ main(int argc,char* argv[])
 	      // 	  (SimPtr->getDataBase(),IterVal);
 	    }
 
-	  SimPtr->resetAll();
-
 	  essSystem::makeESS ESSObj;
-	  World::createOuterObjects(*SimPtr);
-	  ESSObj.build(SimPtr,IParam);
-
-	  SDef::sourceSelection(*SimPtr,IParam);
-
-	  SimPtr->removeComplements();
-	  SimPtr->removeDeadSurfaces(0);         
-
-	  ModelSupport::setDefaultPhysics(*SimPtr,IParam);
-	  const int renumCellWork=tallySelection(*SimPtr,IParam);
-	  SimPtr->masterRotation();
+	  const int renumCellWork=buildModel(*SimPtr,IParam,ESSObj);
 	  if (createVTK(IParam,SimPtr,Oname))
 	    {
 	      delete SimPtr;
 	      ModelSupport::objectRegister::Instance().reset();
 	      return 0;
 	    }
-	  if (IParam.flag("endf"))
-	    SimPtr->setENDF7();
-	  createMeshTally(IParam,SimPtr);
-
-	  SimProcess::importanceSim(*SimPtr,IParam);
-	  SimProcess::inputPatternSim(*SimPtr,IParam); // energy cut etc
-
-	  if (renumCellWork)
-	    tallyRenumberWork(*SimPtr,IParam);
-	  tallyModification(*SimPtr,IParam);
-
-	  if (IParam.flag("cinder"))
-	    SimPtr->setForCinder();
+	  finishModel(*SimPtr,IParam,renumCellWork);
 
 	  // // Cut energy tallies:
 	  // if (IParam.flag("ECut"))
 	  //   SimPtr->setEnergy(IParam.getValue<double>("ECut"));
 
 	  // Ensure we done loop
+	  ELog::ProfilePhase PWrite("write");
 	  do
 	    {
 	      SimProcess::writeIndexSim(*SimPtr,Oname,MCIndex);
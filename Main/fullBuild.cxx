@@ -43,6 +43,7 @@
 #include "RegMethod.h"
 #include "GTKreport.h"
 #include "OutputLog.h"
+#include "BuildProfile.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "version.h"
@@ -136,7 +137,9 @@ main(int argc,char* argv[])
 
   try
     {
+      ELog::ProfilePhase PVar("variables");
       TS2InputModifications(SimPtr,IParam,Names);
+      PVar.end();
       
       if (IParam.flag("units"))
 	chipIRDatum::chipDataStore::Instance().setUnits(chipIRDatum::cm);
@@ -171,29 +174,39 @@ main(int argc,char* argv[])
 		  (SimPtr->getDataBase(),IterVal);
 	    }
 	  SimPtr->resetAll();
+	  ELog::ProfilePhase PBuild("build");
 	  World::createOuterObjects(*SimPtr);
 
 	  moderatorSystem::makeTS2 TS2Obj;
 	  TS2Obj.build(SimPtr,IParam);
 	  // This for chipObjBuild
 	  SDef::sourceSelection(*SimPtr,IParam);
+	  PBuild.end();
 
 	  //      WeightSystem::addForcedCollision(Sim,40.0);
+	  ELog::ProfilePhase PComp("removeComplements");
 	  SimPtr->removeComplements();
+	  PComp.end();
+	  ELog::ProfilePhase PDead("removeDeadSurfaces");
 	  SimPtr->removeDeadSurfaces(0);         
+	  PDead.end();
 
 	  ModelSupport::setDefaultPhysics(*SimPtr,IParam);
 
 	  // Sets a line of tallies at different angles
 	  //	  TMRSystem::setAllTally(Sim,SInfo);
+	  ELog::ProfilePhase PTally("tallySelection");
 	  const int renumCellWork=tallySelection(*SimPtr,IParam);
+	  PTally.end();
 
 	  if (!rotFlag.empty())
 	    {
 	      ModelSupport::setItemRotate(World::masterTS2Origin(),rotFlag);
 	      ModelSupport::setDefRotation(IParam);
 	    }
+	  ELog::ProfilePhase PRot("masterRotation");
 	  SimPtr->masterRotation();
+	  PRot.end();
 	  if (createVTK(IParam,SimPtr,Oname))
 	    {
 	      delete SimPtr;
@@ -219,11 +232,14 @@ main(int argc,char* argv[])
 	  SimProcess::importanceSim(*SimPtr,IParam);
 	  SimProcess::inputPatternSim(*SimPtr,IParam); // energy cut etc
 	  
+	  ELog::ProfilePhase PRenum("renumber");
 	  if (renumCellWork)
 	    tallyRenumberWork(*SimPtr,IParam);
 	  tallyModification(*SimPtr,IParam);
+	  PRenum.end();
 
 	  // Ensure we done loop
+	  ELog::ProfilePhase PWrite("write");
 	  do
 	    {
 	      SimProcess::writeIndexSim(*SimPtr,Oname,MCIndex);
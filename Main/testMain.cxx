@@ -98,6 +98,10 @@
 #include "varList.h"
 #include "FuncDataBase.h"
 #include "Simulation.h"
+#include "neutron.h"
+#include "Detector.h"
+#include "DetGroup.h"
+#include "SimMonte.h"
 #include "LinkUnit.h"
 #include "FixedComp.h"
 #include "ContainedComp.h"
@@ -118,6 +122,7 @@
 #include "testCylinder.h"
 #include "testDoubleErr.h"
 #include "testElement.h"
+#include "testENDF.h"
 #include "testEllipticCyl.h"
 #include "testFace.h"
 #include "testFunc.h"
@@ -136,6 +141,7 @@
 #include "testMD5.h"
 #include "testMersenne.h"
 #include "testNeutron.h"
+#include "testNeutMaterial.h"
 #include "testNList.h"
 #include "testNRange.h"
 #include "testObject.h"
@@ -145,6 +151,7 @@
 #include "testObjTrackItem.h"
 #include "testPairFactory.h"
 #include "testPairItem.h"
+#include "testParamScan.h"
 // #include "testPhysics.h"
 #include "testPipeLine.h"
 #include "testPipeUnit.h"
@@ -158,6 +165,7 @@
 #include "testSimpleObj.h"
 #include "testSimpson.h"
 #include "testSingleObject.h"
+#include "testSimMonte.h"
 #include "testSimulation.h"
 #include "testSolveValues.h"
 #include "testSource.h"
@@ -172,6 +180,7 @@
 #include "testVec3D.h"
 #include "testVarNameOrder.h"
 #include "testVolumes.h"
+#include "testWeightMesh.h"
 #include "testWorkData.h"
 #include "testWrapper.h"
 #include "testXML.h"
@@ -403,11 +412,13 @@ globalTest(const int type,const int extra)
       "testNRange",
       "testRotCounter",
       "testRules",
+      "testSimMonte",
       "testSimulation",
       "testSource",
-      "testTally"
+      "testTally",
+      "testWeightMesh"
     };
-  const int TSize(12);
+  const int TSize(14);
 
   if (type==0)
     {
@@ -477,6 +488,12 @@ globalTest(const int type,const int extra)
 	  X=A.applyTest(extra);
 	}
       cnt++;
+      if(index==cnt)
+	{
+	  testSimMonte A;
+	  X=A.applyTest(extra);
+	}
+      cnt++;
       if(index==cnt)
 	{
 	  testSimulation A;
@@ -494,6 +511,12 @@ globalTest(const int type,const int extra)
 	  testTally A;
 	  X=A.applyTest(extra);
 	}
+      cnt++;
+      if(index==cnt)
+	{
+	  testWeightMesh A;
+	  X=A.applyTest(extra);
+	}
 
     } while (!X && type!=index && index<TSize);
     
@@ -764,6 +787,8 @@ montecarloTest(const int type,const int extra)
       std::cout<<"testElement          (3)"<<std::endl;
       std::cout<<"testNeutron          (4)"<<std::endl;
       std::cout<<"testObject           (5)"<<std::endl;
+      std::cout<<"testENDF             (6)"<<std::endl;
+      std::cout<<"testNeutMaterial     (7)"<<std::endl;
     }
 
   if(type==1 || type<0)
@@ -801,6 +826,20 @@ montecarloTest(const int type,const int extra)
       if (X) return X;
     }
 
+  if(type==6 || type<0)
+    {
+      testENDF A;
+      const int X=A.applyTest(extra);
+      if (X) return X;
+    }
+
+  if(type==7 || type<0)
+    {
+      testNeutMaterial A;
+      const int X=A.applyTest(extra);
+      if (X) return X;
+    }
+
   return 0;
 }
 
@@ -848,15 +887,16 @@ processTest(const int type,const int extra)
       std::cout<<"testObjTrackItem     (8)"<<std::endl;
       std::cout<<"testPairFactory      (9)"<<std::endl;
       std::cout<<"testPairItem        (10)"<<std::endl;
-      std::cout<<"testPipeLine        (11)"<<std::endl;
-      std::cout<<"testPipeUnit        (12)"<<std::endl;
-      std::cout<<"testSimpleObj       (13)"<<std::endl;
-      std::cout<<"testSurfDivide      (14)"<<std::endl;
-      std::cout<<"testSurfEqual       (15)"<<std::endl;
-      std::cout<<"testSurfExpand      (16)"<<std::endl;
-      std::cout<<"testSurfRegister    (17)"<<std::endl;
-      std::cout<<"testVolumes         (18)"<<std::endl;
-      std::cout<<"testWrapper         (19)"<<std::endl;
+      std::cout<<"testParamScan       (11)"<<std::endl;
+      std::cout<<"testPipeLine        (12)"<<std::endl;
+      std::cout<<"testPipeUnit        (13)"<<std::endl;
+      std::cout<<"testSimpleObj       (14)"<<std::endl;
+      std::cout<<"testSurfDivide      (15)"<<std::endl;
+      std::cout<<"testSurfEqual       (16)"<<std::endl;
+      std::cout<<"testSurfExpand      (17)"<<std::endl;
+      std::cout<<"testSurfRegister    (18)"<<std::endl;
+      std::cout<<"testVolumes         (19)"<<std::endl;
+      std::cout<<"testWrapper         (20)"<<std::endl;
     }
   
   if(type==1 || type<0)
@@ -926,58 +966,64 @@ processTest(const int type,const int extra)
     }
   if(type==11 || type<0)
     {
-      testPipeLine A;
+      testParamScan A;
       const int X=A.applyTest(extra);
       if (X) return X;
     }
   if(type==12 || type<0)
     {
-      testPipeUnit A;
+      testPipeLine A;
       const int X=A.applyTest(extra);
       if (X) return X;
     }
   if(type==13 || type<0)
     {
-      testSimpleObj A;
+      testPipeUnit A;
       const int X=A.applyTest(extra);
       if (X) return X;
     }
   if(type==14 || type<0)
+    {
+      testSimpleObj A;
+      const int X=A.applyTest(extra);
+      if (X) return X;
+    }
+  if(type==15 || type<0)
     {
       testSurfDivide A;
       const int X=A.applyTest(extra);
       if (X) return X;
     }
 
-  if(type==15 || type<0)
+  if(type==16 || type<0)
     {
       testSurfEqual A;
       const int X=A.applyTest(extra);
       if (X) return X;
     }
 
-  if(type==16 || type<0)
+  if(type==17 || type<0)
     {
       testSurfExpand A;
       const int X=A.applyTest(extra);
       if (X) return X;
     }
 
-  if(type==17 || type<0)
+  if(type==18 || type<0)
     {
       testSurfRegister A;
       const int X=A.applyTest(extra);
       if (X) return X;
     }
 
-  if(type==18 || type<0)
+  if(type==19 || type<0)
     {
       testVolumes A;
       const int X=A.applyTest(extra);
       if (X) return X;
     }
 
-  if(type==19 || type<0)
+  if(type==20 || type<0)
     {
       testWrapper A;
       const int X=A.applyTest(extra);
@@ -67,6 +67,7 @@
 #include "Source.h"
 #include "Simulation.h"
 #include "SurInter.h"
+#include "BuildContext.h"
 #include "AttachSupport.h"
 
 #include "Debug.h"
@@ -310,6 +311,94 @@ addToInsertSurfCtrl(Simulation& System,
   return;
 }
 
+int
+checkInsertSurf(MonteCarlo::Qhull& CR,
+		const std::vector<Geometry::Surface*>& SVec,
+		const attachSystem::ContainedComp& CC)
+ /*!
+   Test if the outer boundary of CC cuts a cell. The
+   intersection points of the boundary surfaces with the 
+   cell surfaces are tested against both objects. Only 
+   CR is changed (populated) so different cells
+   can be tested on different threads.
+   \param CR :: Cell to test
+   \param SVec :: Outer boundary surfaces of CC
+   \param CC :: ContainedComp object to insert
+   \return true if CC needs to be inserted into CR
+  */
+{
+  ELog::RegMethod RegA("AttachSupport","checkInsertSurf");
+
+  CR.populate();
+  CR.createSurfaceList();
+  const std::vector<const Geometry::Surface*>&
+    CellSVec=CR.getSurList();
+
+  std::vector<Geometry::Vec3D> Out;		
+  std::vector<Geometry::Vec3D>::const_iterator vc;
+
+  // LOOP OVER ALL SURFACE SETS:
+  bool insertFlag(1);
+  for(size_t iA=0;insertFlag && iA<SVec.size();iA++)
+    for(size_t iB=0;insertFlag && iB<CellSVec.size();iB++)
+      for(size_t iC=iB+1;insertFlag && iC<CellSVec.size();iC++)
+	{
+	  Out=SurInter::processPoint(SVec[iA],CellSVec[iB],CellSVec[iC]);
+	  for(vc=Out.begin();vc!=Out.end();vc++)
+	    {
+	      std::set<int> boundarySet;
+	      boundarySet.insert(CellSVec[iB]->getName());
+	      boundarySet.insert(CellSVec[iC]->getName());
+	      if (CR.isValid(*vc,boundarySet) &&
+		  !CC.isOuterValid(*vc,SVec[iA]->getName()))
+		{
+		  insertFlag=0;
+		  break;
+		}
+	    }
+	}
+  if (insertFlag)  // No match found check link points:
+    {
+      for(size_t iA=0;insertFlag && iA<SVec.size();iA++)
+	for(size_t iB=iA+1;insertFlag && iB<SVec.size();iB++)
+	  for(size_t iC=iB+1;insertFlag && iC<SVec.size();iC++)
+	    {
+	      Out=SurInter::processPoint(SVec[iA],SVec[iB],SVec[iC]);
+	      for(vc=Out.begin();vc!=Out.end();vc++)
+		{
+		  if (CR.isValid(*vc))
+		    {
+		      insertFlag=0;
+		      break;
+		    }
+		}
+	    }
+    }
+  if (insertFlag)  // No match found Now inter chekc
+    {
+      for(size_t iA=0;insertFlag && iA<SVec.size();iA++)
+	for(size_t iB=iA+1;insertFlag && iB<SVec.size();iB++)
+	  for(size_t iC=0;insertFlag && iC<CellSVec.size();iC++)
+	    {
+	      Out=SurInter::processPoint(SVec[iA],SVec[iB],CellSVec[iC]);
+	      for(vc=Out.begin();vc!=Out.end();vc++)
+		{
+		  std::set<int> boundarySet;
+		  boundarySet.insert(SVec[iA]->getName());
+		  boundarySet.insert(SVec[iB]->getName());
+		  if (CR.isValid(*vc,CellSVec[iC]->getName()) &&
+		      !CC.isOuterValid(*vc,boundarySet))
+		    {
+		      insertFlag=0;
+		      break;
+		    }
+		}
+	    }
+    }
+
+  return (insertFlag) ? 0 : 1;
+}
+
 void
 addToInsertSurfCtrl(Simulation& System,
 		    const int cellA,const int cellB,
@@ -318,7 +407,8 @@ addToInsertSurfCtrl(Simulation& System,
    Adds this object to the containedComp to be inserted.
    FC is the fixed object that is to be inserted -- linkpoints
    must be set. It is tested against all the ojbect with
-   this object .
+   this object. Each cell test is independent so the cells
+   are tested in parallel and inserted in cell order.
    \param System :: Simulation to use
    \param CellA :: First cell number [to test]
    \param CellB :: Last cell number  [to test]
@@ -329,9 +419,7 @@ addToInsertSurfCtrl(Simulation& System,
 
   const std::vector<Geometry::Surface*> SVec=CC.getSurfaces();
 
-  std::vector<Geometry::Vec3D> Out;		
-  std::vector<Geometry::Vec3D>::const_iterator vc;
-
+  std::vector<MonteCarlo::Qhull*> Work;
   for(int i=cellA+1;i<=cellB;i++)
     {
       MonteCarlo::Qhull* CRPtr=System.findQhull(i);
@@ -339,73 +427,44 @@ addToInsertSurfCtrl(Simulation& System,
 	throw ColErr::InContainerError<int>(i,"Object not build");
       else if (!CRPtr)
 	break;
-      
-      CRPtr->populate();
-      CRPtr->createSurfaceList();
-      const std::vector<const Geometry::Surface*>&
-	CellSVec=CRPtr->getSurList();
-      // LOOP OVER ALL SURFACE SETS:
+      Work.push_back(CRPtr);
+    }
 
-      bool insertFlag(1);
-      for(size_t iA=0;insertFlag && iA<SVec.size();iA++)
-	for(size_t iB=0;insertFlag && iB<CellSVec.size();iB++)
-	  for(size_t iC=iB+1;insertFlag && iC<CellSVec.size();iC++)
-	    {
-	      Out=SurInter::processPoint(SVec[iA],CellSVec[iB],CellSVec[iC]);
-	      for(vc=Out.begin();vc!=Out.end();vc++)
-		{
-		  std::set<int> boundarySet;
-		  boundarySet.insert(CellSVec[iB]->getName());
-		  boundarySet.insert(CellSVec[iC]->getName());
-		  if (CRPtr->isValid(*vc,boundarySet) &&
-		      !CC.isOuterValid(*vc,SVec[iA]->getName()))
-		    {
-		      CC.addInsertCell(i);
-		      insertFlag=0;
-		      break;
-		    }
-		}
-	    }
-      if (insertFlag)  // No match found check link points:
-	{
-	  for(size_t iA=0;insertFlag && iA<SVec.size();iA++)
-	    for(size_t iB=iA+1;insertFlag && iB<SVec.size();iB++)
-	      for(size_t iC=iB+1;insertFlag && iC<SVec.size();iC++)
-		{
-		  Out=SurInter::processPoint(SVec[iA],SVec[iB],SVec[iC]);
-		  for(vc=Out.begin();vc!=Out.end();vc++)
-		    {
-		      if (CRPtr->isValid(*vc))
-			{
-			  CC.addInsertCell(i);
-			  insertFlag=0;
-			  break;
-			}
-		    }
-		}
-	}
-      if (insertFlag)  // No match found Now inter chekc
-	{
-	  for(size_t iA=0;insertFlag && iA<SVec.size();iA++)
-	    for(size_t iB=iA+1;insertFlag && iB<SVec.size();iB++)
-	      for(size_t iC=0;insertFlag && iC<CellSVec.size();iC++)
-		{
-		  Out=SurInter::processPoint(SVec[iA],SVec[iB],CellSVec[iC]);
-		  for(vc=Out.begin();vc!=Out.end();vc++)
-		    {
-		      std::set<int> boundarySet;
-		      boundarySet.insert(SVec[iA]->getName());
-		      boundarySet.insert(SVec[iB]->getName());
-		      if (CRPtr->isValid(*vc,CellSVec[iC]->getName()) &&
-			  !CC.isOuterValid(*vc,boundarySet))
-			{
-			  CC.addInsertCell(i);
-			  insertFlag=0;
-			  break;
-			}
-		    }
-		}
-	}
+  // Surface look up only reads the surfIndex 
+  BuildContext* CPtr=BuildContext::current();
+  std::vector<int> Insert(Work.size(),0);
+  std::vector<int> Failed(Work.size(),0);
+  const long int NW=static_cast<long int>(Work.size());
+#ifdef _OPENMP
+#pragma omp parallel if (NW>1)
+#endif
+  {
+    BuildContext* prevPtr=BuildContext::activate(CPtr);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,1)
+#endif
+    for(long int i=0;i<NW;i++)
+      {
+	const size_t index(static_cast<size_t>(i));
+	try
+	  {
+	    Insert[index]=checkInsertSurf(*Work[index],SVec,CC);
+	  }
+	// exceptions cannot leave the parallel region
+	catch (...)
+	  {
+	    Failed[index]=1;
+	  }
+      }
+    BuildContext::activate(prevPtr);
+  }
+
+  for(size_t i=0;i<Work.size();i++)
+    {
+      if (Failed[i])       // repeat on this thread [throws again]
+	Insert[i]=checkInsertSurf(*Work[i],SVec,CC);
+      if (Insert[i])
+	CC.addInsertCell(cellA+1+static_cast<int>(i));
     }
       
   CC.insertObjects(System);
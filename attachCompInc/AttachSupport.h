@@ -25,6 +25,11 @@
 class Rule;
 class Simulation;
 
+namespace MonteCarlo
+{
+  class Qhull;
+}
+
 namespace attachSystem
 {
 
@@ -48,6 +53,9 @@ void addToInsertControl(Simulation&,const int,const int,
 			 const FixedComp&,ContainedComp&);
 
 // On surface intersects
+int checkInsertSurf(MonteCarlo::Qhull&,
+		    const std::vector<Geometry::Surface*>&,
+		    const ContainedComp&);
 void addToInsertSurfCtrl(Simulation&,const FixedComp&,
 			ContainedComp&);
 void addToInsertSurfCtrl(Simulation&,const int,const int,
@@ -0,0 +1,219 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   bench/BenchFunc.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <time.h>
+#include <boost/tuple/tuple.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "support.h"
+#include "BenchFunc.h"
+
+BenchFunc::BenchFunc() :
+  nRepeat(5),scale(1.0)
+  /*!
+    Basic Constructor
+  */
+{}
+
+BenchFunc::~BenchFunc() 
+  /*!
+    Destructor
+  */
+{}
+
+BenchFunc&
+BenchFunc::Instance()
+  /*!
+    Static accessor to the instance of the singleton
+    \return Effective this
+   */
+{
+  static BenchFunc A;
+  return A;
+}
+
+void
+BenchFunc::regGroup(const std::string& G)
+  /*!
+    Set the group name using static accessor
+    \param G :: Group name
+  */
+{
+  BenchFunc& A=BenchFunc::Instance();
+  A.BGroup=G;
+  return;
+}
+
+double
+BenchFunc::timer()
+  /*!
+    Wall clock time 
+    \return time [seconds] from an arbitary point
+  */
+{
+  struct timespec TS;
+  clock_gettime(CLOCK_MONOTONIC,&TS);
+  return static_cast<double>(TS.tv_sec)+
+    1e-9*static_cast<double>(TS.tv_nsec);
+}
+
+void
+BenchFunc::setRepeat(const size_t N)
+  /*!
+    Set the number of repeats
+    \param N :: Repeat count [min 1]
+  */
+{
+  nRepeat=(N) ? N : 1;
+  return;
+}
+
+void
+BenchFunc::setScale(const double S)
+  /*!
+    Set the loop scale factor
+    \param S :: Scale [+ve]
+  */
+{
+  if (S<=0.0)
+    throw ColErr::RangeError<double>(S,0.0,1e6,"BenchFunc::setScale");
+  scale=S;
+  return;
+}
+
+size_t
+BenchFunc::nLoop(const size_t N) const
+  /*!
+    Scaled loop count
+    \param N :: Default loop count
+    \return loop count [min 1]
+  */
+{
+  const size_t NS=static_cast<size_t>(scale*static_cast<double>(N));
+  return (NS) ? NS : 1;
+}
+
+void
+BenchFunc::addResult(const std::string& Name,const size_t NOp,
+		     const double T,const double Check)
+  /*!
+    Register a result
+    \param Name :: Kernel name [no spaces]
+    \param NOp :: Number of operations timed
+    \param T :: Time of the fastest pass [seconds]
+    \param Check :: Result of the kernel
+  */
+{
+  const std::string FullName=BGroup+" "+Name;
+  const double nsOp=(NOp) ? 1e9*T/static_cast<double>(NOp) : 0.0;
+  Results.push_back(RTYPE(FullName,NOp,nsOp,Check));
+  std::cout<<std::setw(36)<<std::left<<FullName<<" "
+	   <<std::setw(10)<<std::right<<NOp<<" "
+	   <<std::setw(12)<<nsOp<<" ns/op"<<std::endl;
+  return;
+}
+
+void
+BenchFunc::write(std::ostream& OX) const
+  /*!
+    Write the results in the machine readable form
+    \param OX :: Output stream
+  */
+{
+  std::vector<RTYPE>::const_iterator vc;
+  for(vc=Results.begin();vc!=Results.end();vc++)
+    OX<<vc->get<0>()<<" "<<vc->get<1>()<<" "
+      <<std::setprecision(6)<<vc->get<2>()<<" "
+      <<std::setprecision(10)<<vc->get<3>()<<std::endl;
+  return;
+}
+
+int
+BenchFunc::checkReference(const std::string& FName,
+			  const double tol,std::ostream& OX) const
+  /*!
+    Compare the results with a reference file. Each
+    line of the file is : group name nOp ns/op check.
+    A result is a regression if it is more than tol times
+    the reference time or the check value differs.
+    \param FName :: Reference file
+    \param tol :: Allowed ratio of time to reference time
+    \param OX :: Stream for the report
+    \return number of regressions
+  */
+{
+  ELog::RegMethod RegA("BenchFunc","checkReference");
+  
+  std::ifstream IX(FName.c_str());
+  if (!IX.good())
+    throw ColErr::FileError(0,FName,RegA.getFull());
+
+  std::map<std::string,std::pair<double,double> > RefMap;
+  while(IX.good())
+    {
+      std::string Line=StrFunc::getLine(IX,512);
+      std::string Group,Name;
+      size_t NOp;
+      double nsOp,Check;
+      if (StrFunc::section(Line,Group) && 
+	  StrFunc::section(Line,Name) &&
+	  StrFunc::section(Line,NOp) &&
+	  StrFunc::section(Line,nsOp) &&
+	  StrFunc::section(Line,Check))
+	RefMap[Group+" "+Name]=std::pair<double,double>(nsOp,Check);
+    }
+
+  int nFail(0);
+  std::vector<RTYPE>::const_iterator vc;
+  for(vc=Results.begin();vc!=Results.end();vc++)
+    {
+      std::map<std::string,std::pair<double,double> >::const_iterator 
+	mc=RefMap.find(vc->get<0>());
+      if (mc==RefMap.end())
+	continue;
+      const double ratio=(mc->second.first>0.0) ?
+	vc->get<2>()/mc->second.first : 0.0;
+      const double checkDiff=std::abs(vc->get<3>()-mc->second.second);
+      const int regFlag(ratio>tol);
+      const int checkFlag(checkDiff>1e-6*(1.0+std::abs(vc->get<3>())));
+      OX<<std::setw(36)<<std::left<<vc->get<0>()<<" "
+	<<std::setw(10)<<std::right<<std::setprecision(4)<<ratio;
+      if (regFlag) OX<<" REGRESSION";
+      if (checkFlag) OX<<" CHECK-CHANGED";
+      OX<<std::endl;
+      if (regFlag || checkFlag) nFail++;
+    }
+  return nFail;
+}
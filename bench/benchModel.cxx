@@ -0,0 +1,390 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   bench/benchModel.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <boost/array.hpp>
+#include <boost/format.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "inputParam.h"
+#include "Triple.h"
+#include "NRange.h"
+#include "NList.h"
+#include "Quaternion.h"
+#include "localRotate.h"
+#include "masterRotate.h"
+#include "Surface.h"
+#include "surfIndex.h"
+#include "surfRegister.h"
+#include "surfEqual.h"
+#include "objectRegister.h"
+#include "Code.h"
+#include "varList.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "ModeCard.h"
+#include "PhysCard.h"
+#include "PhysImp.h"
+#include "KGroup.h"
+#include "LSwitchCard.h"
+#include "Source.h"
+#include "KCode.h"
+#include "PhysicsCards.h"
+#include "DefPhysics.h"
+#include "MainProcess.h"
+#include "Simulation.h"
+#include "variableSetup.h"
+#include "SourceSelector.h"
+#include "World.h"
+#include "makeESS.h"
+#include "makeTS2.h"
+#include "BenchFunc.h"
+#include "benchModel.h"
+
+benchModel::benchModel() 
+  /*!
+    Constructor
+  */
+{}
+
+benchModel::~benchModel() 
+  /*!
+    Destructor
+  */
+{}
+
+int 
+benchModel::applyBench(const int extra)
+  /*!
+    Applies all the benchmarks 
+    \param extra :: Benchmark number to run
+    \retval 0 : All succeeded
+  */
+{
+  ELog::RegMethod RegA("benchModel","applyBench");
+
+  typedef int (benchModel::*benchPtr)();
+  benchPtr TPtr[]=
+    {
+      &benchModel::benchESS,
+      &benchModel::benchTS2
+    };
+  const std::string TestName[]=
+    {
+      "ESS",
+      "TS2"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(benchPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  BenchFunc::regGroup("benchModel-"+TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+void
+benchModel::buildESS(Simulation& System,
+		     const mainSystem::inputParam& IParam)
+  /*!
+    Build the ESS model up to the complement removal
+    \param System :: Simulation
+    \param IParam :: Input parameters
+  */
+{
+  ELog::RegMethod RegA("benchModel","buildESS");
+
+  essSystem::makeESS ESSObj;
+  World::createOuterObjects(System);
+  ESSObj.build(&System,IParam);
+  SDef::sourceSelection(System,IParam);
+  return;
+}
+
+void
+benchModel::buildTS2(Simulation& System,
+		     const mainSystem::inputParam& IParam)
+  /*!
+    Build the TS2 model up to the complement removal
+    \param System :: Simulation
+    \param IParam :: Input parameters
+  */
+{
+  ELog::RegMethod RegA("benchModel","buildTS2");
+
+  moderatorSystem::makeTS2 TS2Obj;
+  World::createOuterObjects(System);
+  TS2Obj.build(&System,IParam);
+  SDef::sourceSelection(System,IParam);
+  return;
+}
+
+void
+benchModel::timeModel(Simulation& System,
+		      const mainSystem::inputParam& IParam,
+		      const buildPtr BPtr)
+  /*!
+    Time the build and the complement removal of 
+    a model [rebuilt each repeat] and then the kernels
+    on the completed model.
+    \param System :: Simulation
+    \param IParam :: Input parameters
+    \param BPtr :: Model build function
+  */
+{
+  ELog::RegMethod RegA("benchModel","timeModel");
+
+  BenchFunc& BF=BenchFunc::Instance();
+  double bestBuild(1e38);
+  double bestComp(1e38);
+  for(size_t r=0;r<BF.getRepeat();r++)
+    {
+      ModelSupport::objectRegister::Instance().reset();
+      System.resetAll();
+
+      const double T0=BenchFunc::timer();
+      (this->*BPtr)(System,IParam);
+      const double T1=BenchFunc::timer();
+      System.removeComplements();
+      const double T2=BenchFunc::timer();
+
+      bestBuild=std::min(bestBuild,T1-T0);
+      bestComp=std::min(bestComp,T2-T1);
+    }
+  const double NCell=static_cast<double>(System.getCells().size());
+  BF.addResult("Build",1,bestBuild,NCell);
+  BF.addResult("RemoveComplements",System.getCells().size(),
+	       bestComp,NCell);
+
+  System.removeDeadSurfaces(0);         
+  ModelSupport::setDefaultPhysics(System,IParam);
+  System.masterRotation();
+
+  timeFindCell(System);
+  timeEqualSurf();
+  timeWrite(System);
+  return;
+}
+
+void
+benchModel::timeFindCell(Simulation& System)
+  /*!
+    Time Simulation::findCell over a grid of points
+    using the last cell found as the hint.
+    \param System :: Completed simulation
+  */
+{
+  ELog::RegMethod RegA("benchModel","timeFindCell");
+
+  BenchFunc& BF=BenchFunc::Instance();
+  const size_t NG(16);
+  std::vector<Geometry::Vec3D> Pts;
+  for(size_t i=0;i<NG;i++)
+    for(size_t j=0;j<NG;j++)
+      for(size_t k=0;k<NG;k++)
+	Pts.push_back(Geometry::Vec3D(-301.0+40.1*static_cast<double>(i),
+				      -303.0+40.3*static_cast<double>(j),
+				      -299.0+39.9*static_cast<double>(k)));
+
+  const size_t NLoop=BF.nLoop(2);
+  double best(1e38);
+  double check(0.0);
+  for(size_t r=0;r<BF.getRepeat();r++)
+    {
+      check=0.0;
+      MonteCarlo::Object* OPtr(0);
+      const double T0=BenchFunc::timer();
+      for(size_t n=0;n<NLoop;n++)
+	for(size_t i=0;i<Pts.size();i++)
+	  {
+	    OPtr=System.findCell(Pts[i],OPtr);
+	    if (OPtr) check+=OPtr->getName();
+	  }
+      best=std::min(best,BenchFunc::timer()-T0);
+    }
+  BF.addResult("FindCell",NLoop*Pts.size(),best,
+	       check/static_cast<double>(NLoop));
+  return;
+}
+
+void
+benchModel::timeEqualSurf()
+  /*!
+    Time the equal surface search for every 
+    surface in the model.
+  */
+{
+  ELog::RegMethod RegA("benchModel","timeEqualSurf");
+
+  BenchFunc& BF=BenchFunc::Instance();
+  const ModelSupport::surfIndex::STYPE& SMap=
+    ModelSupport::surfIndex::Instance().surMap();
+
+  double best(1e38);
+  size_t check(0);
+  for(size_t r=0;r<BF.getRepeat();r++)
+    {
+      check=0;
+      const double T0=BenchFunc::timer();
+      ModelSupport::surfIndex::STYPE::const_iterator mc;
+      for(mc=SMap.begin();mc!=SMap.end();mc++)
+	{
+	  const Geometry::Surface* SPtr=mc->second;
+	  if (ModelSupport::equalSurface(SPtr)==SPtr)
+	    check++;
+	}
+      best=std::min(best,BenchFunc::timer()-T0);
+    }
+  BF.addResult("EqualSurf",SMap.size(),best,static_cast<double>(check));
+  return;
+}
+
+void
+benchModel::timeWrite(Simulation& System)
+  /*!
+    Time the MCNPX write of the model
+    \param System :: Completed simulation
+  */
+{
+  ELog::RegMethod RegA("benchModel","timeWrite");
+
+  BenchFunc& BF=BenchFunc::Instance();
+  const std::string OutName("benchModel.x");
+
+  System.prepareWrite();
+  double best(1e38);
+  for(size_t r=0;r<BF.getRepeat();r++)
+    {
+      const double T0=BenchFunc::timer();
+      System.write(OutName);
+      best=std::min(best,BenchFunc::timer()-T0);
+    }
+
+  size_t nLine(0);
+  std::ifstream IX(OutName.c_str());
+  std::string Line;
+  while(std::getline(IX,Line))
+    nLine++;
+  IX.close();
+  std::remove(OutName.c_str());
+
+  BF.addResult("Write",1,best,static_cast<double>(nLine));
+  return;
+}
+
+int
+benchModel::benchESS()
+  /*!
+    Build and time the ESS model
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("benchModel","benchESS");
+
+  std::string Oname;
+  std::vector<std::string> Names;
+  Names.push_back("benchESS");
+
+  mainSystem::inputParam IParam;
+  mainSystem::createESSInputs(IParam);
+  Simulation* SimPtr=mainSystem::createSimulation(IParam,Names,Oname);
+  setVariable::EssVariables(SimPtr->getDataBase());
+  mainSystem::InputModifications(SimPtr,IParam,Names);
+
+  timeModel(*SimPtr,IParam,&benchModel::buildESS);
+
+  delete SimPtr;
+  ModelSupport::objectRegister::Instance().reset();
+  ModelSupport::surfIndex::Instance().reset();
+  return 0;
+}
+
+int
+benchModel::benchTS2()
+  /*!
+    Build and time the TS2 model
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("benchModel","benchTS2");
+
+  std::string Oname;
+  std::vector<std::string> Names;
+  Names.push_back("benchTS2");
+
+  mainSystem::inputParam IParam;
+  mainSystem::createFullInputs(IParam);
+  Simulation* SimPtr=mainSystem::createSimulation(IParam,Names,Oname);
+  mainSystem::TS2InputModifications(SimPtr,IParam,Names);
+  // Boron [34] is not in the material database: use void
+  SimPtr->getDataBase().setVariable("imatShutterMaskMat",0);
+  SimPtr->getDataBase().setVariable("chipHutTrimMat_1",0);
+
+  timeModel(*SimPtr,IParam,&benchModel::buildTS2);
+
+  delete SimPtr;
+  ModelSupport::objectRegister::Instance().reset();
+  ModelSupport::surfIndex::Instance().reset();
+  return 0;
+}
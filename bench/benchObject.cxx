@@ -0,0 +1,289 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   bench/benchObject.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <list>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <boost/tuple/tuple.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Transform.h"
+#include "Surface.h"
+#include "Rules.h"
+#include "surfIndex.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "neutron.h"
+#include "surfRegister.h"
+#include "ModelSupport.h"
+#include "BenchFunc.h"
+#include "benchObject.h"
+
+benchObject::benchObject() 
+  /*!
+    Constructor
+  */
+{}
+
+benchObject::~benchObject() 
+  /*!
+    Destructor
+  */
+{
+  ModelSupport::surfIndex::Instance().reset();
+}
+
+void 
+benchObject::createSurfaces()
+  /*!
+    Create the surface list
+   */
+{
+  ELog::RegMethod RegA("benchObject","createSurfaces");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  SurI.reset();
+  
+  // Inner box :
+  SurI.createSurface(1,"px -1");
+  SurI.createSurface(2,"px 1");
+  SurI.createSurface(3,"py -1");
+  SurI.createSurface(4,"py 1");
+  SurI.createSurface(5,"pz -1");
+  SurI.createSurface(6,"pz 1");
+
+  // Outer box :
+  SurI.createSurface(11,"px -3");
+  SurI.createSurface(12,"px 3");
+  SurI.createSurface(13,"py -3");
+  SurI.createSurface(14,"py 3");
+  SurI.createSurface(15,"pz -3");
+  SurI.createSurface(16,"pz 3");
+
+  // Cylinder / sphere :
+  SurI.createSurface(20,"cz 2");
+  SurI.createSurface(100,"so 25");
+  return;
+}
+
+int 
+benchObject::applyBench(const int extra)
+  /*!
+    Applies all the benchmarks 
+    \param extra :: Benchmark number to run
+    \retval 0 : All succeeded
+  */
+{
+  ELog::RegMethod RegA("benchObject","applyBench");
+  BenchFunc::regGroup("benchObject");
+
+  typedef int (benchObject::*benchPtr)();
+  benchPtr TPtr[]=
+    {
+      &benchObject::benchGetComposite,
+      &benchObject::benchIsValid,
+      &benchObject::benchTrackOutCell
+    };
+  const std::string TestName[]=
+    {
+      "GetComposite",
+      "IsValid",
+      "TrackOutCell"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(benchPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+benchObject::benchGetComposite()
+  /*!
+    Time the offset expansion of a cell string
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("benchObject","benchGetComposite");
+
+  BenchFunc& BF=BenchFunc::Instance();
+  const std::string Base("1 -2 3 -4 5 -6 (-11:12:-13:14:-15:16) "
+			 "#T34 -100 (-20:7) 8 -9 T1001");
+
+  const size_t NLoop=BF.nLoop(2000);
+  double best(1e38);
+  size_t check(0);
+  for(size_t r=0;r<BF.getRepeat();r++)
+    {
+      check=0;
+      const double T0=BenchFunc::timer();
+      for(size_t n=0;n<NLoop;n++)
+	check+=ModelSupport::getComposite
+	  (static_cast<int>(n % 1000)*100,Base).size();
+      best=std::min(best,BenchFunc::timer()-T0);
+    }
+  BF.addResult("GetComposite",NLoop,best,
+	       static_cast<double>(check)/static_cast<double>(NLoop));
+  return 0;
+}
+
+int
+benchObject::benchIsValid()
+  /*!
+    Time HeadRule::isValid on a fixed grid of points
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("benchObject","benchIsValid");
+
+  createSurfaces();
+  BenchFunc& BF=BenchFunc::Instance();
+
+  HeadRule HR;
+  if (!HR.procString("-100 (-11:12:-13:14:-15:16) "
+		     "(-1:2:-3:4:-5:6) (20:-5:6)"))
+    throw ColErr::InvalidLine("HeadRule",RegA.getFull(),0);
+  HR.populateSurf();
+
+  const size_t NG(20);
+  std::vector<Geometry::Vec3D> Pts;
+  for(size_t i=0;i<NG;i++)
+    for(size_t j=0;j<NG;j++)
+      for(size_t k=0;k<NG;k++)
+	Pts.push_back(Geometry::Vec3D(-5.0+0.51*static_cast<double>(i),
+				      -5.0+0.53*static_cast<double>(j),
+				      -5.0+0.49*static_cast<double>(k)));
+
+  const size_t NLoop=BF.nLoop(20);
+  double best(1e38);
+  size_t check(0);
+  for(size_t r=0;r<BF.getRepeat();r++)
+    {
+      check=0;
+      const double T0=BenchFunc::timer();
+      for(size_t n=0;n<NLoop;n++)
+	for(size_t i=0;i<Pts.size();i++)
+	  if (HR.isValid(Pts[i])) check++;
+      best=std::min(best,BenchFunc::timer()-T0);
+    }
+  BF.addResult("IsValid",NLoop*Pts.size(),best,
+	       static_cast<double>(check)/static_cast<double>(NLoop));
+  return 0;
+}
+
+int
+benchObject::benchTrackOutCell()
+  /*!
+    Time Object::trackOutCell from points within a 
+    cell over a fan of directions
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("benchObject","benchTrackOutCell");
+
+  createSurfaces();
+  BenchFunc& BF=BenchFunc::Instance();
+
+  MonteCarlo::Qhull A;
+  A.setObject("4 10 0.05 -12 11 -14 13 -16 15 (2:-1:4:-3:6:-5)");
+  A.populate();
+  A.createSurfaceList();
+
+  // Points in the shell between the boxes and directions 
+  std::vector<Geometry::Vec3D> Pts;
+  std::vector<Geometry::Vec3D> Dirs;
+  for(size_t i=0;i<20;i++)
+    {
+      const double x=-2.9+0.29*static_cast<double>(i);
+      Pts.push_back(Geometry::Vec3D(x,2.0,-1.5));
+      Pts.push_back(Geometry::Vec3D(-1.5,x,2.5));
+    }
+  for(size_t i=0;i<16;i++)
+    {
+      const double theta=M_PI*(0.5+static_cast<double>(i))/16.0;
+      for(size_t j=0;j<16;j++)
+	{
+	  const double phi=2.0*M_PI*static_cast<double>(j)/16.0;
+	  Dirs.push_back(Geometry::Vec3D(sin(theta)*cos(phi),
+					 sin(theta)*sin(phi),
+					 cos(theta)));
+	}
+    }
+
+  const size_t NLoop=BF.nLoop(5);
+  double best(1e38);
+  double check(0.0);
+  for(size_t r=0;r<BF.getRepeat();r++)
+    {
+      check=0.0;
+      const double T0=BenchFunc::timer();
+      for(size_t n=0;n<NLoop;n++)
+	for(size_t i=0;i<Pts.size();i++)
+	  for(size_t j=0;j<Dirs.size();j++)
+	    {
+	      double aDist(0.0);
+	      const Geometry::Surface* SPtr(0);
+	      const MonteCarlo::neutron N(1.0,Pts[i],Dirs[j]);
+	      A.trackOutCell(N,aDist,SPtr,0);
+	      check+=aDist;
+	    }
+      best=std::min(best,BenchFunc::timer()-T0);
+    }
+  BF.addResult("TrackOutCell",NLoop*Pts.size()*Dirs.size(),best,
+	       check/static_cast<double>(NLoop));
+  return 0;
+}
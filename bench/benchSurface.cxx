@@ -0,0 +1,165 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   bench/benchSurface.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <boost/tuple/tuple.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "surfaceFactory.h"
+#include "BenchFunc.h"
+#include "benchSurface.h"
+
+benchSurface::benchSurface() 
+  /*!
+    Constructor
+  */
+{}
+
+benchSurface::~benchSurface() 
+  /*!
+    Destructor
+  */
+{}
+
+int 
+benchSurface::applyBench(const int extra)
+  /*!
+    Applies all the benchmarks 
+    \param extra :: Benchmark number to run
+    \retval 0 : All succeeded
+  */
+{
+  ELog::RegMethod RegA("benchSurface","applyBench");
+  BenchFunc::regGroup("benchSurface");
+
+  typedef int (benchSurface::*benchPtr)();
+  benchPtr TPtr[]=
+    {
+      &benchSurface::benchSide
+    };
+  const std::string TestName[]=
+    {
+      "Side"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(benchPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+benchSurface::benchSide()
+  /*!
+    Time Surface::side for each of the main surface 
+    types over a fixed grid of points.
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("benchSurface","benchSide");
+
+  const Geometry::surfaceFactory& SF=
+    Geometry::surfaceFactory::Instance();
+  BenchFunc& BF=BenchFunc::Instance();
+
+  // Name : surface 
+  typedef boost::tuple<std::string,std::string> TTYPE;
+  std::vector<TTYPE> Tests;
+  Tests.push_back(TTYPE("Plane-px","px 1"));
+  Tests.push_back(TTYPE("Plane","p 1 1 1 2"));
+  Tests.push_back(TTYPE("Cylinder-cz","cz 3"));
+  Tests.push_back(TTYPE("Cylinder","c/x 1 2 3"));
+  Tests.push_back(TTYPE("Sphere-so","so 5"));
+  Tests.push_back(TTYPE("Sphere","s 1 2 3 5"));
+  Tests.push_back(TTYPE("Cone","k/z 0 0 1 0.5"));
+  Tests.push_back(TTYPE("General","gq 1 2 3 0 0 0 1 1 1 -10"));
+
+  // Grid of points [-10:10]^3 
+  const size_t NG(20);
+  std::vector<Geometry::Vec3D> Pts;
+  for(size_t i=0;i<NG;i++)
+    for(size_t j=0;j<NG;j++)
+      for(size_t k=0;k<NG;k++)
+	Pts.push_back(Geometry::Vec3D(-10.0+1.01*static_cast<double>(i),
+				      -10.0+1.03*static_cast<double>(j),
+				      -10.0+0.97*static_cast<double>(k)));
+
+  const size_t NLoop=BF.nLoop(50);
+  std::vector<TTYPE>::const_iterator tc;
+  for(tc=Tests.begin();tc!=Tests.end();tc++)
+    {
+      Geometry::Surface* SPtr=SF.processLine(tc->get<1>());
+      if (!SPtr)
+	throw ColErr::InvalidLine(tc->get<1>(),RegA.getFull(),0);
+
+      double best(1e38);
+      int check(0);
+      for(size_t r=0;r<BF.getRepeat();r++)
+	{
+	  check=0;
+	  const double T0=BenchFunc::timer();
+	  for(size_t n=0;n<NLoop;n++)
+	    for(size_t i=0;i<Pts.size();i++)
+	      check+=SPtr->side(Pts[i]);
+	  best=std::min(best,BenchFunc::timer()-T0);
+	}
+      BF.addResult(tc->get<0>(),NLoop*Pts.size(),best,
+		   static_cast<double>(check)/static_cast<double>(NLoop));
+      delete SPtr;
+    }
+  return 0;
+}
@@ -0,0 +1,83 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   benchInc/BenchFunc.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef BenchFunc_h
+#define BenchFunc_h
+
+/*!
+  \class BenchFunc
+  \brief Holds the timing results of the micro-benchmarks
+  \author S. Ansell
+  \date October 2013
+  \version 1.0
+
+  Each kernel is run nRepeat times and the fastest
+  pass is kept. Results are written one per line as
+  : group name nOp ns/op check
+  The check value is a kernel result so that a change in
+  the work done is seen. A reference file of the same 
+  form gives the regression thresholds.
+*/
+
+class BenchFunc
+{
+ private:
+
+  /// Result : full name / number of ops / ns per op / check
+  typedef boost::tuple<std::string,size_t,double,double> RTYPE;
+
+  size_t nRepeat;              ///< Number of repeats [min taken]
+  double scale;                ///< Scale of the loop counts
+
+  std::string BGroup;          ///< Bench group
+  std::vector<RTYPE> Results;  ///< Results in run order
+  
+  BenchFunc();
+  ///\cond NOT WRITTEN
+  BenchFunc(const BenchFunc&);
+  BenchFunc& operator=(const BenchFunc&);
+  ///\endcond NOT WRITTEN
+ 
+public:
+
+  ~BenchFunc();
+
+  static BenchFunc& Instance();
+  static void regGroup(const std::string&);
+  static double timer();
+
+  void setRepeat(const size_t);
+  void setScale(const double);
+  /// Access repeat count
+  size_t getRepeat() const { return nRepeat; }
+  size_t nLoop(const size_t) const;
+
+  void addResult(const std::string&,const size_t,
+		 const double,const double);
+  /// Number of results
+  size_t getNResult() const { return Results.size(); }
+
+  void write(std::ostream&) const;
+  int checkReference(const std::string&,const double,
+		     std::ostream&) const;
+};
+
+#endif
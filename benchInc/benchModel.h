@@ -0,0 +1,72 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   benchInc/benchModel.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef benchModel_h
+#define benchModel_h
+
+class Simulation;
+namespace mainSystem
+{
+  class inputParam;
+}
+
+/*!
+  \class benchModel
+  \brief Timing of the model kernels on full models
+  \author S. Ansell
+  \date October 2013
+  \version 1.0
+
+  The ESS and TS2 models are built as the ess/fullBuild
+  executables do and the build, complement removal,
+  cell finding, equal surface and write steps are timed.
+*/
+
+class benchModel
+{
+ private:
+
+  /// Model build function
+  typedef void (benchModel::*buildPtr)(Simulation&,
+				       const mainSystem::inputParam&);
+
+  void buildESS(Simulation&,const mainSystem::inputParam&);
+  void buildTS2(Simulation&,const mainSystem::inputParam&);
+  void timeModel(Simulation&,const mainSystem::inputParam&,
+		 const buildPtr);
+
+  void timeFindCell(Simulation&);
+  void timeEqualSurf();
+  void timeWrite(Simulation&);
+
+  // Benchmarks
+  int benchESS();
+  int benchTS2();
+  
+ public:
+
+  benchModel();
+  ~benchModel();
+
+  int applyBench(const int);
+};
+
+#endif
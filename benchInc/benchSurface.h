@@ -0,0 +1,48 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   benchInc/benchSurface.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef benchSurface_h
+#define benchSurface_h
+
+/*!
+  \class benchSurface
+  \brief Timing of the surface side kernel
+  \author S. Ansell
+  \date October 2013
+  \version 1.0
+*/
+
+class benchSurface
+{
+ private:
+
+  // Benchmarks
+  int benchSide();
+  
+ public:
+
+  benchSurface();
+  ~benchSurface();
+
+  int applyBench(const int);
+};
+
+#endif
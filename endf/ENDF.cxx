@@ -372,8 +372,10 @@ loglinear(const double& x1,const double& x2,const double& y1,
     \param y1 :: y1 point [at x1]
     \param y2 :: y2 point [at x2]
     \param aimX :: x point for aim
+    \return value [0 if either end point is zero]
    */
 {
+  if (y1<=0.0 || y2<=0.0) return 0.0;
   const double ly1=log(y1);
   const double ly2=log(y2);
   
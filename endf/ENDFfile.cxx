@@ -0,0 +1,732 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   endf/ENDFfile.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <vector>
+#include <map>
+#include <stack>
+#include <string>
+#include <algorithm>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "Triple.h"
+#include "ENDFfile.h"
+
+namespace ENDF
+{
+
+/// Magic string of the index file
+static const char indexMagic[]="CLEIDX02";
+
+std::string ENDFfile::cacheDir(".");
+
+ENDFfile::ENDFfile(const std::string& FN) :
+  FName(FN),fd(open(FN.c_str(),O_RDONLY)),fileSize(0),
+  fileTime(0),Data(0),pos(0),lineCnt(0),LPtr(0),LLen(0),
+  fieldIndex(0)
+  /*!
+    Constructor : maps the file and reads/builds the index
+    \param FN :: ENDF file name
+  */
+{
+  ELog::RegMethod RegA("ENDFfile","constructor");
+
+  struct stat SBuf;
+  if (fd<0 || fstat(fd,&SBuf) || SBuf.st_size<=0)
+    {
+      if (fd>=0) close(fd);
+      throw ColErr::FileError(0,FName,"ENDFfile::ENDFfile");
+    }
+  fileSize=static_cast<size_t>(SBuf.st_size);
+  fileTime=static_cast<long int>(SBuf.st_mtime);
+  void* MPtr=mmap(0,fileSize,PROT_READ,MAP_PRIVATE,fd,0);
+  if (MPtr==MAP_FAILED)
+    {
+      close(fd);
+      throw ColErr::FileError(0,FName,"ENDFfile::mmap");
+    }
+  Data=static_cast<const char*>(MPtr);
+
+  const std::string IName=cacheName(FName,".cidx");
+  if (!readIndex(IName))
+    {
+      buildIndex();
+      writeIndex(IName);
+    }
+}
+
+ENDFfile::~ENDFfile()
+  /*!
+    Destructor : release map and file
+  */
+{
+  munmap(const_cast<char*>(Data),fileSize);
+  close(fd);
+}
+
+void
+ENDFfile::setCacheDir(const std::string& DName)
+  /*!
+    Set the directory for the index and table cache
+    files [created if needed]
+    \param DName :: Directory
+  */
+{
+  ELog::RegMethod RegA("ENDFfile","setCacheDir");
+
+  struct stat SBuf;
+  if (stat(DName.c_str(),&SBuf))
+    {
+      if (mkdir(DName.c_str(),0755))
+	throw ColErr::FileError(0,DName,"ENDFfile::mkdir");
+    }
+  else if (!S_ISDIR(SBuf.st_mode))
+    throw ColErr::FileError(0,DName,"ENDFfile::not directory");
+  cacheDir=DName;
+  return;
+}
+
+std::string
+ENDFfile::cacheName(const std::string& FN,const std::string& Ext)
+  /*!
+    Name of a cache file of an ENDF file. The files are
+    kept in the cache directory not next to the data.
+    \param FN :: ENDF file name
+    \param Ext :: Extension
+    \return cacheDir/basename(FN)Ext
+  */
+{
+  const std::string::size_type pos=FN.rfind('/');
+  return cacheDir+"/"+
+    ((pos==std::string::npos) ? FN : FN.substr(pos+1))+Ext;
+}
+
+int
+ENDFfile::checkCacheHead(std::istream& IX,const char* Magic) const
+  /*!
+    Read and check the head of a cache file :
+    magic string, file size, time and name
+    \param IX :: Input stream
+    \param Magic :: Magic string [8 characters]
+    \return 1 if the cache matches this file
+  */
+{
+  char magic[8];
+  size_t fSize,nLen;
+  long int fTime;
+  IX.read(magic,8);
+  IX.read(reinterpret_cast<char*>(&fSize),sizeof(size_t));
+  IX.read(reinterpret_cast<char*>(&fTime),sizeof(long int));
+  IX.read(reinterpret_cast<char*>(&nLen),sizeof(size_t));
+  if (!IX.good() || strncmp(magic,Magic,8) ||
+      fSize!=fileSize || fTime!=fileTime || nLen!=FName.size())
+    return 0;
+  // same base name in a different directory
+  std::string N(nLen,' ');
+  if (nLen)
+    IX.read(&N[0],static_cast<std::streamsize>(nLen));
+  return (IX.good() && N==FName) ? 1 : 0;
+}
+
+void
+ENDFfile::writeCacheHead(std::ostream& OX,const char* Magic) const
+  /*!
+    Write the head of a cache file 
+    \param OX :: Output stream
+    \param Magic :: Magic string [8 characters]
+  */
+{
+  const size_t nLen(FName.size());
+  OX.write(Magic,8);
+  OX.write(reinterpret_cast<const char*>(&fileSize),sizeof(size_t));
+  OX.write(reinterpret_cast<const char*>(&fileTime),sizeof(long int));
+  OX.write(reinterpret_cast<const char*>(&nLen),sizeof(size_t));
+  OX.write(FName.c_str(),static_cast<std::streamsize>(nLen));
+  return;
+}
+
+double
+ENDFfile::readReal(const char* SPtr,const char* EPtr,int& flag)
+  /*!
+    Read a real from a fixed field. Accepts the ENDF form
+    without the E (1.234567+5) and the normal form (1.2E5).
+    A blank field is zero.
+    \param SPtr :: Start of field
+    \param EPtr :: End of field
+    \param flag :: set to 1 on success / 0 on failure
+    \return value
+  */
+{
+  // powers of 10 that are exact in a double
+  static const double P10[]=
+    {1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+     1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+
+  flag=1;
+  while(SPtr!=EPtr && *SPtr==' ') SPtr++;
+  if (SPtr==EPtr) return 0.0;
+
+  const int sign=(*SPtr=='-') ? -1 : 1;
+  if (*SPtr=='-' || *SPtr=='+') SPtr++;
+
+  unsigned long long mant(0);
+  int nDigit(0);
+  int decExp(0);            // power from digits after '.'/dropped digits
+  int pointFlag(0);
+  for(;SPtr!=EPtr;SPtr++)
+    {
+      if (*SPtr>='0' && *SPtr<='9')
+	{
+	  if (mant<100000000000000000ULL)
+	    {
+	      mant=mant*10+static_cast<unsigned long long>(*SPtr-'0');
+	      if (pointFlag) decExp--;
+	    }
+	  else if (!pointFlag)
+	    decExp++;
+	  nDigit++;
+	}
+      else if (*SPtr=='.' && !pointFlag)
+	pointFlag=1;
+      else
+	break;
+    }
+  if (!nDigit)
+    {
+      flag=0;
+      return 0.0;
+    }
+  // Exponent [E/D with optional sign or sign alone]
+  int expFlag(0);
+  if (SPtr!=EPtr && (*SPtr=='e' || *SPtr=='E' ||
+		     *SPtr=='d' || *SPtr=='D'))
+    {
+      SPtr++;
+      expFlag=1;
+    }
+  if (SPtr!=EPtr && (*SPtr=='-' || *SPtr=='+'))
+    expFlag=1;
+  if (expFlag)
+    {
+      const int eSign=(SPtr!=EPtr && *SPtr=='-') ? -1 : 1;
+      if (SPtr!=EPtr && (*SPtr=='-' || *SPtr=='+')) SPtr++;
+      int eVal(0);
+      int eDigit(0);
+      for(;SPtr!=EPtr && *SPtr>='0' && *SPtr<='9';SPtr++,eDigit++)
+	eVal=eVal*10+(*SPtr-'0');
+      if (!eDigit)
+	{
+	  flag=0;
+	  return 0.0;
+	}
+      decExp+=eSign*eVal;
+    }
+  while(SPtr!=EPtr && *SPtr==' ') SPtr++;
+  if (SPtr!=EPtr)
+    {
+      flag=0;
+      return 0.0;
+    }
+
+  double value=static_cast<double>(mant);
+  if (decExp>0)
+    value*=(decExp<=22) ? P10[decExp] : pow(10.0,decExp);
+  else if (decExp<0)
+    value/=(decExp>=-22) ? P10[-decExp] : pow(10.0,-decExp);
+  return sign*value;
+}
+
+int
+ENDFfile::readInt(const char* SPtr,const char* EPtr,int& flag)
+  /*!
+    Read an integer from a fixed field [blank is zero]
+    \param SPtr :: Start of field
+    \param EPtr :: End of field
+    \param flag :: set to 1 on success / 0 on failure
+    \return value
+  */
+{
+  flag=1;
+  while(SPtr!=EPtr && *SPtr==' ') SPtr++;
+  if (SPtr==EPtr) return 0;
+
+  const int sign=(*SPtr=='-') ? -1 : 1;
+  if (*SPtr=='-' || *SPtr=='+') SPtr++;
+  int value(0);
+  int nDigit(0);
+  for(;SPtr!=EPtr && *SPtr>='0' && *SPtr<='9';SPtr++,nDigit++)
+    value=value*10+(*SPtr-'0');
+  while(SPtr!=EPtr && *SPtr==' ') SPtr++;
+  if (!nDigit || SPtr!=EPtr)
+    flag=0;
+  return sign*value;
+}
+
+Triple<int>
+ENDFfile::lineIndex(const size_t offset,const size_t len) const
+  /*!
+    Read the MAT/MF/MT of a line [columns 67-75]
+    \param offset :: Start of line
+    \param len :: Length of line
+    \return [MAT,MF,MT]
+  */
+{
+  const char* LStart(Data+offset);
+  const char* LEnd(LStart+len);
+  // clip field to the line
+  const char* Col[4];
+  const size_t CPos[4]={66,70,72,75};
+  for(size_t i=0;i<4;i++)
+    Col[i]=(CPos[i]<len) ? LStart+CPos[i] : LEnd;
+
+  Triple<int> Out;
+  int fA,fB,fC;
+  Out.first=readInt(Col[0],Col[1],fA);
+  Out.second=readInt(Col[1],Col[2],fB);
+  Out.third=readInt(Col[2],Col[3],fC);
+  if (!fA || !fB || !fC)
+    throw ColErr::InvalidLine(std::string(LStart,len),
+			      "ENDFfile::lineIndex");
+  return Out;
+}
+
+void
+ENDFfile::buildIndex()
+  /*!
+    Scan the file for the start of each section
+  */
+{
+  ELog::RegMethod RegA("ENDFfile","buildIndex");
+
+  Index.clear();
+  Order.clear();
+  ITYPE::iterator cur(Index.end());
+  Triple<int> lastKey(0,0,0);
+  size_t offset(0);
+  while(offset<fileSize)
+    {
+      const char* NPtr=static_cast<const char*>
+	(memchr(Data+offset,'\n',fileSize-offset));
+      const size_t next=(NPtr) ? static_cast<size_t>(NPtr-Data)+1 : fileSize;
+      size_t len=(NPtr) ? static_cast<size_t>(NPtr-Data)-offset
+	: fileSize-offset;
+      if (len && Data[offset+len-1]=='\r') len--;
+      if (len)
+	{
+	  const Triple<int> Key=lineIndex(offset,len);
+	  if (Key.second>0 && Key.third>0)
+	    {
+	      if (!(Key==lastKey))
+		{
+		  secUnit SU;
+		  SU.offset=offset;
+		  SU.nLine=0;
+		  std::pair<ITYPE::iterator,bool> IP=
+		    Index.insert(ITYPE::value_type(Key,SU));
+		  // repeated section : only the first is indexed
+		  cur=(IP.second) ? IP.first : Index.end();
+		  if (IP.second) Order.push_back(Key);
+		  lastKey=Key;
+		}
+	      if (cur!=Index.end())
+		cur->second.nLine++;
+	    }
+	  else
+	    {
+	      lastKey=Triple<int>(0,0,0);
+	      cur=Index.end();
+	    }
+	}
+      offset=next;
+    }
+  return;
+}
+
+int
+ENDFfile::readIndex(const std::string& IName)
+  /*!
+    Read the index file if it matches this file
+    \param IName :: Index file
+    \return 1 if index read
+  */
+{
+  std::ifstream IX(IName.c_str(),std::ios::binary);
+  if (!IX.good() || !checkCacheHead(IX,indexMagic)) return 0;
+
+  size_t nItem;
+  IX.read(reinterpret_cast<char*>(&nItem),sizeof(size_t));
+  if (!IX.good()) return 0;
+
+  // [offset : key] to rebuild the file order
+  std::vector<std::pair<size_t,Triple<int> > > Items;
+  for(size_t i=0;i<nItem && IX.good();i++)
+    {
+      int MMM[3];
+      secUnit SU;
+      IX.read(reinterpret_cast<char*>(MMM),3*sizeof(int));
+      IX.read(reinterpret_cast<char*>(&SU.offset),sizeof(size_t));
+      IX.read(reinterpret_cast<char*>(&SU.nLine),sizeof(size_t));
+      if (SU.offset>=fileSize) return 0;
+      const Triple<int> Key(MMM[0],MMM[1],MMM[2]);
+      Index.insert(ITYPE::value_type(Key,SU));
+      Items.push_back(std::pair<size_t,Triple<int> >(SU.offset,Key));
+    }
+  if (!IX.good() || Index.size()!=nItem)
+    {
+      Index.clear();
+      return 0;
+    }
+  std::sort(Items.begin(),Items.end());
+  Order.clear();
+  for(size_t i=0;i<Items.size();i++)
+    Order.push_back(Items[i].second);
+  return 1;
+}
+
+int
+ENDFfile::writeIndex(const std::string& IName) const
+  /*!
+    Write the index file. A failed write is reported
+    and the index is rebuilt on the next read.
+    \param IName :: Index file
+    \return 1 on success / 0 on failure
+  */
+{
+  ELog::RegMethod RegA("ENDFfile","writeIndex");
+
+  std::ofstream OX((IName+".tmp").c_str(),std::ios::binary);
+  const size_t nItem(Index.size());
+  writeCacheHead(OX,indexMagic);
+  OX.write(reinterpret_cast<const char*>(&nItem),sizeof(size_t));
+  ITYPE::const_iterator mc;
+  for(mc=Index.begin();mc!=Index.end();mc++)
+    {
+      const int MMM[3]={mc->first.first,mc->first.second,mc->first.third};
+      OX.write(reinterpret_cast<const char*>(MMM),3*sizeof(int));
+      OX.write(reinterpret_cast<const char*>(&mc->second.offset),
+	       sizeof(size_t));
+      OX.write(reinterpret_cast<const char*>(&mc->second.nLine),
+	       sizeof(size_t));
+    }
+  OX.close();
+  return closeCache(OX,IName);
+}
+
+int
+ENDFfile::closeCache(const std::ostream& OX,const std::string& CName)
+  /*!
+    Move a written cache file [CName.tmp] into place or
+    report the failure and remove it
+    \param OX :: Closed output stream 
+    \param CName :: Cache file
+    \return 1 on success / 0 on failure
+  */
+{
+  if (OX.fail() || 
+      std::rename((CName+".tmp").c_str(),CName.c_str()))
+    {
+      ELog::EM<<"Unable to write ENDF cache file "<<CName<<ELog::endWarn;
+      std::remove((CName+".tmp").c_str());
+      return 0;
+    }
+  return 1;
+}
+
+int
+ENDFfile::firstMat() const
+  /*!
+    Get the first material in the file
+    \return MAT number [0 if no sections]
+  */
+{
+  return (Order.empty()) ? 0 : Order.front().first;
+}
+
+int
+ENDFfile::hasSection(const int aimMAT,const int aimMF,
+		     const int aimMT) const
+  /*!
+    Determine if a section exists
+    \param aimMAT :: material number
+    \param aimMF :: format
+    \param aimMT :: table
+    \return 1 if found
+  */
+{
+  return (Index.find(Triple<int>(aimMAT,aimMF,aimMT))!=Index.end()) ? 1 : 0;
+}
+
+void
+ENDFfile::findSection(const int aimMAT,const int aimMF,
+		      const int aimMT)
+  /*!
+    Move the read point to the start (HEAD record) of a
+    section. A zero value matches any value [first in the file]
+    \param aimMAT :: material number
+    \param aimMF :: format
+    \param aimMT :: table
+  */
+{
+  ELog::RegMethod RegA("ENDFfile","findSection");
+
+  ITYPE::const_iterator mc=
+    Index.find(Triple<int>(aimMAT,aimMF,aimMT));
+  if (mc==Index.end() && (!aimMAT || !aimMF || !aimMT))
+    {
+      std::vector<Triple<int> >::const_iterator vc;
+      for(vc=Order.begin();vc!=Order.end();vc++)
+	if ((vc->first==aimMAT || !aimMAT) &&
+	    (vc->second==aimMF || !aimMF) &&
+	    (vc->third==aimMT || !aimMT))
+	  {
+	    mc=Index.find(*vc);
+	    break;
+	  }
+    }
+  if (mc==Index.end())
+    {
+      std::ostringstream cx;
+      cx<<FName<<" : "<<aimMAT<<" "<<aimMF<<" "<<aimMT;
+      throw ColErr::InContainerError<std::string>
+	(cx.str(),"ENDFfile::findSection");
+    }
+  pos=mc->second.offset;
+  LPtr=0;
+  LLen=0;
+  fieldIndex=0;
+  return;
+}
+
+void
+ENDFfile::nextLine()
+  /*!
+    Move to the next line [throws at end of file]
+  */
+{
+  if (pos>=fileSize)
+    throw ColErr::FileError(0,FName,"ENDFfile::nextLine");
+
+  LPtr=Data+pos;
+  const char* NPtr=static_cast<const char*>
+    (memchr(LPtr,'\n',fileSize-pos));
+  LLen=(NPtr) ? static_cast<size_t>(NPtr-LPtr) : fileSize-pos;
+  pos+=(NPtr) ? LLen+1 : LLen;
+  if (LLen && LPtr[LLen-1]=='\r') LLen--;
+  // only the 66 data columns are read
+  if (LLen>66) LLen=66;
+  fieldIndex=0;
+  lineCnt++;
+  return;
+}
+
+void
+ENDFfile::lineError(const std::string& Method) const
+  /*!
+    Throw an error for the current line
+    \param Method :: Calling method
+  */
+{
+  std::ostringstream cx;
+  cx<<"ENDFfile::"<<Method<<" ["<<FName<<":"<<lineCnt<<"]";
+  throw ColErr::InvalidLine((LPtr) ? std::string(LPtr,LLen) : "",
+			    cx.str(),fieldIndex);
+}
+
+double
+ENDFfile::realField()
+  /*!
+    Read the next 11 column real field of the current line
+    \return value
+  */
+{
+  const size_t SPos(11*fieldIndex);
+  if (fieldIndex>=6)
+    lineError("realField");
+  const char* SPtr=LPtr+std::min(SPos,LLen);
+  const char* EPtr=LPtr+std::min(SPos+11,LLen);
+  int flag;
+  const double Out=readReal(SPtr,EPtr,flag);
+  if (!flag)
+    lineError("realField");
+  fieldIndex++;
+  return Out;
+}
+
+int
+ENDFfile::intField()
+  /*!
+    Read the next 11 column integer field of the current line
+    \return value
+  */
+{
+  const size_t SPos(11*fieldIndex);
+  if (fieldIndex>=6)
+    lineError("intField");
+  const char* SPtr=LPtr+std::min(SPos,LLen);
+  const char* EPtr=LPtr+std::min(SPos+11,LLen);
+  int flag;
+  const int Out=readInt(SPtr,EPtr,flag);
+  if (!flag)
+    lineError("intField");
+  fieldIndex++;
+  return Out;
+}
+
+void
+ENDFfile::headRead(double& c1,double& c2,
+		   int &l1,int& l2,int& n1,int& n2)
+  /*!
+    Read a HEAD/CONT record
+    - Format : 2e11.0,4I11
+    \param c1 :: double number
+    \param c2 :: double number
+    \param l1 :: int number
+    \param l2 :: int number
+    \param n1 :: int number
+    \param n2 :: int number
+   */
+{
+  nextLine();
+  c1=realField();
+  c2=realField();
+  l1=intField();
+  l2=intField();
+  n1=intField();
+  n2=intField();
+  return;
+}
+
+void
+ENDFfile::listRead(double& c1,double& c2,
+		   int &l1,int& l2,int& npl,int& n2,
+		   std::vector<double>& Data)
+  /*!
+    Processes the list with the parameter
+    - Format : 2e11.0,4I11
+    - Format : 6e11.0
+    \param c1 :: double number
+    \param c2 :: double number
+    \param l1 :: int number
+    \param l2 :: int number
+    \param npl :: number of points
+    \param n2 :: int number
+    \param Data :: Data vector
+  */
+{
+  headRead(c1,c2,l1,l2,npl,n2);
+  Data.resize(static_cast<size_t>(std::max(npl,0)));
+  for(size_t i=0;i<Data.size();i++)
+    {
+      if (!(i % 6)) nextLine();
+      Data[i]=realField();
+    }
+  return;
+}
+
+void
+ENDFfile::table1Read(double& c1,double& c2,
+		     int& l1,int& l2,int& nr,int& np,
+		     std::vector<int>& NBT,
+		     std::vector<int>& INT,
+		     std::vector<double>& XData,
+		     std::vector<double>& YData)
+  /*!
+    Read and process a table of type 1.
+    - format(2e11,4i11)
+    - format(6i11)
+    - format(6e11.0)
+    \param c1 :: double number
+    \param c2 :: double number
+    \param l1 :: int number
+    \param l2 :: int number
+    \param nr :: number of records
+    \param np :: number of points
+    \param NBT :: tables
+    \param INT :: Interpolation type
+    \param XData :: Data vector
+    \param YData :: Data vector
+   */
+{
+  table2Read(c1,c2,l1,l2,nr,np,NBT,INT);
+
+  const size_t NP(static_cast<size_t>(std::max(np,0)));
+  XData.resize(NP);
+  YData.resize(NP);
+  for(size_t i=0;i<NP;i++)
+    {
+      if (!(i % 3)) nextLine();
+      XData[i]=realField();
+      YData[i]=realField();
+    }
+  return;
+}
+
+void
+ENDFfile::table2Read(double& c1,double& c2,
+		     int &l1,int& l2,int& nr,int& nz,
+		     std::vector<int>& NBT,
+		     std::vector<int>& INT)
+  /*!
+    Processes the tab2 with the parameter
+    - Format (2e11,4I11)
+    - Format (6i11)
+    \param c1 :: double number
+    \param c2 :: double number
+    \param l1 :: int number
+    \param l2 :: int number
+    \param nr :: number of points
+    \param nz :: int number
+    \param NBT :: First data unit
+    \param INT :: Second data unit
+   */
+{
+  headRead(c1,c2,l1,l2,nr,nz);
+
+  const size_t NR(static_cast<size_t>(std::max(nr,0)));
+  NBT.resize(NR);
+  INT.resize(NR);
+  for(size_t i=0;i<NR;i++)
+    {
+      if (!(i % 3)) nextLine();
+      NBT[i]=intField();
+      INT[i]=intField();
+    }
+  return;
+}
+
+}  // NAMESPACE ENDF
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <sstream>
 #include <cmath>
+#include <cstdio>
 #include <list>
 #include <vector>
 #include <map>
@@ -44,9 +45,9 @@
 #include "Triple.h"
 #include "support.h"
 #include "RefCon.h"
-#include "Simpson.h"
 #include "neutMaterial.h"
 #include "ENDF.h"
+#include "ENDFfile.h"
 #include "SQWtable.h"
 #include "SEtable.h"
 #include "ENDFmaterial.h"
@@ -132,37 +133,33 @@ ENDFmaterial::~ENDFmaterial()
 {}
  
 void
-ENDFmaterial::procZaid(std::string& Line)
+ENDFmaterial::procZaid(ENDFfile& EF)
   /*!
-    Process Zaid
-    \param Line :: Line to process
+    Process Zaid [HEAD record of MF 7 MT 4]
+    \param EF :: ENDF file at the section start
   */
 {
   ELog::RegMethod RegA("ENDFmaterial","procZaid");
   
   double DZ;
-  int N;
-  if (!getNumber(Line,DZ) || !getNumber(Line,AWR) ||
-      !StrFunc::section(Line,N) || !StrFunc::section(Line,LAT) ||
-      !StrFunc::section(Line,LASYM) )
-    throw ColErr::InvalidLine(Line,"ENDFmaterial::procZaid");
-  
+  int N,N2;
+  EF.headRead(DZ,AWR,N,LAT,LASYM,N2);
   ZA=static_cast<int>(DZ);
   return;
 }
 
 void
-ENDFmaterial::procB(std::istream& IX)
+ENDFmaterial::procB(ENDFfile& EF)
   /*!
     Process flags / Bpts
-    \param IX :: File to process from
+    \param EF :: File to process from
   */
 {
   ELog::RegMethod RegA("ENDFmaterial","procB");
   double c1,c2;
   int b;
   B.clear();
-  listRead(IX,c1,c2,LLN,b,NI,NS,B);
+  EF.listRead(c1,c2,LLN,b,NI,NS,B);
   
   ELog::EM<<"Diag c1 c2:: "<<c1<<" "<<c2<<ELog::endDiag;
   ELog::EM<<"Diag lln,b,ni,ns,(B) :: "<<LLN<<" "<<b<<" "<<NI<<" "<<NS
@@ -174,18 +171,18 @@ ENDFmaterial::procB(std::istream& IX)
 }
 
 void
-ENDFmaterial::procBeta(std::istream& IX)
+ENDFmaterial::procBeta(ENDFfile& EF)
   /*!
     Process the Beta line
-    \param IX :: File to process from
+    \param EF :: File to process from
    */
 {
   ELog::RegMethod RegA("ENDFmaterial","procBeta");
   
   double c1,c2;
   int a,b,nr,nb;
-  table2Read(IX,c1,c2,a,b,nr,nb,
-	     Sn.betaIBoundary,Sn.betaInterp);
+  EF.table2Read(c1,c2,a,b,nr,nb,
+		Sn.betaIBoundary,Sn.betaInterp);
   
   Sn.setNBeta(static_cast<size_t>(nb));
   ELog::EM<<"Number of beta == "<<nb<<ELog::endDebug;
@@ -198,10 +195,10 @@ ENDFmaterial::procBeta(std::istream& IX)
 }
 
 void
-ENDFmaterial::procAlpha(std::istream& IX)
+ENDFmaterial::procAlpha(ENDFfile& EF)
   /*!
     Process the alpha line
-    \param IX :: input stream
+    \param EF :: File to process from
    */
 {
   ELog::RegMethod RegA("ENDFmaterial","procAlpha");
@@ -212,12 +209,12 @@ ENDFmaterial::procAlpha(std::istream& IX)
   std::vector<double> YDATA;
 
 
-  table1Read(IX,c1,c2,NT,b,nr,np,Sn.alphaIBoundary,
-	     Sn.alphaInterp,XDATA,YDATA);
+  EF.table1Read(c1,c2,NT,b,nr,np,Sn.alphaIBoundary,
+		Sn.alphaInterp,XDATA,YDATA);
   NT++;        // Number of temperatures
   for(size_t j=0;j<static_cast<size_t>(NT);j++)
     {
-      if (j) listRead(IX,c1,c2,li,a,np,b,YDATA);
+      if (j) EF.listRead(c1,c2,li,a,np,b,YDATA);
       if (tmpIndex==j)
 	{
 	  Sn.setNAlpha(static_cast<size_t>(np));
@@ -242,12 +239,12 @@ ENDFmaterial::procAlpha(std::istream& IX)
   
   for(size_t i=1;i<Sn.nBeta;i++)
     {
-      table1Read(IX,c1,c2,nt,b,nr,np,IB,II,XDATA,YDATA);
+      EF.table1Read(c1,c2,nt,b,nr,np,IB,II,XDATA,YDATA);
       if (Sn.checkAlpha(IB,II,XDATA)) 
 	throw ColErr::ExitAbort("SN.checkAlpha");
       for(size_t j=0;j<static_cast<size_t>(NT);j++)
 	{
-	  if (j) listRead(IX,c1,c2,li,a,np,b,YDATA);
+	  if (j) EF.listRead(c1,c2,li,a,np,b,YDATA);
 	  if (tmpIndex==j)
 	    {
 	      Sn.Beta[i]=c2;
@@ -259,10 +256,10 @@ ENDFmaterial::procAlpha(std::istream& IX)
 }
 
 void
-ENDFmaterial::procTeff(std::istream& IX)
+ENDFmaterial::procTeff(ENDFfile& EF)
   /*!
     Process the Teff Line
-    \param IX :: input stream
+    \param EF :: File to process from
   */
 {
   ELog::RegMethod RegA("ENDFmaterial","procTeff");
@@ -275,7 +272,7 @@ ENDFmaterial::procTeff(std::istream& IX)
   std::vector<double> YDATA;
   // Beta[0] READ:
   Teff.clear();
-  table1Read(IX,c1,c2,a,b,nr,nb,NBT,INT,XDATA,YDATA);
+  EF.table1Read(c1,c2,a,b,nr,nb,NBT,INT,XDATA,YDATA);
   if (YDATA.size()<=tmpIndex)
     {
       ELog::EM<<"Error with number of Teff:"<<YDATA.size()<<ELog::endErr;
@@ -286,7 +283,7 @@ ENDFmaterial::procTeff(std::istream& IX)
   while(B.size()>index)
     {
       if (B[index]==0.0)
-	table1Read(IX,c1,c2,a,b,nr,nb,NBT,INT,XDATA,YDATA);
+	EF.table1Read(c1,c2,a,b,nr,nb,NBT,INT,XDATA,YDATA);
       if (YDATA.size()<=tmpIndex)
 	{
 	  ELog::EM<<"Error with number of Teff:"
@@ -299,10 +296,169 @@ ENDFmaterial::procTeff(std::istream& IX)
   return;  
 }
 
+/// Magic string of the table cache
+static const char cacheMagic[]="CLESQW02";
+
+/*!
+  Write a POD value to a binary stream
+  \param OX :: Output stream
+  \param V :: Value
+*/
+template<typename T>
+static void
+writeItem(std::ostream& OX,const T& V)
+{
+  OX.write(reinterpret_cast<const char*>(&V),sizeof(T));
+  return;
+}
+
+/*!
+  Write a vector [size : items] to a binary stream
+  \param OX :: Output stream
+  \param V :: Vector
+*/
+template<typename T>
+static void
+writeVec(std::ostream& OX,const std::vector<T>& V)
+{
+  writeItem(OX,V.size());
+  if (!V.empty())
+    OX.write(reinterpret_cast<const char*>(&V[0]),
+	     static_cast<std::streamsize>(V.size()*sizeof(T)));
+  return;
+}
+
+/*!
+  Read a POD value from a binary stream
+  \param IX :: Input stream
+  \param V :: Value
+  \return stream state
+*/
+template<typename T>
+static bool
+readItem(std::istream& IX,T& V)
+{
+  IX.read(reinterpret_cast<char*>(&V),sizeof(T));
+  return IX.good();
+}
+
+/*!
+  Read a vector [size : items] from a binary stream
+  \param IX :: Input stream
+  \param V :: Vector
+  \return stream state
+*/
+template<typename T>
+static bool
+readVec(std::istream& IX,std::vector<T>& V)
+{
+  size_t N;
+  if (!readItem(IX,N) || N>(1UL<<28)) return 0;
+  V.resize(N);
+  if (N)
+    IX.read(reinterpret_cast<char*>(&V[0]),
+	    static_cast<std::streamsize>(N*sizeof(T)));
+  return IX.good();
+}
+
+int
+ENDFmaterial::readCache(const std::string& CName,const ENDFfile& EF)
+  /*!
+    Read the parsed tables from the binary cache. The
+    cache is only used if the ENDF file name, size and time match.
+    \param CName :: Cache file
+    \param EF :: ENDF file
+    \return 1 on success
+  */
+{
+  ELog::RegMethod RegA("ENDFmaterial","readCache");
+
+  std::ifstream IX(CName.c_str(),std::ios::binary);
+  size_t tIndex,NA,NB;
+  if (!IX.good() || !EF.checkCacheHead(IX,cacheMagic) ||
+      !readItem(IX,tIndex) || tIndex!=tmpIndex)
+    return 0;
+
+  std::vector<double> SData,EVec,SVec;
+  if (!readItem(IX,mat) || !readItem(IX,tempActual) ||
+      !readItem(IX,ZA) || !readItem(IX,AWR) ||
+      !readItem(IX,LAT) || !readItem(IX,LASYM) ||
+      !readItem(IX,LLN) || !readItem(IX,NS) ||
+      !readItem(IX,NI) || !readItem(IX,NT) ||
+      !readVec(IX,B) || !readVec(IX,Teff) ||
+      !readItem(IX,NA) || !readItem(IX,NB) ||
+      !readVec(IX,Sn.alphaInterp) || !readVec(IX,Sn.alphaIBoundary) ||
+      !readVec(IX,Sn.betaInterp) || !readVec(IX,Sn.betaIBoundary))
+    return 0;
+
+  Sn.setNAlpha(NA);
+  Sn.setNBeta(NB);
+  if (!readVec(IX,Sn.Alpha) || !readVec(IX,Sn.Beta) ||
+      !readVec(IX,SData) || !readVec(IX,EVec) ||
+      !readVec(IX,SVec) || Sn.Alpha.size()!=NA ||
+      Sn.Beta.size()!=NB || SData.size()!=NA*NB ||
+      EVec.size()!=SVec.size())
+    return 0;
+
+  std::copy(SData.begin(),SData.end(),Sn.SAB.data());
+  SE.clear();
+  for(size_t i=0;i<EVec.size();i++)
+    SE.addEnergy(EVec[i],SVec[i]);
+
+  return 1;
+}
+
+int
+ENDFmaterial::writeCache(const std::string& CName,
+			 const ENDFfile& EF) const
+  /*!
+    Write the parsed tables to the binary cache.
+    A failed write is reported and the tables are 
+    parsed again on the next load.
+    \param CName :: Cache file
+    \param EF :: ENDF file
+    \return 1 on success / 0 on failure
+  */
+{
+  ELog::RegMethod RegA("ENDFmaterial","writeCache");
+
+  std::ofstream OX((CName+".tmp").c_str(),std::ios::binary);
+  EF.writeCacheHead(OX,cacheMagic);
+  writeItem(OX,tmpIndex);
+  writeItem(OX,mat);
+  writeItem(OX,tempActual);
+  writeItem(OX,ZA);
+  writeItem(OX,AWR);
+  writeItem(OX,LAT);
+  writeItem(OX,LASYM);
+  writeItem(OX,LLN);
+  writeItem(OX,NS);
+  writeItem(OX,NI);
+  writeItem(OX,NT);
+  writeVec(OX,B);
+  writeVec(OX,Teff);
+  writeItem(OX,Sn.nAlpha);
+  writeItem(OX,Sn.nBeta);
+  writeVec(OX,Sn.alphaInterp);
+  writeVec(OX,Sn.alphaIBoundary);
+  writeVec(OX,Sn.betaInterp);
+  writeVec(OX,Sn.betaIBoundary);
+  writeVec(OX,Sn.Alpha);
+  writeVec(OX,Sn.Beta);
+  writeVec(OX,std::vector<double>
+	   (Sn.SAB.data(),Sn.SAB.data()+Sn.SAB.num_elements()));
+  writeVec(OX,SE.getE());
+  writeVec(OX,SE.getSTotal());
+  OX.close();
+  return ENDFfile::closeCache(OX,CName);
+}
+
 int
 ENDFmaterial::ENDF7file(const std::string& FName)
   /*!
-    Process the whole file
+    Process the whole file. The file is memory mapped and 
+    indexed and the parsed tables are read from the binary 
+    cache if it is current.
     \param FName :: file
     \retval 0 on success 
     \retval -1 on exeception
@@ -310,46 +466,36 @@ ENDFmaterial::ENDF7file(const std::string& FName)
 {
   ELog::RegMethod RegA("ENDFmaterial","ENDF7file");
   
-  typedef std::pair<std::string,std::string> LTYPE;
-
-  std::ifstream IX;
-  LTYPE IA;
   try
     {
-      IX.open(FName.c_str());
-      if (!IX.good())
+      ENDFfile EF(FName);
+      std::ostringstream cx;
+      cx<<".t"<<tmpIndex<<".sqw";
+      const std::string CName=ENDFfile::cacheName(FName,cx.str());
+      if (readCache(CName,EF))
 	{
-	  ELog::EM<<"Failed to to open file "<<FName<<ELog::endErr;
-	  return -1;
-	}      
-      ENDF::lineCnt=0;
+	  Sn.makeGrid(std::min<size_t>(4*Sn.nAlpha,2048),
+		      std::min<size_t>(4*Sn.nBeta,2048));
+	  return 0;
+	}
 
-      
       // Determine the Mat number :
-      Triple<int> Index;
-      do 
-	{
-	  LTYPE IA=getLine(IX);
-	  Index=getMatIndex(IA.second);
-	} while(!Index.second);
-      mat=Index.first;
-      // Get Zaid + Symmetry
-      std::string Line=findMatMfMt(IX,mat,7,4);
+      mat=EF.firstMat();
       // Get Zaid + Symmetry
-      ELog::EM<<"Zaid Line ["<<lineCnt<<"]== "<<Line<<"::"<<ELog::endDebug;
-      
-      procZaid(Line);
+      EF.findSection(mat,7,4);
+      procZaid(EF);
       // Get Bs:
-      procB(IX);
+      procB(EF);
       // Beta 
-      procBeta(IX);
+      procBeta(EF);
       // Alpha
-      procAlpha(IX);
+      procAlpha(EF);
       // Teff
-      procTeff(IX);
+      procTeff(EF);
 
       // Populate SEtable:
       populateSETable();
+      writeCache(CName,EF);
     }
   catch (ColErr::ExBase& A)
     {
@@ -361,27 +507,17 @@ ENDFmaterial::ENDF7file(const std::string& FName)
   return 0;
 }
 
-
 double
-ENDFmaterial::Sab(const size_t atomIndex,const double E,
-		  const double Eprime,const double mu) const
+ENDFmaterial::atomSab(const size_t atomIndex,const double alpha,
+		      const double beta) const
   /*!
-    Calculate S(q,omega) for a neutron of energy E, for a given
-    atom index [not primary]
-    \param atomIndex :: Atom index
-    \param E :: Energy of neutron [eV]
-    \param Eprime :: Final Energy of neutron [eV]
-    \param mu :: cos(angle)
-    \return S(Q,w)
+    Calculate S(alpha,beta) for a given atom index 
+    \param atomIndex :: Atom index [0 : principle]
+    \param alpha :: momentum transfer [unitless]
+    \param beta :: energy transfer [unitless]
+    \return S(alpha,beta)
   */
 {
-  ELog::RegMethod RegA("ENDFmaterial","Sab");
-
-  const double alpha=(Eprime+E-2*mu*sqrt(Eprime*E))/
-    (AWR*RefCon::k_bev*tempActual);
-
-  const double beta=(Eprime-E)/(tempActual*RefCon::k_bev);
-  
   if (atomIndex==0) 
     return Sn.Sab(alpha,beta);
   
@@ -404,6 +540,27 @@ ENDFmaterial::Sab(const size_t atomIndex,const double E,
   return 0.0;
 }
 
+double
+ENDFmaterial::Sab(const size_t atomIndex,const double E,
+		  const double Eprime,const double mu) const
+  /*!
+    Calculate S(q,omega) for a neutron of energy E, for a given
+    atom index [not primary]
+    \param atomIndex :: Atom index
+    \param E :: Energy of neutron [eV]
+    \param Eprime :: Final Energy of neutron [eV]
+    \param mu :: cos(angle)
+    \return S(Q,w)
+  */
+{
+  const double alpha=(Eprime+E-2*mu*sqrt(Eprime*E))/
+    (AWR*RefCon::k_bev*tempActual);
+
+  const double beta=(Eprime-E)/(tempActual*RefCon::k_bev);
+  
+  return atomSab(atomIndex,alpha,beta);
+}
+
 
 double
 ENDFmaterial::dSdOdE(const double E,const double Eprime,
@@ -416,8 +573,6 @@ ENDFmaterial::dSdOdE(const double E,const double Eprime,
     \return do/dOde=S(Q,w)  [barns/str/ev] 
   */
 {
-  ELog::RegMethod RegA("ENDFmaterial","dSdOdE");
-
   const double beta=(Eprime-E)/(tempActual*RefCon::k_bev);
   const double fact=sqrt(Eprime/E)/
     (4.0*M_PI*RefCon::k_bev*tempActual);
@@ -432,31 +587,99 @@ ENDFmaterial::dSdOdE(const double E,const double Eprime,
   return sigma*fact*symFactor;
 }
 
+double
+ENDFmaterial::sigmaE(const double E) const
+  /*!
+    Integrate dSdOdE over E' [Simpson 250 intervals 
+    from E/51 to 4E] and mu [20 point sum]. 
+    The E' terms that do not depend on mu (beta, Simpson 
+    weight, flux factor) are set once in flat arrays so the 
+    inner loop is only the alpha and S(alpha,beta) evaluation.
+    \param E :: Energy of neutron [eV]
+    \return sigma(E) / (2pi * mu-step)
+  */
+{
+  const int NInt(250);
+  const size_t NPts(2*NInt+1);
+  const double EA(E/51.0);
+  const double hStep=(4.0*E-EA)/(2*NInt);
+  const double kT(tempActual*RefCon::k_bev);
+  const double aScale(1.0/(AWR*kT));
+
+  // atom weights
+  std::vector<double> AWeight;
+  for(size_t i=0;i<=static_cast<size_t>(NS);i++)
+    {
+      const size_t bI(i*6);
+      AWeight.push_back(B[bI]*pow((B[bI+2]+1.0)/B[bI+2],2.0));
+    }
+  
+  std::vector<double> EPE(NPts);      // E'+E
+  std::vector<double> SqEE(NPts);     // 2 sqrt(E' E)
+  std::vector<double> BetaV(NPts);    // beta
+  std::vector<double> W(NPts);        // Simpson weight * factors
+  for(size_t k=0;k<NPts;k++)
+    {
+      const double Eprime=EA+hStep*static_cast<double>(k);
+      const double beta=(Eprime-E)/kT;
+      const double symFactor=(LASYM) ? exp(-beta/2) : 1.0;
+      const double sW=(k==0 || k+1==NPts) ? 1.0 : ((k % 2) ? 4.0 : 2.0);
+      EPE[k]=Eprime+E;
+      SqEE[k]=2.0*sqrt(Eprime*E);
+      BetaV[k]=beta;
+      W[k]=sW*(hStep/3.0)*symFactor*
+	sqrt(Eprime/E)/(4.0*M_PI*kT);
+    }
+
+  double sigma(0.0);
+  for(int i=-10;i<10;i++)
+    {
+      const double mu(i*0.1);
+      for(size_t k=0;k<NPts;k++)
+	{
+	  const double alpha=(EPE[k]-mu*SqEE[k])*aScale;
+	  double S(0.0);
+	  for(size_t a=0;a<AWeight.size();a++)
+	    S+=AWeight[a]*atomSab(a,alpha,BetaV[k]);
+	  sigma+=W[k]*S;
+	}
+    }
+  return sigma;
+}
+
 void
 ENDFmaterial::populateSETable()
   /*!
-    Create table of sigma(E)
+    Create table of sigma(E).
+    S(alpha,beta) is first sampled on to a grid and the 
+    energies are then calculated in parallel.
   */
 {
   ELog::RegMethod RegA("ENDFmaterial","populateSETable");
   
   const double Eend(4.0);
   const double NSteps(500);
-  SE.clear();
-  for(int i=1;i<NSteps;i++)
+  const int nStep(static_cast<int>(NSteps));
+
+  Sn.makeGrid(std::min<size_t>(4*Sn.nAlpha,2048),
+	      std::min<size_t>(4*Sn.nBeta,2048));
+
+  std::vector<double> EVec(static_cast<size_t>(nStep));
+  std::vector<double> SVec(static_cast<size_t>(nStep));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,4)
+#endif
+  for(int i=1;i<nStep;i++)
     {
+      const size_t index(static_cast<size_t>(i));
       const double E=(exp(i/NSteps)-1.0)*Eend/(exp(1)-1.0);
-      double sigma(0.0);
-      for(int i=-10;i<10;i++)
-	{
-	  const double mu(i*0.1);
-	  ePrimeFunc XX=ePrimeFunc(*this,E,mu);
-	  sigma+=Simpson::integrate<ePrimeFunc>(250,E/51,4*E,XX);
-	}
-      sigma*=0.1;     // step size:
-      sigma*=2*M_PI;  // Integral of theta
-      SE.addEnergy(E,sigma);
+      EVec[index]=E;
+      SVec[index]=sigmaE(E)*0.1*2*M_PI;   // mu step / theta integral
     }
+
+  SE.clear();
+  for(size_t i=1;i<static_cast<size_t>(nStep);i++)
+    SE.addEnergy(EVec[i],SVec[i]);
   
   return;
 }
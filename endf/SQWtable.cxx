@@ -50,9 +50,13 @@
 
 namespace ENDF
 {
+
+const double SQWtable::zeroLnS(-700.0);
   
 SQWtable::SQWtable() : 
-  nAlpha(0),nBeta(0)
+  nAlpha(0),nBeta(0),nGA(0),nGB(0),
+  aLow(0.0),aHigh(0.0),bLow(0.0),bHigh(0.0),
+  invDA(0.0),invDB(0.0)
   /*!
     Constructor
   */
@@ -64,7 +68,10 @@ SQWtable::SQWtable(const SQWtable& A) :
   SAB(A.SAB),alphaInterp(A.alphaInterp),
   alphaIBoundary(A.alphaIBoundary),
   betaInterp(A.betaInterp),
-  betaIBoundary(A.betaIBoundary)
+  betaIBoundary(A.betaIBoundary),
+  nGA(A.nGA),nGB(A.nGB),aLow(A.aLow),aHigh(A.aHigh),
+  bLow(A.bLow),bHigh(A.bHigh),invDA(A.invDA),invDB(A.invDB),
+  lnGrid(A.lnGrid)
   /*!
     Copy Constructor
     \param A :: SQWtable to copy
@@ -90,6 +97,15 @@ SQWtable::operator=(const SQWtable& A)
       alphaIBoundary=A.alphaIBoundary;
       betaInterp=A.betaInterp;
       betaIBoundary=A.betaIBoundary;
+      nGA=A.nGA;
+      nGB=A.nGB;
+      aLow=A.aLow;
+      aHigh=A.aHigh;
+      bLow=A.bLow;
+      bHigh=A.bHigh;
+      invDA=A.invDA;
+      invDB=A.invDB;
+      lnGrid=A.lnGrid;
     }
   return *this;
 }			
@@ -244,27 +260,17 @@ SQWtable::isValidRangePt(const double& alphaV,const double& betaV,
 }
 
 double
-SQWtable::Sab(const double alphaV,const double betaV) const
+SQWtable::interpSab(const long int aInt,const long int bInt,
+		    const double alphaV,const double betaV) const
   /*!
-    Calculate S(q,omega) for a neutron of energy E.
-    \param alphaV :: Q-values
-    \param betaV :: energy transfer
-    \return S(Q,w)
+    Log-linear interpolation in a table cell
+    \param aInt :: low alpha index
+    \param bInt :: low beta index
+    \param alphaV :: alpha value
+    \param betaV :: beta value
+    \return S(alpha,beta)
   */
 {
-  ELog::RegMethod RegA("SQWtable","Sab");
-
-  long int aInt,bInt;
-  if (!isValidRangePt(alphaV,betaV,aInt,bInt))
-    {
-      // ELog::EM<<"Returning value but Material def required:"
-      // 	      <<alphaV<<" "<<betaV<<ELog::endErr;
-      return 0.0;
-    }
-
-  const int aType=alphaType(aInt);
-  const int bType=betaType(bInt);
-
   const double Alow=loglinear(Alpha[aInt],Alpha[aInt+1],
 			      SAB[aInt][bInt],SAB[aInt+1][bInt],
 			      alphaV);
@@ -273,20 +279,130 @@ SQWtable::Sab(const double alphaV,const double betaV) const
 			       SAB[aInt][bInt+1],SAB[aInt+1][bInt+1],
 			       alphaV);
 
-  // ELog::EM<<Alow<<" "<<Ahigh<<" :: "<<alphaV<<" "
-  //  	  <<Alpha[aInt]<<" "<<Alpha[aInt+1]<<ELog::endCrit;
-  // ELog::EM<<Beta[bInt]<<" "<<Beta[bInt+1]<<" "<<betaV<<ELog::endCrit;
-  // ELog::EM<<SAB[aInt][bInt]<<" "<<SAB[aInt+1][bInt]<<" "
-  //  	  <<SAB[aInt][bInt+1]<<" "<<SAB[aInt+1][bInt+1]<<ELog::endCrit;
+  return loglinear(Beta[bInt],Beta[bInt+1],Alow,Ahigh,betaV);  
+}
+
+double
+SQWtable::tableSab(const double alphaV,const double betaV) const
+  /*!
+    Calculate S(alpha,beta) from the table
+    \param alphaV :: Q-values
+    \param betaV :: energy transfer
+    \return S(Q,w)
+  */
+{
+  long int aInt,bInt;
+  if (!isValidRangePt(alphaV,betaV,aInt,bInt))
+    return 0.0;
+  return interpSab(aInt,bInt,alphaV,betaV);
+}
+
+void
+SQWtable::makeGrid(const size_t NA,const size_t NB)
+  /*!
+    Sample ln(S) onto a grid uniform in ln(alpha) and
+    ln(1+beta-beta0). The grid covers the range
+    where the table is valid.
+    \param NA :: Number of alpha points
+    \param NB :: Number of beta points
+  */
+{
+  ELog::RegMethod RegA("SQWtable","makeGrid");
+
+  lnGrid.clear();
+  nGA=0;
+  nGB=0;
+  // ln(alpha) needs a positive alpha range
+  if (NA<2 || NB<2 || nAlpha<3 || nBeta<3 || Alpha[0]<=0.0)
+    return;
+
+  aLow=Alpha[0];
+  aHigh=Alpha[nAlpha-2];
+  bLow=Beta[0];
+  bHigh=Beta[nBeta-2];
+  if (aHigh<=aLow || bHigh<=bLow)
+    return;
+  
+  nGA=NA;
+  nGB=NB;
+  const double lnAStep=log(aHigh/aLow)/static_cast<double>(nGA-1);
+  const double lnBStep=log(1.0+bHigh-bLow)/static_cast<double>(nGB-1);
+  invDA=1.0/lnAStep;
+  invDB=1.0/lnBStep;
 
-  const double SAB=loglinear(Beta[bInt],Beta[bInt+1],
-			     Alow,Ahigh,betaV);  
-  //  ELog::EM<<ELog::endCrit;
+  // table cells of each grid line
+  std::vector<long int> aCell(nGA),bCell(nGB);
+  std::vector<double> aVal(nGA),bVal(nGB);
+  for(size_t i=0;i<nGA;i++)
+    {
+      aVal[i]=(i+1==nGA) ? aHigh :
+	aLow*exp(lnAStep*static_cast<double>(i));
+      const long int index=std::lower_bound(Alpha.begin(),Alpha.end(),
+					    aVal[i])-Alpha.begin();
+      aCell[i]=std::max(1L,std::min(index,static_cast<long int>(nAlpha)-2))-1;
+    }
+  for(size_t j=0;j<nGB;j++)
+    {
+      bVal[j]=(j+1==nGB) ? bHigh :
+	bLow+exp(lnBStep*static_cast<double>(j))-1.0;
+      const long int index=std::lower_bound(Beta.begin(),Beta.end(),
+					    bVal[j])-Beta.begin();
+      bCell[j]=std::max(1L,std::min(index,static_cast<long int>(nBeta)-2))-1;
+    }
 
-  return SAB;
+  lnGrid.resize(nGA*nGB);
+  for(size_t i=0;i<nGA;i++)
+    for(size_t j=0;j<nGB;j++)
+      {
+	const double S=interpSab(aCell[i],bCell[j],aVal[i],bVal[j]);
+	// zero / invalid table entries
+	lnGrid[i*nGB+j]=(S>0.0 && S<1e300) ? log(S) : zeroLnS;
+      }
+  return;
 }
 
+double
+SQWtable::gridSab(const double alphaV,const double betaV) const
+  /*!
+    Calculate S(alpha,beta) from the grid
+    \param alphaV :: Q-values
+    \param betaV :: energy transfer
+    \return S(Q,w)
+  */
+{
+  if (alphaV<=aLow || alphaV>aHigh || betaV<=bLow || betaV>bHigh)
+    return 0.0;
+
+  const double fa=log(alphaV/aLow)*invDA;
+  const double fb=log(1.0+betaV-bLow)*invDB;
+  const size_t ia=std::min(static_cast<size_t>(fa),nGA-2);
+  const size_t ib=std::min(static_cast<size_t>(fb),nGB-2);
+  const double ta=fa-static_cast<double>(ia);
+  const double tb=fb-static_cast<double>(ib);
+
+  const double* G=&lnGrid[ia*nGB+ib];
+  // S is zero over a cell with a zero corner [as loglinear] 
+  if (G[0]<=zeroLnS || G[1]<=zeroLnS || 
+      G[nGB]<=zeroLnS || G[nGB+1]<=zeroLnS)
+    return 0.0;
+  const double lnS=(1.0-ta)*((1.0-tb)*G[0]+tb*G[1])+
+    ta*((1.0-tb)*G[nGB]+tb*G[nGB+1]);
+  return exp(lnS);
+}
 
+double
+SQWtable::Sab(const double alphaV,const double betaV) const
+  /*!
+    Calculate S(q,omega) for a neutron of energy E.
+    Uses the grid if it has been made.
+    \param alphaV :: Q-values
+    \param betaV :: energy transfer
+    \return S(Q,w)
+  */
+{
+  return (lnGrid.empty()) ? 
+    tableSab(alphaV,betaV) : gridSab(alphaV,betaV);
+}
 
 } // NAMESPACE ENDF
 
@@ -0,0 +1,131 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   endfInc/ENDFfile.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ENDF_ENDFfile_h
+#define ENDF_ENDFfile_h
+
+namespace ENDF
+{
+
+/*!
+  \class ENDFfile
+  \version 1.0
+  \author S. Ansell
+  \date October 2013
+  \brief Memory mapped ENDF file with a section index
+
+  The file is mapped read only and the (MAT,MF,MT)
+  sections are indexed to their byte offset. The index is
+  kept in cacheDir/FName.cidx and is rebuilt if the file 
+  name, size or time changes. Fields are read in place from the fixed 11 column
+  format without making strings. Each object keeps its
+  own read point so separate objects can be used on
+  separate threads.
+*/
+
+class ENDFfile
+{
+ private:
+
+  /// Section in the file
+  struct secUnit
+  {
+    size_t offset;         ///< Byte offset of first line
+    size_t nLine;          ///< Number of lines
+  };
+  /// Section index type
+  typedef std::map<Triple<int>,secUnit> ITYPE;
+
+  static std::string cacheDir;   ///< Directory of cache files
+
+  std::string FName;          ///< File name
+  int fd;                     ///< File descriptor
+  size_t fileSize;            ///< File size [bytes]
+  long int fileTime;          ///< Modification time
+  const char* Data;           ///< Mapped file
+
+  std::vector<Triple<int> > Order;   ///< Sections in file order
+  ITYPE Index;                ///< Section index
+
+  size_t pos;                 ///< Offset of next line
+  size_t lineCnt;             ///< Lines read
+  const char* LPtr;           ///< Current line
+  size_t LLen;                ///< Length of current line
+  size_t fieldIndex;          ///< Next field in current line
+
+  ///\cond ABSTRACT
+  ENDFfile(const ENDFfile&);
+  ENDFfile& operator=(const ENDFfile&);
+  ///\endcond ABSTRACT
+
+  void buildIndex();
+  int readIndex(const std::string&);
+  int writeIndex(const std::string&) const;
+
+  Triple<int> lineIndex(const size_t,const size_t) const;
+  void nextLine();
+  void lineError(const std::string&) const;
+  double realField();
+  int intField();
+
+ public:
+
+  explicit ENDFfile(const std::string&);
+  ~ENDFfile();
+
+  /// Access file name
+  const std::string& getFileName() const { return FName; }
+  /// Access file size
+  size_t getSize() const { return fileSize; }
+  /// Access modification time
+  long int getTime() const { return fileTime; }
+  /// Access lines read
+  size_t getLineCnt() const { return lineCnt; }
+
+  int firstMat() const;
+  int hasSection(const int,const int,const int) const;
+  void findSection(const int,const int,const int);
+
+  void headRead(double&,double&,int&,int&,int&,int&);
+  void listRead(double&,double&,int&,int&,int&,int&,
+		std::vector<double>&);
+  void table1Read(double&,double&,int&,int&,int&,int&,
+		  std::vector<int>&,std::vector<int>&,
+		  std::vector<double>&,std::vector<double>&);
+  void table2Read(double&,double&,int&,int&,int&,int&,
+		  std::vector<int>&,std::vector<int>&);
+
+  int checkCacheHead(std::istream&,const char*) const;
+  void writeCacheHead(std::ostream&,const char*) const;
+
+  static void setCacheDir(const std::string&);
+  /// Access cache directory
+  static const std::string& getCacheDir() { return cacheDir; }
+  static std::string cacheName(const std::string&,const std::string&);
+  static int closeCache(const std::ostream&,const std::string&);
+
+  static double readReal(const char*,const char*,int&);
+  static int readInt(const char*,const char*,int&);
+};
+
+}  // NAMESPACE ENDF
+
+#endif
@@ -24,6 +24,7 @@
 
 namespace ENDF
 {
+  class ENDFfile;
 
   /*!
     \class ENDFmaterial
@@ -33,7 +34,9 @@ namespace ENDF
     \date January 2010
     
     This can be extended so that more sophisticated material
-    components can be used.
+    components can be used. The parsed tables are kept in a
+    binary cache (FName.t<tmpIndex>.sqw) in the ENDFfile 
+    cache directory.
     \todo This class needs to have a base class.
   */
   
@@ -59,11 +62,15 @@ class ENDFmaterial
   std::vector<double> Teff;      ///< Effective temperatures for NP-atoms
   std::vector<double> B;         ///< B points
   
-  void procZaid(std::string&);
-  void procB(std::istream&);
-  void procBeta(std::istream&);
-  void procAlpha(std::istream&);
-  void procTeff(std::istream&);
+  void procZaid(ENDFfile&);
+  void procB(ENDFfile&);
+  void procBeta(ENDFfile&);
+  void procAlpha(ENDFfile&);
+  void procTeff(ENDFfile&);
+  int readCache(const std::string&,const ENDFfile&);
+  int writeCache(const std::string&,const ENDFfile&) const;
+  double atomSab(const size_t,const double,const double) const;
+  double sigmaE(const double) const;
   void populateSETable();
 
  public:
@@ -49,6 +49,8 @@ class SEtable
 
   /// Get energy
   const std::vector<double>& getE() const { return E; }
+  /// Get total cross section
+  const std::vector<double>& getSTotal() const { return sTot; }
 
   /// Clear arrays
   void clear() { E.clear(); sTot.clear(); nE=0; }
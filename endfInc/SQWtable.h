@@ -30,6 +30,10 @@ namespace ENDF
     \author S. Ansell
     \date May 2010
     \brief Hold Data for a principle atoms in a scattering law
+
+    After makeGrid, S(alpha,beta) is pre-sampled on a grid
+    uniform in ln(alpha) and ln(1+beta-beta0) so Sab is
+    direct index arithmetic rather than two binary searches.
   */
 struct SQWtable
 {
@@ -46,10 +50,24 @@ struct SQWtable
   std::vector<int> betaInterp;           ///< Beta intep type
   std::vector<int> betaIBoundary;        ///< Beta inter Cut point 
 
+  size_t nGA;                    ///< Grid points in ln(alpha)
+  size_t nGB;                    ///< Grid points in ln(1+beta-beta0)
+  double aLow;                   ///< Low alpha of grid
+  double aHigh;                  ///< High alpha of grid
+  double bLow;                   ///< Low beta of grid
+  double bHigh;                  ///< High beta of grid
+  double invDA;                  ///< 1/step in ln(alpha)
+  double invDB;                  ///< 1/step in ln(1+beta-beta0)
+  std::vector<double> lnGrid;    ///< ln(S) [nGA x nGB]
+  static const double zeroLnS;   ///< ln(S) marker of a zero entry
 
   int alphaType(const long int) const;
   int betaType(const long int) const;
   int isValidRangePt(const double&,const double&,long int&,long int&) const;
+  double interpSab(const long int,const long int,
+		   const double,const double) const;
+  double tableSab(const double,const double) const;
+  double gridSab(const double,const double) const;
   
  public:
   
@@ -65,6 +83,7 @@ struct SQWtable
 		 const std::vector<double>&) const;
   void setData(const size_t,const std::vector<double>&,
 	       const std::vector<double>&);
+  void makeGrid(const size_t,const size_t);
 
   double Sab(const double,const double) const;
   
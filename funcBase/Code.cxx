@@ -138,6 +138,26 @@ Code::addFunctionOpcode(const int B)
   return;
 }
 
+void
+Code::setCompiled(const std::vector<int>& BC,
+		  const std::vector<double>& IM,
+		  const size_t SSize)
+  /*!
+    Set the code from an already compiled unit
+    (e.g. from a binary snapshot)
+    \param BC :: Byte code
+    \param IM :: Immediate values
+    \param SSize :: Stack size required for Eval
+  */
+{
+  clear();
+  ByteCode=BC;
+  Immed=IM;
+  Stack.resize((SSize) ? SSize : 1);
+  valid=1;
+  return;
+}
+
 size_t
 Code::incStackPtr()
   /*!
@@ -457,6 +477,39 @@ Code::Eval(varList* Vars)
   return Stack[SP];
 }
 
+void
+Code::getVariables(std::vector<int>& VIndex) const
+  /*!
+    Get the variable indexes that the code reads. The target
+    of an assignment is not a read and is skipped.
+    \param VIndex :: Variable indexes [appended to]
+  */
+{
+  for(size_t IP=0;IP<ByteCode.size();IP++)
+    {
+      if (ByteCode[IP]==Opcodes::cEqual)
+	IP++;
+      else if (ByteCode[IP]>=Opcodes::varBegin)
+	VIndex.push_back(ByteCode[IP]-Opcodes::varBegin);
+    }
+  return;
+}
+
+int
+Code::hasAssignment() const
+  /*!
+    Determine if the code writes to a variable [x=y]
+    \return 1 if an assignment is present
+  */
+{
+  for(size_t IP=0;IP<ByteCode.size();IP++)
+    {
+      if (ByteCode[IP]==Opcodes::cEqual)
+	return 1;
+    }
+  return 0;
+}
+
 void
 Code::writeCompact(std::ostream& OX) const
   /*!
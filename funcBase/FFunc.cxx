@@ -46,7 +46,8 @@
 //-----------------------------------------
 
 FFunc::FFunc(varList* VA,const int I,const Code& CObj) :
-  FItem(VA,I),BaseUnit(CObj)
+  FItem(VA,I),BaseUnit(CObj),memoFlag(!CObj.hasAssignment()),
+  cacheFlag(0),cacheValue(0.0)
   /*!
     Standard constructor
     \param VA :: VarList pointer
@@ -56,7 +57,8 @@ FFunc::FFunc(varList* VA,const int I,const Code& CObj) :
 {}
 
 FFunc::FFunc(const FFunc& A) :
-  FItem(A),BaseUnit(A.BaseUnit)
+  FItem(A),BaseUnit(A.BaseUnit),memoFlag(A.memoFlag),
+  cacheFlag(0),cacheValue(0.0)
   /*!
     Standard copy constructor
     \param A :: FFunc object to copy
@@ -75,6 +77,8 @@ FFunc::operator=(const FFunc& A)
     {
       FItem::operator=(A);
       BaseUnit=A.BaseUnit;
+      memoFlag=A.memoFlag;
+      cacheFlag=0;
     }
   return *this;
 }
@@ -104,9 +108,52 @@ FFunc::setValue(const Code& AC)
   */
 {
   BaseUnit=AC;
+  memoFlag=!AC.hasAssignment();
+  cacheFlag=0;
+  if (VListPtr)
+    VListPtr->addDependency(getIndex(),AC);
   return;
 }
 
+double
+FFunc::evalCode() const
+  /*!
+    Evaluate the code. The result is memoised until
+    the varList invalidates it via clearCache.
+    Functions containing an assignment are always
+    re-run to keep the side effect. The memo is shared
+    by the threads that read the FuncDataBase.
+    \return value of the code
+  */
+{
+  int validFlag;
+  double Value;
+#ifdef _OPENMP
+#pragma omp critical (FFuncCache)
+#endif
+  {
+    validFlag=cacheFlag;
+    Value=cacheValue;
+  }
+  if (validFlag)
+    return Value;
+
+  // Eval can evaluate other functions : not in the critical section
+  Code BC(BaseUnit);
+  const double Out=BC.Eval(VListPtr);
+  if (memoFlag)
+    {
+#ifdef _OPENMP
+#pragma omp critical (FFuncCache)
+#endif
+      {
+	cacheValue=Out;
+	cacheFlag=1;
+      }
+    }
+  return Out;
+}
+
 void
 FFunc::getValue(Geometry::Vec3D&) const
   /*!
@@ -128,8 +175,7 @@ FFunc::getValue(double& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<double>(BC.Eval(FItem::VListPtr));
+  V=evalCode();
   const_cast<int&>(active)++;
   return;
 }
@@ -142,8 +188,7 @@ FFunc::getValue(int& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<int>(BC.Eval(VListPtr));
+  V=static_cast<int>(evalCode());
   const_cast<int&>(active)++;
   return;
 }
@@ -157,8 +202,7 @@ FFunc::getValue(size_t& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<size_t>(BC.Eval(VListPtr));
+  V=static_cast<size_t>(evalCode());
   const_cast<int&>(active)++;
   return;
 }
@@ -171,8 +215,7 @@ FFunc::getValue(std::string& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  double Val=BC.Eval(VListPtr);
+  const double Val=evalCode();
   std::stringstream cx;
   cx<<Val;
   V=cx.str();
@@ -50,10 +50,12 @@
 #include "XMLobject.h"
 #include "XMLgroup.h"
 #include "XMLcollect.h"
+#include "XMLstream.h"
 #include "Code.h"
 #include "FItem.h"
 #include "funcList.h"
 #include "varList.h"
+#include "varBinary.h"
 #include "MD5hash.h"
 #include "FuncDataBase.h"
 
@@ -137,6 +139,40 @@ FuncDataBase::EvalVar(const std::string& Key) const
   return Out;
 }
 
+int
+FuncDataBase::getHandle(const std::string& Key) const
+  /*!
+    Get the handle (variable index) of a variable so that
+    repeated reads avoid the name lookup. The handle stays
+    valid if the variable is replaced by addVariable.
+    \param Key :: Variable name
+    \return handle [-1 if variable does not exist]
+  */
+{
+  const FItem* FI=findItem(Key);
+  return (FI) ? FI->getIndex() : -1;
+}
+
+template<typename T>
+T
+FuncDataBase::EvalHandle(const int Handle) const
+  /*!
+    Finds the value of a variable item from its handle
+    \param Handle :: variable handle from getHandle
+    \return Value of variable 
+    \throw InContainterError if no variable exists
+  */
+{
+  const FItem* FI=VList.findVar(Handle);
+  if (!FI)
+    throw ColErr::InContainerError<int>
+      (Handle,"FuncDataBase::EvalHandle variable not found");
+
+  T Out;
+  FI->getValue(Out);
+  return Out;
+}
+
 template<typename T>
 T
 FuncDataBase::EvalDefVar(const std::string& Key,const T& def) const
@@ -841,6 +877,7 @@ std::string
 FuncDataBase::variableHash() const
   /*!
     Calculates the hash value for the variables
+    [MD5 : use contentHash to test for a change]
     \return Hash string
   */
 {
@@ -850,55 +887,187 @@ FuncDataBase::variableHash() const
   return sum.processMessage(cx.str());
 }
 
+void
+FuncDataBase::writeBinary(const std::string& FName) const
+  /*!
+    Write the variables as a binary snapshot
+    \param FName :: File name
+  */
+{
+  ELog::RegMethod RegA("FuncDataBase","writeBinary");
+  VarBinary::writeSnapshot(FName,VList);
+  return;
+}
+
+size_t
+FuncDataBase::readBinary(const std::string& FName)
+  /*!
+    Add/replace variables from a binary snapshot
+    \param FName :: File name
+    \return content hash recorded in the snapshot
+  */
+{
+  ELog::RegMethod RegA("FuncDataBase","readBinary");
+  return VarBinary::readSnapshot(FName,VList);
+}
+
+/*!
+  \class varXMLhandler
+  \brief Sets variables from XMLstream call backs
+  \author S. Ansell
+  \date October 2013
+  \version 1.0
+
+  Handles <variable name="" type="">value</variable> and 
+  the group form with a <value> sub-element.
+*/
+
+class varXMLhandler : public XML::XMLhandler
+{
+ private:
+
+  FuncDataBase& FDB;          ///< Database to set
+  int depth;                  ///< Depth in variable [0 : not in]
+  int valueFlag;              ///< In/found <value> [1:in 2:found]
+  std::string Name;           ///< Variable name
+  std::string Type;           ///< Variable type
+  std::string Value;          ///< Value text
+
+  ///\cond ABSTRACT
+  varXMLhandler(const varXMLhandler&);
+  varXMLhandler& operator=(const varXMLhandler&);
+  ///\endcond ABSTRACT
+
+  void setVariable();
+
+ public:
+
+  /// Constructor
+  explicit varXMLhandler(FuncDataBase& F) :
+    FDB(F),depth(0),valueFlag(0) {}
+
+  virtual void startElement(const XML::strView&,const ATYPE&);
+  virtual void endElement(const XML::strView&);
+  virtual void characters(const XML::strView&);
+};
+
+void
+varXMLhandler::startElement(const XML::strView& Key,const ATYPE& Attr)
+  /*!
+    Start a variable [or the value within it]
+    \param Key :: Element name
+    \param Attr :: Attributes 
+  */
+{
+  if (depth)
+    {
+      depth++;
+      if (depth==2 && Key=="value")
+	{
+	  valueFlag=1;
+	  Value.clear();
+	}
+      return;
+    }
+  if (Key!="variable") return;
+
+  depth=1;
+  valueFlag=0;
+  Name.clear();
+  Type="double";
+  Value.clear();
+  for(size_t i=0;i<Attr.size();i++)
+    {
+      if (Attr[i].first=="name")
+	Name=XML::XMLstream::procEntity(Attr[i].second);
+      else if (Attr[i].first=="type")
+	Type=XML::XMLstream::procEntity(Attr[i].second);
+    }
+  return;
+}
+
+void
+varXMLhandler::characters(const XML::strView& Text)
+  /*!
+    Collect the value text
+    \param Text :: Raw text
+  */
+{
+  if ((depth==1 && !valueFlag) || (depth==2 && valueFlag==1))
+    Value+=XML::XMLstream::procEntity(Text);
+  return;
+}
+
+void
+varXMLhandler::endElement(const XML::strView&)
+  /*!
+    End of an element : set the variable at the end
+    of <variable>
+  */
+{
+  if (!depth) return;
+  if (depth==2 && valueFlag==1)
+    valueFlag=2;
+  depth--;
+  if (!depth)
+    setVariable();
+  return;
+}
+
+void
+varXMLhandler::setVariable()
+  /*!
+    Add/set the current variable
+  */
+{
+  ELog::RegMethod RegA("varXMLhandler","setVariable");
+
+  if (Name.empty())
+    throw ColErr::EmptyValue<std::string>("variable name");
+  if (!FDB.hasVariable(Name))
+    ELog::EM<<"Adding variable "<<Name<<ELog::endWarn;
+
+  // Only vector type 
+  if (Type=="Geometry::Vec3D")
+    {
+      Geometry::Vec3D VUnit;
+      if (!StrFunc::convert(Value,VUnit))
+	throw ColErr::InvalidLine(Name,Value,0);
+      FDB.addVariable(Name,VUnit);
+    }
+  else
+    {
+      double V;
+      if (!StrFunc::convert(Value,V))
+	throw ColErr::InvalidLine(Name,Value,0);
+      FDB.addVariable(Name,V);
+    }
+  return;
+}
+
 void
 FuncDataBase::processXML(const std::string& FName) 
   /*!
-    Process an XML file to set/add variables
+    Process an XML file to set/add variables.
+    The file is streamed [XMLstream] so no tree is built.
     \param FName :: filename 
   */
 {
   ELog::RegMethod RegA("FuncDataBase","processXML");
-  XML::XMLcollect CO;
-  if (FName.empty() || CO.loadXML(FName))
+  if (FName.empty())
     {
-      ELog::EM<<"Failed to load  == "<<CO.loadXML(FName)<<ELog::endErr;
       ELog::EM<<"Failed to load  == "<<FName<<ELog::endErr;
-
       return;
     }
-  // Parse for variables:
-  XML::XMLobject* AR=CO.findObj("variable");
-  XML::XMLgroup* AG;
-  double V;
-  Geometry::Vec3D VUnit;
-  std::string VStr;
-  while(AR)
+  try
     {
-      const std::string Name=AR->getItem<std::string>("name");
-      const std::string Type=AR->getDefItem<std::string>("type","double");
-
-      if (!hasVariable(Name))
-	ELog::EM<<"Adding variable "<<Name<<ELog::endWarn;
-
-      // Only vector type 
-      if (Type=="Geometry::Vec3D") 
-	{
-	  if ( (AG=dynamic_cast<XML::XMLgroup*>(AR)) )
-	    VUnit=AG->getItem<Geometry::Vec3D>("value");
-	  else
-	    VUnit=AR->getItem<Geometry::Vec3D>();
-	  addVariable(Name,VUnit);
-	}
-      else
-        {
-	  if ( (AG=dynamic_cast<XML::XMLgroup*>(AR)) )
-	    V=AG->getItem<double>("value");
-	  else
-	    V=AR->getItem<double>();
-	  addVariable(Name,V);
-	}
-      CO.deleteObj(AR);      
-      AR=CO.findObj("variable");
+      XML::XMLstream XS(FName);
+      varXMLhandler VH(*this);
+      XS.parse(VH);
+    }
+  catch (ColErr::FileError&)
+    {
+      ELog::EM<<"Failed to load  == "<<FName<<ELog::endErr;
     }
   return;
 }
@@ -948,6 +1117,12 @@ template int FuncDataBase::EvalVar(const std::string&) const;
 template size_t FuncDataBase::EvalVar(const std::string&) const;
 template std::string FuncDataBase::EvalVar(const std::string&) const;
 
+template double FuncDataBase::EvalHandle(const int) const;
+template Geometry::Vec3D FuncDataBase::EvalHandle(const int) const;
+template int FuncDataBase::EvalHandle(const int) const;
+template size_t FuncDataBase::EvalHandle(const int) const;
+template std::string FuncDataBase::EvalHandle(const int) const;
+
 template double FuncDataBase::EvalDefVar(const std::string&,
 					 const double&) const;
 template int FuncDataBase::EvalDefVar(const std::string&,const int&) const;
@@ -0,0 +1,546 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   funcBase/varBinary.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Code.h"
+#include "FItem.h"
+#include "varList.h"
+#include "varBinary.h"
+
+namespace VarBinary
+{
+
+/// Magic string at the start of a snapshot
+static const char magic[]="CLVBIN01";
+/// Length of the magic string
+static const size_t magicLen(8);
+
+/*!
+  \struct snapItem
+  \brief Unpacked snapshot entry
+*/
+struct snapItem
+{
+  int index;                   ///< Index in the written list
+  char type;                   ///< Type flag [d/i/s/v/t/c]
+  std::string name;            ///< Variable name
+  double DValue;               ///< double value
+  int IValue;                  ///< int value
+  size_t SValue;               ///< size_t value / stack size
+  Geometry::Vec3D VValue;      ///< Vec3D value
+  std::string StrValue;        ///< string value
+  std::vector<int> BC;         ///< Compiled bytecode
+  std::vector<double> IM;      ///< Immediate values
+
+  /// Sort on written index
+  bool operator<(const snapItem& A) const { return index<A.index; }
+};
+
+/*!
+  \class mapFile
+  \brief Read only memory map of a file
+*/
+class mapFile
+{
+ private:
+
+  int fd;                  ///< File descriptor
+  size_t len;              ///< Length of mapped region
+  const char* base;        ///< Start of map
+
+  ///\cond ABSTRACT
+  mapFile(const mapFile&);
+  mapFile& operator=(const mapFile&);
+  ///\endcond ABSTRACT
+
+ public:
+
+  /// Constructor : map whole file [base==0 on failure]
+  explicit mapFile(const std::string& FName) :
+    fd(open(FName.c_str(),O_RDONLY)),len(0),base(0)
+    {
+      struct stat SBuf;
+      if (fd<0 || fstat(fd,&SBuf) || SBuf.st_size<=0) return;
+      len=static_cast<size_t>(SBuf.st_size);
+      void* MPtr=mmap(0,len,PROT_READ,MAP_PRIVATE,fd,0);
+      if (MPtr!=MAP_FAILED)
+	base=static_cast<const char*>(MPtr);
+    }
+  /// Destructor : release map and file
+  ~mapFile()
+    {
+      if (base) munmap(const_cast<char*>(base),len);
+      if (fd>=0) close(fd);
+    }
+
+  const char* begin() const { return base; }       ///< Start
+  const char* end() const { return base+len; }     ///< End
+};
+
+/*!
+  \class snapReader
+  \brief Bounds checked reader over a memory block
+*/
+class snapReader
+{
+ private:
+
+  const char* Ptr;      ///< Current point
+  const char* EPtr;     ///< End point
+
+  /// Check that N bytes remain
+  void check(const size_t N) const
+    {
+      if (static_cast<size_t>(EPtr-Ptr)<N)
+	throw ColErr::IndexError<size_t>
+	  (N,static_cast<size_t>(EPtr-Ptr),"snapReader::check");
+    }
+
+ public:
+
+  /// Constructor
+  snapReader(const char* A,const char* B) : Ptr(A),EPtr(B) {}
+
+  /// Get a plain value
+  template<typename T>
+  T get()
+    {
+      check(sizeof(T));
+      T Out;
+      memcpy(&Out,Ptr,sizeof(T));
+      Ptr+=sizeof(T);
+      return Out;
+    }
+
+  /// Get a length prefixed string
+  std::string getString()
+    {
+      const size_t N=get<size_t>();
+      check(N);
+      std::string Out(Ptr,N);
+      Ptr+=N;
+      return Out;
+    }
+
+  /// Get a length prefixed vector
+  template<typename T>
+  void getVector(std::vector<T>& Out)
+    {
+      const size_t N=get<size_t>();
+      check(N*sizeof(T));
+      Out.resize(N);
+      if (N)
+	memcpy(&Out[0],Ptr,N*sizeof(T));
+      Ptr+=N*sizeof(T);
+    }
+
+  /// Test for a matching magic string
+  int checkMagic()
+    {
+      if (static_cast<size_t>(EPtr-Ptr)<magicLen ||
+	  memcmp(Ptr,magic,magicLen))
+	return 0;
+      Ptr+=magicLen;
+      return 1;
+    }
+};
+
+template<typename T>
+static void
+put(std::string& Out,const T& V)
+  /*!
+    Append the bytes of a plain value
+    \param Out :: Buffer
+    \param V :: Value
+  */
+{
+  Out.append(reinterpret_cast<const char*>(&V),sizeof(T));
+  return;
+}
+
+static void
+putString(std::string& Out,const std::string& V)
+  /*!
+    Append a length prefixed string
+    \param Out :: Buffer
+    \param V :: String
+  */
+{
+  put(Out,V.size());
+  Out.append(V);
+  return;
+}
+
+template<typename T>
+static void
+putVector(std::string& Out,const std::vector<T>& V)
+  /*!
+    Append a length prefixed vector
+    \param Out :: Buffer
+    \param V :: vector
+  */
+{
+  put(Out,V.size());
+  if (!V.empty())
+    Out.append(reinterpret_cast<const char*>(&V[0]),V.size()*sizeof(T));
+  return;
+}
+
+template<typename T>
+static const T&
+rawValue(const FItem& FI)
+  /*!
+    Get the value of a fixed variable without marking it read
+    \param FI :: Variable item
+    \return value
+  */
+{
+  const FValue<T>* FPtr=dynamic_cast<const FValue<T>*>(&FI);
+  if (!FPtr)
+    throw ColErr::CastError<void>(0,"FItem to FValue");
+  return FPtr->getRawValue();
+}
+
+static void
+encodeItem(std::string& Out,const std::string& Name,const FItem& FI,
+	   const std::vector<std::string>* VNamePtr =0)
+  /*!
+    Append the binary form of a variable : type name value
+    \param Out :: Buffer
+    \param Name :: Variable name
+    \param FI :: Variable item
+    \param VNamePtr :: Index : name of the variables. If given the
+      variables in Code are written by name [not index]
+  */
+{
+  ELog::RegMethod RegA("VarBinary","encodeItem");
+
+  // Values are read with getRawValue so the active (read)
+  // count used for the variable report is not changed
+  const std::string TKey=FI.typeKey();
+  if (TKey=="double")
+    {
+      Out+='d';
+      putString(Out,Name);
+      put(Out,rawValue<double>(FI));
+    }
+  else if (TKey=="int")
+    {
+      Out+='i';
+      putString(Out,Name);
+      put(Out,rawValue<int>(FI));
+    }
+  else if (TKey=="size_t")
+    {
+      Out+='s';
+      putString(Out,Name);
+      put(Out,rawValue<size_t>(FI));
+    }
+  else if (TKey=="Geometry::Vec3D")
+    {
+      const Geometry::Vec3D& V=rawValue<Geometry::Vec3D>(FI);
+      Out+='v';
+      putString(Out,Name);
+      for(int i=0;i<3;i++)
+	put(Out,V[i]);
+    }
+  else if (TKey=="std::string")
+    {
+      Out+='t';
+      putString(Out,Name);
+      putString(Out,rawValue<std::string>(FI));
+    }
+  else if (TKey=="Code")
+    {
+      const FFunc* FPtr=dynamic_cast<const FFunc*>(&FI);
+      if (!FPtr)
+	throw ColErr::CastError<void>(0,"FItem to FFunc");
+      const Code& CObj=FPtr->getCode();
+      Out+='c';
+      putString(Out,Name);
+      put(Out,CObj.getStackSize());
+      if (!VNamePtr)
+	putVector(Out,CObj.getBC());
+      else
+	{
+	  const std::vector<int>& BC=CObj.getBC();
+	  put(Out,BC.size());
+	  for(size_t i=0;i<BC.size();i++)
+	    {
+	      put(Out,(BC[i]>=Opcodes::varBegin) ? 
+		  static_cast<int>(Opcodes::varBegin) : BC[i]);
+	      if (BC[i]>=Opcodes::varBegin)
+		{
+		  const size_t VI=
+		    static_cast<size_t>(BC[i]-Opcodes::varBegin);
+		  if (VI>=VNamePtr->size())
+		    throw ColErr::IndexError<size_t>
+		      (VI,VNamePtr->size(),"Code variable in "+Name);
+		  putString(Out,(*VNamePtr)[VI]);
+		}
+	    }
+	}
+      putVector(Out,CObj.getImmed());
+    }
+  else
+    throw ColErr::InContainerError<std::string>(TKey,"Variable type");
+  return;
+}
+
+size_t
+hashString(const std::string& Buffer)
+  /*!
+    FNV-1a hash of a byte block
+    \param Buffer :: Bytes to hash
+    \return hash value
+  */
+{
+  unsigned long long H(14695981039346656037ULL);
+  for(size_t i=0;i<Buffer.size();i++)
+    {
+      H^=static_cast<unsigned char>(Buffer[i]);
+      H*=1099511628211ULL;
+    }
+  return static_cast<size_t>(H);
+}
+
+size_t
+itemHash(const std::string& Name,const FItem& FI,
+	 const std::vector<std::string>& VName)
+  /*!
+    Hash of a single variable [name/type/value]. This is the
+    unit of the incremental content hash of a varList.
+    The variables read by Code are hashed by name so the
+    hash does not depend on the order of the variables.
+    \param Name :: Variable name
+    \param FI :: Variable item
+    \param VName :: Index : name of the variables
+    \return hash value
+  */
+{
+  std::string Buffer;
+  encodeItem(Buffer,Name,FI,&VName);
+  return hashString(Buffer);
+}
+
+void
+writeSnapshot(const std::string& FName,const varList& VL)
+  /*!
+    Write a binary snapshot of the varList
+    \param FName :: File name
+    \param VL :: varList to write
+  */
+{
+  ELog::RegMethod RegA("VarBinary","writeSnapshot");
+
+  std::string Buffer;
+  Buffer.append(magic,magicLen);
+  put(Buffer,VL.contentHash());
+  size_t nItem(0);
+  varList::varStore::const_iterator mc;
+  for(mc=VL.begin();mc!=VL.end();mc++)
+    nItem++;
+  put(Buffer,nItem);
+  for(mc=VL.begin();mc!=VL.end();mc++)
+    {
+      put(Buffer,mc->second->getIndex());
+      encodeItem(Buffer,mc->first,*mc->second);
+    }
+
+  std::ofstream OX(FName.c_str(),std::ios::out | std::ios::binary);
+  if (!OX.good())
+    throw ColErr::FileError(0,FName,"VarBinary::writeSnapshot");
+  OX.write(Buffer.data(),static_cast<std::streamsize>(Buffer.size()));
+  return;
+}
+
+static void
+readItem(snapReader& SR,snapItem& Item)
+  /*!
+    Read the next item from the snapshot
+    \param SR :: Reader
+    \param Item :: Item to fill
+  */
+{
+  Item.index=SR.get<int>();
+  Item.type=SR.get<char>();
+  Item.name=SR.getString();
+  switch (Item.type)
+    {
+    case 'd':
+      Item.DValue=SR.get<double>();
+      return;
+    case 'i':
+      Item.IValue=SR.get<int>();
+      return;
+    case 's':
+      Item.SValue=SR.get<size_t>();
+      return;
+    case 'v':
+      {
+	const double X=SR.get<double>();
+	const double Y=SR.get<double>();
+	const double Z=SR.get<double>();
+	Item.VValue=Geometry::Vec3D(X,Y,Z);
+	return;
+      }
+    case 't':
+      Item.StrValue=SR.getString();
+      return;
+    case 'c':
+      Item.SValue=SR.get<size_t>();
+      SR.getVector(Item.BC);
+      SR.getVector(Item.IM);
+      return;
+    }
+  throw ColErr::InContainerError<int>
+    (static_cast<int>(Item.type),"Snapshot type");
+}
+
+size_t
+readSnapshot(const std::string& FName,varList& VL)
+  /*!
+    Read a binary snapshot and add/replace the variables.
+    Items are created in their written index order so
+    loading into an empty list reproduces the indexes
+    (and hence the content hash). Bytecode variable
+    references are remapped to the new indexes.
+    \param FName :: File name
+    \param VL :: varList to add to
+    \return content hash stored in the file
+  */
+{
+  ELog::RegMethod RegA("VarBinary","readSnapshot");
+
+  const mapFile MF(FName);
+  if (!MF.begin())
+    throw ColErr::FileError(0,FName,"VarBinary::readSnapshot");
+  snapReader SR(MF.begin(),MF.end());
+  if (!SR.checkMagic())
+    throw ColErr::FileError(1,FName,"VarBinary::readSnapshot magic");
+
+  const size_t hashValue=SR.get<size_t>();
+  const size_t nItem=SR.get<size_t>();
+  std::vector<snapItem> Items(nItem);
+  for(size_t i=0;i<nItem;i++)
+    readItem(SR,Items[i]);
+  std::sort(Items.begin(),Items.end());
+
+  // Reserve names and map written index to list index
+  std::map<int,int> IMap;
+  std::vector<snapItem>::const_iterator vc;
+  for(vc=Items.begin();vc!=Items.end();vc++)
+    {
+      const FItem* FPtr=VL.findVar(vc->name);
+      if (!FPtr)
+	{
+	  VL.addVar<double>(vc->name,0.0);
+	  FPtr=VL.findVar(vc->name);
+	}
+      IMap[vc->index]=FPtr->getIndex();
+    }
+
+  for(vc=Items.begin();vc!=Items.end();vc++)
+    {
+      switch (vc->type)
+	{
+	case 'd':
+	  VL.addVar<double>(vc->name,vc->DValue);
+	  break;
+	case 'i':
+	  VL.addVar<int>(vc->name,vc->IValue);
+	  break;
+	case 's':
+	  VL.addVar<size_t>(vc->name,vc->SValue);
+	  break;
+	case 'v':
+	  VL.addVar<Geometry::Vec3D>(vc->name,vc->VValue);
+	  break;
+	case 't':
+	  VL.addVar<std::string>(vc->name,vc->StrValue);
+	  break;
+	case 'c':
+	  {
+	    std::vector<int> BC(vc->BC);
+	    for(size_t i=0;i<BC.size();i++)
+	      if (BC[i]>=Opcodes::varBegin)
+		{
+		  std::map<int,int>::const_iterator mc=
+		    IMap.find(BC[i]-Opcodes::varBegin);
+		  if (mc==IMap.end())
+		    throw ColErr::InContainerError<int>
+		      (BC[i]-Opcodes::varBegin,"Code variable in "+vc->name);
+		  BC[i]=mc->second+Opcodes::varBegin;
+		}
+	    Code CObj;
+	    CObj.setCompiled(BC,vc->IM,vc->SValue);
+	    VL.addVar<Code>(vc->name,CObj);
+	    break;
+	  }
+	}
+    }
+  return hashValue;
+}
+
+size_t
+snapshotHash(const std::string& FName)
+  /*!
+    Read only the content hash of a snapshot.
+    Used to check if a parameter set has changed
+    without loading it.
+    \param FName :: File name
+    \return stored hash [0 if not a readable snapshot]
+  */
+{
+  std::ifstream IX(FName.c_str(),std::ios::in | std::ios::binary);
+  char Head[magicLen+sizeof(size_t)];
+  if (!IX.read(Head,sizeof(Head)) || memcmp(Head,magic,magicLen))
+    return 0;
+  size_t Out;
+  memcpy(&Out,Head+magicLen,sizeof(size_t));
+  return Out;
+}
+
+} // NAMESPACE VarBinary
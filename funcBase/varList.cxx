@@ -28,6 +28,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <set>
 #include <algorithm>
 #include <functional>
 
@@ -44,16 +45,19 @@
 #include "Code.h"
 #include "FItem.h"
 #include "varList.h"
+#include "varBinary.h"
 
 varList::varList() :
-  varNum(0)
+  varNum(0),hashSum(0)
   /*!
     Default constructor
   */
 {}
 
 varList::varList(const varList& A) :
-  varNum(A.varNum)
+  varNum(A.varNum),indexName(A.indexName),depMap(A.depMap),
+  hashSum(A.hashSum),
+  hashItem(A.hashItem),hashDirty(A.hashDirty)
   /*!
     Standard Copy constructor.
     Makes a memory copy of the FItem*
@@ -64,6 +68,7 @@ varList::varList(const varList& A) :
   for(vc=A.varName.begin();vc!=A.varName.end();vc++)
     {
       FItem* Ptr=vc->second->clone();
+      Ptr->setVList(this);
       varName.insert(std::pair<std::string,FItem*>(vc->first,Ptr));
       varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
     }
@@ -83,10 +88,16 @@ varList::operator=(const varList& A)
     {
       varNum=A.varNum;
       deleteMem();
+      indexName=A.indexName;
+      depMap=A.depMap;
+      hashSum=A.hashSum;
+      hashItem=A.hashItem;
+      hashDirty=A.hashDirty;
       std::map<std::string,FItem*>::const_iterator vc;
       for(vc=A.varName.begin();vc!=A.varName.end();vc++)
         {
 	  FItem* Ptr=vc->second->clone();
+	  Ptr->setVList(this);
 	  varName.insert(std::pair<std::string,FItem*>(vc->first,Ptr));
 	  varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
 	}
@@ -114,6 +125,11 @@ varList::deleteMem()
     delete vc->second;
   varItem.erase(varItem.begin(),varItem.end());
   varName.erase(varName.begin(),varName.end());
+  indexName.clear();
+  depMap.clear();
+  hashSum=0;
+  hashItem.clear();
+  hashDirty.clear();
   return;
 }
 
@@ -230,7 +246,10 @@ varList::setValue(const int Key,const T& Value)
 {
   FItem* FPtr=findVar(Key);
   if (FPtr)
-    FPtr->setValue(Value);
+    {
+      FPtr->setValue(Value);
+      invalidate(Key);
+    }
   return;
 }
 
@@ -260,11 +279,14 @@ varList::addVar(const std::string& Name,const T& Value)
       varName.erase(vc);
       varItem.erase(ac);
       Ptr=createFType<T>(I,Value);
+      invalidate(I);
     }
   else
   // Need to make a completely new item
     {
       Ptr=createFType(varNum,Value);
+      hashDirty.push_back(varNum);
+      indexName.push_back(Name);
       varNum++;
     }
   // Now insert into master lists
@@ -290,6 +312,7 @@ varList::setVar(const std::string& Name,const T& Value)
   try
     {
       vc->second->setValue(Value);
+      invalidate(vc->second->getIndex());
     }
   catch (ColErr::ExBase&)
     {
@@ -326,9 +349,102 @@ varList::createFType<Code>(const int I,const Code& V)
     \return Fitem ptr
   */
 { 
+  addDependency(I,V);
   return new FFunc(this,I,V); 
 }
 
+void
+varList::addDependency(const int FIndex,const Code& CObj)
+  /*!
+    Register the variables read by a function so that
+    its memoised value can be dropped when they change
+    \param FIndex :: Index of the function variable
+    \param CObj :: Code of the function
+  */
+{
+  std::vector<int> VIndex;
+  CObj.getVariables(VIndex);
+  std::vector<int>::const_iterator vc;
+  for(vc=VIndex.begin();vc!=VIndex.end();vc++)
+    {
+      std::vector<int>& DVec=depMap[*vc];
+      if (std::find(DVec.begin(),DVec.end(),FIndex)==DVec.end())
+	DVec.push_back(FIndex);
+    }
+  return;
+}
+
+void
+varList::invalidate(const int Key) const
+  /*!
+    Clear the memoised value of all the functions that
+    depend (directly or through other functions) on a variable.
+    The variable is also flagged for the content hash.
+    \param Key :: Index of variable that has changed
+  */
+{
+  hashDirty.push_back(Key);
+  if (hashDirty.size()>2*varName.size()+64)
+    {
+      std::sort(hashDirty.begin(),hashDirty.end());
+      hashDirty.erase(std::unique(hashDirty.begin(),hashDirty.end()),
+		      hashDirty.end());
+    }
+  std::set<int> Done;
+  std::vector<int> Work(1,Key);
+  while(!Work.empty())
+    {
+      const int Index=Work.back();
+      Work.pop_back();
+      std::map<int,std::vector<int> >::const_iterator mc=
+	depMap.find(Index);
+      if (mc==depMap.end()) continue;
+
+      std::vector<int>::const_iterator vc;
+      for(vc=mc->second.begin();vc!=mc->second.end();vc++)
+	if (Done.insert(*vc).second)
+	  {
+	    const FItem* FPtr=findVar(*vc);
+	    if (FPtr)
+	      FPtr->clearCache();
+	    Work.push_back(*vc);
+	  }
+    }
+  return;
+}
+
+size_t
+varList::contentHash() const
+  /*!
+    Hash of the names/types/values of all the variables.
+    Only the items changed since the last call are rehashed
+    and the total is updated by difference.
+    \return hash value
+  */
+{
+  if (hashDirty.empty())
+    return hashSum;
+
+  std::sort(hashDirty.begin(),hashDirty.end());
+  hashDirty.erase(std::unique(hashDirty.begin(),hashDirty.end()),
+		  hashDirty.end());
+  std::vector<int>::const_iterator vc;
+  for(vc=hashDirty.begin();vc!=hashDirty.end();vc++)
+    {
+      const FItem* FPtr=findVar(*vc);
+      if (FPtr)
+	{
+	  size_t& HV=hashItem[*vc];
+	  hashSum-=HV;
+	  HV=VarBinary::itemHash(indexName[static_cast<size_t>(*vc)],
+				 *FPtr,indexName);
+	  hashSum+=HV;
+	}
+    }
+  hashDirty.clear();
+  return hashSum;
+}
+
 void
 varList::writeAll(std::ostream& OX) const
   /*!
@@ -104,7 +104,16 @@ class Code
   std::vector<int>& getBC() { return ByteCode; }
   /// Apply - to the values 
   void minusImmed() { Immed.back()*=-1.0; }
+  /// Accessor to the immediate values
+  const std::vector<double>& getImmed() const { return Immed; }
+  /// Size of the evaluation stack
+  size_t getStackSize() const { return Stack.size(); }
+  void setCompiled(const std::vector<int>&,const std::vector<double>&,
+		   const size_t);
   
+  void getVariables(std::vector<int>&) const;
+  int hasAssignment() const;
+
   void writeCompact(std::ostream&) const;
   void printByteCode(std::ostream&) const;
 
@@ -66,6 +66,8 @@ class FItem
 
   /// Accessor to active
   int isActive() const { return active; }
+  /// Drop any memoised value [inputs changed]
+  virtual void clearCache() const {}
 
   ///\cond ABSTRACT
 
@@ -115,6 +117,8 @@ class FValue : public FItem
   virtual void getValue(size_t&) const;     
   virtual void getValue(double&) const;     
   virtual void getValue(std::string&) const;
+  /// Accessor to value [does not mark the item as read]
+  const T& getRawValue() const { return Value; }
 
   virtual std::string typeKey() const;
   void write(std::ostream&) const;  
@@ -137,6 +141,12 @@ class FFunc : public FItem
 
   Code BaseUnit;    ///< Code unit of a compile Function
 
+  int memoFlag;                 ///< Value can be memoised [no x=y]
+  mutable int cacheFlag;        ///< cacheValue is valid
+  mutable double cacheValue;    ///< Memoised value
+
+  double evalCode() const;
+
  public:
 
   FFunc(varList*,const int,const Code&);
@@ -146,6 +156,9 @@ class FFunc : public FItem
   virtual ~FFunc();
 
   void setValue(const Code&);
+  virtual void clearCache() const { cacheFlag=0; }
+  /// Accessor to the compiled code
+  const Code& getCode() const { return BaseUnit; }
 
   virtual void getValue(Geometry::Vec3D&) const;  
   virtual void getValue(int&) const;     
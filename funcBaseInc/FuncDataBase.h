@@ -80,6 +80,9 @@ class FuncDataBase
   double Eval();
   template<typename T>
   T EvalVar(const std::string&) const;      
+  int getHandle(const std::string&) const;
+  template<typename T>
+  T EvalHandle(const int) const;      
   template<typename T>
   T EvalDefVar(const std::string&,const T&) const;      
   template<typename T>
@@ -102,10 +105,14 @@ class FuncDataBase
   void writeAll(const std::string&) const; 
   void processXML(const std::string&);
   void writeXML(const std::string&) const;
+  void writeBinary(const std::string&) const;
+  size_t readBinary(const std::string&);
   /// Debug print function
   void printByteCode(std::ostream& OX) const { Build.printByteCode(OX); }
 
   std::string variableHash() const;
+  /// Incremental content hash of the variables
+  size_t contentHash() const { return VList.contentHash(); }
 
 };
 
@@ -0,0 +1,58 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   funcBaseInc/varBinary.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef varBinary_h
+#define varBinary_h
+
+class FItem;
+class varList;
+
+/*!
+  \namespace VarBinary
+  \brief Binary snapshot of a varList
+  \author S. Ansell
+  \version 1.0
+  \date October 2013
+
+  Snapshot layout (host byte order) :
+   - 8 char magic "CLVBIN01"
+   - size_t content hash , size_t item count
+   - per item : int index, char type, name [size_t length + chars],
+     value [double/int/size_t/3 doubles/string or compiled Code]
+
+  The content hash is the sum of the item hashes so it
+  can be kept up to date one variable at a time. Items are
+  hashed on names and values [variables in Code by name]
+  so the hash does not depend on the order of addition.
+*/
+
+namespace VarBinary
+{
+  size_t itemHash(const std::string&,const FItem&,
+		  const std::vector<std::string>&);
+  size_t hashString(const std::string&);
+
+  void writeSnapshot(const std::string&,const varList&);
+  size_t readSnapshot(const std::string&,varList&);
+  size_t snapshotHash(const std::string&);
+}
+
+#endif
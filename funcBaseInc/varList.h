@@ -34,6 +34,7 @@
 */
 
 class FItem;
+class Code;
 
 class varList
 {
@@ -47,6 +48,13 @@ class varList
 
   varStore varName;    ///< Var by name
   std::map<int,FItem*> varItem;            ///< Var by number
+  std::vector<std::string> indexName;      ///< Var index : name
+  /// Var index : function indexes that read it
+  std::map<int,std::vector<int> > depMap;
+
+  mutable size_t hashSum;                  ///< Sum of item hashes
+  mutable std::map<int,size_t> hashItem;   ///< Hash of each item
+  mutable std::vector<int> hashDirty;      ///< Items changed since hash
 
   void deleteMem();
 
@@ -80,7 +88,11 @@ class varList
 
   template<typename T>
   FItem* createFType(const int I,const T& V);
-  
+
+  void addDependency(const int,const Code&);
+  void invalidate(const int) const;  
+  size_t contentHash() const;
+
   void writeAll(std::ostream&) const;
 
 };
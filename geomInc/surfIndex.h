@@ -22,6 +22,8 @@
 #ifndef surfIndex_h
 #define surfIndex_h
 
+class BuildContext;
+
 namespace Geometry
 {
   class Surface;
@@ -52,6 +54,8 @@ class surfIndex
   
   surfIndex();
 
+  friend class ::BuildContext;
+
   ////\cond SINGLETON
   surfIndex(const surfIndex&);
   surfIndex& operator=(const surfIndex&);
@@ -63,11 +67,13 @@ class surfIndex
  public:
   
   static surfIndex& Instance();
+  static surfIndex* setContext(surfIndex*);
   
   ~surfIndex();
 
   Geometry::Surface* addSurface(Geometry::Surface*);
   void insertSurface(Geometry::Surface*);
+  void replaceSurface(Geometry::Surface*);
   Geometry::Surface* removeEqualSurface(const int);
   Geometry::Surface* cloneSurface(const Geometry::Surface*);
   
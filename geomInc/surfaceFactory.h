@@ -66,6 +66,7 @@ class surfaceFactory
   Surface* createSurface(const std::string&) const;
   Surface* createSurfaceID(const std::string&) const;
   Surface* processLine(const std::string&) const;
+  Surface* testLine(const std::string&) const;
   int getIndex(const std::string&) const;
 
 };
@@ -38,6 +38,7 @@
 #include "NameStack.h"
 #include "RegMethod.h"
 #include "OutputLog.h"
+#include "BuildProfile.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
@@ -69,6 +70,12 @@
 namespace ModelSupport
 {
 
+/// Per-thread context registry [0 : use process singleton]
+static surfIndex* contextPtr(0);
+#ifdef _OPENMP
+#pragma omp threadprivate(contextPtr)
+#endif
+
 surfIndex::surfIndex() : uniqNum(1)
   /*!
     Constructor
@@ -82,10 +89,25 @@ surfIndex::Instance()
     \return surfIndex object
   */
 {
+  if (contextPtr) return *contextPtr;
   static surfIndex A;
   return A;
 }
 
+surfIndex*
+surfIndex::setContext(surfIndex* CPtr)
+  /*!
+    Bind the calling thread to a BuildContext registry.
+    Instance() returns CPtr until reset with a null pointer.
+    \param CPtr :: Registry to use [0 for the process singleton]
+    \return previous registry [or 0]
+  */
+{
+  surfIndex* prevPtr=contextPtr;
+  contextPtr=CPtr;
+  return prevPtr;
+}
+
 surfIndex::~surfIndex()
   /*!
     Destructor
@@ -144,7 +166,10 @@ surfIndex::addSurface(Geometry::Surface* SPtr)
   Geometry::Surface* NewPtr=ModelSupport::equalSurface(SPtr);
   // Now find if we have copy
   if (NewPtr==SPtr)
-    SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+    {
+      SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+      ELog::BuildProfile::Instance().count(ELog::BuildProfile::surface);
+    }
   else
     delete SPtr;
 
@@ -183,7 +208,34 @@ surfIndex::insertSurface(Geometry::Surface* SPtr)
       (SPtr->getName(),"SPtr name");
 
   SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+  ELog::BuildProfile::Instance().count(ELog::BuildProfile::surface);
+
+  return;
+}
+
+void
+surfIndex::replaceSurface(Geometry::Surface* SPtr)
+  /*!
+    Adds and manages a surface. A surface 
+    of the same name is deleted.
+    \param SPtr :: surface to add
+  */
+{
+  ELog::RegMethod RegA("surfIndex","replaceSurface");
+
+  if (!SPtr) 
+    throw ColErr::EmptyValue<Geometry::Surface*>("SPtr empty");
 
+  const int SN=SPtr->getName();
+  STYPE::iterator mc=SMap.find(SN);
+  if (mc!=SMap.end())
+    {
+      delete mc->second;
+      mc->second=SPtr;
+    }
+  else
+    SMap.insert(STYPE::value_type(SN,SPtr));
+  ELog::BuildProfile::Instance().count(ELog::BuildProfile::surface);
   return;
 }
 
@@ -294,6 +346,7 @@ surfIndex::createSurf(const int surfN)
     }
   outPtr=new T(surfN,0);
   SMap.insert(STYPE::value_type(surfN,outPtr));
+  ELog::BuildProfile::Instance().count(ELog::BuildProfile::surface);
   return outPtr;
 }
 
@@ -366,16 +419,7 @@ surfIndex::createSurface(const int SN,const int TN,const std::string& SLine)
 	Geometry::surfaceFactory::Instance().processLine(SLine);
       SPtr->setName(SN);
       SPtr->setTrans(TN);
-      STYPE::iterator mc=SMap.find(SN);
-      if (mc!=SMap.end())
-        {
-	  delete mc->second;
-	  mc->second=SPtr;
-	}
-      else
-        {
-	  SMap.insert(STYPE::value_type(SN,SPtr));
-	}
+      replaceSurface(SPtr);
     }
   catch (const ColErr::ExBase& A)
     {
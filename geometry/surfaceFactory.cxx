@@ -298,5 +298,43 @@ surfaceFactory::processLine(const std::string& Line) const
   return X;
 }
 
+Surface*
+surfaceFactory::testLine(const std::string& Line) const
+  /*!
+    Creates an instance of a surface as processLine
+    but does not write to the log or throw. Used to
+    test a line that may be incomplete from any thread.
+    \param Line :: Full description of line
+    \return new surface object [0 if the line is not valid]
+  */    
+{
+  int id(0);
+  std::string key;
+  std::string procLine(Line);
+  StrFunc::section(procLine,id);           // Id is only set if this succeeds
+
+  if (!StrFunc::convert(procLine,key))
+    return 0;
+  MapTYPE::const_iterator mc=keyGrid.find(key);
+  if (mc==keyGrid.end())
+    return 0;
+
+  Surface *X = surfaceIndex(mc->second);
+  const int errNum=X->setSurface(procLine);
+  if (errNum && errNum>-100)
+    {
+      delete X;
+      return 0;
+    }
+  if (errNum)
+    {
+      delete X;
+      X=new Geometry::NullSurface(id,0);
+    }
+  else if (id) 
+    X->setName(id);
+  return X;
+}
+
 
 } // NAMESPACE geometry
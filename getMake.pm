@@ -45,6 +45,7 @@ sub new
     boost=>0,
     gtk=>0,
     gcov=>0,          ## Gcov
+    openmp=>0,        ## OpenMP threads
     gsl=>0,          ## Gnu scietific lib
     lua=>0,          ## lua
     xlib=>0,         ## X11 libs
@@ -648,6 +649,7 @@ sub setParameters
 	  $self->{optimise}.=" -O2 " if ($Ostr eq "-O");
 	  $self->{optimise}.=" -pg " if ($Ostr eq "-p"); ## Gprof
 	  $self->{gcov}=1 if ($Ostr eq "-C");
+	  $self->{openmp}=1 if ($Ostr eq "-T");
 	  $self->{debug}="" if ($Ostr eq "-g");
 	  $self->{glut}=1 if ($Ostr eq "-G");    
 	  $self->{boost}=1 if ($Ostr eq "-B");
@@ -780,6 +782,7 @@ sub printHeaders
   
   
   $GcovFlag.=" --coverage " if ($self->{gcov});
+  $OFlag.=" -fopenmp " if ($self->{openmp});
 
   print "#!-----------------------------------------------------------------------\n";
   print "SHELL=/bin/sh\n";
@@ -7,7 +7,8 @@ use strict;
 
 ## EXECUTABLES
 my @masterprog=("fullBuild","ess","muBeam",
-		"sns","t1Real","t1MarkII","testMain"); 
+		"sns","t1Real","t1MarkII","testMain",
+		"benchMain"); 
 
 my @noncompile=("bilbau","clayer","cuBuild","d4c","detectSim",
 		"epb","ess","fussion","lens",
@@ -26,20 +27,21 @@ my @sublibdir=("src","attachComp","bibBuild","build",                    # 0
 	       "support", "tally","t1Build","t1Upgrade",                 # 32
 	       "transport","visit","weights","world",                    # 36
 	       "work","xml","zoom","special",                            # 40
-	       "test");                            
+	       "test","bench");                     # 44
 
 my @core=qw( src attachComp construct crystal endf funcBase
              geometry global input instrument log md5 monte 
              mersenne physics poly process scatMat source 
              support tally transport visit weights
-             world work xml special test);
+             world work xml special test bench);
 
 my @coreInc=qw( include  attachCompInc constructInc crystalInc 
              endfInc funcBaseInc geomInc globalInc inputInc
              instrumentInc logInc md5Inc  mersenneInc
              monteInc muonInc physicsInc polyInc processInc scatMatInc
              sourceInc supportInc tallyInc transportInc visitInc
-             weightsInc worldInc workInc xmlInc specialInc testInclude);
+             weightsInc worldInc workInc xmlInc specialInc testInclude
+             benchInc);
 
 my @libnames=@sublibdir;
 
@@ -54,7 +56,8 @@ my @incdir=("include","attachCompInc","bibBuildInc","buildInc","chipInc",
 	    "processInc","scatMatInc","snsBuildInc","sourceInc","specialInc",
 	    "supportInc","tallyInc","t1BuildInc","t1UpgradeInc",
 	    "transportInc","visitInc","weightsInc","workInc",
-	    "worldInc","xmlInc","zoomInc","testInclude");   ## Includes
+	    "worldInc","xmlInc","zoomInc","testInclude",
+	    "benchInc");   ## Includes
 
 ## Flags on executables
 my @controlflags=("-S -B","-S -B","-S -B","-S -B",
@@ -102,6 +105,8 @@ $gM->addDepUnit("sns",      [30,37,0,26,17,31,24,13,20,33,5,6,36,29,21,10,28,39,
 $gM->addDepUnit("epb",      [11,9,37,0,26,17,31,24,13,20,33,5,6,36,29,21,10,28,39,40,24,14,23,0,41,27,32,38,15,1,37]);
 $gM->addDepUnit("muBeam",   [25,34,16,4,3,37,22,42,0,5,6,36,29,10,26,17,28,31,24,13,20,24,33,14,23,0,39,40,41,27,32,38,21,15,1,37,27]);
 
+$gM->addDepUnit("benchMain",[45,12,3,37,4,22,3,42,16,0,26,5,36,29,6,10,17,31,24,13,20,33,28,33,39,24,14,23,0,40,41,27,32,38,21,15,1,37]);
+
 $gM->addDepUnit("testMain", [44,3,37,4,35,16,22,3,42,5,6,36,29,10,34,0,26,17,28,31,24,13,20,14,33,23,0,40,41,27,32,39,38,21,15,1,37,27]);
 
 ##
@@ -117,6 +122,7 @@ if (@ARGV==0)
     print STDERR "   -g  :: No debug\n";
     print STDERR "   -K  :: GTK \n";
     print STDERR "   -S  :: GSL \n";
+    print STDERR "   -T  :: OpenMP threads \n";
     print STDERR "   -NS :: No GSL \n";
     print STDERR "   -M  :: GTKmm \n";
     print STDERR "   -L  :: Don't make library\n";
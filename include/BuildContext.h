@@ -0,0 +1,118 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   include/BuildContext.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef BuildContext_h
+#define BuildContext_h
+
+class masterRotate;
+
+namespace ModelSupport
+{
+  class surfIndex;
+  class objectRegister;
+  class DBMaterial;
+  class SimTrack;
+}
+
+namespace WeightSystem
+{
+  class weightManager;
+}
+
+/*!
+  \class BuildContext
+  \version 1.0
+  \date October 2013
+  \author S. Ansell
+  \brief Holds the model registries for one Simulation
+
+  A shared context resolves everything through the process
+  singletons (the historical behaviour). An isolated context
+  owns its own registries. While a context is activated on a
+  thread the Instance() of each registry returns the
+  context copy, so existing call sites need no change.
+*/
+
+class BuildContext
+{
+ private:
+
+  const int isolated;                       ///< Registries are owned
+
+  ModelSupport::surfIndex* SIPtr;           ///< Surface index
+  ModelSupport::objectRegister* ORPtr;      ///< Object register
+  WeightSystem::weightManager* WMPtr;       ///< Weight manager
+  ModelSupport::DBMaterial* DBPtr;          ///< Material database
+  masterRotate* MRPtr;                      ///< Master rotation
+  ModelSupport::SimTrack* STPtr;            ///< Simulation tracking
+
+  static void bindRegistries(const BuildContext*);
+
+  ///\cond ABSTRACT
+  BuildContext(const BuildContext&);
+  BuildContext& operator=(const BuildContext&);
+  ///\endcond ABSTRACT
+
+ public:
+
+  explicit BuildContext(const int =0);
+  ~BuildContext();
+
+  /// Owns registries
+  int isIsolated() const { return isolated; }
+
+  ModelSupport::surfIndex& getSurfIndex() const;
+  ModelSupport::objectRegister& getObjectRegister() const;
+  WeightSystem::weightManager& getWeightManager() const;
+  ModelSupport::DBMaterial& getDBMaterial() const;
+  masterRotate& getMasterRotate() const;
+  ModelSupport::SimTrack& getSimTrack() const;
+
+  static BuildContext* activate(BuildContext*);
+  static BuildContext* current();
+};
+
+/*!
+  \class BuildContextGuard
+  \version 1.0
+  \date October 2013
+  \author S. Ansell
+  \brief Activates a BuildContext for a scope on the calling thread
+*/
+
+class BuildContextGuard
+{
+ private:
+
+  BuildContext* prevPtr;        ///< Context to restore
+
+  ///\cond ABSTRACT
+  BuildContextGuard(const BuildContextGuard&);
+  BuildContextGuard& operator=(const BuildContextGuard&);
+  ///\endcond ABSTRACT
+
+ public:
+
+  explicit BuildContextGuard(BuildContext&);
+  ~BuildContextGuard();
+};
+
+#endif
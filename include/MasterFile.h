@@ -0,0 +1,84 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   include/MasterFile.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef MasterFile_h
+#define MasterFile_h
+
+/*!
+  \class MasterFile
+  \version 1.0
+  \author S. Ansell
+  \date October 2013
+  \brief Memory mapped master file with a line/section index
+
+  The file is mapped read only and a single pass finds
+  the start of each line and the "XXX CARDS" section
+  headers. Lines are split on '\\n' as by std::getline.
+  A header is only a candidate : the reader of a section
+  decides where it ends [normally the END line].
+*/
+
+class MasterFile
+{
+ public:
+
+  /// Section header : line index / section type
+  typedef std::pair<size_t,int> HTYPE;
+
+ private:
+
+  std::string FName;          ///< File name
+  int fd;                     ///< File descriptor
+  size_t fileSize;            ///< File size [bytes]
+  const char* Data;           ///< Mapped file
+
+  std::vector<size_t> LStart;     ///< Line start [+ end of file]
+  std::vector<HTYPE> Headers;     ///< Section headers in file order
+
+  ///\cond ABSTRACT
+  MasterFile(const MasterFile&);
+  MasterFile& operator=(const MasterFile&);
+  ///\endcond ABSTRACT
+
+  void buildIndex();
+
+ public:
+
+  explicit MasterFile(const std::string&);
+  ~MasterFile();
+
+  static int sectionType(const char*,const char*);
+
+  /// Access file name
+  const std::string& getFileName() const { return FName; }
+  /// Number of lines
+  size_t getNLine() const { return LStart.size()-1; }
+  /// Access section headers
+  const std::vector<HTYPE>& getHeaders() const { return Headers; }
+
+  std::string getLine(const size_t,const int) const;
+  void getLines(const size_t,const size_t,const int,
+		std::vector<std::string>&) const;
+  std::string getText(const size_t,const size_t) const;
+  size_t getLineIndex(const size_t,const long int) const;
+};
+
+#endif
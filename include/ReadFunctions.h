@@ -24,6 +24,10 @@ namespace physicsSystem
 {
   class PhysicsCards;
 }
+namespace Geometry
+{
+  class Surface;
+}
 class FuncDataBase;
 
 /*!
@@ -39,13 +43,22 @@ namespace ReadFunc
 
   void removeDollarComment(std::string&);
   void processDollarString(FuncDataBase&,std::string&);
+  int parseSurface(const std::string&,const int,Geometry::Surface*&,
+		   const int);
   int processSurface(const std::string&,const int);
+  int sectionEnd(const std::string&,int&);
+  int readSection(std::istream&,const int,std::vector<std::string>&);
   int readSurfaces(FuncDataBase&,std::istream&,const int);
+  int readSurfaces(FuncDataBase&,const std::vector<std::string>&,
+		   const int);
 
   int checkInsert(const MonteCarlo::Qhull&,const int,OTYPE&);
+  int checkInsert(MonteCarlo::Qhull*,const int,OTYPE&);
   int mapInsert(const OTYPE&,OTYPE&);
 
   int readCells(FuncDataBase&,std::istream&,const int,OTYPE&);
+  int readCells(FuncDataBase&,const std::vector<std::string>&,
+		const int,OTYPE&);
   int readMaterial(std::istream&);
   int readPhysics(FuncDataBase&,std::istream&,
 		  physicsSystem::PhysicsCards*);
@@ -35,6 +35,14 @@ namespace Transport
   \author S. Ansell
   \version 1.0
   \date October 2012
+
+  runMonte splits the histories into batches of batchSize.
+  Each batch has its own random stream (seed,batch),
+  cell hint and copy of the detectors, so the result does
+  not depend on the number of threads. Batch detectors are
+  added to DUnit in batch order. Neutrons are scored when
+  they cross into a zero importance cell. If eventFlag is set 
+  the batches are tracked event based [ParticleBank].
  */
 
 class SimMonte : public Simulation
@@ -44,6 +52,14 @@ class SimMonte : public Simulation
   long int TCount;                    ///< Total counts 
   Transport::Beam* B;                 ///< Main Beam (init partiles)
   Transport::DetGroup DUnit;          ///< Detector Units
+
+  size_t batchSize;                   ///< Histories per batch
+  unsigned int seed;                  ///< Base seed of batch streams
+  int eventFlag;                      ///< Use event based transport
+
+  size_t runBatch(const size_t,const size_t,Transport::DetGroup&) const;
+  size_t runEventBatch(const size_t,const size_t,
+		       Transport::DetGroup&) const;
   
  public:
   
@@ -57,6 +73,14 @@ class SimMonte : public Simulation
   void runMonte(const size_t);
   void setBeam(const Transport::Beam&);
   void setDetector(const Transport::Detector&);
+  /// Access the detectors
+  const Transport::DetGroup& getDetGroup() const { return DUnit; }
+  /// Set the number of histories in a batch
+  void setBatch(const size_t N) { batchSize=(N) ? N : 1; }
+  /// Set the base seed of the random streams
+  void setSeed(const unsigned int S) { seed=S; }
+  /// Set event based [ParticleBank] transport
+  void setEvent(const int F) { eventFlag=F; }
   
   void writeDetectors(const std::string&,const double) const;
   void write(const std::string&) const;
@@ -22,7 +22,7 @@
 #ifndef ModelSupport_SimTrack_h
 #define ModelSupport_SimTrack_h
 
-
+class BuildContext;
 class Simulation;
 
 namespace MonteCarlo
@@ -51,6 +51,8 @@ class SimTrack
 
   SimTrack();
 
+  friend class ::BuildContext;
+
   ///\cond SINGLETON
   SimTrack(const SimTrack&);
   SimTrack& operator=(const SimTrack&);
@@ -59,6 +61,7 @@ class SimTrack
  public:
 
   static SimTrack& Instance();
+  static SimTrack* setContext(SimTrack*);
 
   // Cell Ptr:
   MonteCarlo::Object* curCell(const Simulation*) const;
@@ -43,6 +43,7 @@ namespace physicsSystem
 }
 
 class RemoveCell;
+class BuildContext;
 
 namespace ModelSupport
 {
@@ -92,6 +93,10 @@ class Simulation
 
   TallyTYPE TItem;  ///< Tally Items
   physicsSystem::PhysicsCards* PhysPtr;   ///< Physics Cards
+  BuildContext* BCPtr;                    ///< Model registries
+
+  /// Cell string : complement free string
+  std::map<std::string,std::string> ComplementCache;
   
   // METHODS:
 
@@ -155,6 +160,9 @@ class Simulation
   const FuncDataBase& getDataBase() const { return DB; }
   /// Get PhysicsCards
   physicsSystem::PhysicsCards& getPC() { return *PhysPtr; }    
+  /// Get the model registries
+  BuildContext& getContext() const { return *BCPtr; }
+  void isolateContext();
   const OTYPE& getCells() const { return OList; } ///< Get cells
   OTYPE& getCells() { return OList; } ///< Get cells
   Geometry::Transform* createSourceTransform();
@@ -162,6 +170,8 @@ class Simulation
 
   void setCutter(const int); 
   int removeComplements(); 
+  /// Number of cached complement expansions
+  size_t complementCacheSize() const { return ComplementCache.size(); }
 
   int populateCells();  // SHOULD BE PROTECTED
 
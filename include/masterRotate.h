@@ -22,6 +22,7 @@
 #ifndef masterRotate_h
 #define masterRotate_h
 
+class BuildContext;
 class transComp;
 
 /*!
@@ -42,6 +43,8 @@ class masterRotate : public localRotate
   
   masterRotate();
 
+  friend class ::BuildContext;
+
   ///\cond SINGLETON
   masterRotate(const masterRotate&);
   masterRotate& operator=(const masterRotate&);
@@ -56,6 +59,7 @@ class masterRotate : public localRotate
   virtual ~masterRotate() {} 
   
   static masterRotate& Instance();
+  static masterRotate* setContext(masterRotate*);
 
   virtual Geometry::Vec3D calcRotate(const Geometry::Vec3D&) const;
   virtual Geometry::Vec3D calcAxisRotate(const Geometry::Vec3D&) const;
@@ -960,6 +960,8 @@ template const std::string&
 inputParam::getCompValue(const std::string&,const size_t,const size_t) const;
 template const int&
 inputParam::getCompValue(const std::string&,const size_t,const size_t) const;
+template const double&
+inputParam::getCompValue(const std::string&,const size_t,const size_t) const;
 
 template double
 inputParam::getFlagDef(const std::string&,const FuncDataBase& Control,
@@ -0,0 +1,302 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   log/BuildProfile.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <time.h>
+
+#include "BuildProfile.h"
+
+namespace ELog
+{
+
+BuildProfile::BuildProfile() :
+  activeFlag(0)
+  /*!
+    Constructor
+  */
+{
+  std::fill(Counter,Counter+nCount,0);
+}
+
+BuildProfile::~BuildProfile()
+  /*!
+    Destructor : writes the report if active
+  */
+{
+  if (activeFlag)
+    write();
+}
+
+BuildProfile&
+BuildProfile::Instance()
+  /*!
+    Singleton accessor
+    \return BuildProfile 
+  */
+{
+  static BuildProfile A;
+  return A;
+}
+
+const char*
+BuildProfile::countName(const size_t I)
+  /*!
+    Name of a counter 
+    \param I :: Counter index
+    \return name
+  */
+{
+  static const char* CName[nCount]=
+    { "surfaces","cells","ruleNodes","findCell","equalSurf" };
+  return (I<nCount) ? CName[I] : "unknown";
+}
+
+double
+BuildProfile::timer()
+  /*!
+    Wall clock time 
+    \return time [seconds] from an arbitary point
+  */
+{
+  struct timespec TS;
+  clock_gettime(CLOCK_MONOTONIC,&TS);
+  return static_cast<double>(TS.tv_sec)+
+    1e-9*static_cast<double>(TS.tv_nsec);
+}
+
+long int
+BuildProfile::readStatus(const std::string& Key)
+  /*!
+    Read a memory value from /proc/self/status
+    \param Key :: Key [e.g. VmRSS:]
+    \return value [kB] / 0 if not available
+  */
+{
+  std::ifstream IX("/proc/self/status");
+  std::string Line;
+  while(std::getline(IX,Line))
+    {
+      if (Line.compare(0,Key.size(),Key)==0)
+	{
+	  std::istringstream cx(Line.substr(Key.size()));
+	  long int V(0);
+	  cx>>V;
+	  return V;
+	}
+    }
+  return 0;
+}
+
+void
+BuildProfile::updatePeak()
+  /*!
+    Fold the high-water mark into the open phases
+  */
+{
+  const long int HWM=readStatus("VmHWM:");
+  std::vector<size_t>::const_iterator vc;
+  for(vc=Open.begin();vc!=Open.end();vc++)
+    {
+      PhaseUnit& PU(Phases[*vc]);
+      PU.peakRSS=std::max(PU.peakRSS,HWM);
+    }
+  return;
+}
+
+void
+BuildProfile::activate(const std::string& FName)
+  /*!
+    Activate the counters and set the output
+    \param FName :: Output file [.json for JSON / else CSV]
+  */
+{
+  activeFlag=1;
+  OutFile=FName;
+  return;
+}
+
+size_t
+BuildProfile::startPhase(const std::string& Name)
+  /*!
+    Open a phase. Phases are only recorded if active.
+    The high-water mark is folded into the open phases
+    and then reset [if the kernel allows] so the peak 
+    of this phase is its own.
+    \param Name :: Phase name
+    \return phase index [number of phases if not active]
+  */
+{
+  if (!activeFlag)
+    return Phases.size();
+
+  PhaseUnit PU;
+  PU.Name=Name;
+  PU.depth=Open.size();
+  PU.time=0.0;
+  updatePeak();
+  std::ofstream CX("/proc/self/clear_refs");
+  if (CX.good())
+    CX<<"5"<<std::endl;
+  CX.close();
+  PU.RSS=readStatus("VmRSS:");
+  PU.peakRSS=PU.RSS;
+  std::copy(Counter,Counter+nCount,PU.Cnt);
+  PU.startTime=timer();
+
+  Phases.push_back(PU);
+  Open.push_back(Phases.size()-1);
+  return Phases.size()-1;
+}
+
+void
+BuildProfile::endPhase(const size_t Index)
+  /*!
+    Close a phase [and any phases opened within it]
+    \param Index :: Phase index
+  */
+{
+  const double T=timer();
+  if (activeFlag)
+    updatePeak();
+  while(!Open.empty() && Open.back()>=Index)
+    {
+      PhaseUnit& PU(Phases[Open.back()]);
+      PU.time=T-PU.startTime;
+      for(size_t i=0;i<nCount;i++)
+	PU.Cnt[i]=Counter[i]-PU.Cnt[i];
+      Open.pop_back();
+    }
+  return;
+}
+
+void
+BuildProfile::writeJSON(std::ostream& OX) const
+  /*!
+    Write the report as JSON
+    \param OX :: Output stream
+  */
+{
+  OX<<"{"<<std::endl;
+  OX<<"  \"phases\": ["<<std::endl;
+  std::vector<PhaseUnit>::const_iterator vc;
+  for(vc=Phases.begin();vc!=Phases.end();vc++)
+    {
+      OX<<"    {\"name\": \""<<vc->Name<<"\", \"depth\": "<<vc->depth
+	<<", \"time\": "<<vc->time
+	<<", \"rss\": "<<vc->RSS<<", \"peakRSS\": "<<vc->peakRSS;
+      for(size_t i=0;i<nCount;i++)
+	OX<<", \""<<countName(i)<<"\": "<<vc->Cnt[i];
+      OX<<"}"<<((vc+1!=Phases.end()) ? "," : "")<<std::endl;
+    }
+  OX<<"  ],"<<std::endl;
+  OX<<"  \"total\": {";
+  for(size_t i=0;i<nCount;i++)
+    OX<<((i) ? ", \"" : "\"")<<countName(i)<<"\": "<<Counter[i];
+  OX<<"}"<<std::endl;
+  OX<<"}"<<std::endl;
+  return;
+}
+
+void
+BuildProfile::writeCSV(std::ostream& OX) const
+  /*!
+    Write the report as CSV [one line per phase]
+    \param OX :: Output stream
+  */
+{
+  OX<<"phase,depth,time,rss,peakRSS";
+  for(size_t i=0;i<nCount;i++)
+    OX<<","<<countName(i);
+  OX<<std::endl;
+
+  std::vector<PhaseUnit>::const_iterator vc;
+  for(vc=Phases.begin();vc!=Phases.end();vc++)
+    {
+      OX<<vc->Name<<","<<vc->depth<<","<<vc->time<<","
+	<<vc->RSS<<","<<vc->peakRSS;
+      for(size_t i=0;i<nCount;i++)
+	OX<<","<<vc->Cnt[i];
+      OX<<std::endl;
+    }
+  return;
+}
+
+void
+BuildProfile::write() const
+  /*!
+    Write the report to the output file
+  */
+{
+  if (OutFile.empty())
+    return;
+  std::ofstream OX(OutFile.c_str());
+  const size_t L(OutFile.size());
+  if (L>5 && OutFile.compare(L-5,5,".json")==0)
+    writeJSON(OX);
+  else
+    writeCSV(OX);
+  return;
+}
+
+//---------------------------------------------------------
+//                    ProfilePhase
+//---------------------------------------------------------
+
+ProfilePhase::ProfilePhase(const std::string& Name) :
+  index(0),openFlag(BuildProfile::Instance().isActive())
+  /*!
+    Constructor : opens the phase [if the profile is active]
+    \param Name :: Phase name
+  */
+{
+  if (openFlag)
+    index=BuildProfile::Instance().startPhase(Name);
+}
+
+ProfilePhase::~ProfilePhase()
+  /*!
+    Destructor : closes the phase if open
+  */
+{
+  end();
+}
+
+void
+ProfilePhase::end()
+  /*!
+    Close the phase before the end of scope
+  */
+{
+  if (openFlag)
+    {
+      BuildProfile::Instance().endPhase(index);
+      openFlag=0;
+    }
+  return;
+}
+
+} // NAMESPACE ELog
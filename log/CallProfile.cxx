@@ -0,0 +1,353 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   log/CallProfile.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "CallProfile.h"
+
+namespace ELog
+{
+
+/*!
+  \struct CallNode
+  \brief Node of a thread call tree
+*/
+
+struct CallNode
+{
+  std::string Name;                         ///< class::method
+  CallNode* Parent;                         ///< Caller [0 at root]
+  std::map<std::string,CallNode*> Child;    ///< Called methods
+  unsigned long int nCall;                  ///< Number of calls
+  unsigned long int startTick;              ///< Tick at entry 
+  unsigned long int inclTick;               ///< Inclusive ticks
+  unsigned long int childTick;              ///< Ticks in children
+
+  /// Constructor
+  CallNode(const std::string& N,CallNode* P) :
+    Name(N),Parent(P),nCall(0),startTick(0),
+    inclTick(0),childTick(0) {}
+  ~CallNode();
+};
+
+CallNode::~CallNode()
+  /*!
+    Destructor : deletes the children
+  */
+{
+  std::map<std::string,CallNode*>::iterator mc;
+  for(mc=Child.begin();mc!=Child.end();mc++)
+    delete mc->second;
+}
+
+/// Per method totals : calls / inclusive / exclusive
+struct CallSum
+{
+  unsigned long int nCall;     ///< Number of calls
+  unsigned long int inclTick;  ///< Inclusive ticks
+  unsigned long int exclTick;  ///< Exclusive ticks
+  /// Constructor
+  CallSum() : nCall(0),inclTick(0),exclTick(0) {}
+};
+
+static bool
+exclOrder(const std::pair<std::string,CallSum>& A,
+	  const std::pair<std::string,CallSum>& B)
+  /*!
+    Order of the exclusive time [largest first]
+    \param A :: First method
+    \param B :: Second method
+    \return A.excl > B.excl
+  */
+{
+  return A.second.exclTick>B.second.exclTick;
+}
+
+static void
+walkTree(const CallNode* NPtr,std::vector<std::string>& Path,
+	 std::map<std::string,unsigned long int>& Folded,
+	 std::map<std::string,CallSum>& Flat)
+  /*!
+    Accumulate the folded stacks and method totals 
+    of a call tree. The inclusive time of a recursive
+    method is only taken at the outermost call.
+    \param NPtr :: Node [below root]
+    \param Path :: Names of the callers
+    \param Folded :: Exclusive ticks per stack
+    \param Flat :: Totals per method
+  */
+{
+  const unsigned long int excl=(NPtr->inclTick>NPtr->childTick) ?
+    NPtr->inclTick-NPtr->childTick : 0;
+
+  CallSum& CS(Flat[NPtr->Name]);
+  CS.nCall+=NPtr->nCall;
+  CS.exclTick+=excl;
+  if (std::find(Path.begin(),Path.end(),NPtr->Name)==Path.end())
+    CS.inclTick+=NPtr->inclTick;
+
+  Path.push_back(NPtr->Name);
+  std::string Stack(Path.front());
+  for(size_t i=1;i<Path.size();i++)
+    Stack+=";"+Path[i];
+  Folded[Stack]+=excl;
+
+  std::map<std::string,CallNode*>::const_iterator mc;
+  for(mc=NPtr->Child.begin();mc!=NPtr->Child.end();mc++)
+    walkTree(mc->second,Path,Folded,Flat);
+  Path.pop_back();
+  return;
+}
+
+int CallProfile::activeFlag(0);
+
+#ifdef _OPENMP
+/// Current node of this thread [0 : not yet assigned]
+static CallNode* threadNode(0);
+#pragma omp threadprivate(threadNode)
+#else
+static CallNode* threadNode(0);
+#endif
+
+CallProfile::CallProfile() :
+  tickStart(0),timeStart(0.0)
+  /*!
+    Constructor
+  */
+{}
+
+CallProfile::~CallProfile()
+  /*!
+    Destructor : writes the profile if active
+  */
+{
+  if (activeFlag)
+    {
+      write();
+      activeFlag=0;
+    }
+  for(size_t i=0;i<Roots.size();i++)
+    delete Roots[i];
+}
+
+CallProfile&
+CallProfile::Instance()
+  /*!
+    Singleton accessor
+    \return CallProfile 
+  */
+{
+  static CallProfile A;
+  return A;
+}
+
+unsigned long int
+CallProfile::tick()
+  /*!
+    Time stamp counter [nanoseconds if not x86]
+    \return ticks from an arbitary point
+  */
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return static_cast<unsigned long int>(__rdtsc());
+#else
+  struct timespec TS;
+  clock_gettime(CLOCK_MONOTONIC,&TS);
+  return static_cast<unsigned long int>(TS.tv_sec)*1000000000UL+
+    static_cast<unsigned long int>(TS.tv_nsec);
+#endif
+}
+
+double
+CallProfile::timer()
+  /*!
+    Wall clock time 
+    \return time [seconds] from an arbitary point
+  */
+{
+  struct timespec TS;
+  clock_gettime(CLOCK_MONOTONIC,&TS);
+  return static_cast<double>(TS.tv_sec)+
+    1e-9*static_cast<double>(TS.tv_nsec);
+}
+
+CallNode*&
+CallProfile::current()
+  /*!
+    Access the current node of this thread. A thread 
+    gets a new call tree on its first call.
+    \return current node
+  */
+{
+  if (!threadNode)
+    {
+      threadNode=new CallNode("",0);
+      CallProfile& CP=Instance();
+#ifdef _OPENMP
+#pragma omp critical(ELogCallProfile)
+#endif
+      CP.Roots.push_back(threadNode);
+    }
+  return threadNode;
+}
+
+void
+CallProfile::enter(const std::string& CN,const std::string& MN)
+  /*!
+    Enter a method on this thread
+    \param CN :: Class name
+    \param MN :: Method name
+  */
+{
+  CallNode*& NPtr=current();
+  const std::string Name=CN+"::"+MN;
+  std::map<std::string,CallNode*>::iterator mc=NPtr->Child.find(Name);
+  if (mc==NPtr->Child.end())
+    mc=NPtr->Child.insert
+      (std::map<std::string,CallNode*>::value_type
+       (Name,new CallNode(Name,NPtr))).first;
+  NPtr=mc->second;
+  NPtr->nCall++;
+  NPtr->startTick=tick();
+  return;
+}
+
+void
+CallProfile::leave()
+  /*!
+    Leave the current method on this thread
+  */
+{
+  const unsigned long int T=tick();
+  CallNode*& NPtr=current();
+  if (NPtr->Parent)
+    {
+      const unsigned long int D=T-NPtr->startTick;
+      NPtr->inclTick+=D;
+      NPtr->Parent->childTick+=D;
+      NPtr=NPtr->Parent;
+    }
+  return;
+}
+
+void
+CallProfile::activate(const std::string& FName)
+  /*!
+    Start profiling. Methods already entered
+    are not profiled.
+    \param FName :: Output file for the folded stacks
+  */
+{
+  OutFile=FName;
+  tickStart=tick();
+  timeStart=timer();
+  activeFlag=1;
+  return;
+}
+
+void
+CallProfile::deactivate()
+  /*!
+    Stop profiling. Methods already entered are
+    still closed and the trees are kept.
+  */
+{
+  activeFlag=0;
+  return;
+}
+
+void
+CallProfile::write() const
+  /*!
+    Write the folded stacks [OutFile] and the 
+    method table [OutFile.calls]
+  */
+{
+  if (OutFile.empty())
+    return;
+
+  std::ofstream OX(OutFile.c_str());
+  const std::string CallFile(OutFile+".calls");
+  std::ofstream CX(CallFile.c_str());
+  write(OX,CX);
+  return;
+}
+
+void
+CallProfile::write(std::ostream& OX,std::ostream& CX) const
+  /*!
+    Merge the thread trees and write the folded
+    stacks and the method table
+    \param OX :: Folded stack output
+    \param CX :: Method table output
+  */
+{
+  const double dT=timer()-timeStart;
+  const double dTick=static_cast<double>(tick()-tickStart);
+  const double secPerTick=(dTick>0.0) ? dT/dTick : 0.0;
+
+  std::map<std::string,unsigned long int> Folded;
+  std::map<std::string,CallSum> Flat;
+  std::vector<std::string> Path;
+  for(size_t i=0;i<Roots.size();i++)
+    {
+      std::map<std::string,CallNode*>::const_iterator mc;
+      for(mc=Roots[i]->Child.begin();mc!=Roots[i]->Child.end();mc++)
+	walkTree(mc->second,Path,Folded,Flat);
+    }
+
+  std::map<std::string,unsigned long int>::const_iterator fc;
+  for(fc=Folded.begin();fc!=Folded.end();fc++)
+    {
+      const unsigned long int uSec=static_cast<unsigned long int>
+	(1e6*secPerTick*static_cast<double>(fc->second)+0.5);
+      if (uSec)
+	OX<<fc->first<<" "<<uSec<<std::endl;
+    }
+
+  std::vector<std::pair<std::string,CallSum> > 
+    Table(Flat.begin(),Flat.end());
+  std::sort(Table.begin(),Table.end(),exclOrder);
+
+  CX<<"# calls inclusive[s] exclusive[s] class::method"<<std::endl;
+  for(size_t i=0;i<Table.size();i++)
+    {
+      const CallSum& CS(Table[i].second);
+      CX<<CS.nCall<<" "
+	<<secPerTick*static_cast<double>(CS.inclTick)<<" "
+	<<secPerTick*static_cast<double>(CS.exclTick)<<" "
+	<<Table[i].first<<std::endl;
+    }
+  return;
+}
+
+} // NAMESPACE ELog
@@ -23,31 +23,69 @@
 #include <sstream>
 #include <map>
 #include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "NameStack.h"
 #include "RegMethod.h"
+#include "CallProfile.h"
 
 namespace ELog
 {
 
 NameStack RegMethod::Base;
 
+#ifdef _OPENMP
+/// Stack of this thread [0 : not yet assigned]
+static NameStack* threadStack(0);
+#pragma omp threadprivate(threadStack)
+#endif
+
+NameStack&
+RegMethod::stack()
+  /*!
+    Access the calling stack of this thread. The initial
+    thread uses Base, other threads get a private stack
+    so that concurrent methods do not push/pop each other.
+    The private stack is released when the thread exits.
+    \return stack of the calling thread
+  */
+{
+#ifdef _OPENMP
+  static thread_local NameStack localStack;
+  if (!threadStack)
+    {
+      int initialThread(1);
+      for(int level=omp_get_level();level>0 && initialThread;level--)
+	if (omp_get_ancestor_thread_num(level))
+	  initialThread=0;
+      threadStack=(initialThread) ? &Base : &localStack;
+    }
+  return *threadStack;
+#else
+  return Base;
+#endif
+}
+
 RegMethod::RegMethod(const std::string& CN,
 		     const std::string& MN) :
-  indentLevel(0)
+  indentLevel(0),profFlag(CallProfile::isActive())
   /*!
     Constructor add name to stack
     \param CN :: Class name
     \param MN :: Method name
   */
 {
-  Base.addComp(CN,MN);
+  stack().addComp(CN,MN);
+  if (profFlag)
+    CallProfile::enter(CN,MN);
 }
 
 RegMethod::RegMethod(const std::string& CN,
 		     const std::string& MN,
 		     const int param) :
-  indentLevel(0)
+  indentLevel(0),profFlag(CallProfile::isActive())
   /*!
     Constructor add name to stack
     \param CN :: Class name
@@ -57,7 +95,9 @@ RegMethod::RegMethod(const std::string& CN,
 {
   std::ostringstream cx;
   cx<<"<"<<param<<">";
-  Base.addComp(CN+cx.str(),MN);
+  stack().addComp(CN+cx.str(),MN);
+  if (profFlag)
+    CallProfile::enter(CN+cx.str(),MN);
 }
 
 RegMethod::~RegMethod() 
@@ -65,9 +105,11 @@ RegMethod::~RegMethod()
     Destructor removes one from the stack
   */
 {
-  Base.popBack();
+  if (profFlag)
+    CallProfile::leave();
+  stack().popBack();
   if (indentLevel) 
-    Base.addIndent(-indentLevel);
+    stack().addIndent(-indentLevel);
 }
 
 void
@@ -77,7 +119,7 @@ RegMethod::incIndent()
   */
 {
   indentLevel+=2;
-  Base.addIndent(2);
+  stack().addIndent(2);
   return;
 }
 
@@ -88,7 +130,7 @@ RegMethod::decIndent()
   */
 {
   indentLevel-=2;
-  Base.addIndent(-2);
+  stack().addIndent(-2);
   return;
 }
 
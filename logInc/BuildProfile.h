@@ -0,0 +1,147 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   logInc/BuildProfile.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ELog_BuildProfile_h
+#define ELog_BuildProfile_h
+
+namespace ELog
+{
+  /*!
+    \class BuildProfile 
+    \brief Times / counts / memory of the model build phases
+    \author S. Ansell
+    \version 1.0
+    \date October 2013
+
+    Phases are opened and closed by ProfilePhase and are
+    kept in the order they were opened. Each phase records 
+    the wall time, the resident memory at the start, the peak 
+    resident memory and the change in the item counters.
+    Counters are only incremented after activate() and are
+    safe to call from the OpenMP workers.
+    The report is written as JSON [.json] or CSV at exit.
+  */
+
+class BuildProfile
+{
+ public:
+
+  /// Items counted 
+  enum CNT { surface=0,cell=1,ruleNode=2,findCell=3,equalSurf=4 };
+  static const size_t nCount=5;        ///< Number of counters
+
+ private:
+
+  /// Phase record
+  struct PhaseUnit
+  {
+    std::string Name;                  ///< Phase name
+    size_t depth;                      ///< Nesting depth
+    double startTime;                  ///< Time at open [s]
+    double time;                       ///< Wall time [s]
+    long int RSS;                      ///< Resident memory at open [kB]
+    long int peakRSS;                  ///< Peak resident memory [kB]
+    size_t Cnt[nCount];                ///< Counters at open / change
+  };
+
+  int activeFlag;                      ///< Counters active
+  std::string OutFile;                 ///< Output file
+  size_t Counter[nCount];              ///< Item counters
+  std::vector<PhaseUnit> Phases;       ///< Phases in open order
+  std::vector<size_t> Open;            ///< Open phase index stack
+
+  BuildProfile();
+  /// \cond NOWRITTEN
+  BuildProfile(const BuildProfile&);
+  BuildProfile& operator=(const BuildProfile&);
+  /// \endcond NOWRITTEN
+
+  static double timer();
+  static long int readStatus(const std::string&);
+  void updatePeak();
+
+ public:
+
+  ~BuildProfile();   
+
+  static BuildProfile& Instance(); 
+  static const char* countName(const size_t);
+
+  void activate(const std::string&);
+  /// Is active
+  int isActive() const { return activeFlag; }
+
+  /// Count an item if active
+  void count(const CNT I)
+    {
+      if (activeFlag)
+	{
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+	  Counter[I]++;
+	}
+    }
+  /// Access a counter
+  size_t getCount(const CNT I) const { return Counter[I]; }
+
+  size_t startPhase(const std::string&);
+  void endPhase(const size_t);
+
+  void writeJSON(std::ostream&) const;
+  void writeCSV(std::ostream&) const;
+  void write() const;
+};
+
+/*!
+  \class ProfilePhase 
+  \brief Scoped phase of a BuildProfile
+  \author S. Ansell
+  \version 1.0
+  \date October 2013
+
+  Nothing is recorded unless the profile is active
+  when the phase is opened.
+*/
+
+class ProfilePhase
+{
+ private:
+
+  size_t index;               ///< Phase index
+  int openFlag;               ///< Phase still open
+
+  /// \cond NOWRITTEN
+  ProfilePhase(const ProfilePhase&);
+  ProfilePhase& operator=(const ProfilePhase&);
+  /// \endcond NOWRITTEN
+
+ public:
+
+  explicit ProfilePhase(const std::string&);
+  ~ProfilePhase();
+
+  void end();
+};
+
+}
+
+#endif
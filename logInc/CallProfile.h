@@ -0,0 +1,85 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   logInc/CallProfile.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ELog_CallProfile_h
+#define ELog_CallProfile_h
+
+namespace ELog
+{
+
+struct CallNode;
+
+  /*!
+    \class CallProfile 
+    \brief Call counts / times of the RegMethod registrations
+    \author S. Ansell
+    \version 1.0
+    \date October 2013
+
+    When active each RegMethod enters a node of a call tree
+    kept by the calling thread. The node keeps the number of
+    calls and the inclusive / child time in TSC ticks. At exit
+    the thread trees are merged and written as folded stacks 
+    [flame graph input, times in microseconds] to the output 
+    file and as a table of calls, inclusive and exclusive 
+    time per class::method to file.calls.
+  */
+
+class CallProfile
+{
+ private:
+
+  static int activeFlag;                ///< Profiling active
+
+  std::string OutFile;                  ///< Output file
+  unsigned long int tickStart;          ///< Ticks at activation
+  double timeStart;                     ///< Wall time at activation
+  std::vector<CallNode*> Roots;         ///< Thread call trees
+
+  CallProfile();
+  /// \cond NOWRITTEN
+  CallProfile(const CallProfile&);
+  CallProfile& operator=(const CallProfile&);
+  /// \endcond NOWRITTEN
+
+  static unsigned long int tick();
+  static double timer();
+  static CallNode*& current();
+
+ public:
+
+  ~CallProfile();   
+
+  static CallProfile& Instance(); 
+  /// Is profiling active
+  static int isActive() { return activeFlag; }
+  static void enter(const std::string&,const std::string&);
+  static void leave();
+  
+  void activate(const std::string&);
+  void deactivate();
+  void write() const;
+  void write(std::ostream&,std::ostream&) const;
+};
+
+}
+
+#endif
@@ -33,6 +33,8 @@ namespace ELog
 
     This class is called as a registration class.
     It keeps location etc possible for 
+    Each OpenMP worker thread keeps its own stack.
+    If CallProfile is active the call is also timed.
   */
 
 class RegMethod
@@ -41,7 +43,9 @@ class RegMethod
 
   static NameStack Base;           ///< Singleton of base to register
 
+  static NameStack& stack();
   int indentLevel;                 ///< Additional indent
+  int profFlag;                    ///< Entered in CallProfile
   /// \cond NOWRITTEN
   RegMethod(const RegMethod&);
   RegMethod& operator=(const RegMethod&);
@@ -50,17 +54,17 @@ class RegMethod
  public:
 
   /// Access NameStack pointer
-  NameStack* getBasePtr() { return &Base; }
+  NameStack* getBasePtr() { return &stack(); }
   RegMethod(const std::string&,const std::string&);
   RegMethod(const std::string&,const std::string&,const int);
   ~RegMethod();
 
   /// Access string
-  static std::string getBase() { return Base.getBase(); }
+  static std::string getBase() { return stack().getBase(); }
   /// Access string
-  static std::string getFull() { return Base.getFullTree(); }
+  static std::string getFull() { return stack().getFullTree(); }
   /// Access particular item 
-  static std::string getItem(const int I) { return Base.getItem(I); }
+  static std::string getItem(const int I) { return stack().getItem(I); }
 
   void incIndent();
   void decIndent();
@@ -32,6 +32,8 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <utility>
+#include <climits>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -66,7 +68,9 @@ BnId::BnId() :
 {}
 
 BnId::BnId(const size_t TSize,const size_t X) :
-  size(TSize),PI(1),Tnum(0),Znum(0),Tval(TSize)
+  size(TSize),PI(1),Tnum(0),Znum(0),
+  Care((TSize+WBits-1)/WBits,~static_cast<WORD>(0)),
+  Value((TSize+WBits-1)/WBits,0)
   /*!
     Constructer that creates a true/false mapping
     without the  undetermined option
@@ -74,21 +78,24 @@ BnId::BnId(const size_t TSize,const size_t X) :
     \param X :: integer for of the binary representation 
   */
 {
-  size_t cnt=1;
-  long int sum(0);
-  for(size_t i=0;i<size;cnt*=2,i++)
-    { 
-      Tval[i] = (X & cnt) ? 1 : -1;
-      sum+=Tval[i];
+  if (!Care.empty())
+    {
+      // Only the first word can hold bits of X
+      Value[0]=static_cast<WORD>(X);
+      if (size%WBits)
+	{
+	  const WORD mask=(static_cast<WORD>(1) << (size%WBits))-1;
+	  Care.back()&=mask;
+	  Value.back()&=mask;
+	}
     }
-  // counts number of true numbers
-  Tnum=static_cast<size_t>((sum+static_cast<long>(size))/2);
-  Znum=size-Tnum;
+  setCounters();
 }
 
 BnId::BnId(const BnId& A) :
   size(A.size),PI(A.PI),Tnum(A.Tnum),
-  Znum(A.Znum),Tval(A.Tval),MinTerm(A.MinTerm)
+  Znum(A.Znum),Care(A.Care),Value(A.Value),
+  MinTerm(A.MinTerm)
   /*!
     Standard Copy Constructor
     \param A :: Object to copy
@@ -109,7 +116,8 @@ BnId::operator=(const BnId& A)
       PI=A.PI;
       Tnum=A.Tnum;
       Znum=A.Znum;
-      Tval=A.Tval;
+      Care=A.Care;
+      Value=A.Value;
       MinTerm=A.MinTerm;
     }
   return *this;
@@ -121,6 +129,43 @@ BnId::~BnId()
    */
 {}
 
+int
+BnId::literal(const size_t Index) const
+  /*!
+    Tri-state value of a literal [no range check]
+    \param Index :: literal number
+    \return -1 / 0 / 1
+  */
+{
+  const WORD bit=static_cast<WORD>(1) << (Index%WBits);
+  const size_t W(Index/WBits);
+  if (!(Care[W] & bit))
+    return 0;
+  return (Value[W] & bit) ? 1 : -1;
+}
+
+void
+BnId::setLiteral(const size_t Index,const int TV)
+  /*!
+    Set the tri-state value of a literal [no range check]
+    Counters are not updated
+    \param Index :: literal number
+    \param TV :: -1 / 0 / 1
+  */
+{
+  const WORD bit=static_cast<WORD>(1) << (Index%WBits);
+  const size_t W(Index/WBits);
+  if (TV)
+    Care[W]|=bit;
+  else
+    Care[W]&= ~bit;
+  if (TV>0)
+    Value[W]|=bit;
+  else
+    Value[W]&= ~bit;
+  return;
+}
+
 int
 BnId::operator==(const BnId& A) const
   /*!
@@ -133,16 +178,7 @@ BnId::operator==(const BnId& A) const
   if (A.size!=size || A.Tnum!=Tnum
       || A.Znum!=Znum)
     return 0;
-  std::vector<int>::const_iterator vc;
-  std::vector<int>::const_iterator ac=A.Tval.begin();
-  for(vc=Tval.begin();vc!=Tval.end();vc++,ac++)
-    {
-      if (ac==A.Tval.end())     // This should neve happen
-	return 0;
-      if (*vc!=*ac)
-	return 0;
-    }
-  return 1;
+  return (Care==A.Care && Value==A.Value) ? 1 : 0;
 }
 
 int
@@ -158,11 +194,12 @@ BnId::equivalent(const BnId& A) const
   if (A.size!=size)
     return 0;
   int retval=1;
-  for(size_t i=0;i<size;i++)
+  for(size_t i=0;i<Care.size();i++)
     {
-      if (Tval[i]*A.Tval[i]<0)          //true * false == -1.
+      // true * false 
+      if ((Value[i]^A.Value[i]) & Care[i] & A.Care[i])
         return 0;
-      if (Tval[i]!=A.Tval[i]) 
+      if (Care[i]!=A.Care[i])
 	retval=2;
     }
   return retval;
@@ -190,22 +227,23 @@ BnId::operator<(const BnId& A) const
 {
   if (A.size!=size)
     return size<A.size;
-  std::pair<int,int> cntA(0,0);   // count for A
-  std::pair<int,int> cntT(0,0);   // count for this
   if (Znum!=A.Znum)
     return (Znum<A.Znum) ? 1 : 0;
 
   if (Tnum!=A.Tnum)
     return (Tnum<A.Tnum) ? 1 : 0;
 
-  std::vector<int>::const_reverse_iterator tvc=Tval.rbegin();
-  std::vector<int>::const_reverse_iterator avc=A.Tval.rbegin();
-  while(tvc!=Tval.rend())
+  // Highest literal that differs decides [-1 < 0 < 1]
+  for(size_t i=Care.size();i>0;i--)
     {
-      if (*tvc!=*avc)
-	return *tvc<*avc;
-      tvc++;
-      avc++;
+      const WORD diff=(Care[i-1]^A.Care[i-1]) | (Value[i-1]^A.Value[i-1]);
+      if (diff)
+	{
+	  const size_t bit=WBits-1-
+	    static_cast<size_t>(__builtin_clzll(diff));
+	  const size_t Index=(i-1)*WBits+bit;
+	  return literal(Index)<A.literal(Index);
+	}
     }
   return 0;
 }
@@ -221,7 +259,7 @@ BnId::operator[](const size_t A) const
   if (A>=size)
     throw ColErr::IndexError<size_t>(A,size,"BnId::operator[]"+
 				     ELog::RegMethod::getFull());
-  return Tval[A];
+  return literal(A);
 }
 
 int 
@@ -246,21 +284,25 @@ BnId::operator++()
     \retval 1 :: no loop occored
   */
 {
-  std::vector<int>::iterator vc;
-  for(vc=Tval.begin();vc!=Tval.end() && (*vc)!=-1;vc++)
+  for(size_t i=0;i<Care.size();i++)
     {
-      if (*vc==1)
+      // care bits that are false 
+      const WORD zeros=Care[i] & ~Value[i];
+      if (zeros)
 	{
-	  Tnum--;
-	  *vc= -1;
+	  const WORD low=zeros & (~zeros+1);     // lowest false
+	  const WORD carry=Care[i] & (low-1);    // true below it
+	  Tnum-=static_cast<size_t>(__builtin_popcountll(carry));
+	  Value[i]&= ~carry;
+	  Value[i]|=low;
+	  Tnum++;
+	  return 1;
 	}
+      // all true in this word : roll over
+      Tnum-=static_cast<size_t>(__builtin_popcountll(Value[i]));
+      Value[i]=0;
     }
-  if (vc==Tval.end())
-    return 0;
-  // Normal exit
-  *vc=1;
-  Tnum++;
-  return 1;
+  return 0;
 }
 
 int 
@@ -285,19 +327,24 @@ BnId::operator--()
     \retval 1 :: no loop occored
   */
 {
-  std::vector<int>::iterator vc;
-  for(vc=Tval.begin();vc!=Tval.end() && (*vc)!=1;vc++)
-    if (*vc== -1)
-      {
-	*vc= 1;
-	Tnum++;
-      }
-  if (vc==Tval.end())       // Loop took place
-    return 0;
-
-  *vc= -1;
-  Tnum--;
-  return 1;
+  for(size_t i=0;i<Care.size();i++)
+    {
+      const WORD ones=Value[i];
+      if (ones)
+	{
+	  const WORD low=ones & (~ones+1);       // lowest true
+	  const WORD borrow=Care[i] & (low-1);   // false below it
+	  Tnum+=static_cast<size_t>(__builtin_popcountll(borrow));
+	  Value[i]|=borrow;
+	  Value[i]&= ~low;
+	  Tnum--;
+	  return 1;
+	}
+      // all false in this word : roll under
+      Value[i]=Care[i];
+      Tnum+=static_cast<size_t>(__builtin_popcountll(Care[i]));
+    }
+  return 0;
 }
 
 void
@@ -342,16 +389,14 @@ BnId::setCounters()
     Sets the counters Tnum and Znum
   */
 {
-  std::vector<int>::const_iterator vc;
   Tnum=0;
-  Znum=0;
-  for(vc=Tval.begin();vc!=Tval.end();vc++)
+  size_t careCnt(0);
+  for(size_t i=0;i<Care.size();i++)
     {
-      if (*vc==1)
-	Tnum++;
-      else if (*vc==0)
-	Znum++;
+      Tnum+=static_cast<size_t>(__builtin_popcountll(Value[i]));
+      careCnt+=static_cast<size_t>(__builtin_popcountll(Care[i]));
     }
+  Znum=size-careCnt;
   return;
 }
 
@@ -363,14 +408,7 @@ BnId::intValue() const
     \returns lowest bit in the BnId vector
   */
 {
-  size_t out(0);
-  std::vector<int>::const_reverse_iterator vc;
-  for(vc=Tval.rbegin();vc!=Tval.rend();vc++)
-    {
-      out<<=1;
-      out+=((*vc)==1) ? 1 : 0;
-    }
-  return out;
+  return (Value.empty()) ? 0 : static_cast<size_t>(Value[0]);
 }
 
 void
@@ -383,13 +421,11 @@ BnId::mapState(const std::vector<int>& Index,
   */ 
 {
   for(size_t i=0;i<Index.size();i++)
-    Base[Index[i]]=(Tval[i]==1) ? 1 : 0;    
+    Base[Index[i]]=(literal(i)==1) ? 1 : 0;    
 
   return;
 }
 
-
-
 std::pair<int,BnId>
 BnId::makeCombination(const BnId& A) const
   /*!
@@ -416,29 +452,27 @@ BnId::makeCombination(const BnId& A) const
   if (Tnum==A.Tnum)
     return std::pair<int,BnId>(0,BnId());
 
-  int flag(0);         // numb of diff
-  std::pair<int,int> Tcnt(0,0);        // this counter 
-  std::pair<int,int> Acnt(0,0);        // A counter 
-  std::vector<int>::const_iterator tvc;
-  std::vector<int>::const_iterator avc=A.Tval.begin();
-  std::vector<int>::const_iterator chpt;   // change point
-  for(tvc=Tval.begin();tvc!=Tval.end();tvc++,avc++)
+  // Must have the same don't care positions and differ in one bit
+  size_t chpt(0);
+  int flag(0);
+  for(size_t i=0;i<Care.size();i++)
     {
-      if ((*avc * *tvc)<0)       // false/true
+      if (Care[i]!=A.Care[i])
+	return std::pair<int,BnId>(0,BnId());
+      const WORD diff=Value[i]^A.Value[i];
+      if (diff)
 	{
-	  if (flag)           // failed
-	    return std::pair<int,BnId>(0,BnId());;
-	  flag=1;  //inc change counter
-	  chpt=tvc;
+	  if (flag || (diff & (diff-1)))
+	    return std::pair<int,BnId>(0,BnId());
+	  flag=1;
+	  chpt=i*WBits+static_cast<size_t>(__builtin_ctzll(diff));
 	}
-      else if (*avc!= *tvc)       // failed on a 0 : value
-	return std::pair<int,BnId>(0,BnId());;
     }
   // Good value
   if (flag)
     {
       BnId PIout(*this);
-      PIout.Tval[static_cast<size_t>(chpt-Tval.begin())]=0;
+      PIout.setLiteral(chpt,0);
       PIout.setCounters();
       PIout.addMinTerm(A);
       return std::pair<int,BnId>(1,PIout);
@@ -447,6 +481,123 @@ BnId::makeCombination(const BnId& A) const
   return std::pair<int,BnId>(0,BnId());
 }
 
+size_t
+BnId::hashValue() const
+  /*!
+    Hash of the tri-state pattern
+    \return hash value
+  */
+{
+  WORD H(14695981039346656037ULL);
+  for(size_t i=0;i<Care.size();i++)
+    {
+      H=(H^Care[i])*1099511628211ULL;
+      H=(H^Value[i])*1099511628211ULL;
+    }
+  return static_cast<size_t>(H ^ (H>>29));
+}
+
+size_t
+BnId::findIndex(const std::vector<std::pair<size_t,size_t> >& HIndex,
+		const std::vector<BnId>& Work) const
+  /*!
+    Find this pattern in a hash index
+    \param HIndex :: sorted (hash,index) pairs of Work
+    \param Work :: Items indexed
+    \return index in Work [ULONG_MAX if not found]
+  */
+{
+  typedef std::vector<std::pair<size_t,size_t> >::const_iterator HITER;
+  const size_t H=hashValue();
+  HITER hc=std::lower_bound(HIndex.begin(),HIndex.end(),
+			    std::pair<size_t,size_t>(H,0));
+  // Counters are not compared : this may be a part modified copy
+  for(;hc!=HIndex.end() && hc->first==H;hc++)
+    if (Work[hc->second].Value==Value && Work[hc->second].Care==Care)
+      return hc->second;
+  return ULONG_MAX;
+}
+
+void
+BnId::primeImplicants(std::vector<BnId>& Work,std::vector<BnId>& PIComp)
+  /*!
+    Quine-McClusky reduction to the prime implicants.
+    Rather than testing all pairs in neighbouring true-count
+    groups, each item looks up its one-bit neighbours
+    in a hash index. Each round is split over threads.
+    \param Work :: Starting items [destroyed]
+    \param PIComp :: Prime implicants [appended]
+  */
+{
+  std::vector<std::pair<size_t,size_t> > HIndex;
+  std::vector<int> PIflag;
+  while(!Work.empty())
+    {
+      std::sort(Work.begin(),Work.end());
+      Work.erase(std::unique(Work.begin(),Work.end()),Work.end());
+
+      const size_t NW(Work.size());
+      HIndex.resize(NW);
+      for(size_t i=0;i<NW;i++)
+	HIndex[i]=std::pair<size_t,size_t>(Work[i].hashValue(),i);
+      std::sort(HIndex.begin(),HIndex.end());
+
+      PIflag.assign(NW,1);
+      std::vector<BnId> Tmod;
+      const long int NWL=static_cast<long int>(NW);
+#ifdef _OPENMP
+#pragma omp parallel if (NW>256)
+#endif
+      {
+	std::vector<BnId> TLocal;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,64)
+#endif
+	for(long int ii=0;ii<NWL;ii++)
+	  {
+	    const size_t i=static_cast<size_t>(ii);
+	    const BnId& Item=Work[i];
+	    BnId Test(Item);
+	    for(size_t bit=0;bit<Item.size;bit++)
+	      {
+		const int TV=Item.literal(bit);
+		if (!TV) continue;
+		Test.setLiteral(bit,-TV);
+		const size_t j=Test.findIndex(HIndex,Work);
+		Test.setLiteral(bit,TV);
+		if (j!=ULONG_MAX)
+		  {
+		    // Only this item writes its own flag
+		    PIflag[i]=0;
+		    // combination made from the lower true count
+		    if (TV<0)
+		      {
+			BnId PIout(Item);
+			PIout.setLiteral(bit,0);
+			PIout.setCounters();
+			PIout.addMinTerm(Work[j]);
+			TLocal.push_back(PIout);
+		      }
+		  }
+	      }
+	  }
+#ifdef _OPENMP
+#pragma omp critical(BnIdPrimeImplicants)
+#endif
+	Tmod.insert(Tmod.end(),TLocal.begin(),TLocal.end());
+      }
+
+      for(size_t i=0;i<NW;i++)
+	if (PIflag[i])
+	  {
+	    Work[i].setPI(1);
+	    PIComp.push_back(Work[i]);
+	  }
+      Work.swap(Tmod);
+    }
+  return;
+}
+
 void
 BnId::reverse() 
   /*!
@@ -454,8 +605,9 @@ BnId::reverse()
     Transform 1 -> -1
   */
 {
-  transform(Tval.begin(),Tval.end(),Tval.begin(),
-	    std::bind2nd(std::multiplies<int>(),-1));
+  for(size_t i=0;i<Care.size();i++)
+    Value[i]= ~Value[i] & Care[i];
+  Tnum=size-Znum-Tnum;
   return;
 }
 
@@ -468,13 +620,13 @@ BnId::display() const
    */
 {
   std::string Out;
-  std::vector<int>::const_reverse_iterator vc;
   std::ostringstream cx;
-  for(vc=Tval.rbegin();vc!=Tval.rend();vc++)
+  for(size_t i=size;i>0;i--)
     {
-      if (*vc==0)
+      const int TV=literal(i-1);
+      if (TV==0)
 	Out+="-";
-      else if (*vc==1)
+      else if (TV==1)
 	Out+="1";
       else
 	Out+="0";
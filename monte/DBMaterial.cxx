@@ -54,6 +54,12 @@
 namespace ModelSupport
 {
 
+/// Per-thread context registry [0 : use process singleton]
+static DBMaterial* contextPtr(0);
+#ifdef _OPENMP
+#pragma omp threadprivate(contextPtr)
+#endif
+
 DBMaterial::DBMaterial() 
   /*!
     Constructor
@@ -70,10 +76,25 @@ DBMaterial::Instance()
     \return DBMaterial object
   */
 {
+  if (contextPtr) return *contextPtr;
   static DBMaterial DObj;
   return DObj;
 }
 
+DBMaterial*
+DBMaterial::setContext(DBMaterial* CPtr)
+  /*!
+    Bind the calling thread to a BuildContext registry.
+    Instance() returns CPtr until reset with a null pointer.
+    \param CPtr :: Registry to use [0 for the process singleton]
+    \return previous registry [or 0]
+  */
+{
+  DBMaterial* prevPtr=contextPtr;
+  contextPtr=CPtr;
+  return prevPtr;
+}
+
 void
 DBMaterial::checkNameIndex(const int MIndex,const std::string& MName) const
   /*!
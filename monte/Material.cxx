@@ -45,6 +45,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "regexSupport.h"
+#include "RefCon.h"
 #include "Element.h"
 #include "Zaid.h"
 #include "MXcards.h"
@@ -431,6 +432,36 @@ Material::calcAtomicDensity()
   return;
 }
 
+double
+Material::getNumberDensity() const
+  /*!
+    Get the atom density. A material defined by
+    mass density [-ve : g/cc] is converted using the 
+    mean atomic mass of the zaid fractions. Zaid fractions
+    are atom fractions [+ve] or mass fractions [-ve].
+    \return atom density [Atom/A^3]
+   */
+{
+  if (atomDensity>=0.0)
+    return atomDensity;
+
+  const Element& EL=Element::Instance();
+  double sumFA(0.0),sumF(0.0);
+  std::vector<Zaid>::const_iterator zc;
+  for(zc=zaidVec.begin();zc!=zaidVec.end();zc++)
+    {
+      const double A=(zc->getIso()) ?
+	static_cast<double>(zc->getIso()) : EL.mass(zc->getZ());
+      if (A<=0.0) continue;
+      // mass fraction to atom fraction
+      const double F=(zc->getDensity()<0.0) ?
+	-zc->getDensity()/A : zc->getDensity();
+      sumF+=F;
+      sumFA+=F*A;
+    }
+  return (sumFA>0.0) ? -atomDensity*RefCon::avogadro*sumF/sumFA : 0.0;
+}
+
 void
 Material::listComponent() const
   /*!
@@ -360,53 +360,11 @@ RuleBinary::group()
 {
   if (DNFobj.empty())   // no work to do return.
     return 0;
-  // Note: need to store PI components separately
+  // Note: PI components are stored separately 
   // since we don't want to loop continuously through them
-  std::vector<BnId> Work;       // Working copy
-  std::vector<BnId> Comp;       // Store for PI componends
-  std::vector<BnId> Tmod;       // store modified components
-  int changeCount(0);           // Number change
-  std::vector<BnId>::iterator uend;     // itor to remove unique
-  // Need to make an initial copy.
-  Work=DNFobj;
-  do
-    {
-      sort(Work.begin(),Work.end());
-      uend=unique(Work.begin(),Work.end());
-      Work.erase(uend,Work.end());
-
-      Tmod.clear();                  // erase all at the start
-      //set PI status to 1
-      for_each( Work.begin(),Work.end(),
-		std::bind2nd(std::mem_fun_ref(&BnId::setPI),1) );
-
-      //Collect into pairs
-      std::vector<BnId>::iterator vc;
-      for(vc=Work.begin();vc!=Work.end();vc++)
-	{
-	  std::vector<BnId>::iterator oc=vc+1;
-	  for(oc=vc+1;oc!=Work.end();oc++)
-	    {
-	      std::pair<int,BnId> cVal=vc->makeCombination(*oc);
-	      if (cVal.first<0)  //Diffs >1 
-		break;
-
-	      if (cVal.first==1)   // was complementary
-		{
-		  Tmod.push_back(cVal.second);
-		  oc->setPI(0);         
-		  vc->setPI(0);
-		  changeCount++;       // 1 changed
-		}
-	    }
-	}	
-
-      for(vc=Work.begin();vc!=Work.end();vc++)
-	if (vc->PIstatus()==1)
-	  Comp.push_back(*vc);
-      // Now make unique:
-      Work=Tmod;
-    } while (!Tmod.empty());
+  std::vector<BnId> Work(DNFobj);   // Working copy [destroyed]
+  std::vector<BnId> Comp;           // Store for PI componends
+  BnId::primeImplicants(Work,Comp);
 
   return makeEPI(Comp);
 }
@@ -40,6 +40,7 @@
 #include "NameStack.h"
 #include "RegMethod.h"
 #include "MemStack.h"
+#include "BuildProfile.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "Triple.h"
@@ -590,6 +591,7 @@ Rule::Rule()  : Parent(0)
   ELog::MemStack::Instance().
     addMem("Rule",ELog::RegMethod::getBase(),
 	   reinterpret_cast<size_t>(this));
+  ELog::BuildProfile::Instance().count(ELog::BuildProfile::ruleNode);
 }
 
 Rule::Rule(const Rule&) : 
@@ -602,6 +604,7 @@ Rule::Rule(const Rule&) :
   ELog::MemStack::Instance().
     addMem("Rule",ELog::RegMethod::getBase(),
 	   reinterpret_cast<size_t>(this));
+  ELog::BuildProfile::Instance().count(ELog::BuildProfile::ruleNode);
 }
 
 Rule::Rule(Rule* A) : 
@@ -615,6 +618,7 @@ Rule::Rule(Rule* A) :
  ELog::MemStack::Instance().
     addMem("Rule",ELog::RegMethod::getBase(),
 	   reinterpret_cast<size_t>(this));
+  ELog::BuildProfile::Instance().count(ELog::BuildProfile::ruleNode);
 }
 
 Rule&
@@ -34,24 +34,37 @@
   of -1 (false) 0 (not-important) 1 (true) against
   each of the possible input desisions. It has
   arbiatary length (unlike using a long integer)
-  \todo Could be improved by using a set of 
-  unsigned integers. 
+  
+  The states are packed into 64 bit words as a pair 
+  of masks : Care (bit is -1/1) and Value (bit is 1).
+  Value bits are always zero when the Care bit is zero.
 */
 
 class BnId
 {
  private:
 
+  /// Storage word
+  typedef unsigned long long WORD;
+  /// Bits in a word
+  static const size_t WBits=64;
+
   static int fullOut;       ///< Full output for display
 
   size_t size;              ///< number of variables
   int PI;                   ///< Prime Implicant
   size_t Tnum;                 ///< True number (1 in Tval)
   size_t Znum;                 ///< Zero number (0 in Tval)
-  std::vector<int> Tval;    ///< Truth values
+  std::vector<WORD> Care;   ///< Literal is required (-1/1)
+  std::vector<WORD> Value;  ///< Literal is true
   std::set<int> MinTerm;    ///< Minterms list
 
   void setCounters();    ///< Calculates Tnum and Znum
+  int literal(const size_t) const;
+  void setLiteral(const size_t,const int);
+  size_t hashValue() const;
+  size_t findIndex(const std::vector<std::pair<size_t,size_t> >&,
+		   const std::vector<BnId>&) const;
 
  public:
   
@@ -93,6 +106,8 @@ class BnId
   
   void mapState(const std::vector<int>&,std::map<int,int>&) const;
 
+  static void primeImplicants(std::vector<BnId>&,std::vector<BnId>&);
+
   /// Set output state
   static void setFullDisplay(const int I) { fullOut=I; }
   std::string display() const;           
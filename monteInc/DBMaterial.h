@@ -22,6 +22,8 @@
 #ifndef ModelSupport_DBMaterial_h
 #define ModelSupport_DBMaterial_h
 
+class BuildContext;
+
 namespace scatterSystem
 {
   class neutMaterial;
@@ -57,6 +59,8 @@ class DBMaterial
 
   DBMaterial();
 
+  friend class ::BuildContext;
+
   ///\cond SINGLETON
   DBMaterial(const DBMaterial&);
   DBMaterial& operator=(const DBMaterial&);
@@ -69,6 +73,7 @@ class DBMaterial
  public:
   
   static DBMaterial& Instance();
+  static DBMaterial* setContext(DBMaterial*);
   
   ~DBMaterial() {}  ///< Destructor
   
@@ -98,6 +98,7 @@ class Material
 		 const std::string&);
   /// Get atomic density
   double getAtomDensity() const { return atomDensity; }
+  double getNumberDensity() const;
   void setENDF7();
   void setDensity(const double);
   
@@ -186,6 +186,7 @@ LineTrack::calculate(const Simulation& ASim)
   
   const MonteCarlo::Object* prevOPtr(0);
   int SN(0);
+  size_t nZero(0);                         // zero length steps
   while(OPtr)
     {
       // Note: Need OPPOSITE Sign on exiting surface
@@ -225,7 +226,24 @@ LineTrack::calculate(const Simulation& ASim)
 	    }
 
 	  if (aDist<Geometry::zeroTol)
-	    OPtr=ASim.findCell(nOut.Pos,0);
+	    {
+	      OPtr=ASim.findCell(nOut.Pos,0);
+	      // Where several cells meet on an edge findCell can 
+	      // return a cell the track leaves at once, so the track 
+	      // cycles round the edge with zero length steps. Step a
+	      // short way along the line and count it in that cell.
+	      if (++nZero>4)
+		{
+		  const double step(Geometry::zeroTol*1e3);
+		  nOut.moveForward(step);
+		  nZero=0;
+		  OPtr=ASim.findCell(nOut.Pos,0);
+		  if (OPtr && !updateDistance(OPtr,step))
+		    OPtr=0;
+		}
+	    }
+	  else
+	    nZero=0;
 	}
       else
 	OPtr=0;
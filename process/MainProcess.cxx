@@ -40,6 +40,8 @@
 #include "NameStack.h"
 #include "RegMethod.h"
 #include "OutputLog.h"
+#include "BuildProfile.h"
+#include "CallProfile.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "varList.h"
@@ -223,9 +225,11 @@ createInputs(inputParam& IParam)
   IParam.regItem<Geometry::Vec3D>("MB","meshB");
   IParam.regItem<size_t>("MN","meshNPS",3);
   IParam.regFlag("md5","md5");
+  IParam.regItem<size_t>("mfrac","matFrac",1);
   IParam.regItem<int>("memStack","memStack");
   IParam.regDefItem<int>("n","nps",1,10000);
   IParam.regFlag("p","PHITS");
+  IParam.regItem<std::string>("prof","profile",1);
   IParam.regFlag("Monte","Monte");
   IParam.regDefItem<double>("photon","photon",1,0.001);
 
@@ -234,6 +238,7 @@ createInputs(inputParam& IParam)
   IParam.regDefItem("sdefEnergy","sdefEnergy",1,800.0);
   IParam.regDefItem<std::string>("sdefType","sdefType",1,"");
   IParam.regDefItem<std::string>("physModel","physicsModel",1,"CEM03"); 
+  IParam.regItem<std::string>("regProf","regProfile",1);
   IParam.regDefItem<double>("SA","sdefAngle",1,35.0);
   IParam.regItem<std::string>("SF","sdefFile");
   IParam.regDefItem<int>("SI","sdefIndex",1,1);
@@ -243,6 +248,10 @@ createInputs(inputParam& IParam)
   IParam.regItem<Geometry::Vec3D>("SV","sdefVec");
   IParam.regItem<double>("SZ","sdefZRot");
   IParam.regDefItem<long int>("s","random",1,375642321L);
+  IParam.regMulti<std::string>("scan","scan",4,4);
+  IParam.regItem<std::string>("scanFile","scanFile");
+  IParam.regDefItem<int>("scanLHS","scanLHS",1,0);
+  IParam.regDefItem<int>("scanWork","scanWorkers",1,1);
   // std::vector<std::string> AItems(15);
   // IParam.regDefItemList<std::string>("T","tally",15,AItems);
   IParam.regMulti<std::string>("T","tally",25,0);
@@ -265,6 +274,8 @@ createInputs(inputParam& IParam)
 
   IParam.regItem<double>("w","weight");
   IParam.regItem<Geometry::Vec3D>("WP","weightPt");
+  IParam.regItem<std::string>("WM","weightMesh",1);
+  IParam.regMulti<double>("WSig","weightSigma",20,1);
   IParam.regItem<double>("WTemp","weightTemp",1);
   IParam.regDefItem<std::string>("WType","weightType",1,"basic");
 
@@ -290,19 +301,26 @@ createInputs(inputParam& IParam)
   IParam.setDesc("MB","Upper Point in mesh tally");
   IParam.setDesc("MN","Number of points [3]");
   IParam.setDesc("md5","MD5 track of cells");
+  IParam.setDesc("mfrac","Material fractions of mesh voxels [samples/side]");
   IParam.setDesc("memStack","Memstack verbrosity value");
   IParam.setDesc("n","Number of starting particles");
   IParam.setDesc("p","PHITS output");
+  IParam.setDesc("profile","Build phase profile [file.json / file.csv]");
   IParam.setDesc("Monte","MonteCarlo capable simulation");
   IParam.setDesc("photon","Photon Cut energy");
   IParam.setDesc("r","Renubmer cells");
   IParam.setDesc("s","RND Seed");
+  IParam.setDesc("scan","Scan variable [name low high nPts]");
+  IParam.setDesc("scanFile","File of variants to scan [names/values]");
+  IParam.setDesc("scanLHS","Latin hypercube scan with N variants");
+  IParam.setDesc("scanWork","Number of concurrent scan builds");
   IParam.setDesc("SF","File read source");
   IParam.setDesc("SA","Source Angle [deg]");
   IParam.setDesc("SI","Source Index value [1:2]");
   IParam.setDesc("SObj","Source Initialization Object");
   IParam.setDesc("sdefType","Source Type (TS1/TS2)");
   IParam.setDesc("physModel","Physics Model"); 
+  IParam.setDesc("regProfile","Method call profile [folded stacks file]");
   IParam.setDesc("SP","Source start point");
   IParam.setDesc("SV","Sourece direction vector");
   IParam.setDesc("SZ","Source direction: Rotation to +ve Z [deg]");
@@ -327,6 +345,8 @@ createInputs(inputParam& IParam)
   IParam.setDesc("WType","Initial model for weights [help for info]");
   IParam.setDesc("WTemp","Temperature correction for weights");
   IParam.setDesc("WP","Weight bias Point");
+  IParam.setDesc("WM","Ray traced WWINP file over meshA/meshB/MN");
+  IParam.setDesc("WSig","Removal cross section [barn] per energy group");
 
   IParam.setDesc("x","XML input file");
   IParam.setDesc("X","XML output file");
@@ -706,6 +726,15 @@ createSimulation(inputParam& IParam,
       (static_cast<unsigned int>(IParam.getValue<int>("debug")));
     
   IParam.processMainInput(Names);
+  if (IParam.flag("profile"))
+    ELog::BuildProfile::Instance().
+      activate(IParam.getValue<std::string>("profile"));
+  if (IParam.flag("regProfile"))
+    ELog::CallProfile::Instance().
+      activate(IParam.getValue<std::string>("regProfile"));
+
+  // Opened after the profile is activated
+  ELog::ProfilePhase PSim("createSimulation");
 
   Simulation* SimPtr;
   if (IParam.flag("PHITS"))
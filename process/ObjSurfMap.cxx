@@ -62,6 +62,101 @@
 namespace ModelSupport
 {
 
+/// Crossing hint of a signed surface
+struct surfHint
+{
+  size_t MRU;                         ///< Index of the last object found
+  std::vector<int> Hit;               ///< Object has a crossing box
+  std::vector<Geometry::Vec3D> Low;   ///< Low corner of the crossings
+  std::vector<Geometry::Vec3D> High;  ///< High corner of the crossings
+};
+
+/// Crossing hints of one thread
+struct threadHint
+{
+  size_t stamp;                       ///< Stamp of the map of the hints
+  std::map<int,surfHint> HMap;        ///< Signed surface : hint
+};
+
+/// Last stamp given to a map
+static size_t stampCount(0);
+/// Hints of all the threads [deleted at exit]
+static std::vector<boost::shared_ptr<threadHint> > hintStore;
+/// Hints of this thread [0 : not yet assigned]
+static threadHint* threadHintPtr(0);
+#ifdef _OPENMP
+#pragma omp threadprivate(threadHintPtr)
+#endif
+
+static threadHint&
+getThreadHint()
+  /*!
+    Access the hints of the calling thread
+    \return thread hints
+  */
+{
+  if (!threadHintPtr)
+    {
+#ifdef _OPENMP
+#pragma omp critical(ObjSurfMapHint)
+#endif
+      {
+	hintStore.push_back(boost::shared_ptr<threadHint>(new threadHint));
+	threadHintPtr=hintStore.back().get();
+	threadHintPtr->stamp=0;
+      }
+    }
+  return *threadHintPtr;
+}
+
+static bool
+inHintBox(const surfHint& SH,const size_t index,
+	  const Geometry::Vec3D& Pos)
+  /*!
+    Determine if a point is within the crossing box of an object
+    \param SH :: Surface hint
+    \param index :: Object index
+    \param Pos :: Point on the surface
+    \return true if within the box
+  */
+{
+  if (!SH.Hit[index])
+    return 0;
+  const Geometry::Vec3D& LV=SH.Low[index];
+  const Geometry::Vec3D& HV=SH.High[index];
+  for(size_t i=0;i<3;i++)
+    if (Pos[i]<LV[i]-Geometry::zeroTol || Pos[i]>HV[i]+Geometry::zeroTol)
+      return 0;
+  return 1;
+}
+
+static void
+addHint(surfHint& SH,const size_t index,const Geometry::Vec3D& Pos)
+  /*!
+    Add a crossing to the hint of a surface
+    \param SH :: Surface hint
+    \param index :: Object index found
+    \param Pos :: Point on the surface
+  */
+{
+  SH.MRU=index;
+  Geometry::Vec3D& LV=SH.Low[index];
+  Geometry::Vec3D& HV=SH.High[index];
+  if (!SH.Hit[index])
+    {
+      SH.Hit[index]=1;
+      LV=Pos;
+      HV=Pos;
+      return;
+    }
+  for(size_t i=0;i<3;i++)
+    {
+      LV[i]=std::min(LV[i],Pos[i]);
+      HV[i]=std::max(HV[i],Pos[i]);
+    }
+  return;
+}
+
 void
 ObjSurfMap::removeEqualSurf(const std::map<int,Geometry::Surface*>& EQMap,
 			    std::map<int,MonteCarlo::Qhull*>& OMap)
@@ -85,14 +180,17 @@ ObjSurfMap::removeEqualSurf(const std::map<int,Geometry::Surface*>& EQMap,
   return;
 }
 
-ObjSurfMap::ObjSurfMap() 
+ObjSurfMap::ObjSurfMap() :
+  mapStamp(0)
  /*! 
    Constructor 
  */
-{}
+{
+  newStamp();
+}
 
 ObjSurfMap::ObjSurfMap(const ObjSurfMap& A) :
-  SMap(A.SMap)
+  SMap(A.SMap),mapStamp(A.mapStamp)
   /*! 
     Copy Constructor 
     \param A :: ObjSurfMap to copy
@@ -111,10 +209,27 @@ ObjSurfMap::operator=(const ObjSurfMap& A)
   if (this!=&A)
     {
       SMap=A.SMap;
+      mapStamp=A.mapStamp;
     }
   return *this;
 }
 
+void
+ObjSurfMap::newStamp()
+  /*!
+    Give the map a new stamp : the thread hints 
+    of the old stamp are no longer used
+  */
+{
+#ifdef _OPENMP
+#pragma omp critical(ObjSurfMapHint)
+#endif
+  {
+    mapStamp=++stampCount;
+  }
+  return;
+}
+
 void
 ObjSurfMap::clearAll()
   /*!
@@ -122,6 +237,7 @@ ObjSurfMap::clearAll()
   */
 {
   SMap.erase(SMap.begin(),SMap.end());
+  newStamp();
   return;
 }
 
@@ -201,13 +317,17 @@ ObjSurfMap::addSurface(const int SurfN,MonteCarlo::Object* OPtr)
 	find_if(VItem.begin(),VItem.end(),
 		boost::bind(std::equal_to<MonteCarlo::Object*>(),_1,OPtr));
       if (vc==VItem.end())
-	mc->second.push_back(OPtr);
+	{
+	  mc->second.push_back(OPtr);
+	  newStamp();
+	}
     }
   else   // 
     {
       std::pair<OMTYPE::iterator,bool> PIter=
 	SMap.insert(OMTYPE::value_type(SurfN,STYPE()));
       PIter.first->second.push_back(OPtr);
+      newStamp();
     }
   return;
 }
@@ -217,7 +337,12 @@ ObjSurfMap::findNextObject(const int SN,
 			   const Geometry::Vec3D& Pos,
 			   const int objExclude) const
   /*!
-    Calculate the next object 
+    Calculate the next object. The object last found on
+    the signed surface is tested first, then the objects
+    with a crossing box round the point and then the rest.
+    If objects overlap at the point [several valid] the
+    object returned depends on the hints of the thread and
+    is not always the first in map order.
     \param SN :: Surface number
     \param Pos :: position
     \param ObjExclude :: Excluded object
@@ -230,11 +355,52 @@ ObjSurfMap::findNextObject(const int SN,
   const STYPE& MVec=getObjects(SN);
   STYPE::const_iterator mc;
 
-  for(mc=MVec.begin();mc!=MVec.end();mc++)
+  const size_t NV(MVec.size());
+  if (NV>2)
+    {
+      threadHint& TH=getThreadHint();
+      if (TH.stamp!=mapStamp)
+	{
+	  TH.HMap.clear();
+	  TH.stamp=mapStamp;
+	}
+      surfHint& SH=TH.HMap[SN];
+      if (SH.Hit.size()!=NV)
+	{
+	  SH.MRU=0;
+	  SH.Hit=std::vector<int>(NV,0);
+	  SH.Low.resize(NV);
+	  SH.High.resize(NV);
+	}
+
+      const size_t mru(SH.MRU);
+      if (MVec[mru]->getName()!=objExclude &&
+	  MVec[mru]->isDirectionValid(Pos,SN))
+	{
+	  addHint(SH,mru,Pos);
+	  return MVec[mru];
+	}
+      // pass 0 : in crossing box / pass 1 : rest
+      for(int pass=0;pass<2;pass++)
+	for(size_t i=0;i<NV;i++)
+	  {
+	    if (i!=mru && inHintBox(SH,i,Pos)==(pass==0) &&
+		MVec[i]->getName()!=objExclude && 
+		MVec[i]->isDirectionValid(Pos,SN))
+	      {
+		addHint(SH,i,Pos);
+		return MVec[i];
+	      }
+	  }
+    }
+  else
     {
-      if ((*mc)->getName()!=objExclude && 
-	  (*mc)->isDirectionValid(Pos,SN))
-	return *mc;
+      for(mc=MVec.begin();mc!=MVec.end();mc++)
+	{
+	  if ((*mc)->getName()!=objExclude && 
+	      (*mc)->isDirectionValid(Pos,SN))
+	    return *mc;
+	}
     }
   
   // DEBUG CODE FOR FAILURE:
@@ -295,6 +461,7 @@ ObjSurfMap::removeReverseSurf(const int primSurf,const int revSurf)
 	    addSurface(-sign_index*primSurf,*oc);
 	  // Now remove item list
 	  SMap.erase(ac);
+	  newStamp();
 	}
     }
   return;
@@ -32,6 +32,7 @@
 #include <string>
 #include <algorithm>
 #include <boost/format.hpp>
+#include <boost/unordered_map.hpp>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -51,13 +52,20 @@
 #include "TwinComp.h"
 #include "ContainedComp.h"
 #include "ContainedGroup.h"
+#include "regionIndex.h"
 #include "objectRegister.h"
 
 namespace ModelSupport
 {
 
+/// Per-thread context registry [0 : use process singleton]
+static objectRegister* contextPtr(0);
+#ifdef _OPENMP
+#pragma omp threadprivate(contextPtr)
+#endif
+
 objectRegister::objectRegister() : 
-  cellNumber(1000000)
+  cellNumber(1000000),RIPtr(new regionIndex)
   /*!
     Constructor
   */
@@ -67,7 +75,9 @@ objectRegister::~objectRegister()
   /*!
     Destructor
   */
-{}
+{
+  delete RIPtr;
+}
 
 void
 objectRegister::reset()
@@ -85,10 +95,25 @@ objectRegister::Instance()
     \return objectRegister object
   */
 {
+  if (contextPtr) return *contextPtr;
   static objectRegister A;
   return A;
 }
 
+objectRegister*
+objectRegister::setContext(objectRegister* CPtr)
+  /*!
+    Bind the calling thread to a BuildContext registry.
+    Instance() returns CPtr until reset with a null pointer.
+    \param CPtr :: Registry to use [0 for the process singleton]
+    \return previous registry [or 0]
+  */
+{
+  objectRegister* prevPtr=contextPtr;
+  contextPtr=CPtr;
+  return prevPtr;
+}
+
 int
 objectRegister::getCell(const std::string& Name,const int Index) const
   /*!
@@ -98,18 +123,16 @@ objectRegister::getCell(const std::string& Name,const int Index) const
     \return Cell number
   */
 {
-  MTYPE::const_iterator mc;
+  const std::pair<int,int>* IPtr;
   if (Index>=0)
     {
       std::ostringstream cx;
       cx<<Name<<Index;
-      mc=regionMap.find(cx.str());
+      IPtr=RIPtr->find(cx.str());
     }
   else
-    mc=regionMap.find(Name);
-  if (mc!=regionMap.end())
-    return mc->second.first;
-  return 0;
+    IPtr=RIPtr->find(Name);
+  return (IPtr) ? IPtr->first : 0;
 }
 
 int
@@ -121,49 +144,27 @@ objectRegister::getRange(const std::string& Name,const int Index) const
     \return Range
    */
 {
-  MTYPE::const_iterator mc;
+  const std::pair<int,int>* IPtr;
   if (Index>=0)
     {
       std::ostringstream cx;
       cx<<Name<<Index;
-      mc=regionMap.find(cx.str());
+      IPtr=RIPtr->find(cx.str());
     }
   else
-    mc=regionMap.find(Name);
-  if (mc!=regionMap.end())
-    return mc->second.second;
-  return 0;
+    IPtr=RIPtr->find(Name);
+  return (IPtr) ? IPtr->second : 0;
 }
 
 std::string
 objectRegister::inRange(const int Index) const
   /*!
-    Get the range of an object
-    \param Name :: Name of the object to get
-    \param Index :: Offset number
-    \return string
+    Get the name of the object that holds a cell
+    \param Index :: Cell number
+    \return object name [empty if not registered]
    */
 {
-  static std::string prev;
-  
-  MTYPE::const_iterator mc;
-  mc=regionMap.find(prev);
-
-  if (mc!=regionMap.end() && 
-      Index>=mc->second.first && 
-      Index<=mc->second.first+mc->second.second)
-    return mc->first;
-    
-  for(mc=regionMap.begin();mc!=regionMap.end();mc++)
-    {
-      const std::pair<int,int>& IP=mc->second;
-      if (Index>=IP.first && Index<=IP.first+IP.second)
-	{
-	  prev=mc->first;
-	  return mc->first;
-	}
-    }
-  return std::string("");
+  return RIPtr->inRange(Index);
 }
 
 int
@@ -183,19 +184,43 @@ objectRegister::cell(const std::string& Name,const int Index,const int size)
   if (Index>=0)
     cx<<Index;
 
-  MTYPE::const_iterator mc=regionMap.find(cx.str());  
-  if (mc!=regionMap.end())
+  const std::pair<int,int>* IPtr=RIPtr->find(cx.str());
+  if (IPtr)
     {
-      if (mc->second.second<size)
+      if (IPtr->second<size)
 	ELog::EM<<"Insufficient space reserved for "<<cx.str()<<ELog::endErr;
-      return mc->second.first;
+      return IPtr->first;
     }
-  regionMap.insert(MTYPE::value_type(cx.str(),
-				     std::pair<int,int>(cellNumber,size)));
+  RIPtr->insert(cx.str(),cellNumber,size);
   cellNumber+=size;
   return cellNumber-size;
 }
 
+void
+objectRegister::removeCell(const std::string& Name,const int Index)
+  /*!
+    Remove a cell range. If it is the last range reserved
+    the cell number is returned to the start of the range.
+    \param Name :: Name of the unit
+    \param Index :: Index on number [-ve not used]
+  */
+{
+  ELog::RegMethod RegA("objectRegister","removeCell");
+
+  std::ostringstream cx;
+  cx<<Name;
+  if (Index>=0)
+    cx<<Index;
+
+  const std::pair<int,int>* IPtr=RIPtr->find(cx.str());
+  if (!IPtr)
+    throw ColErr::InContainerError<std::string>(cx.str(),"Cell range");
+  if (IPtr->first+IPtr->second==cellNumber)
+    cellNumber=IPtr->first;
+  RIPtr->erase(cx.str());
+  return;
+}
+
 void
 objectRegister::addObject(const CTYPE& Ptr)
   /*! 
@@ -230,7 +255,7 @@ objectRegister::addObject(const std::string& Name,
 {
   ELog::RegMethod RegA("objectRegister","addObject");
   // First check that we have it in Register:
-  if (regionMap.find(Name)==regionMap.end())
+  if (!RIPtr->find(Name))
     throw ColErr::InContainerError<std::string>(Name,"regionMap empty");
   // Does it exist:
   if (Components.find(Name)!=Components.end())
@@ -310,6 +335,10 @@ objectRegister::write(const std::string& OFile) const
       std::ofstream OX(OFile.c_str());
 
       boost::format FMT("%s%|30t|%d    ::     %d %|20t|(%s)");
+      // sorted output
+      typedef std::map<std::string,std::pair<int,int> > MTYPE;
+      const MTYPE regionMap(RIPtr->getNameMap().begin(),
+			    RIPtr->getNameMap().end());
       MTYPE::const_iterator mc;
       for(mc=regionMap.begin();mc!=regionMap.end();mc++)
 	{
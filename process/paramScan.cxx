@@ -0,0 +1,545 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   process/paramScan.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <map>
+#include <list>
+#include <set>
+#include <string>
+#include <algorithm>
+#include <cerrno>
+#include <boost/array.hpp>
+#include <boost/shared_ptr.hpp>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "MersenneTwister.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "inputParam.h"
+#include "Triple.h"
+#include "NList.h"
+#include "NRange.h"
+#include "Rules.h"
+#include "Code.h"
+#include "FItem.h"
+#include "varList.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "ModeCard.h"
+#include "PhysCard.h"
+#include "PhysImp.h"
+#include "LSwitchCard.h"
+#include "KGroup.h"
+#include "Source.h"
+#include "KCode.h"
+#include "PhysicsCards.h"
+#include "Simulation.h"
+#include "paramScan.h"
+
+namespace mainSystem
+{
+
+paramScan::paramScan() :
+  nWorker(1)
+  /*!
+    Constructor
+  */
+{}
+
+paramScan::paramScan(const paramScan& A) :
+  nWorker(A.nWorker),Ranges(A.Ranges),VarNames(A.VarNames),
+  Variants(A.Variants),Done(A.Done)
+  /*!
+    Copy constructor
+    \param A :: paramScan to copy
+  */
+{}
+
+paramScan&
+paramScan::operator=(const paramScan& A)
+  /*!
+    Assignment operator
+    \param A :: paramScan to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      nWorker=A.nWorker;
+      Ranges=A.Ranges;
+      VarNames=A.VarNames;
+      Variants=A.Variants;
+      Done=A.Done;
+    }
+  return *this;
+}
+
+paramScan::~paramScan()
+  /*!
+    Destructor
+  */
+{}
+
+double
+paramScan::wallTime()
+  /*!
+    Wall clock time
+    \return time [s]
+  */
+{
+  struct timeval TV;
+  gettimeofday(&TV,0);
+  return static_cast<double>(TV.tv_sec)+
+    1e-6*static_cast<double>(TV.tv_usec);
+}
+
+int
+paramScan::fileExists(const std::string& FName)
+  /*!
+    Determine if a file exists
+    \param FName :: File name
+    \return 1 if present
+  */
+{
+  struct stat SBuf;
+  return (!FName.empty() && stat(FName.c_str(),&SBuf)==0) ? 1 : 0;
+}
+
+const std::vector<double>&
+paramScan::getVariant(const size_t Index) const
+  /*!
+    Access a variant
+    \param Index :: Variant index
+    \return values [by getVarNames]
+  */
+{
+  if (Index>=Variants.size())
+    throw ColErr::IndexError<size_t>(Index,Variants.size(),
+				     "paramScan::getVariant");
+  return Variants[Index];
+}
+
+void
+paramScan::addRange(const std::string& Name,const double LowV,
+		    const double HighV,const size_t NP)
+  /*!
+    Add a variable to scan
+    \param Name :: Variable name
+    \param LowV :: Low value
+    \param HighV :: High value
+    \param NP :: Number of points [1 : LowV only]
+  */
+{
+  scanRange SR;
+  SR.name=Name;
+  SR.low=LowV;
+  SR.high=HighV;
+  SR.nPts=(NP) ? NP : 1;
+  Ranges.push_back(SR);
+  return;
+}
+
+void
+paramScan::makeGrid()
+  /*!
+    Create the variants as the full grid of the ranges
+  */
+{
+  ELog::RegMethod RegA("paramScan","makeGrid");
+
+  VarNames.clear();
+  Variants.clear();
+  if (Ranges.empty()) return;
+
+  size_t NTotal(1);
+  std::vector<scanRange>::const_iterator rc;
+  for(rc=Ranges.begin();rc!=Ranges.end();rc++)
+    {
+      VarNames.push_back(rc->name);
+      NTotal*=rc->nPts;
+    }
+
+  for(size_t i=0;i<NTotal;i++)
+    {
+      std::vector<double> Values;
+      size_t index(i);
+      for(rc=Ranges.begin();rc!=Ranges.end();rc++)
+	{
+	  const size_t step(index % rc->nPts);
+	  index/=rc->nPts;
+	  const double frac=(rc->nPts>1) ?
+	    static_cast<double>(step)/static_cast<double>(rc->nPts-1) : 0.0;
+	  Values.push_back(rc->low+frac*(rc->high-rc->low));
+	}
+      Variants.push_back(Values);
+    }
+  return;
+}
+
+void
+paramScan::makeLatin(const size_t NSample,MTRand& RNG)
+  /*!
+    Create the variants as a Latin hypercube sample
+    of the ranges. Each range is split into NSample
+    strata and every stratum is used once per variable.
+    \param NSample :: Number of variants
+    \param RNG :: Random number generator
+  */
+{
+  ELog::RegMethod RegA("paramScan","makeLatin");
+
+  VarNames.clear();
+  Variants.clear();
+  if (Ranges.empty() || !NSample) return;
+
+  Variants.resize(NSample,std::vector<double>(Ranges.size()));
+  std::vector<size_t> Strata(NSample);
+  for(size_t j=0;j<Ranges.size();j++)
+    {
+      const scanRange& SR(Ranges[j]);
+      VarNames.push_back(SR.name);
+      for(size_t i=0;i<NSample;i++)
+	Strata[i]=i;
+      // Fisher-Yates shuffle of the strata
+      for(size_t i=NSample-1;i>0;i--)
+	{
+	  const size_t k=RNG.randInt(static_cast<MTRand::uint32>(i));
+	  std::swap(Strata[i],Strata[k]);
+	}
+      const double step=(SR.high-SR.low)/static_cast<double>(NSample);
+      for(size_t i=0;i<NSample;i++)
+	Variants[i][j]=SR.low+step*
+	  (static_cast<double>(Strata[i])+RNG.randExc());
+    }
+  return;
+}
+
+void
+paramScan::readVariants(const std::string& FName)
+  /*!
+    Read the variants from a file. The first line
+    is the variable names; each following line is one
+    variant. Lines starting with # are comments.
+    \param FName :: File name
+  */
+{
+  ELog::RegMethod RegA("paramScan","readVariants");
+
+  std::ifstream IX(FName.c_str());
+  if (!IX.good())
+    throw ColErr::FileError(0,FName,RegA.getBase());
+
+  VarNames.clear();
+  Variants.clear();
+  std::string Line;
+  while(std::getline(IX,Line))
+    {
+      const std::string::size_type pos=Line.find('#');
+      if (pos!=std::string::npos)
+	Line.erase(pos);
+      std::string Item;
+      if (VarNames.empty())
+	{
+	  while(StrFunc::section(Line,Item))
+	    VarNames.push_back(Item);
+	  continue;
+	}
+      std::vector<double> Values;
+      double V;
+      while(StrFunc::section(Line,V))
+	Values.push_back(V);
+      if (Values.empty()) continue;
+      if (Values.size()!=VarNames.size() || !StrFunc::isEmpty(Line))
+	throw ColErr::InvalidLine(Line,FName+" : variant line");
+      Variants.push_back(Values);
+    }
+  return;
+}
+
+void
+paramScan::writeVariants(const std::string& FName) const
+  /*!
+    Write the variants in the form read by readVariants
+    [e.g. to rerun a Latin hypercube sample]
+    \param FName :: File name
+  */
+{
+  ELog::RegMethod RegA("paramScan","writeVariants");
+
+  std::ofstream OX(FName.c_str());
+  if (!OX.good())
+    throw ColErr::FileError(0,FName,RegA.getBase());
+
+  for(size_t j=0;j<VarNames.size();j++)
+    OX<<((j) ? " " : "")<<VarNames[j];
+  OX<<std::endl;
+  OX.precision(17);
+  for(size_t i=0;i<Variants.size();i++)
+    {
+      for(size_t j=0;j<VarNames.size();j++)
+	OX<<((j) ? " " : "")<<Variants[i][j];
+      OX<<std::endl;
+    }
+  return;
+}
+
+void
+paramScan::readManifest(const std::string& FName)
+  /*!
+    Read a manifest from a previous scan. Successful
+    builds are registered by hash so they can be skipped.
+    A missing file is not an error.
+    \param FName :: File name
+  */
+{
+  ELog::RegMethod RegA("paramScan","readManifest");
+
+  std::ifstream IX(FName.c_str());
+  std::string Line;
+  while(IX.good() && std::getline(IX,Line))
+    {
+      std::string Deck,Hash;
+      double Time;
+      int status;
+      if (!Line.empty() && Line[0]!='#' &&
+	  StrFunc::section(Line,Deck) &&
+	  StrFunc::section(Line,Hash) &&
+	  StrFunc::section(Line,Time) &&
+	  StrFunc::section(Line,status) && !status)
+	Done[Hash]=Deck;
+    }
+  return;
+}
+
+void
+paramScan::setVariant(FuncDataBase& Control,const size_t Index) const
+  /*!
+    Set the variables of a variant
+    \param Control :: DataBase to set
+    \param Index :: Variant index
+  */
+{
+  ELog::RegMethod RegA("paramScan","setVariant");
+
+  for(size_t i=0;i<VarNames.size();i++)
+    {
+      if (!Control.hasVariable(VarNames[i]))
+	{
+	  ELog::EM<<"Failure to find variable name "
+		  <<VarNames[i]<<ELog::endCrit;
+	  throw ColErr::ExitAbort(VarNames[i]+" not found");
+	}
+      Control.setVariable(VarNames[i],Variants[Index][i]);
+    }
+  return;
+}
+
+int
+paramScan::run(Simulation& System,inputParam& IParam,
+	       const std::string& OName,buildFunc BFunc,
+	       const std::string& Manifest)
+  /*!
+    Build all the variants. The deck of a variant is
+    written to OName+"S"+hash+".x" so a deck is never
+    overwritten by a different variant. The manifest is
+    rewritten with one line per variant:
+    deck hash time[s] status values
+    \param System :: Simulation [in its pre-build state]
+    \param IParam :: Input parameters
+    \param OName :: Output stub name
+    \param BFunc :: Function to build and write a deck
+    \param Manifest :: Manifest file
+    \return number of failed builds
+  */
+{
+  ELog::RegMethod RegA("paramScan","run");
+
+  FuncDataBase& Control=System.getDataBase();
+  const size_t NV(Variants.size());
+  std::vector<std::string> Decks(NV);
+  std::vector<std::string> Hash(NV);
+  std::vector<double> Time(NV,0.0);
+  std::vector<int> Status(NV,0);
+
+  // pid : variant index / start time
+  std::map<pid_t,std::pair<size_t,double> > Running;
+  int nFail(0);
+  for(size_t i=0;i<=NV;i++)
+    {
+      // Wait for a worker slot (or for all at the end)
+      while(!Running.empty() && (i==NV || Running.size()>=nWorker))
+	{
+	  int wStatus(0);
+	  const pid_t pid=waitpid(-1,&wStatus,0);
+	  if (pid<0)
+	    {
+	      if (errno==EINTR) continue;
+	      // No children left to wait for : workers are lost
+	      std::map<pid_t,std::pair<size_t,double> >::const_iterator lc;
+	      for(lc=Running.begin();lc!=Running.end();lc++)
+		{
+		  Status[lc->second.first]=-1;
+		  nFail++;
+		}
+	      ELog::EM<<"Lost "<<Running.size()<<" workers"<<ELog::endErr;
+	      Running.clear();
+	      break;
+	    }
+	  // Not one of the workers
+	  std::map<pid_t,std::pair<size_t,double> >::iterator
+	    mc=Running.find(pid);
+	  if (mc==Running.end())
+	    continue;
+	  const size_t index=mc->second.first;
+	  Time[index]=wallTime()-mc->second.second;
+	  Status[index]=(WIFEXITED(wStatus)) ? WEXITSTATUS(wStatus) : -1;
+	  if (Status[index]) nFail++;
+	  Running.erase(mc);
+	}
+      if (i==NV) break;
+
+      setVariant(Control,i);
+      Hash[i]=Control.variableHash();
+      Decks[i]=OName+"S"+Hash[i]+".x";
+
+      std::map<std::string,std::string>::const_iterator dc=
+	Done.find(Hash[i]);
+      if (dc!=Done.end() && fileExists(dc->second))
+	{
+	  ELog::EM<<"Variant "<<i+1<<" unchanged : "
+		  <<dc->second<<ELog::endDiag;
+	  Decks[i]=dc->second;
+	  continue;
+	}
+
+      const double startTime=wallTime();
+      const pid_t pid=fork();
+      if (pid==0)
+	{
+	  int flag(-1);
+	  try
+	    {
+	      flag=BFunc(System,IParam,Decks[i]);
+	    }
+	  catch (ColErr::ExBase& A)
+	    {
+	      ELog::EM<<"EXCEPTION FAILURE :: "<<A.what()<<ELog::endCrit;
+	    }
+	  catch (ColErr::ExitAbort& EA)
+	    {
+	      ELog::EM<<"Exiting from "<<EA.what()<<ELog::endCrit;
+	    }
+	  // Nothing may unwind into the code of the parent
+	  catch (...)
+	    {
+	      ELog::EM<<"Unknown exception in variant "<<i+1<<ELog::endCrit;
+	    }
+	  std::cout.flush();
+	  _exit((flag) ? 1 : 0);
+	}
+      if (pid<0)
+	throw ColErr::ExitAbort("fork failure");
+      Running.insert(std::pair<pid_t,std::pair<size_t,double> >
+		     (pid,std::pair<size_t,double>(i,startTime)));
+    }
+
+  std::ofstream OX(Manifest.c_str());
+  OX<<"# deck hash time status";
+  for(size_t j=0;j<VarNames.size();j++)
+    OX<<" "<<VarNames[j];
+  OX<<std::endl;
+  for(size_t i=0;i<NV;i++)
+    {
+      OX<<Decks[i]<<" "<<Hash[i]<<" "<<Time[i]<<" "<<Status[i];
+      for(size_t j=0;j<VarNames.size();j++)
+	OX<<" "<<Variants[i][j];
+      OX<<std::endl;
+      if (!Status[i])
+	Done[Hash[i]]=Decks[i];
+    }
+  return nFail;
+}
+
+int
+createScan(paramScan& PS,const inputParam& IParam,MTRand& RNG)
+  /*!
+    Set up a scan from the input parameters
+    (scan/scanFile/scanLHS/scanWorkers)
+    \param PS :: Scan to set
+    \param IParam :: Input parameters
+    \param RNG :: Random number generator [for Latin hypercube]
+    \return 1 if a scan is to be run
+  */
+{
+  ELog::RegMethod RegA("paramScan","createScan");
+
+  PS.setWorkers(static_cast<size_t>(IParam.getValue<int>("scanWorkers")));
+  if (IParam.flag("scanFile"))
+    {
+      PS.readVariants(IParam.getValue<std::string>("scanFile"));
+      return (PS.nVariants()) ? 1 : 0;
+    }
+
+  const size_t NGrp=IParam.grpCnt("scan");
+  for(size_t i=0;i<NGrp;i++)
+    {
+      const std::string Name=
+	IParam.getCompValue<std::string>("scan",i,0);
+      double LowV,HighV;
+      int NP;
+      if (!StrFunc::convert(IParam.getCompValue<std::string>("scan",i,1),LowV) ||
+	  !StrFunc::convert(IParam.getCompValue<std::string>("scan",i,2),HighV) ||
+	  !StrFunc::convert(IParam.getCompValue<std::string>("scan",i,3),NP) ||
+	  NP<1)
+	throw ColErr::InvalidLine(Name,"scan : name low high nPts");
+      PS.addRange(Name,LowV,HighV,static_cast<size_t>(NP));
+    }
+  const int NLatin=IParam.getValue<int>("scanLHS");
+  if (NLatin>0)
+    PS.makeLatin(static_cast<size_t>(NLatin),RNG);
+  else
+    PS.makeGrid();
+  return (PS.nVariants()) ? 1 : 0;
+}
+
+} // NAMESPACE mainSystem
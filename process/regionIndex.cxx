@@ -0,0 +1,131 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   process/regionIndex.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <boost/unordered_map.hpp>
+
+#include "Exception.h"
+#include "regionIndex.h"
+
+namespace ModelSupport
+{
+
+regionIndex::regionIndex()
+  /*!
+    Constructor
+  */
+{}
+
+regionIndex::~regionIndex()
+  /*!
+    Destructor
+  */
+{}
+
+const std::pair<int,int>*
+regionIndex::find(const std::string& Name) const
+  /*!
+    Find a block by name
+    \param Name :: Name of the block
+    \return start/size pair [0 if not found]
+  */
+{
+  NTYPE::const_iterator mc=NameMap.find(Name);
+  return (mc!=NameMap.end()) ? &mc->second : 0;
+}
+
+void
+regionIndex::insert(const std::string& Name,const int startCell,
+		    const int blockSize)
+  /*!
+    Add a new block. The blocks are normally registered in
+    increasing cell order so the sorted insert is a push_back.
+    \param Name :: Name of block
+    \param startCell :: First cell number
+    \param blockSize :: Number of cells reserved
+  */
+{
+  std::pair<NTYPE::iterator,bool> IP=
+    NameMap.insert(NTYPE::value_type(Name,std::pair<int,int>
+				     (startCell,blockSize)));
+  if (!IP.second)
+    throw ColErr::InContainerError<std::string>(Name,"regionIndex::insert");
+
+  rangeUnit RU;
+  RU.start=startCell;
+  RU.size=blockSize;
+  RU.namePtr=&IP.first->first;      // node based : stable on rehash
+
+  std::vector<rangeUnit>::iterator vc=
+    std::upper_bound(Ranges.begin(),Ranges.end(),startCell,
+		     &regionIndex::startLess);
+  Ranges.insert(vc,RU);
+  return;
+}
+
+void
+regionIndex::erase(const std::string& Name)
+  /*!
+    Remove a block
+    \param Name :: Name of block
+  */
+{
+  NTYPE::iterator mc=NameMap.find(Name);
+  if (mc==NameMap.end())
+    throw ColErr::InContainerError<std::string>(Name,"regionIndex::erase");
+
+  std::vector<rangeUnit>::iterator vc;
+  for(vc=Ranges.begin();vc!=Ranges.end() && vc->namePtr!=&mc->first;vc++) ;
+  if (vc!=Ranges.end())
+    Ranges.erase(vc);
+  NameMap.erase(mc);
+  return;
+}
+
+std::string
+regionIndex::inRange(const int Index) const
+  /*!
+    Find the block holding a cell. The last block starting
+    at or below Index is tested, so on a shared boundary the
+    block that starts at Index wins.
+    \param Index :: Cell number
+    \return block name [empty if none]
+  */
+{
+  std::vector<rangeUnit>::const_iterator vc=
+    std::upper_bound(Ranges.begin(),Ranges.end(),Index,
+		     &regionIndex::startLess);
+  if (vc==Ranges.begin())
+    return std::string("");
+  vc--;
+  return (Index<=vc->start+vc->size) ?
+    *(vc->namePtr) : std::string("");
+}
+
+} // NAMESPACE ModelSupport
@@ -52,6 +52,7 @@
 #include "RegMethod.h"
 #include "GTKreport.h"
 #include "OutputLog.h"
+#include "BuildProfile.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "MatrixBase.h"
@@ -163,6 +164,8 @@ equalSurface(const Geometry::Surface* SPtr)
 {
   if (!SPtr)
     throw ColErr::EmptyValue<Geometry::Surface*>("equalSurface(const)");
+
+  ELog::BuildProfile::Instance().count(ELog::BuildProfile::equalSurf);
   
   const int Index=
     Geometry::surfaceFactory::Instance().getIndex(SPtr->className());
@@ -185,6 +188,8 @@ equalSurface(Geometry::Surface* SPtr)
 {
   if (!SPtr)
     throw ColErr::EmptyValue<Geometry::Surface*>("equalSurface");
+
+  ELog::BuildProfile::Instance().count(ELog::BuildProfile::equalSurf);
   
   const int Index=
     Geometry::surfaceFactory::Instance().getIndex(SPtr->className());
@@ -235,6 +240,8 @@ equalSurfNum(const Geometry::Surface* SPtr)
 {
   if (!SPtr)
     throw ColErr::EmptyValue<Geometry::Surface*>("equalSurfNum");
+
+  ELog::BuildProfile::Instance().count(ELog::BuildProfile::equalSurf);
   
   const int Index=
     Geometry::surfaceFactory::Instance().getIndex(SPtr->className());
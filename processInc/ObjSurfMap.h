@@ -41,6 +41,14 @@ namespace ModelSupport
   \author S. Ansell
   \date November 2010
   \brief Surface number to Object map
+
+  findNextObject keeps hints for each thread : the last
+  object found on a signed surface and the box of the
+  crossing points of each object on the surface. The
+  hints are reset when the map changes [stamp].
+  In a valid geometry only one object is found at a 
+  crossing. Where objects overlap the object found 
+  follows the hints of the thread : use -validCheck.
 */
 
 class ObjSurfMap
@@ -55,6 +63,9 @@ class ObjSurfMap
  private:
 
   OMTYPE SMap;                    ///< SurfNumber : Object map
+  size_t mapStamp;                ///< Stamp of the map [hint validity]
+
+  void newStamp();
   void addSurface(const int,MonteCarlo::Object*);
 
  public:
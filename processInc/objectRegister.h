@@ -22,6 +22,8 @@
 #ifndef ModelSupport_objectRegister_h
 #define ModelSupport_objectRegister_h
 
+class BuildContext;
+
 namespace attachSystem
 {
   class FixedComp;
@@ -30,6 +32,8 @@ namespace attachSystem
 namespace ModelSupport
 {
 
+class regionIndex;
+
 /*!
   \class objectRegister 
   \version 1.0
@@ -42,18 +46,18 @@ class objectRegister
 {
  private:
  
-  /// Storage type : name : startPt : size 
-  typedef std::map<std::string,std::pair<int,int> > MTYPE;
   /// Storage of component pointers
   typedef boost::shared_ptr<attachSystem::FixedComp> CTYPE;
   /// Index of them
   typedef std::map<std::string,CTYPE > cMapTYPE;
 
   int cellNumber;                  ///< Current new cell number
-  MTYPE regionMap;                 ///< Index of kept object number
+  regionIndex* RIPtr;              ///< Index of kept object number
 
   cMapTYPE Components;             ///< Pointer to real objects
 
+  friend class ::BuildContext;
+
   ///\cond SINGLETON
   objectRegister(const objectRegister&);
   objectRegister& operator=(const objectRegister&);
@@ -65,8 +69,10 @@ class objectRegister
   ~objectRegister();
 
   static objectRegister& Instance();
+  static objectRegister* setContext(objectRegister*);
 
   int cell(const std::string&,const int = -1,const int = 10000);
+  void removeCell(const std::string&,const int = -1);
   int getCell(const std::string&,const int =-1) const;
   int getRange(const std::string&,const int =-1) const;
   std::string inRange(const int) const;
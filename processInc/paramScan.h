@@ -0,0 +1,106 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   processInc/paramScan.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef mainSystem_paramScan_h
+#define mainSystem_paramScan_h
+
+class Simulation;
+class FuncDataBase;
+class MTRand;
+
+namespace mainSystem
+{
+  class inputParam;
+
+/*!
+  \class paramScan
+  \version 1.0
+  \author S. Ansell
+  \date October 2013
+  \brief Builds a deck for each of a set of variable assignments
+
+  The variants are a grid, a Latin hypercube sample or
+  are read from a file. Each variant is built in a forked
+  worker process (so the registries start clean) with up
+  to nWorker builds running at once. A variant whose
+  variable hash matches a successful build in an existing
+  manifest (and whose deck is still present) is skipped.
+*/
+
+class paramScan
+{
+ public:
+
+  /// Build and write one deck [return 0 on success]
+  typedef int (*buildFunc)(Simulation&,inputParam&,const std::string&);
+
+ private:
+
+  /// Scan range of one variable
+  struct scanRange
+  {
+    std::string name;         ///< Variable name
+    double low;               ///< Low value
+    double high;              ///< High value
+    size_t nPts;              ///< Number of points
+  };
+
+  size_t nWorker;                               ///< Concurrent builds
+  std::vector<scanRange> Ranges;                ///< Ranges to scan
+  std::vector<std::string> VarNames;            ///< Variant variables
+  std::vector<std::vector<double> > Variants;   ///< Values [by VarNames]
+  std::map<std::string,std::string> Done;       ///< hash : deck built
+
+  static double wallTime();
+  static int fileExists(const std::string&);
+  void setVariant(FuncDataBase&,const size_t) const;
+
+ public:
+
+  paramScan();
+  paramScan(const paramScan&);
+  paramScan& operator=(const paramScan&);
+  ~paramScan();
+
+  /// Set the number of concurrent builds
+  void setWorkers(const size_t N) { nWorker=(N) ? N : 1; }
+  /// Number of variants
+  size_t nVariants() const { return Variants.size(); }
+  /// Names of the variant variables
+  const std::vector<std::string>& getVarNames() const { return VarNames; }
+  const std::vector<double>& getVariant(const size_t) const;
+
+  void addRange(const std::string&,const double,const double,const size_t);
+  void makeGrid();
+  void makeLatin(const size_t,MTRand&);
+  void readVariants(const std::string&);
+  void writeVariants(const std::string&) const;
+  void readManifest(const std::string&);
+
+  int run(Simulation&,inputParam&,const std::string&,buildFunc,
+	  const std::string&);
+};
+
+  int createScan(paramScan&,const inputParam&,MTRand&);
+
+}
+
+#endif
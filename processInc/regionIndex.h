@@ -0,0 +1,89 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   processInc/regionIndex.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_regionIndex_h
+#define ModelSupport_regionIndex_h
+
+namespace ModelSupport
+{
+
+/*!
+  \class regionIndex
+  \version 1.0
+  \author S. Ansell
+  \date October 2013
+  \brief Name and cell-number index of the objectRegister blocks
+
+  Names are held in a hash map. The blocks are also held
+  in a vector sorted on the start cell so that a cell number
+  is mapped to its block by binary search. Nothing is
+  cached on lookup so const access is safe from many threads.
+*/
+
+class regionIndex
+{
+ public:
+
+  /// Storage type : name : startPt : size
+  typedef boost::unordered_map<std::string,std::pair<int,int> > NTYPE;
+
+ private:
+
+  /// Block unit for the sorted index
+  struct rangeUnit
+  {
+    int start;                     ///< First cell
+    int size;                      ///< Size of block
+    const std::string* namePtr;    ///< Name [points into NameMap]
+  };
+
+  NTYPE NameMap;                   ///< Name index
+  std::vector<rangeUnit> Ranges;   ///< Blocks sorted on start
+
+  /// Comparison for the sorted index
+  static bool startLess(const int A,const rangeUnit& B)
+    { return A<B.start; }
+
+  ///\cond ABSTRACT
+  regionIndex(const regionIndex&);
+  regionIndex& operator=(const regionIndex&);
+  ///\endcond ABSTRACT
+
+ public:
+
+  regionIndex();
+  ~regionIndex();
+
+  const std::pair<int,int>* find(const std::string&) const;
+  void insert(const std::string&,const int,const int);
+  void erase(const std::string&);
+  std::string inRange(const int) const;
+
+  /// Size of index
+  size_t size() const { return NameMap.size(); }
+  /// Access to the name map
+  const NTYPE& getNameMap() const { return NameMap; }
+
+};
+
+}
+
+#endif
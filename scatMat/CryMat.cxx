@@ -173,6 +173,7 @@ CryMat::setTemperatures(const double dTemp,const double Temp)
   realTemp=Temp;
   Rsum=Rvalue(debyeTemp/realTemp);
   B0plusBT=Bvalue(debyeTemp/realTemp);
+  updateTable();
   
   const double x(debyeTemp/realTemp);
   ELog::EM<<"Rvalue == "<<Rsum<<" "<<x
@@ -193,6 +194,7 @@ CryMat::setCif(const std::string& FName)
   
   if (XStruct.readFile(FName))
     ELog::EM<<"Failed to read cif file:"<<FName<<ELog::endErr;
+  updateTable();
   return;
 }
 
@@ -206,6 +208,7 @@ CryMat::setMass(const double A)
   Amass=A;
   C2=4.27*exp(Amass/61.0);
   B0plusBT=Bvalue(debyeTemp/realTemp);
+  updateTable();
   return;
 }
 
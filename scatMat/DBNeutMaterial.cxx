@@ -67,7 +67,20 @@
 namespace scatterSystem
 {
 
-DBNeutMaterial::DBNeutMaterial() 
+static bool
+hasFile(const std::string& FName)
+  /*!
+    Determine if a data file can be read
+    \param FName :: File name
+    \return true if readable
+  */
+{
+  std::ifstream IX(FName.c_str());
+  return IX.good();
+}
+
+DBNeutMaterial::DBNeutMaterial() :
+  tabLow(0.1),tabHigh(20.0),nTab(4096)
   /*!
     Constructor
   */
@@ -89,29 +102,66 @@ DBNeutMaterial::Instance()
 void
 DBNeutMaterial::initMaterial()
   /*!
-     Initialize the database of materials
+     Initialize the database of materials. The S(Q,w) 
+     materials are left out if their ENDF-7 file is missing
    */
 {
+  ELog::RegMethod RegA("DBNeutMaterial","initMaterial");
+
+  const std::string PolyFile("tsl-HinCH2.endf");
+  const std::string ParaH2File("tsl-para-H.endf");
   CryMat Silicon("Silicon",28.09,0.0499,4.1491,2.16,0.01,0.171);
   Silicon.setTemperatures(420,420/6);
 
   neutMaterial Aluminium("Aluminium",27,0.07,3.449,1.5,0.01,0.23);
 
   SQWmaterial Poly("Poly",4.6767,0.3,-0.27733,4.9054,51.3846,0.22);
-  Poly.setENDF7("tsl-HinCH2.endf");
   Poly.setExtra("Carbon",0.333333,12.01,6.6484,5.55,0.00,0.0035);
 
   neutMaterial H2O("Water",6.0,0.0992,-0.5589,2.5867,53.2667,0.22);
   //  scatterSystem::Material Silicon("Silicon",0.1,-0.27733,4.9054,51.3846,0.22);
   SQWmaterial ParaH2("ParaH2",1.0,0.041957,-3.7409,1.79,79.9,0.33);
-  ParaH2.setENDF7("tsl-para-H.endf");
 
   MStore.insert(MTYPE::value_type(5,Aluminium));
   MStore.insert(MTYPE::value_type(11,H2O));
-  MStore.insert(MTYPE::value_type(25,ParaH2));
   MStore.insert(MTYPE::value_type(41,Silicon));
-  MStore.insert(MTYPE::value_type(48,Poly));
-  
+  if (hasFile(ParaH2File))
+    {
+      ParaH2.setENDF7(ParaH2File);
+      MStore.insert(MTYPE::value_type(25,ParaH2));
+    }
+  else
+    ELog::EM<<"No ParaH2 [25] : missing "<<ParaH2File<<ELog::endWarn;
+  if (hasFile(PolyFile))
+    {
+      Poly.setENDF7(PolyFile);
+      MStore.insert(MTYPE::value_type(48,Poly));
+    }
+  else
+    ELog::EM<<"No Poly [48] : missing "<<PolyFile<<ELog::endWarn;
+
+  setTable(tabLow,tabHigh,nTab);
+  return;
+}
+
+void
+DBNeutMaterial::setTable(const double WLow,const double WHigh,
+			 const size_t N)
+  /*!
+    Set and build the cross section table of all the materials.
+    \param WLow :: Low wavelength [Angstrom]
+    \param WHigh :: High wavelength [Angstrom]
+    \param N :: Number of points [0 : exact cross sections]
+  */
+{
+  ELog::RegMethod RegA("DBNeutMaterial","setTable");
+
+  tabLow=WLow;
+  tabHigh=WHigh;
+  nTab=N;
+  MTYPE::iterator mc;
+  for(mc=MStore.begin();mc!=MStore.end();mc++)
+    mc->second.setTable(WLow,WHigh,N);
   return;
 }
 
@@ -160,7 +210,7 @@ DBNeutMaterial::getMat(const int ID) const
   if (!ID) return 0;
   
   MTYPE::const_iterator mc=MStore.find(ID);
-  if (mc!=MStore.end())
+  if (mc==MStore.end())
     throw ColErr::InContainerError<int>(ID,RegA.getFull());
 
   return &mc->second;
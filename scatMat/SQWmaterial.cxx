@@ -163,6 +163,7 @@ SQWmaterial::setExtra(const std::string& N,const double Frac,
   delete Extra;
   Extra=new neutMaterial(N,density,M,B,S,I,A);
   eFrac=Frac;
+  updateTable();
   return;
 }
 
@@ -177,6 +178,7 @@ SQWmaterial::setENDF7(const std::string& FName)
   
   if (HMat.ENDF7file(FName))
     ELog::EM<<"Failed to read endf-7 file:"<<FName<<ELog::endErr;
+  updateTable();
   return;
 }
 
@@ -49,15 +49,15 @@
 #include "Vec3D.h"
 #include "neutron.h"
 #include "neutMaterial.h"
-
-extern MTRand RNG;
+#include "RNGStream.h"
 
 namespace scatterSystem
 {
 
 neutMaterial::neutMaterial() : 
   Amass(1.0),density(0),realTemp(0.0),scoh(0.0),
-  sinc(0.0),sabs(0.0),bTotal(0.0)
+  sinc(0.0),sabs(0.0),bTotal(0.0),nTab(0),tabLow(0.0),
+  tabHigh(0.0),tabInvStep(0.0)
   /*!
     Constructor
   */
@@ -67,7 +67,8 @@ neutMaterial::neutMaterial(const std::string& N,const double M,
 		   const double D,const double B,
 		   const double S,const double I,const double A) : 
   Name(N),Amass(M),density(D),realTemp(300.0),bcoh(B),
-  scoh(S),sinc(I),sabs(A),bTotal(sqrt(S+I)/(4*M_PI))
+  scoh(S),sinc(I),sabs(A),bTotal(sqrt(S+I)/(4*M_PI)),
+  nTab(0),tabLow(0.0),tabHigh(0.0),tabInvStep(0.0)
   /*!
     Constructor for values
     \param N :: neutMaterial name
@@ -83,7 +84,8 @@ neutMaterial::neutMaterial(const std::string& N,const double M,
 neutMaterial::neutMaterial(const double M,const double D,const double B,
 		   const double S,const double I,const double A) : 
   Amass(M),density(D),realTemp(300.0),bcoh(B),scoh(S),
-  sinc(I),sabs(A),bTotal(sqrt(S+I)/(4*M_PI))
+  sinc(I),sabs(A),bTotal(sqrt(S+I)/(4*M_PI)),
+  nTab(0),tabLow(0.0),tabHigh(0.0),tabInvStep(0.0)
   /*!
     Constructor for values
     \param M :: Mean atomic mass
@@ -98,7 +100,9 @@ neutMaterial::neutMaterial(const double M,const double D,const double B,
 neutMaterial::neutMaterial(const neutMaterial& A) : 
   Name(A.Name),Amass(A.Amass),density(A.density),
   realTemp(A.realTemp),bcoh(A.bcoh),scoh(A.scoh),
-  sinc(A.sinc),sabs(A.sabs),bTotal(A.bTotal)
+  sinc(A.sinc),sabs(A.sabs),bTotal(A.bTotal),
+  nTab(A.nTab),tabLow(A.tabLow),tabHigh(A.tabHigh),
+  tabInvStep(A.tabInvStep),XTab(A.XTab)
   /*!
     Copy constructor
     \param A :: neutMaterial to copy
@@ -124,6 +128,11 @@ neutMaterial::operator=(const neutMaterial& A)
       sinc=A.sinc;
       sabs=A.sabs;
       bTotal=A.bTotal;
+      nTab=A.nTab;
+      tabLow=A.tabLow;
+      tabHigh=A.tabHigh;
+      tabInvStep=A.tabInvStep;
+      XTab=A.XTab;
     }
   return *this;
 }
@@ -152,6 +161,7 @@ neutMaterial::setDensity(const double D)
   */
 {
   density=D;
+  updateTable();
   return;
 }
 
@@ -169,6 +179,163 @@ neutMaterial::setScat(const double S,const double I,const double A)
   sinc=I;
   sabs=A;
   bTotal=sqrt(S+I)/(4*M_PI);
+  updateTable();
+  return;
+}
+
+void
+neutMaterial::setTable(const double WLow,const double WHigh,
+		       const size_t N)
+  /*!
+    Set and build the wavelength table.
+    \param WLow :: Low wavelength [Angstrom]
+    \param WHigh :: High wavelength [Angstrom]
+    \param N :: Number of points [0 : no table]
+  */
+{
+  ELog::RegMethod RegA("neutMaterial","setTable");
+  
+  if (N && (N<2 || WLow<=0.0 || WHigh<=WLow))
+    throw ColErr::RangeError<double>(WLow,0.0,WHigh,
+				     "neutMaterial::setTable");
+  nTab=N;
+  tabLow=WLow;
+  tabHigh=WHigh;
+  updateTable();
+  return;
+}
+
+void
+neutMaterial::updateTable()
+  /*!
+    Fill the table from the virtual cross section functions.
+    This is called by setTable and by every change of the 
+    material, so the table* lookups only read the table.
+    The attenuation column is the coefficient mu for 
+    calcAtten=exp(-mu L), taken from a short path length
+    so it is correct for any calcAtten of that form.
+  */
+{
+  ELog::RegMethod RegA("neutMaterial","updateTable");
+
+  const double LStep(1e-3);
+  XTab.clear();
+  if (nTab<2) return;
+
+  const double step=(tabHigh-tabLow)/static_cast<double>(nTab-1);
+  std::vector<double> Out(3*nTab);
+  for(size_t i=0;i<nTab;i++)
+    {
+      const double W=tabLow+step*static_cast<double>(i);
+      const double AT=calcAtten(W,LStep);
+      Out[3*i]=TotalCross(W);
+      Out[3*i+1]=ScatCross(W);
+      Out[3*i+2]=(AT>0.0) ? -log(AT)/LStep : 1e6;
+    }
+  tabInvStep=1.0/step;
+  XTab.swap(Out);
+  return;
+}
+
+int
+neutMaterial::tableIndex(const double Wave,size_t& index,
+			 double& frac) const
+  /*!
+    Find the table interval of a wavelength
+    \param Wave :: Wavelength [Angstrom]
+    \param index :: Low point of interval
+    \param frac :: Fraction in the interval
+    \return 1 if in the table
+  */
+{
+  if (XTab.empty()) return 0;
+
+  const double x=(Wave-tabLow)*tabInvStep;
+  if (x<0.0 || x>=static_cast<double>(nTab-1))
+    return 0;
+  index=static_cast<size_t>(x);
+  frac=x-static_cast<double>(index);
+  return 1;
+}
+
+double
+neutMaterial::tableTotal(const double Wave) const
+  /*!
+    Tabulated TotalCross
+    \param Wave :: Wavelength [Angstrom]
+    \return Attenuation (including density)
+  */
+{
+  size_t index;
+  double frac;
+  if (!tableIndex(Wave,index,frac))
+    return TotalCross(Wave);
+  const double* TPtr(&XTab[3*index]);
+  return TPtr[0]+frac*(TPtr[3]-TPtr[0]);
+}
+
+double
+neutMaterial::tableScat(const double Wave) const
+  /*!
+    Tabulated ScatCross
+    \param Wave :: Wavelength [Angstrom]
+    \return Scattering attenuation (including density)
+  */
+{
+  size_t index;
+  double frac;
+  if (!tableIndex(Wave,index,frac))
+    return ScatCross(Wave);
+  const double* TPtr(&XTab[3*index+1]);
+  return TPtr[0]+frac*(TPtr[3]-TPtr[0]);
+}
+
+double
+neutMaterial::tableAtten(const double Wave,const double Length) const
+  /*!
+    Tabulated calcAtten
+    \param Wave :: Wavelength [Angstrom]
+    \param Length :: Absorption length
+    \return Attenuation factor
+  */
+{
+  size_t index;
+  double frac;
+  if (!tableIndex(Wave,index,frac))
+    return calcAtten(Wave,Length);
+  const double* TPtr(&XTab[3*index+2]);
+  return exp(-Length*(TPtr[0]+frac*(TPtr[3]-TPtr[0])));
+}
+
+void
+neutMaterial::tableCross(const double* Wave,const size_t N,
+			 double* Tot,double* Scat) const
+  /*!
+    Tabulated TotalCross/ScatCross for a set of wavelengths
+    \param Wave :: Wavelengths [Angstrom]
+    \param N :: Number of wavelengths
+    \param Tot :: Output total attenuation [N]
+    \param Scat :: Output scattering attenuation [N]
+  */
+{
+  const double maxX(static_cast<double>(nTab)-1.0);
+  for(size_t i=0;i<N;i++)
+    {
+      const double x=(Wave[i]-tabLow)*tabInvStep;
+      if (XTab.empty() || x<0.0 || x>=maxX)
+	{
+	  Tot[i]=TotalCross(Wave[i]);
+	  Scat[i]=ScatCross(Wave[i]);
+	}
+      else
+	{
+	  const size_t index=static_cast<size_t>(x);
+	  const double frac=x-static_cast<double>(index);
+	  const double* TPtr(&XTab[3*index]);
+	  Tot[i]=TPtr[0]+frac*(TPtr[3]-TPtr[0]);
+	  Scat[i]=TPtr[1]+frac*(TPtr[4]-TPtr[1]);
+	}
+    }
   return;
 }
   
@@ -217,8 +384,8 @@ neutMaterial::scatterNeutron(MonteCarlo::neutron& N) const
 {
   ELog::RegMethod RegA("neutMaterial","scatterNeutron");
 
-  const double theta=2*M_PI*RNG.rand();
-  const double phi=M_PI*RNG.rand();
+  const double theta=2*M_PI*Transport::randGen().rand();
+  const double phi=M_PI*Transport::randGen().rand();
   N.uVec[0]=cos(theta)*sin(phi);
   N.uVec[1]=sin(theta)*sin(phi);
   N.uVec[2]=cos(phi);
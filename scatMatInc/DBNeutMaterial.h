@@ -31,6 +31,11 @@ namespace scatterSystem
   \author S. Ansell
   \date August 2011
   \brief Storage for true scattering materials
+
+  Each stored material keeps a wavelength table of its
+  cross sections. The table range and number of points
+  are set here for all materials and the tables are 
+  built by setTable.
 */
 
 class DBNeutMaterial
@@ -44,6 +49,10 @@ class DBNeutMaterial
   /// Active list
   std::set<int> active;
 
+  double tabLow;            ///< Low wavelength of tables [Angstrom]
+  double tabHigh;           ///< High wavelength of tables [Angstrom]
+  size_t nTab;              ///< Points in tables [0 : no tables]
+
   DBNeutMaterial();
 
   ////\cond SINGLETON
@@ -65,6 +74,7 @@ class DBNeutMaterial
   void setActive(const int);
   bool isActive(const int) const;
   void setENDF7();
+  void setTable(const double,const double,const size_t);
 
   const scatterSystem::neutMaterial* getMat(const int) const;
 
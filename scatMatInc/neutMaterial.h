@@ -39,6 +39,13 @@ namespace scatterSystem
     This can be extended so that more sophisticated material
     components can be used.
     \todo This class needs to have a base class.
+
+    The total, scatter and attenuation cross sections can be
+    tabulated on a uniform wavelength grid (setTable). The
+    table* lookups interpolate that grid and fall back
+    to the virtual functions outside it. Any change of
+    material parameters rebuilds the table, so a material
+    can be shared by transport threads.
   */
   
 class neutMaterial
@@ -56,6 +63,15 @@ class neutMaterial
   double sinc;           ///< incoherrrent cross section 
   double sabs;           ///< Absorption cross section
   double bTotal;         ///< Total scattering cross section
+
+  size_t nTab;                     ///< Table points [0 : no table]
+  double tabLow;                   ///< Low wavelength of table
+  double tabHigh;                  ///< High wavelength of table
+  double tabInvStep;               ///< 1/wavelength step
+  std::vector<double> XTab;        ///< [total:scatter:atten] per point
+
+  void updateTable();
+  int tableIndex(const double,size_t&,double&) const;
   
  public:
   
@@ -86,9 +102,12 @@ class neutMaterial
   void setName(const std::string& N) { Name=N; }  ///< Set Name
   void setNumber(const int N) { mcnpxNum=N; }  ///< Set Number
   void setDensity(const double);
-  virtual void setMass(const double M) { Amass=M; }  ///< Set Mass
-  void setTmp(const double T) { realTemp=T; }  ///< Set Temperature [Kelvin]
+  /// Set Mass
+  virtual void setMass(const double M) { Amass=M; updateTable(); }
+  /// Set Temperature [Kelvin]
+  void setTmp(const double T) { realTemp=T; updateTable(); }
   void setScat(const double,const double,const double);
+  void setTable(const double,const double,const size_t);
 
   double getAtomDensity() const { return density; }   ///< Density accessor
   double getScat() const { return scoh+sinc; }  ///< Scattering cross-section
@@ -106,6 +125,11 @@ class neutMaterial
 
   virtual double calcRefIndex(const double) const;
   virtual double calcAtten(const double,const double) const;
+
+  double tableTotal(const double) const;
+  double tableScat(const double) const;
+  double tableAtten(const double,const double) const;
+  void tableCross(const double*,const size_t,double*,double*) const;
   
   virtual void scatterNeutron(MonteCarlo::neutron&) const;
   
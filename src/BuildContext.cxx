@@ -0,0 +1,221 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   src/BuildContext.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <boost/shared_ptr.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Quaternion.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "localRotate.h"
+#include "masterRotate.h"
+#include "Element.h"
+#include "MapSupport.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "surfIndex.h"
+#include "objectRegister.h"
+#include "WForm.h"
+#include "weightManager.h"
+#include "SimTrack.h"
+#include "BuildContext.h"
+
+/// Context active on this thread [0 : process singletons]
+static BuildContext* activePtr(0);
+#ifdef _OPENMP
+#pragma omp threadprivate(activePtr)
+#endif
+
+BuildContext::BuildContext(const int isoFlag) :
+  isolated(isoFlag ? 1 : 0),
+  SIPtr(isolated ? new ModelSupport::surfIndex : 0),
+  ORPtr(isolated ? new ModelSupport::objectRegister : 0),
+  WMPtr(isolated ? new WeightSystem::weightManager : 0),
+  DBPtr(isolated ? new ModelSupport::DBMaterial : 0),
+  MRPtr(isolated ? new masterRotate : 0),
+  STPtr(isolated ? new ModelSupport::SimTrack : 0)
+  /*!
+    Constructor
+    \param isoFlag :: Own a private set of registries
+  */
+{}
+
+BuildContext::~BuildContext()
+  /*!
+    Destructor : releases owned registries.
+    If this context is still active on the calling thread
+    the thread is reset to the process singletons
+  */
+{
+  if (activePtr==this)
+    activate(0);
+  delete STPtr;
+  delete MRPtr;
+  delete DBPtr;
+  delete WMPtr;
+  delete ORPtr;
+  delete SIPtr;
+}
+
+void
+BuildContext::bindRegistries(const BuildContext* BPtr)
+  /*!
+    Point each registry Instance() at the context copy
+    \param BPtr :: Context [0 or shared for the process singletons]
+  */
+{
+  const int iso=(BPtr && BPtr->isolated);
+  ModelSupport::surfIndex::setContext(iso ? BPtr->SIPtr : 0);
+  ModelSupport::objectRegister::setContext(iso ? BPtr->ORPtr : 0);
+  WeightSystem::weightManager::setContext(iso ? BPtr->WMPtr : 0);
+  ModelSupport::DBMaterial::setContext(iso ? BPtr->DBPtr : 0);
+  masterRotate::setContext(iso ? BPtr->MRPtr : 0);
+  ModelSupport::SimTrack::setContext(iso ? BPtr->STPtr : 0);
+  return;
+}
+
+BuildContext*
+BuildContext::activate(BuildContext* BPtr)
+  /*!
+    Activate a context on the calling thread
+    \param BPtr :: Context to use [0 for process singletons]
+    \return previously active context
+  */
+{
+  BuildContext* prevPtr=activePtr;
+  activePtr=BPtr;
+  bindRegistries(BPtr);
+  return prevPtr;
+}
+
+BuildContext*
+BuildContext::current()
+  /*!
+    Accessor to the active context on this thread
+    \return active context [0 if using process singletons]
+  */
+{
+  return activePtr;
+}
+
+ModelSupport::surfIndex&
+BuildContext::getSurfIndex() const
+  /*!
+    Accessor to the surface index
+    \return surfIndex
+  */
+{
+  return (SIPtr) ? *SIPtr : ModelSupport::surfIndex::Instance();
+}
+
+ModelSupport::objectRegister&
+BuildContext::getObjectRegister() const
+  /*!
+    Accessor to the object register
+    \return objectRegister
+  */
+{
+  return (ORPtr) ? *ORPtr : ModelSupport::objectRegister::Instance();
+}
+
+WeightSystem::weightManager&
+BuildContext::getWeightManager() const
+  /*!
+    Accessor to the weight manager
+    \return weightManager
+  */
+{
+  return (WMPtr) ? *WMPtr : WeightSystem::weightManager::Instance();
+}
+
+ModelSupport::DBMaterial&
+BuildContext::getDBMaterial() const
+  /*!
+    Accessor to the material database
+    \return DBMaterial
+  */
+{
+  return (DBPtr) ? *DBPtr : ModelSupport::DBMaterial::Instance();
+}
+
+masterRotate&
+BuildContext::getMasterRotate() const
+  /*!
+    Accessor to the master rotation
+    \return masterRotate
+  */
+{
+  return (MRPtr) ? *MRPtr : masterRotate::Instance();
+}
+
+ModelSupport::SimTrack&
+BuildContext::getSimTrack() const
+  /*!
+    Accessor to the simulation tracker
+    \return SimTrack
+  */
+{
+  return (STPtr) ? *STPtr : ModelSupport::SimTrack::Instance();
+}
+
+//------------------------------------------------------------
+//                  BuildContextGuard
+//------------------------------------------------------------
+
+BuildContextGuard::BuildContextGuard(BuildContext& BC) :
+  prevPtr(BuildContext::activate(&BC))
+  /*!
+    Constructor : activates the context
+    \param BC :: Context to activate
+  */
+{}
+
+BuildContextGuard::~BuildContextGuard()
+  /*!
+    Destructor : restores the previous context
+  */
+{
+  BuildContext::activate(prevPtr);
+}
@@ -0,0 +1,224 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   src/MasterFile.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <cstring>
+#include <list>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "MasterFile.h"
+
+MasterFile::MasterFile(const std::string& FN) :
+  FName(FN),fd(open(FN.c_str(),O_RDONLY)),fileSize(0),Data(0)
+  /*!
+    Constructor : maps the file and builds the index
+    \param FN :: Master file name
+  */
+{
+  ELog::RegMethod RegA("MasterFile","constructor");
+
+  struct stat SBuf;
+  if (fd<0 || fstat(fd,&SBuf))
+    {
+      if (fd>=0) close(fd);
+      throw ColErr::FileError(0,FName,"MasterFile::MasterFile");
+    }
+  fileSize=static_cast<size_t>(SBuf.st_size);
+  // An empty file cannot be mapped
+  if (fileSize)
+    {
+      void* MPtr=mmap(0,fileSize,PROT_READ,MAP_PRIVATE,fd,0);
+      if (MPtr==MAP_FAILED)
+	{
+	  close(fd);
+	  throw ColErr::FileError(0,FName,"MasterFile::mmap");
+	}
+      Data=static_cast<const char*>(MPtr);
+    }
+  buildIndex();
+}
+
+MasterFile::~MasterFile()
+  /*!
+    Destructor : release map and file
+  */
+{
+  if (Data)
+    munmap(const_cast<char*>(Data),fileSize);
+  close(fd);
+}
+
+int
+MasterFile::sectionType(const char* SPtr,const char* EPtr)
+  /*!
+    Determine the section that a line starts. Trailing
+    #/! comments are ignored. The order of the
+    tests is that of the original stream reader.
+    \param SPtr :: Start of line
+    \param EPtr :: End of line
+    \retval 0 :: Not a section header
+    \retval 1-6 :: Transform/Surface/Cell/Material/Tally/Physics
+  */
+{
+  static const char* Keys[]=
+    {"TRANSFORM CARDS","SURFACE CARDS","CELL CARDS",
+     "MATERIAL CARDS","TALLY CARDS","PHYSICS CARDS"};
+  static const char CardStr[]="CARDS";
+
+  const char* CPtr=std::find_first_of(SPtr,EPtr,"#!","#!"+2);
+  // Quick rejection of the normal line
+  if (std::search(SPtr,CPtr,CardStr,CardStr+5)==CPtr)
+    return 0;
+  for(int i=0;i<6;i++)
+    {
+      const char* KeyEnd=Keys[i]+strlen(Keys[i]);
+      if (std::search(SPtr,CPtr,Keys[i],KeyEnd)!=CPtr)
+	return i+1;
+    }
+  return 0;
+}
+
+void
+MasterFile::buildIndex()
+  /*!
+    Single pass to find the line starts and the
+    section headers
+  */
+{
+  ELog::RegMethod RegA("MasterFile","buildIndex");
+
+  LStart.clear();
+  Headers.clear();
+  size_t pos(0);
+  while(pos<fileSize)
+    {
+      const char* EPtr=static_cast<const char*>
+	(memchr(Data+pos,'\n',fileSize-pos));
+      const size_t endPos=(EPtr) ? 
+	static_cast<size_t>(EPtr-Data) : fileSize;
+      const int sType=sectionType(Data+pos,Data+endPos);
+      if (sType)
+	Headers.push_back(HTYPE(LStart.size(),sType));
+      LStart.push_back(pos);
+      pos=endPos+1;
+    }
+  // Empty line after a final newline [as getline]
+  if (!fileSize || Data[fileSize-1]=='\n')
+    LStart.push_back(fileSize);
+  // End point : one past the newline
+  LStart.push_back(fileSize+1);
+  return;
+}
+
+std::string
+MasterFile::getLine(const size_t index,const int commentFlag) const
+  /*!
+    Get a line from the file 
+    \param index :: Line number [from 0]
+    \param commentFlag :: Remove #/! trailing comments
+    \return line
+  */
+{
+  if (index+1>=LStart.size())
+    throw ColErr::IndexError<size_t>(index,LStart.size()-1,
+				     "MasterFile::getLine");
+  
+  const char* SPtr=Data+LStart[index];
+  const char* EPtr=Data+LStart[index+1]-1;
+  if (commentFlag)
+    EPtr=std::find_first_of(SPtr,EPtr,"#!","#!"+2);
+  return std::string(SPtr,EPtr);
+}
+
+void
+MasterFile::getLines(const size_t indexA,const size_t indexB,
+		     const int commentFlag,
+		     std::vector<std::string>& Lines) const
+  /*!
+    Get a range of lines from the file 
+    \param indexA :: First line
+    \param indexB :: One past the last line
+    \param commentFlag :: Remove #/! trailing comments
+    \param Lines :: Lines [appended]
+  */
+{
+  ELog::RegMethod RegA("MasterFile","getLines");
+
+  const size_t NL=std::min(indexB,getNLine());
+  if (NL>indexA)
+    Lines.reserve(Lines.size()+NL-indexA);
+  for(size_t i=indexA;i<NL;i++)
+    Lines.push_back(getLine(i,commentFlag));
+  return;
+}
+
+std::string
+MasterFile::getText(const size_t indexA,const size_t indexB) const
+  /*!
+    Get the raw text of a range of lines [including
+    the newline characters]
+    \param indexA :: First line
+    \param indexB :: One past the last line
+    \return text block
+  */
+{
+  const size_t NL=std::min(indexB,getNLine());
+  if (indexA>=NL) return "";
+  const size_t posB=std::min(LStart[NL],fileSize);
+  return std::string(Data+LStart[indexA],Data+posB);
+}
+
+size_t
+MasterFile::getLineIndex(const size_t indexA,const long int nChar) const
+  /*!
+    Find the line that starts nChar characters after
+    the start of line indexA [e.g. a stream position
+    in the text from getText(indexA,...)]
+    \param indexA :: First line
+    \param nChar :: Character offset [-ve : end of file]
+    \return line index [getNLine() at end of file]
+  */
+{
+  const size_t NL=getNLine();
+  if (indexA>=NL || nChar<0)
+    return NL;
+  const size_t pos=LStart[indexA]+static_cast<size_t>(nChar);
+  std::vector<size_t>::const_iterator vc=
+    std::lower_bound(LStart.begin(),LStart.end(),pos);
+  return std::min(static_cast<size_t>(vc-LStart.begin()),NL);
+}
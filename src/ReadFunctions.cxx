@@ -137,7 +137,8 @@ processDollarString(FuncDataBase& DB,std::string& Line)
       (tolower(Line[0])=='c' && isspace(Line[1])))
     return;
 
-  while(StrFunc::section(Line,Part))
+  const char* cPtr(Line.c_str());
+  while(StrFunc::section(cPtr,Part))
     {
       std::string::size_type pos=Part.find('$');
       if (pos != std::string::npos)
@@ -178,13 +179,18 @@ processDollarString(FuncDataBase& DB,std::string& Line)
 }
 
 int
-processSurface(const std::string& InputLine,const int offset)
+parseSurface(const std::string& InputLine,const int offset,
+	     Geometry::Surface*& SPtr,const int quietFlag)
   /*! 
     Job is to decide which type of surface the 
     current line is attached too. It also must decide if 
-    there is enough information on the current line 
-    \param InputLine :: Line to process (Stripped of comments on return)
+    there is enough information on the current line.
+    The surface is not registered and with quietFlag 
+    nothing is logged, so this can be called from separate threads.
+    \param InputLine :: Line to process
     \param offset :: surface ID offset
+    \param SPtr :: New surface [on 1 : 0 otherwise]
+    \param quietFlag :: Do not report an incomplete line
     \retval 0 More information required
     \retval -1 failed
     \retval 1 good
@@ -192,8 +198,9 @@ processSurface(const std::string& InputLine,const int offset)
     \retval 3 valid but void surface
   */
 {
-  ELog::RegMethod RegItem("ReadFunctions","processSurface");
+  ELog::RegMethod RegItem("ReadFunctions","parseSurface");
 
+  SPtr=0;
   std::string Line=StrFunc::fullBlock(InputLine);
   StrFunc::stripComment(Line);
   if (Line.size()<1 ||               // comments blank line, ^c or ^c<spc> 
@@ -210,10 +217,95 @@ processSurface(const std::string& InputLine,const int offset)
   int transN(0);
   StrFunc::section(Line,transN);
 
-  int retNum=ModelSupport::surfIndex::Instance().
-    createSurface(name,transN,Line);
-  if (!retNum) return 1;
+  const Geometry::surfaceFactory& SF=Geometry::surfaceFactory::Instance();
+  if (quietFlag)
+    SPtr=SF.testLine(Line);
+  else
+    {
+      try
+	{
+	  SPtr=SF.processLine(Line);
+	}
+      catch (const ColErr::ExBase&)
+	{
+	  SPtr=0;
+	}
+    }
   // Incomplete here:
+  if (!SPtr)
+    return 0;
+
+  SPtr->setName(name);
+  SPtr->setTrans(transN);
+  return 1;
+}
+
+int
+processSurface(const std::string& InputLine,const int offset)
+  /*! 
+    Process a surface line and add the surface
+    to the surfIndex
+    \param InputLine :: Line to process
+    \param offset :: surface ID offset
+    \retval 0 More information required
+    \retval -1 failed
+    \retval 1 good
+    \retval 2 pure comment 
+    \retval 3 valid but void surface
+  */
+{
+  ELog::RegMethod RegItem("ReadFunctions","processSurface");
+
+  Geometry::Surface* SPtr;
+  const int retNum=parseSurface(InputLine,offset,SPtr,0);
+  if (SPtr)
+    ModelSupport::surfIndex::Instance().replaceSurface(SPtr);
+  return retNum;
+}
+
+int
+sectionEnd(const std::string& InputLine,int& ignore)
+  /*!
+    Test if a line is the END of a section. 
+    IGNORE/ENDIGNORE blocks are followed in ignore.
+    \param InputLine :: Line to test
+    \param ignore :: In an IGNORE block [updated]
+    \return 1 if the line is the END 
+  */
+{
+  std::string Line(InputLine);
+  removeDollarComment(Line);
+  if (Line.find(" ENDIGNORE")!=std::string::npos) 
+    ignore=0;
+  else if (Line.find(" IGNORE")!=std::string::npos) 
+    ignore=1;
+  else if (!ignore && Line.find("END")!=std::string::npos) 
+    return 1;
+  return 0;
+}
+
+int
+readSection(std::istream& IX,const int allFlag,
+	    std::vector<std::string>& Lines)
+  /*!
+    Read the lines of a section upto and including the
+    END line. IGNORE/ENDIGNORE blocks are respected.
+    \param IX :: input stream
+    \param allFlag :: keep #/! comments [getAllLine]
+    \param Lines :: Lines read [appended]
+    \return 1 if END found / 0 at end of stream
+  */
+{
+  ELog::RegMethod RegItem("ReadFunctions","readSection");
+
+  int ignore(0);
+  while(IX.good())
+    {
+      Lines.push_back((allFlag) ? 
+		      StrFunc::getAllLine(IX) : StrFunc::getLine(IX));
+      if (sectionEnd(Lines.back(),ignore))
+	return 1;
+    }
   return 0;
 }
 
@@ -231,15 +323,40 @@ readSurfaces(FuncDataBase& DB,std::istream& IX,const int offset)
 {
   ELog::RegMethod RegItem("ReadFunctions","readSurfaces");
 
-  std::string Line;
-  int monoLine(1);        // Do we have and extention to add
-  int Scount(0);
+  std::vector<std::string> Lines;
+  readSection(IX,0,Lines);
+  return readSurfaces(DB,Lines,offset);
+}
+
+int
+readSurfaces(FuncDataBase& DB,const std::vector<std::string>& Lines,
+	     const int offset)
+  /*!
+    Reads the surfaces
+      - Section is teminated with an END comment or a 
+         blank line
+    Variables are expanded in order. The lines are split into
+    cards [continuation lines start with a space] and each card
+    is parsed in parallel without logging. Cards that do not match
+    the serial read are parsed again as the lines are joined.
+    \param DB :: DataBase for function evaluation
+    \param Lines :: Lines of the surface section
+    \param offset :: Offset nubmer 
+    \return Number of surfaces read
+  */
+{
+  ELog::RegMethod RegItem("ReadFunctions","readSurfaces");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+
+  std::vector<std::string> InputLines;
+  std::vector<int> CardStart;      // Line starts a card [+ end]
+  std::vector<size_t> CardIndex;   // First line of each card [+ end]
+  int endFlag(0);
   int ignore(0);          // 
-  std::vector<std::string> errLine;
-  
-  while(IX.good())
+  for(size_t i=0;!endFlag && i<Lines.size();i++)
     {
-      std::string InputLine = StrFunc::getLine(IX);           
+      std::string InputLine = Lines[i];
       removeDollarComment(InputLine);
       // HANDLE Actions
       if (InputLine.find(" ENDIGNORE")!=std::string::npos) 
@@ -247,37 +364,100 @@ readSurfaces(FuncDataBase& DB,std::istream& IX,const int offset)
       else if (InputLine.find(" IGNORE")!=std::string::npos) 
 	ignore=1;
       else if (!ignore && InputLine.find("END")!=std::string::npos) 
+	endFlag=1;
+
+      if (!ignore && !endFlag)
 	{
-	  ELog::EM<<"Read Surfaces == "<<Scount<<ELog::endDebug;
-	  return Scount;
-	}
-      
-      if (!ignore)
-	{
-	  processDollarString(DB,InputLine);
-	  Line+=InputLine+" ";
-	  monoLine=processSurface(Line,offset);
-	  if (monoLine==1 || monoLine==2 || monoLine==3)      // Good line / comment
-	    {
-	      if (monoLine==1) Scount++;
-	      Line="";
-	      errLine.clear();
-	    }
-	  else if ((!errLine.empty() && monoLine>1) ||
-		   errLine.size()>4)
+	  // Card : a line starting in the first column starts a card
+	  if (InputLines.empty() || InputLine.empty() ||
+	      !isspace(InputLine[0]))
 	    {
-	      ELog::EM<<"Error with line grp:\n";
-	      for(size_t i=0;i<errLine.size();i++)
-		ELog::EM<<" -- "<<errLine[i]<<"\n";
-	      ELog::EM<<ELog::endErr;
+	      CardIndex.push_back(InputLines.size());
+	      CardStart.push_back(1);
 	    }
 	  else
-	    {
-	      errLine.push_back(InputLine);
-	    }
+	    CardStart.push_back(0);
+	  processDollarString(DB,InputLine);
+	  InputLines.push_back(InputLine);
 	}
     }
-  ELog::EM<<"File ended without END"<<ELog::endWarn;
+  CardIndex.push_back(InputLines.size());
+  CardStart.push_back(1);
+
+  // Each card is parsed [in parallel] as its lines are joined
+  const long int NC=static_cast<long int>(CardIndex.size()-1);
+  std::vector<Geometry::Surface*> SVec(InputLines.size(),0);
+  std::vector<int> Flag(InputLines.size(),0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,64) if (NC>1)
+#endif
+  for(long int c=0;c<NC;c++)
+    {
+      const size_t cIndex(static_cast<size_t>(c));
+      std::string Line;
+      for(size_t i=CardIndex[cIndex];i<CardIndex[cIndex+1];i++)
+	{
+	  Line+=InputLines[i]+" ";
+	  Flag[i]=parseSurface(Line,offset,SVec[i],1);
+	  if (Flag[i]>0) break;
+	}
+    }
+
+  // The parsed values are used while the cards match the
+  // serial read [else the lines are parsed again as joined]
+  std::string Line;
+  int Scount(0);
+  int cardValid(0);
+  std::vector<std::string> errLine;
+  for(size_t i=0;i<InputLines.size();i++)
+    {
+      if (CardStart[i])
+	cardValid=Line.empty();
+      else if (Line.empty())
+	cardValid=0;
+
+      Line+=InputLines[i]+" ";
+      int monoLine;
+      Geometry::Surface* SPtr;
+      if (cardValid && (Flag[i]>0 || !CardStart[i+1]))
+	{
+	  monoLine=Flag[i];
+	  SPtr=SVec[i];
+	  SVec[i]=0;
+	}
+      else   // not parsed / last line of an incomplete card : report
+	monoLine=parseSurface(Line,offset,SPtr,0);
+
+      if (SPtr)
+	SurI.replaceSurface(SPtr);
+
+      if (monoLine==1 || monoLine==2 || monoLine==3)      // Good line / comment
+	{
+	  if (monoLine==1) Scount++;
+	  Line="";
+	  errLine.clear();
+	}
+      else if ((!errLine.empty() && monoLine>1) ||
+	       errLine.size()>4)
+	{
+	  ELog::EM<<"Error with line grp:\n";
+	  for(size_t j=0;j<errLine.size();j++)
+	    ELog::EM<<" -- "<<errLine[j]<<"\n";
+	  ELog::EM<<ELog::endErr;
+	}
+      else
+	{
+	  errLine.push_back(InputLines[i]);
+	}
+    }
+  // Lines parsed past the end of a card
+  for(size_t i=0;i<SVec.size();i++)
+    delete SVec[i];
+
+  if (endFlag)
+    ELog::EM<<"Read Surfaces == "<<Scount<<ELog::endDebug;
+  else
+    ELog::EM<<"File ended without END"<<ELog::endWarn;
   return Scount;
 }
 
@@ -299,9 +479,23 @@ checkInsert(const MonteCarlo::Qhull& A,const int offset,OTYPE& ObjMap)
 {
   ELog::RegMethod RegItem("ReadFunctions","checkInsert");
 
-  const int cellNumber=A.getName()+offset;
+  return checkInsert(A.clone(),offset,ObjMap);
+}
+
+int
+checkInsert(MonteCarlo::Qhull* APtr,const int offset,OTYPE& ObjMap)
+  /*!
+    Insert a new Qhull object [managed by the map]. 
+    An object of the same number is over-written
+    \param APtr :: Hull to insert in the main list
+    \param offset :: offset number to add to object index
+    \param ObjMap :: Map to add the cells to.
+    \returns 1 on success and 0 on overwrite
+  */
+{
+  ELog::RegMethod RegItem("ReadFunctions","checkInsert");
 
-  OTYPE::mapped_type APtr=A.clone();
+  const int cellNumber=APtr->getName()+offset;
   APtr->setName(cellNumber);
   std::pair<OTYPE::iterator,bool> iPair=
     ObjMap.insert(OTYPE::value_type(cellNumber,APtr));
@@ -366,16 +560,38 @@ readCells(FuncDataBase& DB,std::istream& IX,
 {
   ELog::RegMethod RegA("ReadFunctions","readCells");
 
+  std::vector<std::string> Lines;
+  readSection(IX,1,Lines);
+  return readCells(DB,Lines,offset,ObjMap);
+}
+
+int
+readCells(FuncDataBase& DB,const std::vector<std::string>& Lines,
+	  const int offset,OTYPE& ObjMap)
+  /*!
+    Reads the Cell definitions from MCNPX.
+    The cards are found and the variables expanded in order.
+    The Qhull objects are then built [in parallel] and 
+    inserted in card order.
+    \param DB :: DataBase for function evaluation
+    \param Lines :: Lines of the cell section [with comments]
+    \param offset :: Cell number offset to add the cell number
+    \param ObjMap :: Map to place cells
+    \retval Number of cell read
+  */
+{
+  ELog::RegMethod RegA("ReadFunctions","readCells");
+
   std::string Line;        // Line with everything
   std::string ObjLine;     // Stripped line
-  int Ccount(0);
+  std::vector<std::string> Cards;
   int last(0);
   int endActive(0);        // No active line
   int ignore(0);
 
-  while(!last && IX.good())
+  for(size_t i=0;!last && i<Lines.size();i++)
     {
-      Line=StrFunc::getAllLine(IX);                // Read Line [with comment]
+      Line=Lines[i];
       ReadFunc::removeDollarComment(Line);         // Strip comments
       if (Line.find(" ENDIGNORE")!=std::string::npos) 
 	ignore=0;
@@ -403,23 +619,7 @@ readCells(FuncDataBase& DB,std::istream& IX,
       
       if (endActive && !ObjLine.empty())
         {
-	  MonteCarlo::Qhull Tx;
-	  // This loop over the string making fake object
-	  // for each #(xxx) 
-	  // REMOVED To use new CompGrp object
-	  // Now add object
-	  Tx.setCreate(Ccount);
-	  if (Tx.setObject(ObjLine) && 
-	      checkInsert(Tx,offset,ObjMap))
-	    {
-	      Ccount++;
-	    }
-	  else
-	    {
-	      ELog::EM<<"Failed on Line:"
-		      <<ObjLine<<ELog::endErr;
-	      throw ColErr::ExitAbort(RegA.getFull());
-	    }
+	  Cards.push_back(ObjLine);
 	  ObjLine="";
 	}
 
@@ -435,6 +635,66 @@ readCells(FuncDataBase& DB,std::istream& IX,
   if (!last)
     ELog::EM<<"Over run end of Cells file"<<ELog::endErr;
 
+  // Build the objects : each card is independent
+  const long int NC=static_cast<long int>(Cards.size());
+  std::vector<MonteCarlo::Qhull*> QVec(Cards.size(),0);
+  std::vector<int> QFlag(Cards.size(),0);
+  std::vector<int> Failed(Cards.size(),0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,16) if (NC>1)
+#endif
+  for(long int i=0;i<NC;i++)
+    {
+      const size_t index(static_cast<size_t>(i));
+      QVec[index]=new MonteCarlo::Qhull;
+      QVec[index]->setCreate(static_cast<int>(index));
+      try
+	{
+	  QFlag[index]=QVec[index]->setObject(Cards[index]);
+	}
+      // exceptions cannot leave the parallel region
+      catch (...)
+	{
+	  Failed[index]=1;
+	}
+    }
+
+  int Ccount(0);
+  for(size_t i=0;i<Cards.size();i++)
+    {
+      if (Failed[i])       // repeat on this thread [throws again]
+	{
+	  delete QVec[i];
+	  QVec[i]=new MonteCarlo::Qhull;
+	  QVec[i]->setCreate(static_cast<int>(i));
+	  try
+	    {
+	      QFlag[i]=QVec[i]->setObject(Cards[i]);
+	    }
+	  catch (...)
+	    {
+	      for(size_t j=i;j<Cards.size();j++)
+		delete QVec[j];
+	      throw;
+	    }
+	}
+      MonteCarlo::Qhull* QPtr=QVec[i];
+      QVec[i]=0;
+      if (QFlag[i] && checkInsert(QPtr,offset,ObjMap))
+	{
+	  Ccount++;
+	}
+      else
+	{
+	  if (!QFlag[i]) delete QPtr;
+	  for(size_t j=i+1;j<Cards.size();j++)
+	    delete QVec[j];
+	  ELog::EM<<"Failed on Line:"
+		  <<Cards[i]<<ELog::endErr;
+	  throw ColErr::ExitAbort(RegA.getFull());
+	}
+    }
+
   ELog::EM<<"Read Cells =="<<Ccount<<ELog::endDiag;
   return Ccount;
 }
@@ -34,6 +34,10 @@
 #include <functional>
 #include <numeric>
 #include <iterator>
+#include <exception>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <boost/functional.hpp>
 #include <boost/bind.hpp>
 #include <boost/multi_array.hpp>
@@ -98,13 +102,14 @@
 #include "Detector.h"
 #include "DetGroup.h"
 #include "NRange.h"
+#include "RNGStream.h"
+#include "ParticleBank.h"
 #include "Simulation.h"
 #include "SimMonte.h"
 
-extern MTRand RNG;
-
 SimMonte::SimMonte() : 
-  TCount(0),B(0),DUnit()
+  TCount(0),B(0),DUnit(),batchSize(10000),seed(12345),
+  eventFlag(0)
   /*!
     Start of simulation Object
     Initialise currentSample to Sample 
@@ -113,7 +118,8 @@ SimMonte::SimMonte() :
 
 SimMonte::SimMonte(const SimMonte& A)  :
   TCount(A.TCount),B((A.B) ? A.B->clone() : 0),
-  DUnit(A.DUnit)
+  DUnit(A.DUnit),batchSize(A.batchSize),seed(A.seed),
+  eventFlag(A.eventFlag)
   /*!
     Copy constructor:: makes a deep copy of the SurMap 
     object including calling the virtual clone on the 
@@ -138,6 +144,9 @@ SimMonte::operator=(const SimMonte& A)
       delete B;
       B=(A.B) ? A.B->clone() : 0;
       DUnit=A.DUnit;
+      batchSize=A.batchSize;
+      seed=A.seed;
+      eventFlag=A.eventFlag;
     }
   return *this;
 }
@@ -188,51 +197,60 @@ SimMonte::setDetector(const Transport::Detector& DObj)
   return;
 }
  
-void
-SimMonte::runMonte(const size_t Npts)
+size_t
+SimMonte::runBatch(const size_t batchIndex,const size_t NHist,
+		   Transport::DetGroup& DGrp) const
   /*!
-    Run a specific number 
-    \param Npts :: number of points
+    Run one batch of histories. The batch has its own 
+    random stream and cell hint and scores into its
+    own detectors. A neutron is scored when it crosses
+    into a zero importance cell.
+    \param batchIndex :: Batch number [random stream]
+    \param NHist :: Number of histories
+    \param DGrp :: Detectors of this batch
+    \return number of failed histories
   */
 {
-  ELog::RegMethod RegA("SimMonte","runMonte");
-
-  static MonteCarlo::Object* defObj(0);
+  ELog::RegMethod RegA("SimMonte","runBatch");
 
-  //  const int aim((Npts>10) ? Npts/10 : 1);
+  Transport::RNGStream RStream(seed,batchIndex);
+  MonteCarlo::Object* cellHint(0);
   const Geometry::Surface* surfPtr;
-  MonteCarlo::neutron Nout(0,Geometry::Vec3D(0,0,0),
-			   Geometry::Vec3D(1,0,0));
   const ModelSupport::ObjSurfMap* OSMPtr =getOSM();
 
-  //  double tDist;  // Track disnace 
-  //  Geometry::Surface* SPtr;  // Exit surface
-
-  for(size_t i=0;i<Npts;i++)
+  size_t nFail(0);
+  for(size_t i=0;i<NHist;i++)
     {
       try
 	{
 	  // No material info at this point:
 	  MonteCarlo::neutron n=B->generateNeutron();
-	  //      if (!DUnit.calcCell(n,testA,testB))
-	  //	ELog::EM<<"Failed on hit with "<<n<<ELog::endErr;
 	  
 	  // Note teh double loop : 
 	  //    -- A to track to scatter point [outer]
 	  //    -- B to track to track length point [inner]
-
-	  const MonteCarlo::Object* OPtr=this->findCell(n.Pos,defObj);
-	  
-	  while (OPtr->getImp())
+	  const MonteCarlo::Object* OPtr;
+#ifdef _OPENMP
+#pragma omp critical(SimMonteFindCell)
+#endif
+	  {
+	    cellHint=this->findCell(n.Pos,cellHint);
+	  }
+	  OPtr=cellHint;
+	  while (OPtr && OPtr->getImp())
 	    {
 	      Transport::ObjComponent Cell(OPtr);
-	      double R=RNG.randExc();
+	      double R=Transport::randGen().randExc();
 	      // Calculate forward Track:
-	      int surfN;
-	      surfN=Cell.trackWeight(n,R,surfPtr);   
+	      const int surfN=Cell.trackWeight(n,R,surfPtr);   
 	      if (surfN)  
-		OPtr=OSMPtr->findNextObject(surfN,n.Pos,
-					    OPtr->getName());
+		{
+		  // Note: Need OPPOSITE Sign on exiting surface
+		  OPtr=OSMPtr->findNextObject(-surfN,n.Pos,
+					      OPtr->getName());
+		  if (OPtr && !OPtr->getImp())
+		    DGrp.addEvent(n);
+		}
 	      else         // Internal scatter : Get new R
 		{
 		  /*
@@ -241,16 +259,16 @@ SimMonte::runMonte(const size_t Npts)
 		  
 		  // To sample you need : 
 		  // Direction / solid angle / dsigma/domega
-		  DUnit.project(n,Nout);                       // get both
+		  DGrp.project(n,Nout);                       // get both
 		  // Object
 		  Nout.weight*=CellS.catTotalRatio(n,Nout);
 		  // ATTENUATE:
 		  Layout.attenPath(Nout,SP.first,SP.second);
-		  DUnit.addEvent(Nout);
+		  DGrp.addEvent(Nout);
 		  // Now scattering neutron
 		  SP.second->scatterNeutron(n);
 		  do
-		    R=RNG.randExc();
+		    R=Transport::randGen().randExc();
 		  while(R-1.0>Geometry::shiftTol);
 		  */  
 		}
@@ -258,11 +276,176 @@ SimMonte::runMonte(const size_t Npts)
 	}
       catch (ColErr::NumericalAbort& A)
 	{
-	  ELog::EM<<"Failed at point :"<<i<<ELog::endCrit;
-	  ELog::EM<<"From :"<<A.what()<<ELog::endCrit;
+#ifdef _OPENMP
+#pragma omp critical(SimMonteLog)
+#endif
+	  {
+	    ELog::EM<<"Failed at point :"<<batchIndex<<":"<<i<<ELog::endCrit;
+	    ELog::EM<<"From :"<<A.what()<<ELog::endCrit;
+	  }
+	  nFail++;
 	}
     }
-  
+  return nFail;
+}
+
+size_t
+SimMonte::runEventBatch(const size_t batchIndex,const size_t NHist,
+			Transport::DetGroup& DGrp) const
+  /*!
+    Event based version of runBatch. The batch neutrons are
+    held in a ParticleBank and all the neutrons in a cell 
+    are tracked together. The bank is regrouped by cell
+    after each event.
+    \param batchIndex :: Batch number [random stream]
+    \param NHist :: Number of histories
+    \param DGrp :: Detectors of this batch
+    \return number of failed histories
+  */
+{
+  ELog::RegMethod RegA("SimMonte","runEventBatch");
+
+  Transport::RNGStream RStream(seed,batchIndex);
+  MonteCarlo::Object* cellHint(0);
+  const ModelSupport::ObjSurfMap* OSMPtr =getOSM();
+
+  Transport::ParticleBank PB;
+  PB.reserve(NHist);
+  for(size_t i=0;i<NHist;i++)
+    {
+      const MonteCarlo::neutron n=B->generateNeutron();
+#ifdef _OPENMP
+#pragma omp critical(SimMonteFindCell)
+#endif
+      {
+	cellHint=this->findCell(n.Pos,cellHint);
+      }
+      PB.addNeutron(n,cellHint);
+    }
+
+  size_t nFail(0);
+  std::vector<size_t> Group;
+  while(PB.sortCells())
+    {
+      // Random numbers in bank order [reproducible]
+      for(size_t i=0;i<PB.size();i++)
+	PB.R[i]=Transport::randGen().randExc();
+
+      PB.cellGroups(Group);
+      for(size_t g=1;g<Group.size();g++)
+	{
+	  try
+	    {
+	      const Transport::ObjComponent Cell(PB.Cell[Group[g-1]]);
+	      Cell.trackEvent(PB,Group[g-1],Group[g]);
+	    }
+	  catch (ColErr::NumericalAbort& A)
+	    {
+#ifdef _OPENMP
+#pragma omp critical(SimMonteLog)
+#endif
+	      {
+		ELog::EM<<"Failed at cell :"<<batchIndex<<":"
+			<<PB.Cell[Group[g-1]]->getName()<<ELog::endCrit;
+		ELog::EM<<"From :"<<A.what()<<ELog::endCrit;
+	      }
+	      for(size_t i=Group[g-1];i<Group[g];i++)
+		PB.Cell[i]=0;
+	      nFail+=Group[g]-Group[g-1];
+	    }
+	}
+      // Move neutrons that crossed a surface to the next cell
+      // and score those leaving into a zero importance cell
+      for(size_t i=0;i<PB.size();i++)
+	if (PB.Cell[i] && PB.SN[i])
+	  {
+	    PB.Cell[i]=OSMPtr->findNextObject
+	      (-PB.SN[i],Geometry::Vec3D(PB.X[i],PB.Y[i],PB.Z[i]),
+	       PB.Cell[i]->getName());
+	    if (PB.Cell[i] && !PB.Cell[i]->getImp())
+	      DGrp.addEvent(PB.getNeutron(i));
+	  }
+      // Internal scatter : [See runBatch]
+    }
+  return nFail;
+}
+
+void
+SimMonte::runMonte(const size_t Npts)
+  /*!
+    Run a specific number of histories. The batches are 
+    run in rounds of one batch per thread and the batch 
+    detectors added to DUnit in batch order. An exception
+    from a batch is rethrown [unchanged] after the round.
+    \param Npts :: number of points
+  */
+{
+  ELog::RegMethod RegA("SimMonte","runMonte");
+
+  if (!B)
+    throw ColErr::EmptyValue<void>("SimMonte::B");
+
+  const size_t NBatch((Npts+batchSize-1)/batchSize);
+#ifdef _OPENMP
+  const size_t NRound(static_cast<size_t>(omp_get_max_threads()));
+#else
+  const size_t NRound(1);
+#endif
+
+  // Batch scores for the error estimate
+  std::vector<double> Score;
+  for(size_t bStart=0;bStart<NBatch;bStart+=NRound)
+    {
+      const size_t NB(std::min(NRound,NBatch-bStart));
+      std::vector<Transport::DetGroup> BDet(NB,DUnit);
+      std::vector<size_t> NFail(NB,0);
+      std::vector<std::exception_ptr> BErr(NB);
+      const int NBI(static_cast<int>(NB));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1) if (NB>1)
+#endif
+      for(int ib=0;ib<NBI;ib++)
+	{
+	  const size_t index(static_cast<size_t>(ib));
+	  try
+	    {
+	      const size_t batchIndex(bStart+index);
+	      const size_t NHist=
+		std::min(batchSize,Npts-batchIndex*batchSize);
+	      BDet[index].clear();
+	      NFail[index]=(eventFlag) ?
+		runEventBatch(batchIndex,NHist,BDet[index]) :
+		runBatch(batchIndex,NHist,BDet[index]);
+	    }
+	  catch (...)
+	    {
+	      BErr[index]=std::current_exception();
+	    }
+	}
+      // Ordered reduction:
+      for(size_t index=0;index<NB;index++)
+	{
+	  if (BErr[index])
+	    std::rethrow_exception(BErr[index]);
+	  DUnit+=BDet[index];
+	  Score.push_back(BDet[index].getTotal());
+	  ELog::EM<<"Batch "<<bStart+index<<" : failed "<<NFail[index]
+		  <<" : score "<<Score.back()<<ELog::endDiag;
+	}
+      // Running mean / error over batches
+      const double NS(static_cast<double>(Score.size()));
+      double sum(0.0),sumSqr(0.0);
+      for(size_t i=0;i<Score.size();i++)
+	{
+	  sum+=Score[i];
+	  sumSqr+=Score[i]*Score[i];
+	}
+      const double mean(sum/NS);
+      const double var((NS>1.0) ? (sumSqr/NS-mean*mean)/(NS-1.0) : 0.0);
+      ELog::EM<<"Batches "<<Score.size()<<"/"<<NBatch<<" : mean score "
+	      <<mean<<" +/- "<<sqrt(std::max(var,0.0))<<ELog::endDiag;
+    }
+  TCount+=static_cast<long int>(Npts);
   return;
 }
 
@@ -42,6 +42,12 @@
 namespace ModelSupport
 {
 
+/// Per-thread context registry [0 : use process singleton]
+static SimTrack* contextPtr(0);
+#ifdef _OPENMP
+#pragma omp threadprivate(contextPtr)
+#endif
+
 SimTrack::SimTrack() 
   /*!
     Constructor
@@ -55,10 +61,25 @@ SimTrack::Instance()
     \return SimTrack object
    */
 {
+  if (contextPtr) return *contextPtr;
   static SimTrack ST;
   return ST;
 }
 
+SimTrack*
+SimTrack::setContext(SimTrack* CPtr)
+  /*!
+    Bind the calling thread to a BuildContext registry.
+    Instance() returns CPtr until reset with a null pointer.
+    \param CPtr :: Registry to use [0 for the process singleton]
+    \return previous registry [or 0]
+  */
+{
+  SimTrack* prevPtr=contextPtr;
+  contextPtr=CPtr;
+  return prevPtr;
+}
+
 void
 SimTrack::clearSim(const Simulation* SimPtr)
   /*!
@@ -103,6 +124,7 @@ SimTrack::setCell(const Simulation* SimPtr,MonteCarlo::Object* OPtr)
       if (OPtr)
 	throw ColErr::InContainerError<fcTYPE::key_type>
 	  (sInt,"SimTrack::setCell"+ELog::RegMethod::getFull());
+      return;
     }
   mc->second=OPtr;
   return;
@@ -22,6 +22,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <complex> 
 #include <vector>
@@ -44,6 +45,7 @@
 #include "NameStack.h"
 #include "RegMethod.h"
 #include "OutputLog.h"
+#include "BuildProfile.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "mathSupport.h"
@@ -101,12 +103,15 @@
 #include "ObjSurfMap.h"
 #include "PhysicsCards.h"
 #include "ReadFunctions.h"
+#include "MasterFile.h"
 #include "SimTrack.h"
+#include "BuildContext.h"
 #include "Simulation.h"
 
 Simulation::Simulation()  :
   CNum(100000),OSMPtr(new ModelSupport::ObjSurfMap),
-  PhysPtr(new physicsSystem::PhysicsCards)
+  PhysPtr(new physicsSystem::PhysicsCards),
+  BCPtr(new BuildContext(0))
   /*!
     Start of simulation Object
   */
@@ -118,7 +123,9 @@ Simulation::Simulation(const Simulation& A)  :
   inputFile(A.inputFile),CNum(A.CNum),DB(A.DB),
   OSMPtr(new ModelSupport::ObjSurfMap),
   TList(A.TList),  cellOutOrder(A.cellOutOrder),
-  PhysPtr(new physicsSystem::PhysicsCards(*A.PhysPtr))
+  PhysPtr(new physicsSystem::PhysicsCards(*A.PhysPtr)),
+  BCPtr(new BuildContext(A.BCPtr->isIsolated())),
+  ComplementCache(A.ComplementCache)
   /*!
     Copy constructor:: makes a deep copy of the point objects
     object including calling the virtual clone on the 
@@ -127,6 +134,8 @@ Simulation::Simulation(const Simulation& A)  :
   */
 {
   ModelSupport::SimTrack::Instance().addSim(this);
+  if (BCPtr->isIsolated())
+    BCPtr->getSimTrack().addSim(this);
   // Object
   OTYPE::const_iterator mc;
   for(mc=A.OList.begin();mc!=A.OList.end();mc++)
@@ -161,6 +170,7 @@ Simulation::operator=(const Simulation& A)
       DB=A.DB;
       TList=A.TList;
       cellOutOrder=A.cellOutOrder;
+      ComplementCache=A.ComplementCache;
       delete PhysPtr;
       PhysPtr=new physicsSystem::PhysicsCards(*A.PhysPtr);
       deleteObjects();
@@ -195,6 +205,26 @@ Simulation::~Simulation()
   delete OSMPtr;
   deleteObjects();
   deleteTally();
+  delete BCPtr;
+}
+
+void
+Simulation::isolateContext()
+  /*!
+    Replace the shared (process singleton) registries with
+    a private set owned by this simulation. Must be called
+    before any component is built. The context is used by
+    code running under a BuildContextGuard on getContext().
+  */
+{
+  ELog::RegMethod RegA("Simulation","isolateContext");
+  if (!BCPtr->isIsolated())
+    {
+      delete BCPtr;
+      BCPtr=new BuildContext(1);
+      BCPtr->getSimTrack().addSim(this);
+    }
+  return;
 }
 
 void
@@ -209,6 +239,7 @@ Simulation::resetAll()
   PhysPtr->clearAll();
   deleteTally();
   deleteObjects();
+  ComplementCache.clear();
   cellOutOrder.clear();
   CNum=0;
   masterRotate& MR = masterRotate::Instance();
@@ -445,6 +476,7 @@ Simulation::addCell(const int cellNumber,const MonteCarlo::Qhull& A)
     }
 
   OList.insert(OTYPE::value_type(cellNumber,A.clone()));
+  ELog::BuildProfile::Instance().count(ELog::BuildProfile::cell);
   MonteCarlo::Qhull* QHptr=OList[cellNumber];
   QHptr->setName(cellNumber);
   if (setMaterialDensity(cellNumber))
@@ -516,6 +548,8 @@ Simulation::readMaster(const std::string& Fname)
     - Materials
     - Weights
     - Physics
+    The file is memory mapped and split at the section
+    headers in one pass. 
     \param Fname :: Master file name (with full path)
   */
   
@@ -534,7 +568,11 @@ Simulation::readMaster(const std::string& Fname)
       throw ColErr::ExitAbort(RegA.getFull());
       return;
     }
+  IX.close();
   inputFile=Fname;
+  // Single pass for the lines and section headers
+  const MasterFile MF(Fname);
+  
 /* Read components and then calculate sections */
   int nT(0);     // Transforms 
   int nS(0);     // Surfaces 
@@ -544,39 +582,61 @@ Simulation::readMaster(const std::string& Fname)
   int nTa(0);    // Tallys
   int nP(0);     // Physics
 
-  while(IX.good())
+  // A section is read upto its END [as a stream] and the
+  // next header is searched for after it
+  const std::vector<MasterFile::HTYPE>& Headers=MF.getHeaders();
+  const size_t NL(MF.getNLine());
+  size_t lineB(0);
+  for(size_t i=0;i<Headers.size();i++)
     {
-      std::string Einfo=StrFunc::getLine(IX);
-      if (Einfo.find("TRANSFORM CARDS")!=std::string::npos)
-        {
-	  ELog::EM.debug("Reading Transforms");
-	  nT+=readTransform(IX);
+      if (Headers[i].first<lineB) continue;   // within the last section
+      const int sType(Headers[i].second);
+      const size_t lineA(Headers[i].first+1);
+      lineB=lineA;
+      std::vector<std::string> Lines;
+      std::istringstream SX;
+      if (sType==2 || sType==3)        // Lines upto and including END
+	{
+	  int ignore(0);
+	  while(lineB<NL)
+	    {
+	      Lines.push_back(MF.getLine(lineB++,sType==2));
+	      if (ReadFunc::sectionEnd(Lines.back(),ignore))
+		break;
+	    }
 	}
-      else if (Einfo.find("SURFACE CARDS")!=std::string::npos)
-        {
+      else
+	SX.str(MF.getText(lineA,NL));
+
+      switch (sType)
+	{
+	case 1:                          // TRANSFORM CARDS
+	  ELog::EM.debug("Reading Transforms");
+	  nT+=readTransform(SX);
+	  break;
+	case 2:                          // SURFACE CARDS
 	  ELog::EM.debug("Reading surfaces");
-	  nS+=ReadFunc::readSurfaces(DB,IX,0);
-	}
-      else if (Einfo.find("CELL CARDS")!=std::string::npos)
-        {
+	  nS+=ReadFunc::readSurfaces(DB,Lines,0);
+	  break;
+	case 3:                          // CELL CARDS
 	  ELog::EM.debug("Reading cells");
-	  nC+=ReadFunc::readCells(DB,IX,0,OList);
-	}
-      else if (Einfo.find("MATERIAL CARDS")!=std::string::npos)
-        {
+	  nC+=ReadFunc::readCells(DB,Lines,0,OList);
+	  break;
+	case 4:                          // MATERIAL CARDS
 	  ELog::EM.debug("Reading materials");
-	  nM+=ReadFunc::readMaterial(IX);
-	}
-      else if (Einfo.find("TALLY CARDS")!=std::string::npos)
-        {
+	  nM+=ReadFunc::readMaterial(SX);
+	  break;
+	case 5:                          // TALLY CARDS
 	  ELog::EM.debug("Reading Tally");
-	  nTa+=readTally(IX);
-	}
-      else if (Einfo.find("PHYSICS CARDS")!=std::string::npos)
-        {
+	  nTa+=readTally(SX);
+	  break;
+	case 6:                          // PHYSICS CARDS
 	  ELog::EM.debug("Reading Physics");
-	  nP+=ReadFunc::readPhysics(DB,IX,PhysPtr);
+	  nP+=ReadFunc::readPhysics(DB,SX,PhysPtr);
+	  break;
 	}
+      if (sType!=2 && sType!=3)
+	lineB=MF.getLineIndex(lineA,static_cast<long int>(SX.tellg()));
     }
   RegA.incIndent();
   ELog::EM<<"Number of  Transforms == "<<nT<<ELog::endTrace;
@@ -587,7 +647,6 @@ Simulation::readMaster(const std::string& Fname)
   ELog::EM<<"Number of Tallies == "<<nTa<<ELog::endTrace;
   ELog::EM<<"Number of Physics == "<<nP<<ELog::endTrace;
   RegA.decIndent();
-  IX.close();
 
   if (applyTransforms())
     {
@@ -954,6 +1013,10 @@ int
 Simulation::removeComplements()
   /*!
     Expand each complement on a tree.
+    The cell strings are all resolved first (so they do not
+    depend on the cell order), each distinct string is expanded
+    once and the results are processed into the cells in order.
+    The expansions are kept in ComplementCache for later builds.
     \retval 0 on success, 
     \retval -1 failed to find surface key
   */
@@ -962,6 +1025,11 @@ Simulation::removeComplements()
 
   populateCells();
   int retVal(0);
+
+  std::vector<MonteCarlo::Qhull*> Work;    // Cells to expand
+  std::vector<std::string> CellStr;        // Cell string of Work
+  std::vector<std::string> NewStr;         // Strings to expand
+  std::set<std::string> NewSet;
   OTYPE::iterator vc;
   for(vc=OList.begin();vc!=OList.end();vc++)
     {
@@ -971,16 +1039,11 @@ Simulation::removeComplements()
         {  
 	  if (workObj.isPopulated())
 	    {
-	      MonteCarlo::Algebra AX;
-	      AX.setFunctionObjStr(workObj.cellStr(OList));
-	      if (!workObj.procString(AX.writeMCNPX()))
-		{
-		  ELog::EM<<"Error processing Algebra Complement : "
-			  <<ELog::endErr;
-		  throw ColErr::ExitAbort(RegA.getFull());
-		}
-	      workObj.populate();
-	      workObj.createSurfaceList();
+	      Work.push_back(&workObj);
+	      CellStr.push_back(workObj.cellStr(OList));
+	      if (ComplementCache.find(CellStr.back())==ComplementCache.end()
+		  && NewSet.insert(CellStr.back()).second)
+		NewStr.push_back(CellStr.back());
 	    }
 	  else 
 	    {
@@ -990,6 +1053,54 @@ Simulation::removeComplements()
 	    }
 	}
     }
+
+  // Expansion only depends on the string : 
+  // each thread uses its own Algebra
+  std::vector<std::string> Expand(NewStr.size());
+  std::vector<int> Failed(NewStr.size(),0);
+  const long int NS=static_cast<long int>(NewStr.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1) if (NS>1)
+#endif
+  for(long int i=0;i<NS;i++)
+    {
+      const size_t index(static_cast<size_t>(i));
+      try
+	{
+	  MonteCarlo::Algebra AX;
+	  AX.setFunctionObjStr(NewStr[index]);
+	  Expand[index]=AX.writeMCNPX();
+	}
+      // exceptions cannot leave the parallel region
+      catch (...)
+	{
+	  Failed[index]=1;
+	}
+    }
+  for(size_t i=0;i<NewStr.size();i++)
+    {
+      if (Failed[i])       // repeat to throw on this thread
+	{
+	  MonteCarlo::Algebra AX;
+	  AX.setFunctionObjStr(NewStr[i]);
+	  Expand[i]=AX.writeMCNPX();
+	}
+      ComplementCache.insert(std::map<std::string,std::string>::
+			     value_type(NewStr[i],Expand[i]));
+    }
+
+  for(size_t i=0;i<Work.size();i++)
+    {
+      MonteCarlo::Qhull& workObj= *Work[i];
+      if (!workObj.procString(ComplementCache[CellStr[i]]))
+	{
+	  ELog::EM<<"Error processing Algebra Complement : "
+		  <<ELog::endErr;
+	  throw ColErr::ExitAbort(RegA.getFull());
+	}
+      workObj.populate();
+      workObj.createSurfaceList();
+    }
   return retVal;
 }
 
@@ -1039,12 +1150,45 @@ Simulation::populateCells()
   ELog::RegMethod RegA("Simulation","populateCells");
   
   OTYPE::iterator oc;
+  std::vector<MonteCarlo::Qhull*> Work;
+  for(oc=OList.begin();oc!=OList.end();oc++)
+    Work.push_back(oc->second);
+
+  // Surface look up only reads the surfIndex 
+  BuildContext* CPtr=BuildContext::current();
+  std::vector<int> Failed(Work.size(),0);
+  const long int NW=static_cast<long int>(Work.size());
+#ifdef _OPENMP
+#pragma omp parallel if (NW>1)
+#endif
+  {
+    BuildContext* prevPtr=BuildContext::activate(CPtr);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,16)
+#endif
+    for(long int i=0;i<NW;i++)
+      {
+	const size_t index(static_cast<size_t>(i));
+	try
+	  {
+	    Work[index]->populate();
+	    Work[index]->createSurfaceList();
+	  }
+	// exceptions cannot leave the parallel region
+	catch (ColErr::ExBase&)
+	  {
+	    Failed[index]=1;
+	  }
+      }
+    BuildContext::activate(prevPtr);
+  }
 
   int retVal(0);
-  for(oc=OList.begin();oc!=OList.end();oc++)
+  for(size_t i=0;i<Work.size();i++)
     {
-      MonteCarlo::Qhull& workObj= *(oc->second);
-      try
+      if (!Failed[i]) continue;
+      MonteCarlo::Qhull& workObj= *Work[i];
+      try                   // repeat to throw on this thread
         {
 	  workObj.populate();
 	  workObj.createSurfaceList();
@@ -1457,6 +1601,7 @@ Simulation::findCell(const Geometry::Vec3D& Pt,
     \retval 0 :: No cell exists
   */
 {
+  ELog::BuildProfile::Instance().count(ELog::BuildProfile::findCell);
   ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
   // First test users guess:
   if (testCell && testCell->isValid(Pt))
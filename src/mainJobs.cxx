@@ -68,6 +68,7 @@
 #include "MeshCreate.h"
 #include "MatMD5.h"
 #include "MD5sum.h"
+#include "MatFraction.h"
 #include "Visit.h"
 #include "mainJobs.h"
 
@@ -124,11 +125,11 @@ createVTK(const mainSystem::inputParam& IParam,
 {
   ELog::RegMethod RegA("createVTK","createVTK");
 
-  if (IParam.flag("md5") || IParam.flag("vtk"))
+  if (IParam.flag("md5") || IParam.flag("vtk") || IParam.flag("matFrac"))
     {
       if (!IParam.flag("meshA") || !IParam.flag("meshB") || !IParam.flag("MN"))
 	{
-	  ELog::EM<<"Failed to process VTK/MD5 since mesh and nps "
+	  ELog::EM<<"Failed to process VTK/MD5/matFrac since mesh and nps "
 		  <<"not definded"<<ELog::endErr;
 	  return -1;
 	}
@@ -138,6 +139,7 @@ createVTK(const mainSystem::inputParam& IParam,
 	IParam.getValue<size_t>("meshNPS",2) };
       Geometry::Vec3D MeshA=IParam.getValue<Geometry::Vec3D>("meshA");
       Geometry::Vec3D MeshB=IParam.getValue<Geometry::Vec3D>("meshB");
+      int flag(0);
       if (IParam.flag("md5"))
 	{
 	  ELog::EM<<"Processing MD5:"<<ELog::endBasic;
@@ -146,9 +148,32 @@ createVTK(const mainSystem::inputParam& IParam,
 	  MM.setIndex(meshPts[0],meshPts[1],meshPts[2]);
 	  MM.populate(SimPtr);
 	  std::cout<<"MM == "<<MM<<std::endl;
-	  return 1;
+	  flag=1;
 	}
 
+      if (IParam.flag("matFrac"))
+	{
+	  ELog::EM<<"Processing Material fractions:"<<ELog::endBasic;
+	  const std::string FName(Oname+".mfrac");
+	  std::ofstream OX(FName.c_str());
+	  if (!OX.good())
+	    {
+	      ELog::EM<<"Failed to open material fraction file "
+		      <<FName<<ELog::endErr;
+	      return -1;
+	    }
+	  MatFraction MF;
+	  MF.setBox(MeshA,MeshB);
+	  MF.setIndex(meshPts[0],meshPts[1],meshPts[2]);
+	  MF.setSubSample(IParam.getValue<size_t>("matFrac"));
+	  MF.populate(SimPtr);
+	  MF.write(OX);
+	  OX.close();
+	  flag=1;
+	}
+      if (flag)
+	return 1;
+
       if (IParam.flag("vtk"))
 	{
 	  ELog::EM<<"Processing VTK:"<<ELog::endBasic;
@@ -55,6 +55,12 @@
 #include "localRotate.h"
 #include "masterRotate.h"
 
+/// Per-thread context registry [0 : use process singleton]
+static masterRotate* contextPtr(0);
+#ifdef _OPENMP
+#pragma omp threadprivate(contextPtr)
+#endif
+
 masterRotate::masterRotate() : 
   localRotate(),globalApplied(0)
   /*!
@@ -69,10 +75,25 @@ masterRotate::Instance()
     \return masterRotate object
    */
 {
+  if (contextPtr) return *contextPtr;
   static masterRotate MR;
   return MR;
 }
 
+masterRotate*
+masterRotate::setContext(masterRotate* CPtr)
+  /*!
+    Bind the calling thread to a BuildContext registry.
+    Instance() returns CPtr until reset with a null pointer.
+    \param CPtr :: Registry to use [0 for the process singleton]
+    \return previous registry [or 0]
+  */
+{
+  masterRotate* prevPtr=contextPtr;
+  contextPtr=CPtr;
+  return prevPtr;
+}
+
 Geometry::Vec3D
 masterRotate::calcRotate(const Geometry::Vec3D& V) const
   /*!
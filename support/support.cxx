@@ -23,6 +23,8 @@
 #include <iomanip>
 #include <cstdio>
 #include <cstring>
+#include <cstdlib>
+#include <climits>
 #include <fstream>
 #include <sstream>
 #include <cmath>
@@ -510,6 +512,155 @@ fullBlock(const std::string& A)
   return A.substr(posA,posB-posA);
 }
 
+size_t
+convPartNum(const char* A,double& out)
+  /*!
+    Allocation free read of the first double in a 
+    character string. The grammar is that of the stream
+    operator>> : [ws][+-]digits[.digits][(e|E)[+-]digits] 
+    and trailing characters are allowed. 
+    \param A :: string to process
+    \param out :: place for output
+    \retval number of char read on success
+    \retval 0 on failure
+  */ 
+{
+  if (!A) return 0;
+  const char* cPtr(A);
+  while(isspace(static_cast<unsigned char>(*cPtr))) cPtr++;
+  const char* startPtr(cPtr);
+
+  if (*cPtr=='+' || *cPtr=='-') cPtr++;
+  size_t nDigit(0);
+  for(;isdigit(static_cast<unsigned char>(*cPtr));cPtr++,nDigit++) ;
+  if (*cPtr=='.')
+    for(cPtr++;isdigit(static_cast<unsigned char>(*cPtr));
+	cPtr++,nDigit++) ;
+  if (!nDigit) return 0;
+  if (*cPtr=='e' || *cPtr=='E')
+    {
+      cPtr++;
+      if (*cPtr=='+' || *cPtr=='-') cPtr++;
+      // stream read fails on an empty exponent
+      if (!isdigit(static_cast<unsigned char>(*cPtr)))
+	return 0;
+      for(;isdigit(static_cast<unsigned char>(*cPtr));cPtr++) ;
+    }
+  
+  // Copy : strtod on A would accept hex/inf forms
+  const size_t NLen(static_cast<size_t>(cPtr-startPtr));
+  char Buffer[64];
+  char* endPtr;
+  double retval;
+  if (NLen<sizeof(Buffer))
+    {
+      memcpy(Buffer,startPtr,NLen);
+      Buffer[NLen]=0;
+      retval=strtod(Buffer,&endPtr);
+      if (endPtr!=Buffer+NLen) return 0;
+    }
+  else
+    {
+      const std::string Item(startPtr,NLen);
+      retval=strtod(Item.c_str(),&endPtr);
+      if (endPtr!=Item.c_str()+NLen) return 0;
+    }
+  // Overflow is a failure [as stream]
+  if (retval==HUGE_VAL || retval== -HUGE_VAL)
+    return 0;
+
+  out=retval;
+  return static_cast<size_t>(cPtr-A);
+}
+
+size_t
+convPartNum(const char* A,int& out)
+  /*!
+    Allocation free read of the first int in a 
+    character string. Trailing characters are allowed. 
+    Values outside of the int range fail.
+    \param A :: string to process
+    \param out :: place for output
+    \retval number of char read on success
+    \retval 0 on failure
+  */ 
+{
+  if (!A) return 0;
+  const char* cPtr(A);
+  while(isspace(static_cast<unsigned char>(*cPtr))) cPtr++;
+
+  const int sign((*cPtr=='-') ? -1 : 1);
+  if (*cPtr=='+' || *cPtr=='-') cPtr++;
+  if (!isdigit(static_cast<unsigned char>(*cPtr)))
+    return 0;
+
+  // Limit is 1 more for -ve : but overflow must read all digits
+  const long int maxV=(sign>0) ? 
+    static_cast<long int>(INT_MAX) : -static_cast<long int>(INT_MIN);
+  long int retval(0);
+  int overFlag(0);
+  for(;isdigit(static_cast<unsigned char>(*cPtr));cPtr++)
+    {
+      if (!overFlag)
+	{
+	  retval=10*retval+(*cPtr-'0');
+	  if (retval>maxV) overFlag=1;
+	}
+    }
+  if (overFlag) return 0;
+
+  out=static_cast<int>(sign*retval);
+  return static_cast<size_t>(cPtr-A);
+}
+
+size_t
+convPartNum(const char* A,std::string& out)
+  /*!
+    Allocation free read of the first word in a 
+    character string [as operator>>]
+    \param A :: string to process
+    \param out :: place for output
+    \retval number of char read on success
+    \retval 0 on failure
+  */ 
+{
+  if (!A) return 0;
+  const char* cPtr(A);
+  while(isspace(static_cast<unsigned char>(*cPtr))) cPtr++;
+  const char* startPtr(cPtr);
+  while(*cPtr && !isspace(static_cast<unsigned char>(*cPtr))) cPtr++;
+  if (cPtr==startPtr) return 0;
+
+  out.assign(startPtr,cPtr);
+  return static_cast<size_t>(cPtr-A);
+}
+
+template<typename T>
+size_t
+convPartNum(const char* A,T& out)
+  /*!
+    Takes a character string and evaluates 
+    the first [typename T] object by a stream read.
+    Used for the types that do not have a direct read.
+    \param A :: string to process
+    \param out :: place for output
+    \retval number of char read on success
+    \retval 0 on failure
+  */ 
+{
+  if (!A || !*A) return 0;
+  std::istringstream cx(A);
+  T retval;
+  if ((cx>>retval).fail())
+    return 0;
+  // -ve if the stream hit the end
+  const long int xpt=cx.tellg();
+  const size_t ALen(strlen(A));
+  out=retval;
+  return (static_cast<size_t>(xpt)>ALen) ? 
+    ALen : static_cast<size_t>(xpt); 
+}
+
 template<typename T>
 int
 sectPartNum(std::string& A,T& out)
@@ -524,74 +675,62 @@ sectPartNum(std::string& A,T& out)
     \returns 1 on success 0 on failure
    */ 
 {
-  if (A.empty())
-    return 0;
-
-  std::istringstream cx(A);
   T retval;
-  if ((cx>>retval).fail())
+  const size_t xpt=convPartNum(A.c_str(),retval);
+  if (!xpt)
     return 0;
 
-  const std::ptrdiff_t xpt=cx.tellg();
-  const int xc=cx.get();
-  if (cx.fail())
-    A.erase(0,static_cast<size_t>(xpt));
-  else if (isspace(xc) || xc==',')
-    A.erase(0,static_cast<size_t>(xpt+1));
+  if (xpt<A.size() && 
+      (isspace(static_cast<unsigned char>(A[xpt])) || A[xpt]==','))
+    A.erase(0,xpt+1);
   else  
-    A.erase(0,static_cast<size_t>(xpt));
+    A.erase(0,xpt);
   out=retval;
   return 1; 
 }
 
-
 template<typename T>
 int 
 section(char* cA,T& out)
   /*!
     Takes a character string and evaluates 
-    the first [typename T] object. The string is then filled with
-    spaces upto the end of the [typename T] object
+    the first [typename T] object. The string is then 
+    moved down to remove the [typename T] object
     \param cA :: char array for input and output. 
     \param out :: place for output
     \returns 1 on success 0 on failure
    */ 
 {
-  if (!cA) return 0;
-  std::string sA(cA);
-  const int item(section(sA,out));
-  if (item)
-    {
-      strcpy(cA,sA.c_str());
-      return 1;
-    }
-  return 0;
+  const char* cPtr(cA);
+  if (!section(cPtr,out)) return 0;
+  memmove(cA,cPtr,strlen(cPtr)+1);
+  return 1;
 }
 
 template<typename T>
 int
-section(std::string& A,T& out)
+section(const char*& cPtr,T& out)
   /*! 
     Takes a character string and evaluates 
-    the first \<T\> object. The string is then filled with
-    spaces upto the end of the \<T\> object
-    \param A :: string for input and output. 
+    the first \<T\> object. The cursor is moved past
+    the object and a single space/comma separator.
+    Nothing is copied.
+    \param cPtr :: cursor for input and output. 
     \param out :: place for output
     \return 1 on success 0 on failure
   */
 {
-  if (A.empty()) return 0;
-  std::istringstream cx(A);
+  if (!cPtr || !*cPtr) return 0;
   T retval;
-  if ((cx>>retval).fail())
+  const size_t xpt=convPartNum(cPtr,retval);
+  if (!xpt)
     return 0;
 
-  const std::ptrdiff_t xpt=cx.tellg();
-  const int xc=cx.get();
-  if (cx.fail())
-    A.erase(0,static_cast<size_t>(xpt));
-  else if (isspace(xc) || xc==',')
-    A.erase(0,static_cast<size_t>(xpt+1));
+  const char xc=cPtr[xpt];
+  if (!xc)
+    cPtr+=xpt;
+  else if (isspace(static_cast<unsigned char>(xc)) || xc==',')
+    cPtr+=xpt+1;
   else
     return 0;
 
@@ -599,6 +738,24 @@ section(std::string& A,T& out)
   return 1;
 }
 
+template<typename T>
+int
+section(std::string& A,T& out)
+  /*! 
+    Takes a character string and evaluates 
+    the first \<T\> object. The string is then filled with
+    spaces upto the end of the \<T\> object
+    \param A :: string for input and output. 
+    \param out :: place for output
+    \return 1 on success 0 on failure
+  */
+{
+  const char* cPtr(A.c_str());
+  if (!section(cPtr,out)) return 0;
+  A.erase(0,static_cast<size_t>(cPtr-A.c_str()));
+  return 1;
+}
+
 
 template<typename T>
 int
@@ -623,13 +780,43 @@ fortRead(std::string& A,const size_t N,T& out)
   return 0;
 }
 
+template<typename T>
+int
+sectionMCNPX(const char*& cPtr,T& out)
+/*!
+  Takes a character string and evaluates 
+  the first [T] object. The cursor is moved to
+  the end of the [T] object.
+  This version deals with MCNPX numbers. Those
+  are numbers that are crushed together like
+  - 5.4938e+04-3.32923e-6
+  \param out :: place for output
+  \param cPtr :: cursor for input and output. 
+  \return 1 on success 0 on failure
+*/
+{
+  if (!cPtr || !*cPtr) return 0;
+  T retval;
+  const size_t xpt=convPartNum(cPtr,retval);
+  if (!xpt)
+    return 0;
+
+  const char xc=cPtr[xpt];
+  if (xc && !isspace(static_cast<unsigned char>(xc)) 
+      && (xc!='-' || xpt<5))
+    return 0;
+  cPtr+=xpt;
+  out=retval;
+  return 1;
+}
+
 template<typename T>
 int
 sectionMCNPX(std::string& A,T& out)
 /*!
   Takes a character string and evaluates 
-  the first [T] object. The string is then filled with
-  spaces upto the end of the [T] object.
+  the first [T] object. The string is then cut
+  upto the end of the [T] object.
   This version deals with MCNPX numbers. Those
   are numbers that are crushed together like
   - 5.4938e+04-3.32923e-6
@@ -638,25 +825,10 @@ sectionMCNPX(std::string& A,T& out)
   \return 1 on success 0 on failure
 */
 {
-  if (A.empty()) return 0;
-  std::istringstream cx;
-  T retval;
-  cx.str(A);
-  cx.clear();
-  cx>>retval;
-  if (!cx.fail())
-    {
-      //      const int xpt=static_cast<int>(cx.tellg());
-      const long int xpt=cx.tellg();
-      const int xc=cx.get();
-      if (!cx.fail() && !isspace(xc) 
-	  && (xc!='-' || xpt<5))
-	return 0;
-      A.erase(0,static_cast<size_t>(xpt));
-      out=retval;
-      return 1;
-    }
-  return 0;
+  const char* cPtr(A.c_str());
+  if (!sectionMCNPX(cPtr,out)) return 0;
+  A.erase(0,static_cast<size_t>(cPtr-A.c_str()));
+  return 1;
 }
 
 
@@ -806,19 +978,7 @@ convPartNum(const std::string& A,T& out)
     \retval 0 on failure
   */ 
 {
-  if (A.empty()) return 0;
-  std::istringstream cx;
-  T retval;
-  cx.str(A);
-  cx.clear();
-  cx>>retval;
-  if (cx.fail())
-    return 0;
-  // -ve on error
-  const long int xpt=cx.tellg();
-  out=retval;
-  return (static_cast<size_t>(xpt)>A.size()) ? 
-    A.size() : static_cast<size_t>(xpt); 
+  return convPartNum(A.c_str(),out);
 }
 
 template<typename T>
@@ -831,16 +991,11 @@ convert(const std::string& A,T& out)
   \returns 0 on failure 1 on success
 */
 {
-  if (A.empty()) return 0;
-  std::istringstream cx;
   T retval;
-  cx.str(A);
-  cx.clear();
-  cx>>retval;
-  if (cx.fail())  
+  const size_t xpt=convPartNum(A.c_str(),retval);
+  if (!xpt)  
     return 0;
-  const int clast=cx.get();
-  if (!cx.fail() && !isspace(clast))
+  if (xpt<A.size() && !isspace(static_cast<unsigned char>(A[xpt])))
     return 0;
   out=retval;
   return 1;
@@ -1040,6 +1195,12 @@ template int sectPartNum(std::string&,int&);
 template int sectPartNum(std::string&,size_t&);
 template int sectionMCNPX(std::string&,double&);
 
+template int section(const char*&,double&);
+template int section(const char*&,int&);
+template int section(const char*&,size_t&);
+template int section(const char*&,std::string&);
+template int sectionMCNPX(const char*&,double&);
+
 template int fortRead(std::string&,const size_t,int&);
 
 template int convert(const std::string&,double&);
@@ -1055,6 +1216,7 @@ template size_t convPartNum(const std::string&,double&);
 template size_t convPartNum(const std::string&,int&);
 template size_t convPartNum(const std::string&,size_t&);
 template size_t convPartNum(const std::string&,std::string&);
+template size_t convPartNum(const char*,size_t&);
 
 template int setValues(const std::string&,const std::vector<int>&,
 		      std::vector<double>&);
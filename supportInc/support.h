@@ -67,6 +67,11 @@ int getPartLine(std::istream&,std::string&,std::string&,const size_t= 256);
 template<typename T> int fortRead(std::string&,const size_t,T&);
 
 template<typename T> size_t convPartNum(const std::string&,T&);
+/// Allocation free number reads [trailing chars allowed]
+size_t convPartNum(const char*,double&);
+size_t convPartNum(const char*,int&);
+size_t convPartNum(const char*,std::string&);
+template<typename T> size_t convPartNum(const char*,T&);
 
 /// Convert a string into a number
 template<typename T> int convert(const std::string&,T&);
@@ -77,8 +82,12 @@ int setValues(const std::string&,const std::vector<int>&,
 
 template<typename T> int sectPartNum(std::string&,T&);
 template<typename T> int section(std::string&,T&);
+/// Convert and advance a cursor
+template<typename T> int section(const char*&,T&);
 /// Convert and cut a string for MCNPX
 template<typename T> int sectionMCNPX(std::string&,T&);
+/// Convert and advance a cursor for MCNPX
+template<typename T> int sectionMCNPX(const char*&,T&);
 template<typename T> int itemize(std::string&,std::string&,T&);
 
 
@@ -195,6 +195,7 @@ testAttachSupport::testInsertComponent()
 {
   ELog::RegMethod RegA("testAttachSupport","testInsertComponent");
 
+  initSim();
   SObj.push_back(SOTYPE(new testSystem::simpleObj("A")));
   SObj.back()->addInsertCell(5001);
   SObj.back()->createAll(ASim,World::masterOrigin());
@@ -23,6 +23,7 @@
 #include <iomanip>
 #include <fstream>
 #include <cmath>
+#include <climits>
 #include <string>
 #include <vector>
 #include <complex>
@@ -73,11 +74,15 @@ testBinData::applyTest(const int extra)
   typedef int (testBinData::*testPtr)();
   testPtr TPtr[]=
     {
-      &testBinData::testAdd
+      &testBinData::testAdd,
+      &testBinData::testAddPoint,
+      &testBinData::testRebinSet
     };
   const std::string TestName[]=
     {
-      "Add"
+      "Add",
+      "AddPoint",
+      "RebinSet"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -133,3 +138,127 @@ testBinData::testAdd()
       }
   return 0;
 }
+
+int
+testBinData::testAddPoint()
+  /*!
+    Test the histogram filling and merge of thread copies
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testBinData","testAddPoint");
+
+  // Uniform and irregular grids
+  BinData A;
+  BinData B;
+  double xB(0.0);
+  for(int i=0;i<10;i++)
+    {
+      A.addData(i+0.0,i+1.0,0.0);
+      B.addData(xB,xB+0.1*(i+1),0.0);
+      xB+=0.1*(i+1);
+    }
+  const double XPts[]={-0.5,0.0,0.95,3.0,3.5,9.99,10.0,5.49,5.7};
+  const size_t AIndex[]={ULONG_MAX,0,0,3,3,9,ULONG_MAX,5,5};
+  const size_t BIndex[]={ULONG_MAX,0,3,7,7,ULONG_MAX,ULONG_MAX,9,ULONG_MAX};
+
+  for(size_t i=0;i<sizeof(XPts)/sizeof(double);i++)
+    {
+      if (A.findBin(XPts[i])!=AIndex[i] ||
+	  B.findBin(XPts[i])!=BIndex[i])
+	{
+	  ELog::EM<<"X == "<<XPts[i]<<ELog::endDiag;
+	  ELog::EM<<"A == "<<A.findBin(XPts[i])<<" ("<<AIndex[i]<<")"
+		  <<ELog::endDiag;
+	  ELog::EM<<"B == "<<B.findBin(XPts[i])<<" ("<<BIndex[i]<<")"
+		  <<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  // Two copies filled separately and merged
+  BinData C(A);
+  for(int i=0;i<100;i++)
+    {
+      A.addPoint(0.1*i,1.0);
+      C.addPoint(0.1*i+0.05,2.0);
+    }
+  A+=C;
+  const std::vector<BUnit>& AData=A.getData();
+  for(size_t i=0;i<AData.size();i++)
+    if (fabs(AData[i].Y.getVal()-30.0)>1e-7)
+      {
+	ELog::EM<<"["<<i<<"] == "<<AData[i]<<ELog::endDiag;
+	return -2;
+      }
+  return 0;
+}
+
+int
+testBinData::testRebinSet()
+  /*!
+    Test the rebin of a set of spectra against the 
+    single spectrum rebin and that a Boundary for a 
+    different grid is rejected
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testBinData","testRebinSet");
+
+  // Two spectra on each of two grids
+  std::vector<BinData> BSet(4);
+  for(int i=0;i<10;i++)
+    {
+      BSet[0].addData(i+0.0,i+1.0,1.0+i);
+      BSet[1].addData(i+0.0,i+1.0,2.0-0.1*i);
+    }
+  for(int i=0;i<13;i++)
+    {
+      BSet[2].addData(0.9*i-1.0,0.9*i-0.1,1.0+0.5*i);
+      BSet[3].addData(0.9*i-1.0,0.9*i-0.1,3.0);
+    }
+  std::vector<BinData> Single(BSet);
+
+  std::vector<BUnit> XOut;
+  for(int i=0;i<7;i++)
+    XOut.push_back(BUnit(0.5+1.3*i,1.8+1.3*i,0.0));
+
+  BinData::rebinSet(BSet,XOut);
+  for(size_t i=0;i<BSet.size();i++)
+    {
+      Single[i].rebin(XOut);
+      const std::vector<BUnit>& YA(BSet[i].getData());
+      const std::vector<BUnit>& YB(Single[i].getData());
+      if (YA.size()!=XOut.size() || YA.size()!=YB.size())
+	{
+	  ELog::EM<<"Size failure["<<i<<"] "<<YA.size()<<ELog::endDiag;
+	  return -1;
+	}
+      for(size_t j=0;j<YA.size();j++)
+	if (YA[j].Y!=YB[j].Y)
+	  {
+	    ELog::EM<<"Failed on point["<<i<<"]["<<j<<"] "
+		    <<YA[j]<<" "<<YB[j]<<ELog::endDiag;
+	    return -2;
+	  }
+    }
+
+  // Overlap of a 13 bin grid applied to a 10 bin spectrum
+  BinData A;
+  BinData C;
+  for(int i=0;i<13;i++)
+    C.addData(0.9*i-1.0,0.9*i-0.1,1.0);
+  for(int i=0;i<10;i++)
+    A.addData(i+0.0,i+1.0,1.0);
+  Boundary XComp;
+  XComp.setBoundary(C.getData(),XOut);
+  try
+    {
+      A.rebin(XComp,XOut);
+      ELog::EM<<"Mismatched Boundary accepted"<<ELog::endDiag;
+      return -3;
+    }
+  catch (ColErr::ExBase&)
+    { }
+  return 0;
+}
@@ -73,6 +73,7 @@ testBnId::applyTest(const int extra)
     {
       std::cout<<"Extra options "<<std::endl;
       std::cout<<"testMinTerm          (1)"<<std::endl;
+      std::cout<<"testPrimeImplicant   (2)"<<std::endl;
     }
   int retVal;
   if (extra<0 || extra==1)
@@ -82,6 +83,13 @@ testBnId::applyTest(const int extra)
       if (retVal)
 	return retVal;
     }
+  if (extra<0 || extra==2)
+    {
+      TestFunc::regTest("testPrimeImplicant");
+      retVal=testPrimeImplicant();
+      if (retVal)
+	return retVal;
+    }
 
   return 0;
 }
@@ -99,3 +107,76 @@ testBnId::testMinTerm()
   return 0;
 }
 
+
+int 
+testBnId::testPrimeImplicant()
+  /*!
+    Test the prime implicants of a function : each
+    must be an implicant, no literal can be dropped 
+    and every true minterm must be covered.
+    \retval -1 :: Failed 
+    \retval 0 :: success
+   */
+{
+  ELog::RegMethod RegA("testBnId","testPrimeImplicant");
+
+  typedef std::pair<size_t,std::string> TTYPE;
+  std::vector<TTYPE> Tests;
+  Tests.push_back(TTYPE(3,"0 1 2 5 6 7"));
+  Tests.push_back(TTYPE(4,"0 2 5 7 8 10 13 15"));
+  Tests.push_back(TTYPE(4,"1 3 4 5 6 7 9 11 12 13 14 15"));
+  Tests.push_back(TTYPE(5,"0 1 2 3 8 9 10 11 16 17 18 19 24 25 26 27 31"));
+  // Number of PIs
+  const size_t NPI[]={6,2,2,2};
+
+  for(size_t i=0;i<Tests.size();i++)
+    {
+      const size_t N(Tests[i].first);
+      std::set<size_t> TrueSet;
+      std::vector<BnId> Work;
+      std::istringstream cx(Tests[i].second);
+      size_t index;
+      while(cx>>index)
+	{
+	  TrueSet.insert(index);
+	  Work.push_back(BnId(N,index));
+	}
+      std::vector<BnId> PIComp;
+      BnId::primeImplicants(Work,PIComp);
+
+      int flag(PIComp.size()!=NPI[i]);
+      std::set<size_t> Covered;
+      for(size_t j=0;j<PIComp.size() && !flag;j++)
+	{
+	  for(size_t mt=0;mt<(1UL << N);mt++)
+	    if (PIComp[j].equivalent(BnId(N,mt)))
+	      {
+		if (TrueSet.find(mt)==TrueSet.end())
+		  flag=1;
+		Covered.insert(mt);
+	      }
+	  // maximal : freeing any literal must cover a false term
+	  for(size_t bit=0;bit<N && !flag;bit++)
+	    if (PIComp[j][bit])
+	      {
+		int implicant(1);
+		for(size_t mt=0;mt<(1UL << N) && implicant;mt++)
+		  {
+		    const BnId Item(N,mt ^ (1UL << bit));
+		    if (PIComp[j].equivalent(Item) &&
+			TrueSet.find(mt)==TrueSet.end())
+		      implicant=0;
+		  }
+		if (implicant) flag=1;
+	      }
+	}
+      if (flag || Covered!=TrueSet)
+	{
+	  ELog::EM<<"Test "<<i<<" : "<<Tests[i].second<<ELog::endDiag;
+	  for(size_t j=0;j<PIComp.size();j++)
+	    ELog::EM<<"PI["<<j<<"] == "<<PIComp[j]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
@@ -0,0 +1,489 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   test/testENDF.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <boost/multi_array.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Exception.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "Triple.h"
+#include "ENDFfile.h"
+#include "SQWtable.h"
+#include "SEtable.h"
+#include "ENDFmaterial.h"
+
+#include "testFunc.h"
+#include "testENDF.h"
+
+using namespace ENDF;
+
+/*!
+  Write an ENDF real field [1.234567+5 form]
+  \param V :: Value
+  \return 11 character field
+*/
+static std::string
+endfReal(const double V)
+{
+  char Out[32];
+  snprintf(Out,32,"%.6e",V);
+  char* EPtr=strchr(Out,'e');
+  *EPtr=0;
+  const int E=atoi(EPtr+1);
+  char Field[32];
+  snprintf(Field,32,"%s%+d",Out,E);
+  snprintf(Out,32,"%11s",Field);
+  return Out;
+}
+
+/*!
+  Write an ENDF integer field
+  \param V :: Value
+  \return 11 character field
+*/
+static std::string
+endfInt(const int V)
+{
+  char Out[32];
+  snprintf(Out,32,"%11d",V);
+  return Out;
+}
+
+/*!
+  Write an ENDF line
+  \param OX :: Output stream
+  \param D :: Data columns [1-66]
+  \param mat :: MAT number
+  \param mf :: MF number
+  \param mt :: MT number
+*/
+static void
+endfLine(std::ostream& OX,const std::string& D,
+	 const int mat,const int mf,const int mt)
+{
+  char Out[128];
+  snprintf(Out,128,"%-66s%4d%2d%3d%5d",D.c_str(),mat,mf,mt,0);
+  OX<<Out<<std::endl;
+  return;
+}
+
+/*!
+  Write a list of reals as ENDF lines [6 per line]
+  \param OX :: Output stream
+  \param V :: Values
+  \param mat :: MAT number
+*/
+static void
+endfRows(std::ostream& OX,const std::vector<double>& V,const int mat)
+{
+  for(size_t i=0;i<V.size();i+=6)
+    {
+      std::string D;
+      for(size_t j=i;j<V.size() && j<i+6;j++)
+	D+=endfReal(V[j]);
+      endfLine(OX,D,mat,7,4);
+    }
+  return;
+}
+
+/*!
+  Write a small synthetic MF7/MT4 file [free gas like S(alpha,beta)]
+  \param FName :: File name
+*/
+static void
+writeMF7(const std::string& FName)
+{
+  const int mat(101);
+  std::ofstream OX(FName.c_str());
+  endfLine(OX," synthetic",1,0,0);
+  endfLine(OX,endfReal(1001.0)+endfReal(0.99917)+
+	   endfInt(0)+endfInt(0)+endfInt(0)+endfInt(0),mat,1,451);
+  endfLine(OX,"",mat,1,0);
+  // HEAD : ZA AWR LAT LASYM
+  endfLine(OX,endfReal(1001.0)+endfReal(0.99917)+
+	   endfInt(0)+endfInt(0)+endfInt(0)+endfInt(0),mat,7,4);
+  // B list
+  endfLine(OX,endfReal(0.0)+endfReal(0.0)+
+	   endfInt(0)+endfInt(0)+endfInt(6)+endfInt(0),mat,7,4);
+  const double BVec[]={20.0,2.0,1.0,5.0,1.0,1.0};
+  endfRows(OX,std::vector<double>(BVec,BVec+6),mat);
+
+  const int NA(12);
+  const int NB(10);
+  endfLine(OX,endfReal(0.0)+endfReal(0.0)+
+	   endfInt(0)+endfInt(0)+endfInt(1)+endfInt(NB),mat,7,4);
+  endfLine(OX,endfInt(NB)+endfInt(4),mat,7,4);
+  for(int j=0;j<NB;j++)
+    {
+      const double beta=0.02*j*j;
+      endfLine(OX,endfReal(296.0)+endfReal(beta)+
+	       endfInt(0)+endfInt(0)+endfInt(1)+endfInt(NA),mat,7,4);
+      endfLine(OX,endfInt(NA)+endfInt(4),mat,7,4);
+      std::vector<double> Pts;
+      for(int i=0;i<NA;i++)
+	{
+	  const double alpha=0.01*pow(1.5,i);
+	  Pts.push_back(alpha);
+	  Pts.push_back(exp(-(alpha-beta)*(alpha-beta)/(4.0*alpha))/
+			sqrt(4.0*M_PI*alpha));
+	}
+      endfRows(OX,Pts,mat);
+    }
+  // Teff
+  endfLine(OX,endfReal(0.0)+endfReal(0.0)+
+	   endfInt(0)+endfInt(0)+endfInt(1)+endfInt(1),mat,7,4);
+  endfLine(OX,endfInt(1)+endfInt(2),mat,7,4);
+  const double TVec[]={296.0,1200.0};
+  endfRows(OX,std::vector<double>(TVec,TVec+2),mat);
+  endfLine(OX,"",mat,7,0);
+  return;
+}
+
+/*!
+  Determine if a file exists
+  \param FName :: File name
+  \return 1 if the file exists
+*/
+static int
+fileExists(const std::string& FName)
+{
+  struct stat SBuf;
+  return (stat(FName.c_str(),&SBuf)) ? 0 : 1;
+}
+
+testENDF::testENDF() 
+  /*!
+    Constructor
+  */
+{}
+
+testENDF::~testENDF() 
+  /*!
+    Destructor
+  */
+{}
+
+int 
+testENDF::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Test number to run
+    \returns -ve on error 0 on success.
+  */
+{
+  ELog::RegMethod RegA("testENDF","applyTest");
+
+  typedef int (testENDF::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testENDF::testCache,
+      &testENDF::testFile,
+      &testENDF::testReadReal,
+      &testENDF::testSQWgrid
+    };
+  const std::string TestName[]=
+    {
+      "Cache",
+      "File",
+      "ReadReal",
+      "SQWgrid"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testENDF::testCache()
+  /*!
+    Test the binary table cache of ENDFmaterial : the
+    cached load matches the parsed load and a cache that
+    cannot be written does not stop the load
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testENDF","testCache");
+
+  const std::string CDir("testENDF.cache");
+  const std::string FName("testENDF.endf");
+  const std::string CName(CDir+"/"+FName+".t0.sqw");
+  const std::string IName(CDir+"/"+FName+".cidx");
+  ENDFfile::setCacheDir(CDir);
+  writeMF7(FName);
+
+  const double EVal[]={0.001,0.01,0.1,1.0};
+  int retVal(0);
+  ENDFmaterial A;
+  if (A.ENDF7file(FName) || !fileExists(CName) || 
+      !fileExists(IName) || fileExists(FName+".cidx"))
+    {
+      ELog::EM<<"Failed to write cache"<<ELog::endTrace;
+      retVal=-1;
+    }
+
+  ENDFmaterial B;
+  if (!retVal && B.ENDF7file(FName))
+    retVal=-2;
+  for(size_t i=0;!retVal && i<4;i++)
+    if ((i<2 && A.sigma(EVal[i])<=0.0) || 
+	A.sigma(EVal[i])!=B.sigma(EVal[i]))
+      {
+	ELog::EM<<"Cache sigma["<<EVal[i]<<"] "<<A.sigma(EVal[i])
+		<<" "<<B.sigma(EVal[i])<<ELog::endTrace;
+	retVal=-3;
+      }
+
+  // unwritable cache : load still succeeds
+  std::remove(CName.c_str());
+  mkdir((CName+".tmp").c_str(),0755);
+  ENDFmaterial C;
+  if (!retVal && (C.ENDF7file(FName) || fileExists(CName) ||
+		  C.sigma(EVal[1])!=A.sigma(EVal[1])))
+    {
+      ELog::EM<<"Failed on unwritable cache"<<ELog::endTrace;
+      retVal=-4;
+    }
+  rmdir((CName+".tmp").c_str());
+
+  std::remove(CName.c_str());
+  std::remove(IName.c_str());
+  std::remove(FName.c_str());
+  rmdir(CDir.c_str());
+  ENDFfile::setCacheDir(".");
+  return retVal;
+}
+
+int
+testENDF::testFile()
+  /*!
+    Test the reading of records and the section index
+    [.cidx] of an ENDF file
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testENDF","testFile");
+
+  const std::string CDir("testENDF.cache");
+  const std::string FName("testENDFfile.endf");
+  const std::string IName(CDir+"/"+FName+".cidx");
+  ENDFfile::setCacheDir(CDir);
+  
+  std::ofstream OX(FName.c_str());
+  endfLine(OX," test file",1,0,0);
+  endfLine(OX," 1.001000+3 9.991673-1          0"
+	   "          0          0          0",125,1,451);
+  endfLine(OX," 1.002000+3 2.000000+0          0"
+	   "          1          1          0",125,7,4);
+  endfLine(OX,"          0          0          0"
+	   "          0          8          2",125,7,4);
+  endfLine(OX," 1.0        2.0        3.0        4.0"
+	   "        5.0        6.0       ",125,7,4);
+  endfLine(OX," 7.0        1.2E5",125,7,4);
+  endfLine(OX,"",125,7,0);
+  OX.close();
+
+  int retVal(0);
+  double c1,c2;
+  int l1,l2,n1,n2;
+  std::vector<double> D;
+  for(int pass=0;!retVal && pass<3;pass++)
+    {
+      // pass 1 : from index / pass 2 : changed file
+      if (pass==2)
+	{
+	  std::ofstream OY(FName.c_str(),std::ios::app);
+	  endfLine(OY," 3.000000+0",125,3,1);
+	}
+      try
+	{
+	  ENDFfile EF(FName);
+	  const double EVal[]={1,2,3,4,5,6,7,1.2e5};
+	  const std::vector<double> Expect(EVal,EVal+8);
+	  if (EF.firstMat()!=125 || !EF.hasSection(125,7,4) ||
+	      EF.hasSection(125,7,2) || !fileExists(IName) ||
+	      EF.hasSection(125,3,1)!=(pass==2))
+	    retVal=-1;
+	  else
+	    {
+	      EF.findSection(0,7,0);
+	      EF.headRead(c1,c2,l1,l2,n1,n2);
+	      EF.listRead(c1,c2,l1,l2,n1,n2,D);
+	      if (n1!=8 || D!=Expect)
+		retVal=-2;
+	    }
+	}
+      catch (ColErr::ExBase& A)
+	{
+	  ELog::EM<<"Exception "<<A.what()<<ELog::endTrace;
+	  retVal=-3;
+	}
+      if (retVal)
+	ELog::EM<<"Failed on pass "<<pass<<ELog::endTrace;
+    }
+  std::remove(IName.c_str());
+  std::remove(FName.c_str());
+  rmdir(CDir.c_str());
+  ENDFfile::setCacheDir(".");
+  return retVal;
+}
+
+int
+testENDF::testReadReal()
+  /*!
+    Test the reading of fixed field reals
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testENDF","testReadReal");
+
+  // field : flag : value
+  typedef boost::tuple<std::string,int,double> TTYPE;
+  std::vector<TTYPE> Tests;
+  Tests.push_back(TTYPE(" 1.234567+5",1,1.234567e5));
+  Tests.push_back(TTYPE("-2.5-3",1,-2.5e-3));
+  Tests.push_back(TTYPE("  1.0E+02",1,100.0));
+  Tests.push_back(TTYPE("  1.2E5",1,1.2e5));
+  Tests.push_back(TTYPE("1.2e-3 ",1,1.2e-3));
+  Tests.push_back(TTYPE(" -4.5D2",1,-450.0));
+  Tests.push_back(TTYPE(" 3.14159   ",1,3.14159));
+  Tests.push_back(TTYPE("           ",1,0.0));
+  Tests.push_back(TTYPE("       12  ",1,12.0));
+  Tests.push_back(TTYPE("1.2.3",0,0.0));
+  Tests.push_back(TTYPE("abc",0,0.0));
+  Tests.push_back(TTYPE("1.2E",0,0.0));
+  Tests.push_back(TTYPE("1.2+",0,0.0));
+  Tests.push_back(TTYPE("1.2E+",0,0.0));
+
+  std::vector<TTYPE>::const_iterator tc;
+  for(tc=Tests.begin();tc!=Tests.end();tc++)
+    {
+      const std::string& Field=tc->get<0>();
+      int flag;
+      const double V=ENDFfile::readReal
+	(Field.c_str(),Field.c_str()+Field.size(),flag);
+      if (flag!=tc->get<1>() || 
+	  fabs(V-tc->get<2>())>1e-12*fabs(tc->get<2>()))
+	{
+	  ELog::EM<<"Failed on ["<<Field<<"] "<<V<<" "<<flag
+		  <<" : expect "<<tc->get<2>()<<" "
+		  <<tc->get<1>()<<ELog::endTrace;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testENDF::testSQWgrid()
+  /*!
+    Test the gridded S(alpha,beta) against the table,
+    including a block of zero entries
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testENDF","testSQWgrid");
+
+  const double AVal[]={0.1,0.2,0.5,1.0,2.0,5.0};
+  const double BVal[]={0.0,0.5,1.0,2.0,3.0,5.0};
+  SQWtable SQ;
+  SQ.setNAlpha(6);
+  SQ.setNBeta(6);
+  const std::vector<double> aVec(AVal,AVal+6);
+  for(size_t j=0;j<6;j++)
+    {
+      SQ.Beta[j]=BVal[j];
+      // S is zero from alpha==2 
+      std::vector<double> sVec;
+      for(size_t i=0;i<6;i++)
+	sVec.push_back((i<4) ? exp(-AVal[i]-BVal[j]/2.0) : 0.0);
+      SQ.setData(j,aVec,sVec);
+    }
+  SQ.makeGrid(200,200);
+
+  for(size_t i=0;i<=50;i++)
+    for(size_t j=0;j<=50;j++)
+      {
+	const double beta=0.1+2.8*static_cast<double>(j)/50.0;
+	// alpha[0.15:0.95] : non-zero region
+	double alpha=0.15+0.8*static_cast<double>(i)/50.0;
+	double SG=SQ.gridSab(alpha,beta);
+	double ST=SQ.tableSab(alpha,beta);
+	if (fabs(SG-ST)>1e-3*ST)
+	  {
+	    ELog::EM<<"Failed on alpha/beta "<<alpha<<" "<<beta<<ELog::endTrace;
+	    ELog::EM<<"Grid/Table "<<SG<<" "<<ST<<ELog::endTrace;
+	    return -1;
+	  }
+	// alpha[1.05:1.95] : cell with zero corners
+	alpha=1.05+0.9*static_cast<double>(i)/50.0;
+	SG=SQ.gridSab(alpha,beta);
+	ST=SQ.tableSab(alpha,beta);
+	if (SG!=0.0 || ST!=0.0)
+	  {
+	    ELog::EM<<"Failed on zero alpha/beta "
+		    <<alpha<<" "<<beta<<ELog::endTrace;
+	    ELog::EM<<"Grid/Table "<<SG<<" "<<ST<<ELog::endTrace;
+	    return -2;
+	  }
+      }
+  return 0;
+}
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <sstream>
 #include <climits>
+#include <cstdio>
 #include <cmath>
 #include <list>
 #include <vector>
@@ -79,8 +80,10 @@ testFunction::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testFunction::testAnalyse,
+      &testFunction::testBinary,
       &testFunction::testBuiltIn,
       &testFunction::testEval,
+      &testFunction::testMemo,
       &testFunction::testString, 
       &testFunction::testVec3D
     };
@@ -88,8 +91,10 @@ testFunction::applyTest(const int extra)
   const std::string TestName[]=
     {
       "Analyse",
+      "Binary",
       "BuiltIn",
       "Eval",
+      "Memo",
       "String",
       "Vec3D"
     };
@@ -162,6 +167,84 @@ testFunction::testAnalyse()
   return 0;
 }
 
+int
+testFunction::testBinary()
+  /*!
+    Test the binary snapshot and the content hash
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testFunction","testBinary");
+
+  const std::string FName("testFunction.bin");
+  FuncDataBase XX;   
+  XX.addVariable("alpha",3.0);
+  XX.addVariable("count",4);
+  XX.addVariable("name",std::string("Value"));
+  XX.addVariable("V",Geometry::Vec3D(1,2,3));
+  XX.Parse("alpha*count+1.0");
+  XX.addVariable("gamma");
+
+  const size_t HA=XX.contentHash();
+  XX.writeBinary(FName);
+
+  FuncDataBase YY;
+  const size_t HFile=YY.readBinary(FName);
+  std::remove(FName.c_str());
+
+  if (HFile!=HA || YY.contentHash()!=HA)
+    {
+      ELog::EM<<"Hash : "<<HA<<" "<<HFile<<" "
+	      <<YY.contentHash()<<ELog::endTrace;
+      return -1;
+    }
+  if (fabs(YY.EvalVar<double>("gamma")-13.0)>1e-6 ||
+      YY.EvalVar<int>("count")!=4 ||
+      YY.EvalVar<std::string>("name")!="Value" ||
+      YY.EvalVar<Geometry::Vec3D>("V")!=Geometry::Vec3D(1,2,3))
+    {
+      ELog::EM<<"gamma == "<<YY.EvalVar<double>("gamma")<<ELog::endTrace;
+      ELog::EM<<"V == "<<YY.EvalVar<Geometry::Vec3D>("V")<<ELog::endTrace;
+      return -2;
+    }
+
+  // Hash follows changes and returns on restore
+  YY.setVariable("alpha",5.0);
+  if (YY.contentHash()==HA || 
+      fabs(YY.EvalVar<double>("gamma")-21.0)>1e-6)
+    {
+      ELog::EM<<"Hash not updated"<<ELog::endTrace;
+      return -3;
+    }
+  YY.setVariable("alpha",3.0);
+  if (YY.contentHash()!=HA)
+    {
+      ELog::EM<<"Hash not restored"<<ELog::endTrace;
+      return -4;
+    }
+
+  // Same variables in a different order : same content hash
+  FuncDataBase ZZ;   
+  ZZ.addVariable("V",Geometry::Vec3D(1,2,3));
+  ZZ.addVariable("name",std::string("Value"));
+  ZZ.addVariable("count",4);
+  ZZ.addVariable("alpha",3.0);
+  ZZ.Parse("alpha*count+1.0");
+  ZZ.addVariable("gamma");
+  if (ZZ.contentHash()!=HA)
+    {
+      ELog::EM<<"Order hash : "<<HA<<" "<<ZZ.contentHash()<<ELog::endTrace;
+      return -5;
+    }
+  // variableHash is the MD5 of the variable list
+  if (XX.variableHash().size()!=32)
+    {
+      ELog::EM<<"Variable hash : "<<XX.variableHash()<<ELog::endTrace;
+      return -6;
+    }
+  return 0;
+}
+
 int
 testFunction::testBuiltIn()
   /*!
@@ -243,6 +326,64 @@ testFunction::testEval()
   return 0;
 }
 
+int
+testFunction::testMemo()
+  /*!
+    Test that memoised functions are recalculated
+    when a variable they depend on changes
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testFunction","testMemo");
+
+  FuncDataBase XX;   
+  XX.addVariable("alpha",1.0);
+  XX.Parse("alpha*2.0");
+  XX.addVariable("beta");
+  XX.Parse("beta+1.0");
+  XX.addVariable("gamma");
+
+  const int cHandle=XX.getHandle("gamma");
+  if (cHandle<0 || XX.getHandle("noVariable")!=-1)
+    {
+      ELog::EM<<"Handle failure :"<<cHandle<<ELog::endTrace;
+      return -1;
+    }
+
+  typedef boost::tuple<double,double> TTYPE;
+  std::vector<TTYPE> Tests;
+  Tests.push_back(TTYPE(1.0,3.0));
+  Tests.push_back(TTYPE(5.0,11.0));
+  Tests.push_back(TTYPE(-2.0,-3.0));
+
+  std::vector<TTYPE>::const_iterator tc;
+  for(tc=Tests.begin();tc!=Tests.end();tc++)
+    {
+      XX.setVariable("alpha",tc->get<0>());
+      // First evaluation from several threads : shared memo
+      int nFail(0);
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nFail)
+#endif
+      for(int i=0;i<64;i++)
+	if (fabs(XX.EvalVar<double>("gamma")-tc->get<1>())>1e-6)
+	  nFail++;
+      // Evaluate twice : second read is from the cache
+      const double CA=XX.EvalVar<double>("gamma");
+      const double CB=XX.EvalHandle<double>(cHandle);
+      if (nFail || fabs(CA-tc->get<1>())>1e-6 || 
+	  fabs(CB-tc->get<1>())>1e-6)
+	{
+	  ELog::EM<<"alpha == "<<tc->get<0>()<<ELog::endTrace;
+	  ELog::EM<<"Thread failures == "<<nFail<<ELog::endTrace;
+	  ELog::EM<<"gamma == "<<CA<<" "<<CB<<" ("
+		  <<tc->get<1>()<<")"<<ELog::endTrace;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
 int
 testFunction::testVec3D()
   /*!
@@ -219,10 +219,12 @@ testLineTrack::applyTest(const int extra)
   typedef int (testLineTrack::*testPtr)();
   testPtr TPtr[]=
     {
+      &testLineTrack::testCorner,
       &testLineTrack::testLine
     };
   const std::string TestName[]=
     {
+      "Corner",
       "Line"
     };
   
@@ -252,6 +254,76 @@ testLineTrack::applyTest(const int extra)
 }
 
 
+int
+testLineTrack::testCorner()
+  /*!
+    Tracks across the edge where four cells meet.
+    The track must not cycle round the edge and the 
+    track length must be split between the two cells 
+    on the line.
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testLineTrack","testCorner");
+
+  ASim.resetAll();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  SurI.createSurface(1,"px 0");
+  SurI.createSurface(2,"py 0");
+  SurI.createSurface(11,"px -3");
+  SurI.createSurface(12,"px 3");
+  SurI.createSurface(13,"py -3");
+  SurI.createSurface(14,"py 3");
+  SurI.createSurface(15,"pz -3");
+  SurI.createSurface(16,"pz 3");
+  SurI.createSurface(100,"so 25");
+
+  // Outer void / four quarters / void
+  ASim.addCell(MonteCarlo::Qhull(1,0,0.0,"100"));
+  ASim.addCell(MonteCarlo::Qhull(2,0,0.0,"1 2 -12 -14 15 -16"));
+  ASim.addCell(MonteCarlo::Qhull(3,0,0.0,"-1 2 11 -14 15 -16"));
+  ASim.addCell(MonteCarlo::Qhull(4,0,0.0,"-1 -2 11 13 15 -16"));
+  ASim.addCell(MonteCarlo::Qhull(5,0,0.0,"1 -2 -12 13 15 -16"));
+  ASim.addCell(MonteCarlo::Qhull(6,0,0.0,"-100 (-11:12:-13:14:-15:16)"));
+  ASim.createObjSurfMap();
+
+  // Point A : Point B : Sum of cellID x track
+  typedef boost::tuple<Geometry::Vec3D,Geometry::Vec3D,double> TTYPE;
+
+  std::vector<TTYPE> Tests;
+  Tests.push_back(TTYPE(Geometry::Vec3D(-1,1,0),Geometry::Vec3D(1,-1,0),
+			8.0*sqrt(2.0)));
+  Tests.push_back(TTYPE(Geometry::Vec3D(1,-1,0),Geometry::Vec3D(-1,1,0),
+			8.0*sqrt(2.0)));
+  Tests.push_back(TTYPE(Geometry::Vec3D(-1,-1,0),Geometry::Vec3D(1,1,0),
+			6.0*sqrt(2.0)));
+
+  std::vector<TTYPE>::const_iterator tc;
+  for(tc=Tests.begin();tc!=Tests.end();tc++)
+    {
+      LineTrack LT(tc->get<0>(),tc->get<1>());
+      LT.calculate(ASim);
+      const std::vector<int>& cells=LT.getCells();
+      const std::vector<double>& tLen=LT.getTrack();
+      double tTotal(0.0);
+      double tValue(0.0);
+      for(size_t i=0;i<cells.size();i++)
+	{
+	  tTotal+=tLen[i];
+	  tValue+=tLen[i]*cells[i];
+	}
+      if (fabs(tTotal-2.0*sqrt(2.0))>1e-5 ||
+	  fabs(tValue-tc->get<2>())>1e-3)
+	{
+	  ELog::EM<<"Failed on test :"<<(tc-Tests.begin())+1<<ELog::endDiag;
+	  ELog::EM<<"Track == "<<tTotal<<" : "<<tValue<<ELog::endDiag;
+	  ELog::EM<<LT<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
 int
 testLineTrack::testLine()
   /*!
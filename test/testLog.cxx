@@ -30,6 +30,7 @@
 #include <complex>
 #include <string>
 #include <algorithm>
+#include <boost/tuple/tuple.hpp>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -37,6 +38,9 @@
 #include "NameStack.h"
 #include "RegMethod.h"
 #include "OutputLog.h"
+#include "BuildProfile.h"
+#include "CallProfile.h"
+#include "support.h"
 
 #include "testFunc.h"
 #include "testLog.h" 
@@ -65,10 +69,14 @@ testLog::applyTest(const int extra)
   typedef int (testLog::*testPtr)();
   testPtr TPtr[]=
     {
+      &testLog::testBuildProfile,
+      &testLog::testCallProfile,
       &testLog::testENDL
     };
   const std::string TestName[]=
     {
+      "BuildProfile",
+      "CallProfile",
       "ENDL"
     };
   
@@ -96,6 +104,193 @@ testLog::applyTest(const int extra)
   return 0;
 }
 
+int
+testLog::testBuildProfile()
+  /*!
+    Test the phase counters of the BuildProfile
+    \return 0 on success
+   */
+{
+  ELog::RegMethod RegA("testLog","testBuildProfile");
+
+  ELog::BuildProfile& BP=ELog::BuildProfile::Instance();
+  // Not recorded before activation
+  if (!BP.isActive())
+    {
+      ELog::ProfilePhase Inactive("testInactive");
+    }
+  BP.activate("");
+
+  const size_t cellN=BP.getCount(ELog::BuildProfile::cell);
+  {
+    ELog::ProfilePhase Outer("testOuter");
+    BP.count(ELog::BuildProfile::cell);
+    {
+      ELog::ProfilePhase Inner("testInner");
+      BP.count(ELog::BuildProfile::cell);
+      BP.count(ELog::BuildProfile::surface);
+    }
+    Outer.end();
+    BP.count(ELog::BuildProfile::cell);
+  }
+  if (BP.getCount(ELog::BuildProfile::cell)!=cellN+3)
+    {
+      ELog::EM<<"Cell count == "<<BP.getCount(ELog::BuildProfile::cell)
+	      <<" ["<<cellN+3<<"]"<<ELog::endDiag;
+      return -1;
+    }
+
+  // phase,depth,time,rss,peakRSS,surfaces,cells,...
+  std::ostringstream cx;
+  BP.writeCSV(cx);
+  std::istringstream IX(cx.str());
+  std::string Line;
+  std::string OuterLine,InnerLine;
+  while(std::getline(IX,Line))
+    {
+      if (Line.compare(0,10,"testOuter,")==0)
+	OuterLine=Line;
+      else if (Line.compare(0,10,"testInner,")==0)
+	InnerLine=Line;
+      else if (Line.compare(0,13,"testInactive,")==0)
+	{
+	  ELog::EM<<"Inactive phase recorded"<<ELog::endDiag;
+	  return -2;
+	}
+    }
+  std::replace(OuterLine.begin(),OuterLine.end(),',',' ');
+  std::replace(InnerLine.begin(),InnerLine.end(),',',' ');
+  const std::vector<std::string> OItem=StrFunc::StrParts(OuterLine);
+  const std::vector<std::string> IItem=StrFunc::StrParts(InnerLine);
+  if (OItem.size()<7 || IItem.size()<7 ||
+      OItem[1]!="0" || IItem[1]!="1" ||
+      OItem[5]!="1" || OItem[6]!="2" ||
+      IItem[5]!="1" || IItem[6]!="1")
+    {
+      ELog::EM<<"Outer == "<<OuterLine<<ELog::endDiag;
+      ELog::EM<<"Inner == "<<InnerLine<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
+double
+testLog::spinWork(const size_t N)
+  /*!
+    Busy work to give a method some time
+    \param N :: Number of loops
+    \return sum [to keep the loop]
+  */
+{
+  double sum(0.0);
+  for(size_t i=0;i<N;i++)
+    sum+=sqrt(static_cast<double>(i));
+  return sum;
+}
+
+int
+testLog::testCallProfile()
+  /*!
+    Test the folded stacks and the inclusive / exclusive
+    times of nested and recursive calls. The exclusive 
+    times of a nest sum to the inclusive time of the outer
+    call, and a recursive method is only counted once in 
+    its inclusive time.
+    \return 0 on success
+   */
+{
+  ELog::RegMethod RegA("testLog","testCallProfile");
+
+  ELog::CallProfile& CP=ELog::CallProfile::Instance();
+  const int activeFlag=CP.isActive();
+  if (!activeFlag)
+    CP.activate("");
+
+  double sum(0.0);
+  // outer -> inner [twice]
+  ELog::CallProfile::enter("testCallProfile","outer");
+  sum+=spinWork(100000);
+  for(size_t i=0;i<2;i++)
+    {
+      ELog::CallProfile::enter("testCallProfile","inner");
+      sum+=spinWork(100000);
+      ELog::CallProfile::leave();
+    }
+  ELog::CallProfile::leave();
+  // recur -> recur -> recur 
+  for(size_t i=0;i<3;i++)
+    {
+      ELog::CallProfile::enter("testCallProfile","recur");
+      sum+=spinWork(100000);
+    }
+  for(size_t i=0;i<3;i++)
+    ELog::CallProfile::leave();
+
+  if (!activeFlag)
+    CP.deactivate();
+
+  std::ostringstream fx,cx;
+  CP.write(fx,cx);
+
+  // Folded stacks : stack time[us]
+  const std::string FStack[]=
+    { "testCallProfile::outer",
+      "testCallProfile::outer;testCallProfile::inner",
+      "testCallProfile::recur;testCallProfile::recur;"
+      "testCallProfile::recur" };
+  for(size_t i=0;i<3;i++)
+    {
+      const std::string Item("\n"+FStack[i]+" ");
+      if (("\n"+fx.str()).find(Item)==std::string::npos)
+	{
+	  ELog::EM<<"Missing stack "<<FStack[i]<<" in \n"
+		  <<fx.str()<<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  // calls inclusive exclusive class::method [6 figures]
+  std::map<std::string,boost::tuple<size_t,double,double> > CMap;
+  std::istringstream IX(cx.str());
+  std::string Line;
+  while(std::getline(IX,Line))
+    {
+      std::istringstream lx(Line);
+      size_t nCall;
+      double incl,excl;
+      std::string Name;
+      if (lx>>nCall>>incl>>excl>>Name &&
+	  Name.compare(0,17,"testCallProfile::")==0)
+	CMap[Name.substr(17)]=boost::make_tuple(nCall,incl,excl);
+    }
+  if (CMap.size()!=3 || 
+      CMap["outer"].get<0>()!=1 || CMap["inner"].get<0>()!=2 ||
+      CMap["recur"].get<0>()!=3)
+    {
+      ELog::EM<<"Calls == \n"<<cx.str()<<ELog::endDiag;
+      return -2;
+    }
+  const double outerIncl=CMap["outer"].get<1>();
+  const double nestExcl=CMap["outer"].get<2>()+CMap["inner"].get<2>();
+  const double innerIncl=CMap["inner"].get<1>();
+  const double recurIncl=CMap["recur"].get<1>();
+  if (outerIncl<=0.0 || fabs(nestExcl-outerIncl)>1e-4*outerIncl ||
+      fabs(CMap["inner"].get<2>()-innerIncl)>1e-4*innerIncl ||
+      innerIncl>=outerIncl)
+    {
+      ELog::EM<<"Nested calls == \n"<<cx.str()<<ELog::endDiag;
+      return -3;
+    }
+  // recursive : inclusive is the outer call = sum of exclusive
+  if (recurIncl<=0.0 || 
+      fabs(CMap["recur"].get<2>()-recurIncl)>1e-4*recurIncl)
+    {
+      ELog::EM<<"Recursive calls == \n"<<cx.str()<<ELog::endDiag;
+      return -4;
+    }
+  return (sum>0.0) ? 0 : -5;
+}
+
 int
 testLog::testENDL()
   /*!
@@ -0,0 +1,187 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   test/testNeutMaterial.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <complex>
+#include <cmath>
+#include <list>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <boost/multi_array.hpp>
+
+#include "MersenneTwister.h"
+#include "Exception.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Triple.h"
+#include "neutMaterial.h"
+#include "SymUnit.h"
+#include "AtomPos.h"
+#include "loopItem.h"
+#include "CifLoop.h"
+#include "CifStore.h"
+#include "CryMat.h"
+
+#include "testFunc.h"
+#include "testNeutMaterial.h"
+
+using namespace scatterSystem;
+
+testNeutMaterial::testNeutMaterial() 
+  /*!
+    Constructor
+  */
+{}
+
+testNeutMaterial::~testNeutMaterial() 
+  /*!
+    Destructor
+  */
+{}
+
+int 
+testNeutMaterial::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Test number to run
+    \returns -ve on error 0 on success.
+  */
+{
+  ELog::RegMethod RegA("testNeutMaterial","applyTest");
+
+  typedef int (testNeutMaterial::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testNeutMaterial::testTable
+    };
+  const std::string TestName[]=
+    {
+      "Table"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testNeutMaterial::checkTable(const neutMaterial& NM)
+  /*!
+    Check the table lookups against the direct cross sections
+    [relative 5e-5] including wavelengths outside the table
+    \param NM :: Material with a table over 0.5-10A
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testNeutMaterial","checkTable");
+
+  const double tol(5e-5);
+  const double Length(2.0);
+  std::vector<double> Wave,TVec(1001),SVec(1001);
+  for(size_t i=0;i<=1000;i++)
+    Wave.push_back(0.3+10.7*static_cast<double>(i)/1000.0);
+  NM.tableCross(&Wave[0],Wave.size(),&TVec[0],&SVec[0]);
+
+  for(size_t i=0;i<Wave.size();i++)
+    {
+      const double W(Wave[i]);
+      const double T=NM.TotalCross(W);
+      const double S=NM.ScatCross(W);
+      const double A=NM.calcAtten(W,Length);
+      if (fabs(NM.tableTotal(W)-T)>tol*T ||
+	  fabs(NM.tableScat(W)-S)>tol*S ||
+	  fabs(NM.tableAtten(W,Length)-A)>tol*A ||
+	  fabs(TVec[i]-T)>tol*T || fabs(SVec[i]-S)>tol*S)
+	{
+	  ELog::EM<<"Failed on "<<NM.getName()<<" at "<<W<<ELog::endTrace;
+	  ELog::EM<<"Total  "<<NM.tableTotal(W)<<" "<<T<<" "
+		  <<TVec[i]<<ELog::endTrace;
+	  ELog::EM<<"Scat   "<<NM.tableScat(W)<<" "<<S<<" "
+		  <<SVec[i]<<ELog::endTrace;
+	  ELog::EM<<"Atten  "<<NM.tableAtten(W,Length)<<" "<<A<<ELog::endTrace;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testNeutMaterial::testTable()
+  /*!
+    Test the tabulated cross sections against the
+    direct calculation and that a change of material
+    rebuilds the table
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testNeutMaterial","testTable");
+
+  neutMaterial Al("Aluminium",27,0.07,3.449,1.5,0.01,0.23);
+  CryMat Si("Silicon",28.09,0.0499,4.1491,2.16,0.01,0.171);
+  Si.setTemperatures(420,70);
+  
+  Al.setTable(0.5,10.0,4000);
+  Si.setTable(0.5,10.0,4000);
+  if (checkTable(Al) || checkTable(Si))
+    return -1;
+
+  // material changes after the table is set
+  Al.setDensity(0.05);
+  Al.setScat(2.0,0.1,0.5);
+  Si.setTemperatures(420,300);
+  if (checkTable(Al) || checkTable(Si))
+    return -2;
+  
+  return 0;
+}
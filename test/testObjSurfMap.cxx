@@ -32,6 +32,7 @@
 #include <stack>
 #include <string>
 #include <algorithm>
+#include <boost/tuple/tuple.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/bind.hpp>
 #include <boost/format.hpp>
@@ -45,6 +46,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "support.h"
+#include "stringCombine.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
@@ -98,12 +100,16 @@ testObjSurfMap::applyTest(const int extra)
   typedef int (testObjSurfMap::*testPtr)();
   testPtr TPtr[]=
     {
-      &testObjSurfMap::testMap
+      &testObjSurfMap::testMap,
+      &testObjSurfMap::testNextObject,
+      &testObjSurfMap::testOverlap
     };
 
   const std::string TestName[]=
     {
-      "Map"
+      "Map",
+      "NextObject",
+      "Overlap"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -148,6 +154,14 @@ testObjSurfMap::createSurfaces()
   SurI.createSurface(5,"pz -1");
   SurI.createSurface(6,"pz 1");
 
+  // Row of boxes on a shared plane
+  SurI.createSurface(10,"pz 0");
+  SurI.createSurface(11,"pz 1");
+  SurI.createSurface(12,"pz -1");
+  SurI.createSurface(13,"py -1");
+  SurI.createSurface(14,"py 1");
+  for(int i=0;i<7;i++)
+    SurI.createSurface(20+i,"px "+StrFunc::makeString(i));
 
   return;
 }
@@ -204,3 +218,126 @@ testObjSurfMap::testMap()
 
 
 
+
+int
+testObjSurfMap::testNextObject()
+  /*!
+    Test the next object across a plane shared by a row of 
+    cells. The crossings jump along the row [hint misses] and
+    repeat [hint hits]. The map is rebuilt in reverse order
+    to check that the hints are reset.
+    \returns 0 on succes and -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testObjSurfMap","testNextObject");
+
+  std::vector<boost::shared_ptr<MonteCarlo::Object> > OVec;
+  for(int i=0;i<6;i++)
+    {
+      const std::string XStr=StrFunc::makeString(20+i)+" "+
+	StrFunc::makeString(-21-i)+" 13 -14 ";
+      OVec.push_back(boost::shared_ptr<MonteCarlo::Object>
+		     (new MonteCarlo::Object(100+i,1,0.1,XStr+"10 -11")));
+      OVec.push_back(boost::shared_ptr<MonteCarlo::Object>
+		     (new MonteCarlo::Object(200+i,1,0.1,XStr+"-10 12")));
+    }
+  for(size_t i=0;i<OVec.size();i++)
+    {
+      OVec[i]->populate();
+      OVec[i]->createSurfaceList();
+    }
+
+  ObjSurfMap OM;
+  for(int pass=0;pass<2;pass++)
+    {
+      OM.clearAll();
+      for(size_t i=0;i<OVec.size();i++)
+	OM.addSurfaces(OVec[(pass) ? OVec.size()-i-1 : i].get());
+
+      for(int k=0;k<60;k++)
+	{
+	  // every third crossing is repeated
+	  const double x=fmod(0.05+(k-k%3)*1.37,6.0);
+	  const int cellIndex(static_cast<int>(x));
+	  const Geometry::Vec3D Pt(x,0.3,0.0);
+	  const MonteCarlo::Object* UPtr=
+	    OM.findNextObject(10,Pt,200+cellIndex);
+	  const MonteCarlo::Object* LPtr=
+	    OM.findNextObject(-10,Pt,100+cellIndex);
+	  if (!UPtr || UPtr->getName()!=100+cellIndex ||
+	      !LPtr || LPtr->getName()!=200+cellIndex)
+	    {
+	      ELog::EM<<"Pass "<<pass<<" point "<<Pt<<ELog::endDebug;
+	      ELog::EM<<"Upper : "<<((UPtr) ? UPtr->getName() : 0)
+		      <<" Lower : "<<((LPtr) ? LPtr->getName() : 0)
+		      <<" expect "<<cellIndex<<ELog::endDebug;
+	      return -1;
+	    }
+	}
+    }
+  return 0;
+}
+
+int
+testObjSurfMap::testOverlap()
+  /*!
+    Test the next object where the cells overlap : the
+    first crossing [and a new map] gives the first valid 
+    object in map order, the later ones the hinted object.
+    \returns 0 on succes and -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testObjSurfMap","testOverlap");
+
+  std::vector<boost::shared_ptr<MonteCarlo::Object> > OVec;
+  for(int i=0;i<3;i++)
+    {
+      const std::string XStr=StrFunc::makeString(20+i)+" "+
+	StrFunc::makeString(-21-i)+" 13 -14 10 -11";
+      OVec.push_back(boost::shared_ptr<MonteCarlo::Object>
+		     (new MonteCarlo::Object(100+i,1,0.1,XStr)));
+    }
+  // Overlaps cells 100 and 101
+  OVec.push_back(boost::shared_ptr<MonteCarlo::Object>
+		 (new MonteCarlo::Object(300,1,0.1,"20 -22 13 -14 10 -11")));
+  for(size_t i=0;i<OVec.size();i++)
+    {
+      OVec[i]->populate();
+      OVec[i]->createSurfaceList();
+    }
+
+  typedef boost::tuple<double,int,int> TTYPE;
+  const TTYPE Tests[]=
+    {
+      TTYPE(0.5,0,100),     // map order
+      TTYPE(1.5,101,300),   // only 300 left
+      TTYPE(0.5,0,300),     // hint : not map order
+      TTYPE(2.5,0,102),
+      TTYPE(0.5,0,100)      // new map : map order
+    };
+
+  ObjSurfMap OM;
+  for(size_t i=0;i<OVec.size();i++)
+    OM.addSurfaces(OVec[i].get());
+  for(size_t i=0;i<sizeof(Tests)/sizeof(TTYPE);i++)
+    {
+      const TTYPE& tc(Tests[i]);
+      if (i==4)
+	{
+	  OM.clearAll();
+	  for(size_t j=0;j<OVec.size();j++)
+	    OM.addSurfaces(OVec[j].get());
+	}
+      const Geometry::Vec3D Pt(tc.get<0>(),0.3,0.0);
+      const MonteCarlo::Object* OPtr=
+	OM.findNextObject(10,Pt,tc.get<1>());
+      if (!OPtr || OPtr->getName()!=tc.get<2>())
+	{
+	  ELog::EM<<"Test "<<i<<" point "<<Pt<<ELog::endDebug;
+	  ELog::EM<<"Object : "<<((OPtr) ? OPtr->getName() : 0)
+		  <<" expect "<<tc.get<2>()<<ELog::endDebug;
+	  return -1;
+	}
+    }
+  return 0;
+}
@@ -103,12 +103,14 @@ testObjectRegister::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testObjectRegister::testExcludeItem,
-      &testObjectRegister::testGetObject
+      &testObjectRegister::testGetObject,
+      &testObjectRegister::testInRange
     };
   const std::string TestName[]=
     {
       "ExcludeItem",
-      "GetObject"
+      "GetObject",
+      "InRange"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -173,5 +175,51 @@ testObjectRegister::testGetObject()
   return 0;
 }
 
+int
+testObjectRegister::testInRange()
+  /*!
+    Test the mapping of cell number to object name
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObjectRegister","testInRange");
 
-
+  ModelSupport::objectRegister OR;
+  OR.cell("A");              // 1000000 : 10000
+  OR.cell("C",-1,100);       // 1010000 : 100
+  OR.cell("B",2,20000);      // 1010100 : 20000
+  OR.cell("D");              // 1030100 : 10000
+  
+  typedef boost::tuple<int,std::string> TTYPE;
+  std::vector<TTYPE> Tests;
+  Tests.push_back(TTYPE(999999,""));
+  Tests.push_back(TTYPE(1000000,"A"));
+  Tests.push_back(TTYPE(1009999,"A"));
+  Tests.push_back(TTYPE(1010000,"C"));
+  Tests.push_back(TTYPE(1010099,"C"));
+  Tests.push_back(TTYPE(1010100,"B2"));
+  Tests.push_back(TTYPE(1030099,"B2"));
+  Tests.push_back(TTYPE(1030100,"D"));
+  Tests.push_back(TTYPE(1040100,"D"));
+  Tests.push_back(TTYPE(1040101,""));
+
+  std::vector<TTYPE>::const_iterator tc;
+  for(tc=Tests.begin();tc!=Tests.end();tc++)
+    {
+      const std::string Res=OR.inRange(tc->get<0>());
+      if (Res!=tc->get<1>())
+	{
+	  ELog::EM<<"Cell == "<<tc->get<0>()<<ELog::endDiag;
+	  ELog::EM<<"Name == "<<Res<<" (expected "
+		  <<tc->get<1>()<<")"<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  if (OR.getCell("B",2)!=1010100 || OR.getRange("B",2)!=20000 ||
+      OR.getCell("C")!=1010000 || OR.getCell("E"))
+    {
+      ELog::EM<<"Failed on getCell/getRange"<<ELog::endDiag;
+      return -2;
+    }
+  return 0;
+}
@@ -0,0 +1,394 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   test/testParamScan.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <list> 
+#include <map> 
+#include <set>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <boost/shared_ptr.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "stringCombine.h"
+#include "MersenneTwister.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "IItemBase.h"
+#include "inputParam.h"
+#include "Simulation.h"
+#include "paramScan.h"
+
+#include "testFunc.h"
+#include "testParamScan.h"
+
+using namespace mainSystem;
+
+testParamScan::testParamScan() 
+  /*!
+    Constructor
+  */
+{}
+
+testParamScan::~testParamScan() 
+  /*!
+    Destructor
+  */
+{}
+
+int 
+testParamScan::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Test number to run
+    \retval -1 : SetObject 
+    \retval 0 : All succeeded
+  */
+{
+  ELog::RegMethod RegA("testParamScan","applyTest");
+
+  typedef int (testParamScan::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testParamScan::testGrid,
+      &testParamScan::testLatin,
+      &testParamScan::testManifest,
+      &testParamScan::testVariants
+    };
+  const std::string TestName[]=
+    {
+      "Grid",
+      "Latin",
+      "Manifest",
+      "Variants"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+/// Write a deck of the value of variable a [test build function]
+static int
+writeDeck(Simulation& System,inputParam&,const std::string& Deck)
+{
+  std::ofstream OX(Deck.c_str());
+  OX<<System.getDataBase().EvalVar<double>("a")<<std::endl;
+  return (OX.good()) ? 0 : 1;
+}
+
+/// Build function that always fails
+static int
+failDeck(Simulation&,inputParam&,const std::string&)
+{
+  return 1;
+}
+
+int
+testParamScan::testGrid()
+  /*!
+    Test the grid of the ranges : the first range 
+    changes fastest. The same grid is set up
+    from the input parameters by createScan.
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testParamScan","testGrid");
+
+  paramScan PA;
+  PA.addRange("a",0.0,1.0,3);
+  PA.addRange("b",10.0,20.0,2);
+  PA.makeGrid();
+
+  inputParam IParam;
+  IParam.regMulti<std::string>("scan","scan",4,4);
+  IParam.regItem<std::string>("scanFile","scanFile");
+  IParam.regDefItem<int>("scanLHS","scanLHS",1,0);
+  IParam.regDefItem<int>("scanWork","scanWorkers",1,1);
+  std::vector<std::string> Names;
+  const char* Input[]={"-scan","a","0","1","3",
+		       "-scan","b","10","20","2"};
+  for(size_t i=0;i<sizeof(Input)/sizeof(const char*);i++)
+    Names.push_back(Input[i]);
+  IParam.processMainInput(Names);
+
+  MTRand RNG(12345UL);
+  paramScan PB;
+  if (!createScan(PB,IParam,RNG))
+    {
+      ELog::EM<<"createScan failed"<<ELog::endDiag;
+      return -1;
+    }
+
+  const double AV[]={0.0,0.5,1.0,0.0,0.5,1.0};
+  const double BV[]={10.0,10.0,10.0,20.0,20.0,20.0};
+  for(size_t pass=0;pass<2;pass++)
+    {
+      const paramScan& PS((pass) ? PB : PA);
+      if (PS.nVariants()!=6 || PS.getVarNames().size()!=2 ||
+	  PS.getVarNames()[0]!="a" || PS.getVarNames()[1]!="b")
+	{
+	  ELog::EM<<"Pass "<<pass<<" nVariants == "
+		  <<PS.nVariants()<<ELog::endDiag;
+	  return -2;
+	}
+      for(size_t i=0;i<6;i++)
+	{
+	  const std::vector<double>& V=PS.getVariant(i);
+	  if (std::abs(V[0]-AV[i])>1e-12 || std::abs(V[1]-BV[i])>1e-12)
+	    {
+	      ELog::EM<<"Pass "<<pass<<" variant "<<i<<" == "
+		      <<V[0]<<" "<<V[1]<<ELog::endDiag;
+	      ELog::EM<<"Expected == "<<AV[i]<<" "<<BV[i]<<ELog::endDiag;
+	      return -3;
+	    }
+	}
+    }
+  return 0;
+}
+
+int
+testParamScan::testLatin()
+  /*!
+    Test the Latin hypercube sample : each stratum of 
+    each range is used once and the values are in range.
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testParamScan","testLatin");
+
+  typedef boost::tuple<double,double> TTYPE;
+  const TTYPE Range[]={ TTYPE(0.0,1.0), TTYPE(-5.0,5.0), TTYPE(2.0,3.0) };
+  const size_t NR(sizeof(Range)/sizeof(TTYPE));
+  const size_t NS[]={1,7,20};
+
+  MTRand RNG(67890UL);
+  for(size_t ns=0;ns<sizeof(NS)/sizeof(size_t);ns++)
+    {
+      paramScan PS;
+      for(size_t j=0;j<NR;j++)
+	PS.addRange("v"+StrFunc::makeString(j),
+		    Range[j].get<0>(),Range[j].get<1>(),1);
+      PS.makeLatin(NS[ns],RNG);
+      if (PS.nVariants()!=NS[ns] || PS.getVarNames().size()!=NR)
+	{
+	  ELog::EM<<"nVariants == "<<PS.nVariants()<<ELog::endDiag;
+	  return -1;
+	}
+      for(size_t j=0;j<NR;j++)
+	{
+	  const double LowV(Range[j].get<0>());
+	  const double HighV(Range[j].get<1>());
+	  const double step=(HighV-LowV)/static_cast<double>(NS[ns]);
+	  std::vector<int> Used(NS[ns],0);
+	  for(size_t i=0;i<NS[ns];i++)
+	    {
+	      const double V=PS.getVariant(i)[j];
+	      const long int SI=static_cast<long int>(floor((V-LowV)/step));
+	      if (V<LowV || V>=HighV || SI<0 || 
+		  SI>=static_cast<long int>(NS[ns]) || 
+		  Used[static_cast<size_t>(SI)]++)
+		{
+		  ELog::EM<<"Sample "<<NS[ns]<<" variable "<<j
+			  <<" value "<<V<<" stratum "<<SI<<ELog::endDiag;
+		  return -2;
+		}
+	    }
+	}
+    }
+  return 0;
+}
+
+int
+testParamScan::testManifest()
+  /*!
+    Test the manifest of a scan. The manifest of the first 
+    run is read back. A second run skips the variants with a 
+    deck and rebuilds [with a failing build] only the variant
+    whose deck is removed.
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testParamScan","testManifest");
+
+  const std::string Stub("testParamScan");
+  const std::string Manifest("testParamScan.manifest");
+
+  Simulation System;
+  System.getDataBase().addVariable("a",0.0);
+  inputParam IParam;
+
+  std::vector<std::string> Decks;
+  int retVal(0);
+  for(int pass=0;!retVal && pass<2;pass++)
+    {
+      paramScan PS;
+      PS.addRange("a",1.0,3.0,3);
+      PS.makeGrid();
+      if (pass)
+	{
+	  PS.readManifest(Manifest);
+	  std::remove(Decks[1].c_str());
+	}
+      const int nFail=
+	PS.run(System,IParam,Stub,(pass) ? &failDeck : &writeDeck,Manifest);
+
+      // Manifest : deck hash time status value
+      std::ifstream IX(Manifest.c_str());
+      std::string Line;
+      std::getline(IX,Line);
+      size_t index(0);
+      while(!retVal && std::getline(IX,Line))
+	{
+	  std::string Deck,Hash;
+	  double Time,Value;
+	  int status;
+	  if (index>=PS.nVariants() ||
+	      !StrFunc::section(Line,Deck) ||
+	      !StrFunc::section(Line,Hash) ||
+	      !StrFunc::section(Line,Time) ||
+	      !StrFunc::section(Line,status) ||
+	      !StrFunc::section(Line,Value) ||
+	      Deck!=Stub+"S"+Hash+".x" ||
+	      std::abs(Value-PS.getVariant(index)[0])>1e-12 ||
+	      status!=((pass && index==1) ? 1 : 0) ||
+	      (pass && Deck!=Decks[index]))
+	    {
+	      ELog::EM<<"Pass "<<pass<<" line "<<index<<" : "
+		      <<Deck<<" "<<Hash<<" "<<status<<ELog::endDiag;
+	      retVal=-1;
+	    }
+	  if (!pass)
+	    Decks.push_back(Deck);
+	  index++;
+	}
+      if (!retVal && (index!=3 || nFail!=pass))
+	{
+	  ELog::EM<<"Pass "<<pass<<" nLines == "<<index
+		  <<" nFail == "<<nFail<<ELog::endDiag;
+	  retVal=-2;
+	}
+      // Deck content of the first run
+      for(size_t i=0;!retVal && !pass && i<Decks.size();i++)
+	{
+	  std::ifstream DX(Decks[i].c_str());
+	  double Value(-1.0);
+	  DX>>Value;
+	  if (std::abs(Value-PS.getVariant(i)[0])>1e-12)
+	    {
+	      ELog::EM<<"Deck "<<Decks[i]<<" == "<<Value<<ELog::endDiag;
+	      retVal=-3;
+	    }
+	}
+    }
+
+  for(size_t i=0;i<Decks.size();i++)
+    std::remove(Decks[i].c_str());
+  std::remove(Manifest.c_str());
+  return retVal;
+}
+
+int
+testParamScan::testVariants()
+  /*!
+    Test that a variants file [with a comment] reads 
+    back the variants written.
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testParamScan","testVariants");
+
+  const std::string FName("testParamScan.variants");
+
+  MTRand RNG(13579UL);
+  paramScan PA;
+  PA.addRange("alpha",0.0,1.0,1);
+  PA.addRange("beta",-2.0,7.0,1);
+  PA.makeLatin(5,RNG);
+  PA.writeVariants(FName);
+  {
+    std::ofstream OX(FName.c_str(),std::ios::app);
+    OX<<"# comment line"<<std::endl;
+  }
+
+  paramScan PB;
+  PB.readVariants(FName);
+  std::remove(FName.c_str());
+
+  if (PB.nVariants()!=PA.nVariants() || 
+      PB.getVarNames()!=PA.getVarNames())
+    {
+      ELog::EM<<"nVariants == "<<PB.nVariants()<<ELog::endDiag;
+      return -1;
+    }
+  for(size_t i=0;i<PA.nVariants();i++)
+    if (PB.getVariant(i)!=PA.getVariant(i))
+      {
+	ELog::EM<<"Variant "<<i<<" == "<<PB.getVariant(i)[0]<<" "
+		<<PB.getVariant(i)[1]<<ELog::endDiag;
+	return -2;
+      }
+  return 0;
+}
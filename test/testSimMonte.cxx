@@ -0,0 +1,343 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   test/testSimMonte.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <list> 
+#include <map> 
+#include <set>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <iterator>
+#include <boost/functional.hpp>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/multi_array.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "mathSupport.h"
+#include "support.h"
+#include "MapSupport.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Triple.h"
+#include "NList.h"
+#include "NRange.h"
+#include "Tally.h"
+#include "Transform.h"
+#include "Surface.h"
+#include "surfIndex.h"
+#include "Quadratic.h"
+#include "surfaceFactory.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FItem.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "ObjSurfMap.h"
+#include "surfRegister.h"
+#include "ModelSupport.h"
+#include "neutron.h"
+#include "Beam.h"
+#include "AreaBeam.h"
+#include "Detector.h"
+#include "DetGroup.h"
+#include "Simulation.h"
+#include "SimMonte.h"
+#include "ObjComponent.h"
+
+#include "testFunc.h"
+#include "testSimMonte.h"
+
+testSimMonte::testSimMonte() 
+  /*!
+    Constructor
+  */
+{
+  initSim();
+}
+
+testSimMonte::~testSimMonte() 
+  /*!
+    Destructor
+  */
+{}
+
+void
+testSimMonte::initSim()
+  /*!
+    Set all the objects in the simulation:
+  */
+{
+  ASim.resetAll();
+  createSurfaces();
+  createObjects();
+  ASim.createObjSurfMap();
+
+  Transport::AreaBeam AB;
+  AB.setStart(0.0);
+  ASim.setBeam(AB);
+  ASim.setDetector(Transport::Detector(10,10,0,Geometry::Vec3D(30,0,0),
+				       Geometry::Vec3D(0,20,0),
+				       Geometry::Vec3D(0,0,20),0.0,0.0));
+  return;
+}
+
+void 
+testSimMonte::createSurfaces()
+  /*!
+    Create the surface list
+   */
+{
+  ELog::RegMethod RegA("testSimMonte","createSurfaces");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  
+  // Slab :
+  SurI.createSurface(1,"px 2");
+  SurI.createSurface(2,"px 4");
+  SurI.createSurface(3,"py -6");
+  SurI.createSurface(4,"py 6");
+  SurI.createSurface(5,"pz -6");
+  SurI.createSurface(6,"pz 6");
+
+  // Sphere :
+  SurI.createSurface(100,"so 25");
+  
+  return;
+}
+  
+void
+testSimMonte::createObjects()
+  /*!
+    Create Object for test
+   */
+{
+  ELog::RegMethod RegA("testSimMonte","createObjects");
+
+  std::string Out;
+  const int surIndex(0);
+  Out=ModelSupport::getComposite(surIndex,"100");
+  ASim.addCell(MonteCarlo::Qhull(1,0,0.0,Out));      // Outside 
+  ASim.findQhull(1)->setImp(0);
+
+  Out=ModelSupport::getComposite(surIndex,"1 -2 3 -4 5 -6");
+  ASim.addCell(MonteCarlo::Qhull(2,0,0.0,Out));      // Inner void
+
+  Out=ModelSupport::getComposite(surIndex,"-100 (-1:2:-3:4:-5:6)");
+  ASim.addCell(MonteCarlo::Qhull(3,0,0.0,Out));      // Void
+  
+  ASim.removeComplements();
+  return;
+}
+
+int
+testSimMonte::sameData(const Transport::DetGroup& A,
+		       const Transport::DetGroup& B)
+  /*!
+    Determine if two detector groups have identical bins
+    \param A :: First group
+    \param B :: Second group
+    \return 1 if identical
+  */
+{
+  if (A.size()!=B.size())
+    return 0;
+  for(size_t i=0;i<A.size();i++)
+    {
+      const boost::multi_array<double,3>& AData=A.getDet(i).getData();
+      const boost::multi_array<double,3>& BData=B.getDet(i).getData();
+      if (A.getDet(i).getNPS()!=B.getDet(i).getNPS() ||
+	  AData.num_elements()!=BData.num_elements() ||
+	  !std::equal(AData.data(),AData.data()+AData.num_elements(),
+		      BData.data()))
+	return 0;
+    }
+  return 1;
+}
+
+int 
+testSimMonte::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Test number to run
+    \retval -1 : SetObject 
+    \retval 0 : All succeeded
+  */
+{
+  ELog::RegMethod RegA("testSimMonte","applyTest");
+
+  typedef int (testSimMonte::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testSimMonte::testEventHistory,
+      &testSimMonte::testReproducible
+    };
+  const std::string TestName[]=
+    {
+      "EventHistory",
+      "Reproducible"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testSimMonte::testEventHistory()
+  /*!
+    Event based [ParticleBank] and history based transport
+    must give the same tally. The random numbers are used in
+    a different order so only the sums are compared. The
+    slab is void and then water [scatMat 11] : the scatter 
+    points do not change the direction so the tally is 
+    attenuated by the absorption of the slab only.
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testSimMonte","testEventHistory");
+
+  const size_t NPts(200);
+  const int MatN[]={0,11};
+
+  int retVal(0);
+  for(size_t i=0;!retVal && i<2;i++)
+    {
+      ASim.findQhull(2)->setMaterial(MatN[i]);
+      // Absorption over the 2cm of the slab [beam : 0.7A]
+      const Transport::ObjComponent Cell(ASim.findQhull(2));
+      const MonteCarlo::neutron N(0.7,Geometry::Vec3D(0,0,0),
+				  Geometry::Vec3D(1,0,0));
+      const double aXsec=Cell.TotalCross(N)*(1.0-Cell.ScatTotalRatio(N,N));
+      const double expect=exp(-2.0*aXsec)*static_cast<double>(NPts)/900.0;
+
+      ASim.setBatch(40);
+      ASim.setSeed(7);
+      ASim.setEvent(0);
+      ASim.clearAll();
+      ASim.runMonte(NPts);
+      const Transport::DetGroup DA(ASim.getDetGroup());
+
+      ASim.setEvent(1);
+      ASim.clearAll();
+      ASim.runMonte(NPts);
+      const Transport::DetGroup DB(ASim.getDetGroup());
+      ASim.setEvent(0);
+
+      if (DA.getDet(0).getNPS()!=static_cast<long int>(NPts) ||
+	  DB.getDet(0).getNPS()!=static_cast<long int>(NPts) ||
+	  fabs(DA.getTotal()-DB.getTotal())>1e-9*DA.getTotal() ||
+	  fabs(DA.getTotal()-expect)>1e-4*expect)
+	{
+	  ELog::EM<<"Material == "<<MatN[i]<<ELog::endDiag;
+	  ELog::EM<<"Total == "<<DA.getTotal()<<" "
+		  <<DB.getTotal()<<" ("<<expect<<")"<<ELog::endDiag;
+	  ELog::EM<<"NPS == "<<DA.getDet(0).getNPS()<<" "
+		  <<DB.getDet(0).getNPS()<<ELog::endDiag;
+	  retVal=-1;
+	}
+    }
+  ASim.findQhull(2)->setMaterial(0);
+  return retVal;
+}
+
+int
+testSimMonte::testReproducible()
+  /*!
+    Two runs with the same seed and batch size must give
+    identical tallies. Every neutron is scored at 30cm from
+    its start so the total is also known.
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testSimMonte","testReproducible");
+
+  const size_t NPts(200);
+  const double expect=static_cast<double>(NPts)/900.0;
+
+  ASim.setBatch(40);
+  ASim.setSeed(7);
+  ASim.clearAll();
+  ASim.runMonte(NPts);
+  const Transport::DetGroup DA(ASim.getDetGroup());
+
+  ASim.clearAll();
+  ASim.runMonte(NPts);
+  const Transport::DetGroup DB(ASim.getDetGroup());
+
+  ASim.setSeed(8);
+  ASim.clearAll();
+  ASim.runMonte(NPts);
+  const Transport::DetGroup DC(ASim.getDetGroup());
+
+  if (!sameData(DA,DB) || sameData(DA,DC) ||
+      fabs(DA.getTotal()-expect)>1e-4*expect ||
+      DA.getDet(0).getNPS()!=static_cast<long int>(NPts))
+    {
+      ELog::EM<<"Total == "<<DA.getTotal()<<" "<<DB.getTotal()
+	      <<" "<<DC.getTotal()<<ELog::endDiag;
+      ELog::EM<<"Expect == "<<expect<<ELog::endDiag;
+      ELog::EM<<"NPS == "<<DA.getDet(0).getNPS()<<ELog::endDiag;
+      ELog::EM<<"Same == "<<sameData(DA,DB)<<" "
+	      <<sameData(DA,DC)<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
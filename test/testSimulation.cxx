@@ -22,6 +22,8 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <cstdio>
 #include <cmath>
 #include <complex> 
 #include <vector>
@@ -99,7 +101,11 @@
 #include "surfRegister.h"
 #include "ModelSupport.h"
 #include "neutron.h"
+#include "objectRegister.h"
+#include "BuildContext.h"
 #include "Simulation.h"
+#include "MasterFile.h"
+#include "MatFraction.h"
 
 #include "testFunc.h"
 #include "testSimulation.h"
@@ -213,14 +219,28 @@ testSimulation::applyTest(const int extra)
   typedef int (testSimulation::*testPtr)();
   testPtr TPtr[]=
     {
+      &testSimulation::testBuildContext,
       &testSimulation::testCreateObjSurfMap,
       &testSimulation::testInCell,
+      &testSimulation::testMasterFile,
+      &testSimulation::testMatFraction,
+      &testSimulation::testReadCells,
+      &testSimulation::testReadMaster,
+      &testSimulation::testReadSurfaces,
+      &testSimulation::testRemoveComplements,
       &testSimulation::testTrackNeutron
     };
   const std::string TestName[]=
     {
+      "BuildContext",
       "CreateObjSurfMap",
       "InCell",
+      "MasterFile",
+      "MatFraction",
+      "ReadCells",
+      "ReadMaster",
+      "ReadSurfaces",
+      "RemoveComplements",
       "TrackNeutron"
     };
   
@@ -248,6 +268,67 @@ testSimulation::applyTest(const int extra)
   return 0;
 }
 
+int
+testSimulation::testBuildContext()
+  /*!
+    Check that an isolated context gives independent
+    registries and that the guard restores the singletons
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testBuildContext");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  ModelSupport::objectRegister& OR=ModelSupport::objectRegister::Instance();
+
+  Simulation BSim;
+  BSim.isolateContext();
+  const int gCell=OR.cell("testBuildContextUnit");
+  int bCell(0);
+  {
+    BuildContextGuard Guard(BSim.getContext());
+    ModelSupport::surfIndex& BSurI=ModelSupport::surfIndex::Instance();
+    if (&BSurI==&SurI || &BSurI!=&BSim.getContext().getSurfIndex())
+      {
+	ELog::EM<<"Context surfIndex not active"<<ELog::endDiag;
+	OR.removeCell("testBuildContextUnit");
+	return -1;
+      }
+    // surface 1 exists in the global index but not in the context
+    if (!SurI.getSurf(1) || BSurI.getSurf(1))
+      {
+	ELog::EM<<"Context surfIndex shares surfaces"<<ELog::endDiag;
+	OR.removeCell("testBuildContextUnit");
+	return -2;
+      }
+    bCell=ModelSupport::objectRegister::Instance().cell
+      ("testBuildContextUnit");
+  }
+  const int testCell=OR.getCell("testBuildContextUnit");
+  OR.removeCell("testBuildContextUnit");
+  if (&ModelSupport::surfIndex::Instance()!=&SurI ||
+      BuildContext::current())
+    {
+      ELog::EM<<"Guard failed to restore singletons"<<ELog::endDiag;
+      return -3;
+    }
+  // independent register : both start from the same base number
+  if (bCell!=1000000 || testCell!=gCell)
+    {
+      ELog::EM<<"Cells == "<<gCell<<" "<<bCell<<ELog::endDiag;
+      return -4;
+    }
+  // copy keeps the isolation
+  Simulation CSim(BSim);
+  if (!CSim.getContext().isIsolated() ||
+      &CSim.getContext().getSurfIndex()==&BSim.getContext().getSurfIndex())
+    {
+      ELog::EM<<"Copy lost the isolated context"<<ELog::endDiag;
+      return -5;
+    }
+  return 0;
+}
+
 int
 testSimulation::testTrackNeutron()
   /*!
@@ -386,3 +467,313 @@ testSimulation::testInCell()
       
   return 0;
 }
+
+int
+testSimulation::testMatFraction()
+  /*!
+    Test the material fractions of a mesh
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testMatFraction");
+
+  initSim();
+  // Voxels [0:2] hold 1/8 of the steel box (mat 3) in Al (mat 5)
+  MatFraction MF;
+  MF.setBox(Geometry::Vec3D(-2,-2,-2),Geometry::Vec3D(2,2,2));
+  MF.setIndex(2,2,2);
+  MF.setSubSample(4);
+  MF.populate(&ASim);
+
+  std::vector<int> MVec;
+  std::vector<double> FVec;
+  for(size_t i=0;i<MF.getNVoxel();i++)
+    {
+      if (MF.getFractions(i,MVec,FVec)!=2 ||
+	  fabs(MF.getFraction(i,3)-0.125)>1e-8 ||
+	  fabs(MF.getFraction(i,5)-0.875)>1e-8)
+	{
+	  ELog::EM<<"Failed on voxel "<<i<<ELog::endTrace;
+	  ELog::EM<<MF<<ELog::endTrace;
+	  return -1;
+	}
+    }
+
+  // Single voxel in the steel : corner early exit
+  MF.setBox(Geometry::Vec3D(-0.5,-0.5,-0.5),Geometry::Vec3D(0.5,0.5,0.5));
+  MF.setIndex(1,1,1);
+  MF.populate(&ASim);
+  if (MF.getNEntry()!=1 || fabs(MF.getFraction(0,3)-1.0)>1e-8)
+    {
+      ELog::EM<<"Failed on steel voxel"<<ELog::endTrace;
+      ELog::EM<<MF<<ELog::endTrace;
+      return -1;
+    }
+  return 0;
+}
+
+int
+testSimulation::testRemoveComplements()
+  /*!
+    Test the expansion of complements and the
+    reuse / reset of the expansion cache
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testRemoveComplements");
+
+  initSim();
+  // addCell has already expanded cell 5
+  const std::string OutA=ASim.findQhull(5)->cellCompStr();
+
+  // put the complement back into cells 5/6 [as read cells]
+  const std::string Out=ModelSupport::getComposite
+    (0,"-100 (-11:12:-13:14:-15:16) #4");
+  ASim.addCell(MonteCarlo::Qhull(6,0,0.0,"-100"));
+  const int cellN[]={5,6};
+  for(size_t index=0;index<3;index++)
+    {
+      // second pass : cell 6 alone from the cache
+      for(size_t i=(index==1) ? 1 : 0;i<2;i++)
+	{
+	  MonteCarlo::Qhull* QPtr=ASim.findQhull(cellN[i]);
+	  QPtr->procString(Out);
+	  QPtr->populate();
+	}
+      if (index==2)
+	ASim.resetAll();
+      else
+	ASim.removeComplements();
+
+      const size_t cacheSize((index==2) ? 0 : 1);
+      if (ASim.complementCacheSize()!=cacheSize)
+	{
+	  ELog::EM<<"Failed on cache size["<<index<<"] :"
+		  <<ASim.complementCacheSize()<<ELog::endTrace;
+	  return -1;
+	}
+      for(size_t i=0;index!=2 && i<2;i++)
+	{
+	  const MonteCarlo::Qhull* QPtr=ASim.findQhull(cellN[i]);
+	  if (QPtr->hasComplement() || QPtr->cellCompStr()!=OutA)
+	    {
+	      ELog::EM<<"Failed on cell "<<cellN[i]<<"["
+		      <<index<<"]"<<ELog::endTrace;
+	      ELog::EM<<"Expect == "<<OutA<<ELog::endTrace;
+	      ELog::EM<<"Found  == "<<QPtr->cellCompStr()<<ELog::endTrace;
+	      return -2;
+	    }
+	}
+    }
+  initSim();         // later tests use the base model
+  return 0;
+}
+
+int
+testSimulation::testMasterFile()
+  /*!
+    Check the line index, the section headers and 
+    the line access of the mapped master file
+    \return 0 on success / -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testMasterFile");
+
+  const std::string FName("testSimulation.master");
+  std::ofstream OX(FName.c_str());
+  OX<<"c header # note\n"
+    <<"SURFACE CARDS\n"
+    <<"1 so 10 ! comment\n"
+    <<"END\n"
+    <<"CELL CARDS\n"
+    <<"last line";               // No final newline
+  OX.close();
+
+  int retVal(0);
+  {
+    const MasterFile MF(FName);
+    const std::vector<MasterFile::HTYPE>& Headers=MF.getHeaders();
+    if (MF.getNLine()!=6 || Headers.size()!=2 ||
+	Headers[0]!=MasterFile::HTYPE(1,2) ||
+	Headers[1]!=MasterFile::HTYPE(4,3))
+      {
+	ELog::EM<<"Lines == "<<MF.getNLine()<<" Headers == "
+		<<Headers.size()<<ELog::endDiag;
+	retVal=-1;
+      }
+    else if (MF.getLine(0,1)!="c header " ||
+	     MF.getLine(0,0)!="c header # note" ||
+	     MF.getLine(5,0)!="last line")
+      {
+	ELog::EM<<"Line 0 == "<<MF.getLine(0,1)<<ELog::endDiag;
+	ELog::EM<<"Line 5 == "<<MF.getLine(5,0)<<ELog::endDiag;
+	retVal=-2;
+      }
+    else if (MF.getText(2,4)!="1 so 10 ! comment\nEND\n" ||
+	     MF.getText(4,10)!="CELL CARDS\nlast line")
+      {
+	ELog::EM<<"Text == "<<MF.getText(2,4)<<ELog::endDiag;
+	retVal=-3;
+      }
+    // Position after the first line of getText(2,..) 
+    else if (MF.getLineIndex(2,0)!=2 || MF.getLineIndex(2,18)!=3 ||
+	     MF.getLineIndex(2,-1)!=6 || MF.getLineIndex(2,200)!=6)
+      {
+	ELog::EM<<"Line index == "<<MF.getLineIndex(2,18)<<ELog::endDiag;
+	retVal=-4;
+      }
+  }
+  std::remove(FName.c_str());
+  return retVal;
+}
+
+int
+testSimulation::testReadCells()
+  /*!
+    Read the cells from the lines of a section
+    \return 0 on success / -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testReadCells");
+
+  std::vector<std::string> Lines;
+  Lines.push_back("c cell test");
+  Lines.push_back("1 0 -1");
+  Lines.push_back("2 0 1 -2");
+  Lines.push_back("      3 -4");          // continuation
+  Lines.push_back("3 0 4 $ comment");
+  Lines.push_back("END");
+  Lines.push_back("4 0 -5");              // after END
+
+  FuncDataBase DB;
+  ReadFunc::OTYPE ObjMap;
+  const int nCell=ReadFunc::readCells(DB,Lines,100,ObjMap);
+
+  // Surfaces of the continued cell 
+  std::set<int> SSet;
+  SSet.insert(1);
+  SSet.insert(-2);
+  SSet.insert(3);
+  SSet.insert(-4);
+
+  int retVal(0);
+  ReadFunc::OTYPE::const_iterator mc=ObjMap.find(102);
+  if (nCell!=3 || ObjMap.size()!=3 || mc==ObjMap.end() ||
+      ObjMap.find(101)==ObjMap.end() || ObjMap.find(103)==ObjMap.end())
+    {
+      ELog::EM<<"Cells read == "<<nCell<<" "<<ObjMap.size()<<ELog::endDiag;
+      retVal=-1;
+    }
+  else 
+    {
+      std::istringstream cx(mc->second->cellCompStr());
+      std::set<int> CSet;
+      int SN;
+      while(cx>>SN)
+	CSet.insert(SN);
+      if (CSet!=SSet)
+	retVal=-2;
+    }
+  if (retVal==-2)
+    {
+      ELog::EM<<"Cell 102 == "<<mc->second->cellCompStr()<<ELog::endDiag;
+      retVal=-2;
+    }
+  for(mc=ObjMap.begin();mc!=ObjMap.end();mc++)
+    delete mc->second;
+  return retVal;
+}
+
+int
+testSimulation::testReadMaster()
+  /*!
+    Read a master file : a section runs to its END
+    and a "CARDS" text within a section is not a header
+    \return 0 on success / -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testReadMaster");
+
+  const std::string FName("testSimulation.master");
+  std::ofstream OX(FName.c_str());
+  OX<<"c master file test\n"
+    <<"SURFACE CARDS\n"
+    <<"501 so 10\n"
+    <<"c surfaces for the CELL CARDS below\n"
+    <<"502 so 20\n"
+    <<"END\n"
+    <<"CELL CARDS\n"
+    <<"1 0 -501\n"
+    <<"2 0 501 -502\n"
+    <<"3 0 502\n"
+    <<"END\n";
+  OX.close();
+
+  Simulation BSim;
+  BSim.isolateContext();
+  int retVal(0);
+  {
+    BuildContextGuard Guard(BSim.getContext());
+    try
+      {
+	BSim.readMaster(FName);
+	const ModelSupport::surfIndex& SurI=
+	  ModelSupport::surfIndex::Instance();
+	if (!SurI.getSurf(501) || !SurI.getSurf(502) ||
+	    !BSim.findQhull(1) || !BSim.findQhull(2) || 
+	    !BSim.findQhull(3) || BSim.getCells().size()!=3)
+	  {
+	    ELog::EM<<"Cells == "<<BSim.getCells().size()<<ELog::endDiag;
+	    retVal=-1;
+	  }
+      }
+    catch (ColErr::ExBase& A)
+      {
+	ELog::EM<<"Failed to read master : "<<A.what()<<ELog::endDiag;
+	retVal=-2;
+      }
+  }
+  std::remove(FName.c_str());
+  return retVal;
+}
+
+int
+testSimulation::testReadSurfaces()
+  /*!
+    Read the surfaces from the lines of a section 
+    including a card with a continuation line
+    \return 0 on success / -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testReadSurfaces");
+
+  std::vector<std::string> Lines;
+  Lines.push_back("c surface test");
+  Lines.push_back("1 so 5");
+  Lines.push_back("2 gq 1 1 1 0 0 0");
+  Lines.push_back("      0 0 0 -4");      // continuation
+  Lines.push_back("3 px 2");
+  Lines.push_back("END");
+  Lines.push_back("4 px 7");              // after END
+
+  Simulation BSim;
+  BSim.isolateContext();
+  BuildContextGuard Guard(BSim.getContext());
+
+  FuncDataBase DB;
+  const int nSurf=ReadFunc::readSurfaces(DB,Lines,300);
+  const ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  const Geometry::Surface* SPtr=SurI.getSurf(302);
+  if (nSurf!=3 || !SurI.getSurf(301) || !SurI.getSurf(303) ||
+      SurI.getSurf(304) || SurI.getSurf(300) || !SPtr)
+    {
+      ELog::EM<<"Surfaces read == "<<nSurf<<ELog::endDiag;
+      return -1;
+    }
+  if (SPtr->className()!="General")
+    {
+      ELog::EM<<"Surface 302 == "<<SPtr->className()<<ELog::endDiag;
+      return -2;
+    }
+  return 0;
+}
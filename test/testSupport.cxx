@@ -78,6 +78,7 @@ testSupport::applyTest(const int extra)
       &testSupport::testFullBlock,
       &testSupport::testItemize,
       &testSupport::testSection,
+      &testSupport::testSectionMCNPX,
       &testSupport::testSectPartNum,
       &testSupport::testSingleLine,
       &testSupport::testStrComp,
@@ -95,6 +96,7 @@ testSupport::applyTest(const int extra)
       "FullBlock",
       "Itemize",
       "Section",
+      "SectionMCNPX",
       "SectPartNum",
       "SingleLine",
       "StrComp",
@@ -441,6 +443,77 @@ testSupport::testSection()
   return 0;
 }
 
+int
+testSupport::testSectionMCNPX()
+  /*!
+    Applies a test to sectionMCNPX and the cursor 
+    forms of section
+    \retval -ve :: failed to section a string
+    \retval 0 on success
+  */
+{
+  ELog::RegMethod RegA("testSupport","testSectionMCNPX");
+
+  // Init string : values : remainder
+  typedef boost::tuple<std::string,std::vector<double>,std::string> TTYPE;
+  std::vector<TTYPE> Tests;
+
+  std::vector<double> V;
+  V.push_back(5.4938e+04);
+  V.push_back(-3.32923e-6);
+  V.push_back(7.0);
+  Tests.push_back(TTYPE(" 5.4938e+04-3.32923e-6 7",V,""));
+  V.clear();
+  V.push_back(1.0);
+  Tests.push_back(TTYPE("1.0 1-3",V," 1-3"));
+  V.clear();
+  Tests.push_back(TTYPE("1e -3",V,"1e -3"));
+  
+  double D;
+  std::vector<TTYPE>::const_iterator tc;
+  for(tc=Tests.begin();tc!=Tests.end();tc++)
+    {
+      const std::vector<double>& Res(tc->get<1>());
+      std::vector<double> OutS,OutC;
+      std::string TLine=tc->get<0>();
+      while(sectionMCNPX(TLine,D))
+	OutS.push_back(D);
+      const char* cPtr(tc->get<0>().c_str());
+      while(sectionMCNPX(cPtr,D))
+	OutC.push_back(D);
+
+      if (OutS!=Res || OutC!=Res || 
+	  TLine!=tc->get<2>() || std::string(cPtr)!=tc->get<2>())
+	{
+	  ELog::EM<<"TEST :: "<<(tc-Tests.begin())+1<<ELog::endDiag;
+	  ELog::EM<<"Size == "<<OutS.size()<<" "<<OutC.size()
+		  <<" ("<<Res.size()<<")"<<ELog::endDiag;
+	  ELog::EM<<"Final string :"<<tc->get<2>()<<ELog::endDiag;
+	  ELog::EM<<"Found string :"<<TLine<<":"<<cPtr<<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  // Cursor section : separators are consumed
+  const std::string Line("1,2 x 3");
+  const char* cPtr(Line.c_str());
+  int I[2];
+  std::string Unit;
+  if (!section(cPtr,I[0]) || !section(cPtr,I[1]) ||
+      I[0]!=1 || I[1]!=2 || std::string(cPtr)!="x 3")
+    {
+      ELog::EM<<"Cursor Int :"<<cPtr<<":"<<ELog::endDiag;
+      return -2;
+    }
+  if (section(cPtr,D) || !section(cPtr,Unit) || Unit!="x" ||
+      !section(cPtr,D) || D!=3.0 || *cPtr)
+    {
+      ELog::EM<<"Cursor Unit :"<<Unit<<":"<<cPtr<<":"<<ELog::endDiag;
+      return -3;
+    }
+  return 0;
+}
+
 int
 testSupport::testSectPartNum()
   /*!
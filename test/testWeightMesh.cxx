@@ -0,0 +1,346 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   test/testWeightMesh.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <list> 
+#include <map> 
+#include <set>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <boost/functional.hpp>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/multi_array.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "mathSupport.h"
+#include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Triple.h"
+#include "NList.h"
+#include "NRange.h"
+#include "Tally.h"
+#include "Surface.h"
+#include "surfIndex.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "WForm.h"
+#include "WeightMesh.h"
+#include "ObjSurfMap.h"
+#include "surfRegister.h"
+#include "ModelSupport.h"
+#include "Simulation.h"
+#include "MeshWeights.h"
+
+#include "testFunc.h"
+#include "testWeightMesh.h"
+
+using namespace WeightSystem;
+
+testWeightMesh::testWeightMesh() 
+  /*!
+    Constructor
+  */
+{}
+
+testWeightMesh::~testWeightMesh() 
+  /*!
+    Destructor
+  */
+{}
+
+void
+testWeightMesh::initSim()
+  /*!
+    Water slab [mass fractions] between x=-1 and x=1 
+    in a void sphere of radius 3.5
+  */
+{
+  ELog::RegMethod RegA("testWeightMesh","initSim");
+
+  ASim.resetAll();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  SurI.createSurface(1,"px -1");
+  SurI.createSurface(2,"px 1");
+  SurI.createSurface(3,"py -2");
+  SurI.createSurface(4,"py 2");
+  SurI.createSurface(5,"pz -2");
+  SurI.createSurface(6,"pz 2");
+  SurI.createSurface(100,"so 3.5");
+
+  MonteCarlo::Material MObj;
+  MObj.setMaterial(995,"testMassWater",
+		   "1001.70c -0.111894 8016.70c -0.888106","","");
+  ModelSupport::DBMaterial::Instance().resetMaterial(MObj);
+
+  ASim.addCell(MonteCarlo::Qhull(1,0,0.0,"100"));
+  ASim.findQhull(1)->setImp(0);
+  ASim.addCell(MonteCarlo::Qhull(2,995,0.0,"1 -2 3 -4 5 -6"));
+  ASim.addCell(MonteCarlo::Qhull(3,0,0.0,"-100 (-1:2:-3:4:-5:6)"));
+  ASim.createObjSurfMap();
+  return;
+}
+
+int 
+testWeightMesh::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Test number to run
+    \retval -1 : SetObject 
+    \retval 0 : All succeeded
+  */
+{
+  ELog::RegMethod RegA("testWeightMesh","applyTest");
+
+  typedef int (testWeightMesh::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testWeightMesh::testCalcMeshWeights,
+      &testWeightMesh::testWWINP,
+      &testWeightMesh::testXYZ
+    };
+  const std::string TestName[]=
+    {
+      "CalcMeshWeights",
+      "WWINP",
+      "XYZ"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testWeightMesh::testCalcMeshWeights()
+  /*!
+    Voxel centres at x=-2,0,2,4 tracked to (10,0,0) cross
+    2,1,0 cm of water. The last voxel is outside the model.
+    The water is given by mass fraction at 1g/cc.
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testWeightMesh","testCalcMeshWeights");
+
+  initSim();
+
+  // Atom density of 1g/cc water [A(H)=1 : A(O)=16]
+  const double rho(0.602214*(0.111894+0.888106/16.0));
+  const double MD=
+    ModelSupport::DBMaterial::Instance().getMaterial(995).getNumberDensity();
+  if (fabs(MD-rho)>1e-6)
+    {
+      ELog::EM<<"Number density == "<<MD<<" ("<<rho<<")"<<ELog::endDiag;
+      return -1;
+    }
+
+  std::vector<double> E;
+  E.push_back(1.0);
+  E.push_back(20.0);
+  std::vector<double> Sigma;
+  Sigma.push_back(1.0);
+  Sigma.push_back(3.0);
+
+  WeightMesh WMesh;
+  WMesh.setEnergy(E);
+  WMesh.setXYZ(Geometry::Vec3D(-3,-1,-1),Geometry::Vec3D(5,1,1),4,1,1);
+  calcMeshWeights(ASim,WMesh,Geometry::Vec3D(10,0,0),Sigma);
+
+  const double depth[]={0.0,-rho,-2.0*rho};
+  for(size_t e=0;e<2;e++)
+    for(size_t a=0;a<4;a++)
+      {
+	const double expect=(a<3) ? exp(Sigma[e]*depth[a]) : 0.0;
+	const double W=WMesh.getValue(a,0,0,e);
+	if (fabs(W-expect)>1e-5)
+	  {
+	    ELog::EM<<"Weight["<<a<<"]["<<e<<"] == "<<W<<" ("
+		    <<expect<<")"<<ELog::endDiag;
+	    return -2;
+	  }
+      }
+  return 0;
+}
+
+int
+testWeightMesh::testWWINP()
+  /*!
+    Write a two voxel mesh and check the WWINP values
+    and the six items per line format
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testWeightMesh","testWWINP");
+
+  WeightMesh WMesh;
+  WMesh.setEnergy(std::vector<double>(1,20.0));
+  WMesh.setXYZ(Geometry::Vec3D(0,0,0),Geometry::Vec3D(2,1,1),2,1,1);
+  WMesh.setValue(0,0,0,0,0.5);
+  WMesh.setValue(1,0,0,0,0.25);
+
+  std::ostringstream cx;
+  WMesh.writeWWINP(cx);
+
+  // header / ne / mesh / x / y / z / energy / weights
+  const double Expect[]=
+    { 1,1,1,10, 1, 2,1,1,0,0,0,2,1,1,1,  
+      0,1,1,1,1,2,1, 0,1,1,1, 0,1,1,1, 20.0, 0.5,0.25 };
+  const size_t NExpect(sizeof(Expect)/sizeof(double));
+
+  std::istringstream lx(cx.str());
+  std::string Line;
+  std::vector<double> Value;
+  while(std::getline(lx,Line))
+    {
+      std::istringstream ix(Line);
+      double V;
+      size_t cnt(0);
+      while(ix>>V)
+	{
+	  Value.push_back(V);
+	  cnt++;
+	}
+      if (cnt>6)
+	{
+	  ELog::EM<<"Line too long :"<<Line<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  if (Value.size()!=NExpect ||
+      !std::equal(Value.begin(),Value.end(),Expect))
+    {
+      ELog::EM<<"WWINP == \n"<<cx.str()<<ELog::endDiag;
+      return -2;
+    }
+  return 0;
+}
+
+int
+testWeightMesh::testXYZ()
+  /*!
+    Test the rectangular mesh and the voxel centres
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testWeightMesh","testXYZ");
+
+  std::vector<double> E;
+  E.push_back(1.0);
+  E.push_back(20.0);
+
+  WeightMesh WMesh;
+  WMesh.setEnergy(E);
+  WMesh.setXYZ(Geometry::Vec3D(-3,-1,-2),Geometry::Vec3D(5,1,2),4,1,2);
+  if (WMesh.getXSize()!=4 || WMesh.getYSize()!=1 ||
+      WMesh.getZSize()!=2 || WMesh.getESize()!=2 ||
+      WMesh.getValue(3,0,1,1)!=1.0)
+    {
+      ELog::EM<<"Size == "<<WMesh.getXSize()<<" "<<WMesh.getYSize()
+	      <<" "<<WMesh.getZSize()<<" "<<WMesh.getESize()<<ELog::endDiag;
+      return -1;
+    }
+  if (WMesh.voxelCentre(1,0,1)!=Geometry::Vec3D(0,0,1) ||
+      WMesh.voxelCentre(3,0,0)!=Geometry::Vec3D(4,0,-1))
+    {
+      ELog::EM<<"Centre == "<<WMesh.voxelCentre(1,0,1)<<" : "
+	      <<WMesh.voxelCentre(3,0,0)<<ELog::endDiag;
+      return -2;
+    }
+
+  // Voxel outside the mesh / empty mesh / inverted corners
+  int nThrow(0);
+  try
+    {
+      WMesh.voxelCentre(4,0,0);
+    }
+  catch (ColErr::ExBase&)
+    {
+      nThrow++;
+    }
+  try
+    {
+      WMesh.setXYZ(Geometry::Vec3D(0,0,0),Geometry::Vec3D(1,1,1),0,1,1);
+    }
+  catch (ColErr::ExBase&)
+    {
+      nThrow++;
+    }
+  try
+    {
+      WMesh.setXYZ(Geometry::Vec3D(0,0,0),Geometry::Vec3D(1,-1,1),1,1,1);
+    }
+  catch (ColErr::ExBase&)
+    {
+      nThrow++;
+    }
+  if (nThrow!=3)
+    {
+      ELog::EM<<"Bad mesh accepted : "<<nThrow<<ELog::endDiag;
+      return -3;
+    }
+  return 0;
+}
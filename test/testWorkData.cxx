@@ -77,11 +77,13 @@ testWorkData::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testWorkData::testIntegral,
+      &testWorkData::testRebinSet,
       &testWorkData::testSum
     };
   const std::string TestName[]=
     {
       "Integral",
+      "RebinSet",
       "Sum"
     };
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -183,6 +185,50 @@ testWorkData::testIntegral()
   return 0;
 }
  
+int
+testWorkData::testRebinSet()
+  /*!
+    Test the rebin of a set of spectra against
+    the single spectrum rebin
+    \retval -1 :: mismatch
+    \retval 0 :: All passed
+  */
+{
+  ELog::RegMethod RegA("testWorkData","testRebinSet");
+
+  std::vector<WorkData> WSet(4);
+  populate(WSet[0],10,0.0,10.0,1.0,1.0);
+  populate(WSet[1],10,0.0,10.0,2.0,-0.1);
+  populate(WSet[2],13,-1.0,12.0,1.0,0.5);
+  populate(WSet[3],13,-1.0,12.0,3.0,0.0);
+  std::vector<WorkData> Single(WSet);
+
+  std::vector<double> XOut;
+  for(int i=0;i<8;i++)
+    XOut.push_back(0.5+1.3*i);
+
+  WorkData::rebinSet(WSet,XOut);
+  for(size_t i=0;i<WSet.size();i++)
+    {
+      Single[i].rebin(XOut);
+      const std::vector<DError::doubleErr>& YA(WSet[i].getYdata());
+      const std::vector<DError::doubleErr>& YB(Single[i].getYdata());
+      if (YA.size()!=XOut.size()-1 || YA.size()!=YB.size())
+	{
+	  ELog::EM<<"Size failure["<<i<<"] "<<YA.size()<<ELog::endDiag;
+	  return -1;
+	}
+      for(size_t j=0;j<YA.size();j++)
+	if (YA[j]!=YB[j])
+	  {
+	    ELog::EM<<"Failed on point["<<i<<"]["<<j<<"] "
+		    <<YA[j]<<" "<<YB[j]<<ELog::endDiag;
+	    return -1;
+	  }
+    }
+  return 0;
+}
+
 int
 testWorkData::testSum()
 {
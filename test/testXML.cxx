@@ -58,6 +58,7 @@
 #include "XMLnamespace.h" 
 #include "XMLiterator.h"
 #include "XMLgridSupport.h"
+#include "XMLstream.h"
 
 #include "testFunc.h"
 #include "testUnitSupport.h"
@@ -246,7 +247,8 @@ testXML::applyTest(const int extra)
       &testXML::testDataBlock,	    
       &testXML::testGroupContent,   
       &testXML::testXMLiterator,     
-      &testXML::testProcString    
+      &testXML::testProcString,
+      &testXML::testStream
     };
 
   std::string TestName[] = 
@@ -269,7 +271,8 @@ testXML::applyTest(const int extra)
       "testDataBlock",
       "testGroupContent",
       "testXMLiterator",
-      "testProcString"
+      "testProcString",
+      "testStream"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -1128,3 +1131,97 @@ testXML::testDataBlock()
   
   return 0;
 }
+
+/*!
+  \class streamRecord
+  \brief Records XMLstream call backs as strings
+*/
+class streamRecord : public XML::XMLhandler
+{
+ public:
+
+  std::vector<std::string> Out;    ///< Events
+
+  /// Start element
+  virtual void startElement(const XML::strView& Key,const ATYPE& Attr)
+    {
+      std::string Item="S:"+Key.str();
+      for(size_t i=0;i<Attr.size();i++)
+	Item+=" "+Attr[i].first.str()+"="+
+	  XML::XMLstream::procEntity(Attr[i].second);
+      Out.push_back(Item);
+    }
+  /// End element
+  virtual void endElement(const XML::strView& Key)
+    { Out.push_back("E:"+Key.str()); }
+  /// Text
+  virtual void characters(const XML::strView& Text)
+    {
+      const XML::strView TV=XML::XMLstream::trim(Text);
+      if (!TV.empty())
+	Out.push_back("C:"+XML::XMLstream::procEntity(TV));
+    }
+};
+
+int
+testXML::testStream()
+  /*!
+    Test the streaming [call back] reader
+    \retval -1 :: Failed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testXML","testStream");
+
+  std::ofstream cx("testXML.xml");
+  cx<<"<?xml version=\"1.0\" encoding=\"ISO-8859-1\" ?>"<<std::endl;
+  cx<<"<!-- comment <not> a tag -->"<<std::endl;
+  cx<<"<Out>"<<std::endl;
+  cx<<"<test f=\"54\" g='a&amp;b'> Some text </test>";
+  cx<<"<testB/><testC a = \"10\"  />"<<std::endl;
+  cx<<"<testD>1 &lt; 2<![CDATA[<x>]]></testD>";
+  cx<<"</Out>"<<std::endl;
+  cx.close();
+
+  const char* Res[]=
+    {
+      "S:Out","S:test f=54 g=a&b","C:Some text","E:test",
+      "S:testB","E:testB","S:testC a=10","E:testC",
+      "S:testD","C:1 < 2","C:<x>","E:testD","E:Out"
+    };
+  const size_t NRes(sizeof(Res)/sizeof(const char*));
+
+  streamRecord SR;
+  XML::XMLstream XS("testXML.xml");
+  XS.parse(SR);
+  if (SR.Out.size()!=NRes)
+    {
+      ELog::EM<<"Size == "<<SR.Out.size()<<" ("<<NRes<<")"<<ELog::endDiag;
+      for(size_t i=0;i<SR.Out.size();i++)
+	ELog::EM<<"Out["<<i<<"] == "<<SR.Out[i]<<ELog::endDiag;
+      return -1;
+    }
+  for(size_t i=0;i<NRes;i++)
+    if (SR.Out[i]!=Res[i])
+      {
+	ELog::EM<<"Out["<<i<<"] == "<<SR.Out[i]<<ELog::endDiag;
+	ELog::EM<<"Expected == "<<Res[i]<<ELog::endDiag;
+	return -1;
+      }
+
+  // Mismatched close tag:
+  cx.open("testXML.xml");
+  cx<<"<Out><test></Out></test>"<<std::endl;
+  cx.close();
+  XML::XMLstream XSB("testXML.xml");
+  streamRecord SRB;
+  try
+    {
+      XSB.parse(SRB);
+      ELog::EM<<"Failed to find bad close tag"<<ELog::endDiag;
+      return -2;
+    }
+  catch (ColErr::InvalidLine&)
+    { }
+  return 0;
+}
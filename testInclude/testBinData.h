@@ -36,6 +36,8 @@ private:
 
   //Tests 
   int testAdd();
+  int testAddPoint();
+  int testRebinSet();
 
 public:
 
@@ -39,6 +39,7 @@ private:
 
   //Tests 
   int testMinTerm();
+  int testPrimeImplicant();
 
 public:
 
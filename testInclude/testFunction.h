@@ -37,8 +37,10 @@ private:
 
   //Tests 
   int testAnalyse();
+  int testBinary();
   int testBuiltIn();
   int testEval();
+  int testMemo();
   int testString();
   int testVec3D();
  
@@ -50,6 +50,7 @@ private:
 		  const double) const;
 
   //Tests 
+  int testCorner();
   int testLine();
   
 
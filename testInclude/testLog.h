@@ -35,8 +35,11 @@ class testLog
 {
 private:
 
+  static double spinWork(const size_t);
 
   //Tests 
+  int testBuildProfile();
+  int testCallProfile();
   int testENDL();
  
 public:
@@ -0,0 +1,55 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   testInclude/testNeutMaterial.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef testNeutMaterial_h
+#define testNeutMaterial_h 
+
+namespace scatterSystem
+{
+  class neutMaterial;
+}
+
+/*!
+  \class testNeutMaterial
+  \brief Test of the scatterSystem materials
+  \version 1.0
+  \date October 2013
+  \author S.Ansell
+*/
+
+class testNeutMaterial 
+{
+private:
+
+  static int checkTable(const scatterSystem::neutMaterial&);
+
+  //Tests 
+  int testTable();
+
+public:
+
+  testNeutMaterial();
+  ~testNeutMaterial();
+
+  int applyTest(const int);     
+};
+
+#endif
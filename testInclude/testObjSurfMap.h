@@ -39,6 +39,8 @@ class testObjSurfMap
   void createSurfaces();
   //Tests 
   int testMap();
+  int testNextObject();
+  int testOverlap();
 
  
  public:
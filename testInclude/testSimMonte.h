@@ -0,0 +1,62 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   testInclude/testSimMonte.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef testSimMonte_h
+#define testSimMonte_h 
+
+/*!
+  \class testSimMonte
+  \brief Tests the batch transport of SimMonte
+  \author S. Ansell
+  \date October 2013
+  \version 1.0
+
+  Builds a void slab in a void sphere and scores the
+  neutrons leaving the sphere on a detector plane.
+*/
+
+class testSimMonte
+{
+private:
+  
+  SimMonte ASim;       ///< Simulation to build tests in
+
+  void initSim();
+  void createSurfaces();
+  void createObjects();
+
+  static int sameData(const Transport::DetGroup&,
+		      const Transport::DetGroup&);
+
+  //Tests 
+  int testEventHistory();
+  int testReproducible();
+
+public:
+  
+  testSimMonte();
+  ~testSimMonte();
+  
+  int applyTest(const int);       
+
+};
+
+#endif
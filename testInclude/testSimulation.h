@@ -43,8 +43,15 @@ private:
   void createObjects();
 
   //Tests 
+  int testBuildContext();
   int testCreateObjSurfMap();
   int testInCell();
+  int testMasterFile();
+  int testMatFraction();
+  int testReadCells();
+  int testReadMaster();
+  int testReadSurfaces();
+  int testRemoveComplements();
   int testTrackNeutron();
 
 public:
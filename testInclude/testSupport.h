@@ -45,6 +45,7 @@ private:
   int testFullBlock();  
   int testItemize();    
   int testSection();    
+  int testSectionMCNPX();
   int testSectPartNum();
   int testSingleLine();
   int testStrComp();    
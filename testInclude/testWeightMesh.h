@@ -0,0 +1,57 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   testInclude/testWeightMesh.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef testWeightMesh_h
+#define testWeightMesh_h 
+
+/*!
+  \class testWeightMesh
+  \brief Tests the WeightMesh and the mesh weight calculation
+  \author S. Ansell
+  \date October 2013
+  \version 1.0
+
+  calcMeshWeights is tested on a water slab in a void sphere.
+*/
+
+class testWeightMesh
+{
+private:
+  
+  Simulation ASim;       ///< Simulation to build tests in
+
+  void initSim();
+
+  //Tests 
+  int testCalcMeshWeights();
+  int testWWINP();
+  int testXYZ();
+
+public:
+  
+  testWeightMesh();
+  ~testWeightMesh();
+  
+  int applyTest(const int);       
+
+};
+
+#endif
@@ -43,6 +43,7 @@ private:
 
   //Tests 
   int testIntegral();
+  int testRebinSet();
   int testSum();
  
 public:
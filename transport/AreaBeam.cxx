@@ -36,8 +36,7 @@
 #include "neutron.h"
 #include "Beam.h"
 #include "AreaBeam.h"
-
-extern MTRand RNG;
+#include "RNGStream.h"
 
 namespace Transport
 {
@@ -92,7 +91,7 @@ AreaBeam::generateNeutron() const
   */
 {
   return MonteCarlo::neutron(wavelength,
-     Geometry::Vec3D(0.0,startY,(RNG.rand()-0.5)*Height*2.0),
+     Geometry::Vec3D(0.0,startY,(randGen().rand()-0.5)*Height*2.0),
 	 Geometry::Vec3D(1,0,0));
 }
 
@@ -92,6 +92,23 @@ DetGroup::operator=(const DetGroup& A)
   return *this;
 }
 
+DetGroup&
+DetGroup::operator+=(const DetGroup& A) 
+  /*!
+    Add the counts of each detector in another group
+    \param A :: Group to add [same detectors]
+    \return *this
+   */
+{
+  ELog::RegMethod RegA("DetGroup","operator+=");
+  if (DetVec.size()!=A.DetVec.size())
+    throw ColErr::MisMatch<size_t>(DetVec.size(),A.DetVec.size(),
+				   "DetGroup::operator+=");
+  for(size_t i=0;i<DetVec.size();i++)
+    *DetVec[i]+= *A.DetVec[i];
+  return *this;
+}
+
 DetGroup::~DetGroup()
   /*!
     Destructor
@@ -181,6 +198,33 @@ DetGroup::getDet(const size_t Index) const
   return *DetVec[Index];
 }
 
+void
+DetGroup::addEvent(const MonteCarlo::neutron& N)
+  /*!
+    Score a neutron in all the detectors
+    \param N :: Neutron
+  */
+{
+  std::vector<Detector*>::iterator vc;
+  for(vc=DetVec.begin();vc!=DetVec.end();vc++)
+    (*vc)->addEvent(N);
+  return;
+}
+
+double
+DetGroup::getTotal() const
+  /*!
+    Sum of all the detectors
+    \return total weight
+  */
+{
+  double sum(0.0);
+  std::vector<Detector*>::const_iterator vc;
+  for(vc=DetVec.begin();vc!=DetVec.end();vc++)
+    sum+=(*vc)->getTotal();
+  return sum;
+}
+
 void
 DetGroup::write(std::ostream& OX,const double ) const
 {
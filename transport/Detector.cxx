@@ -29,6 +29,7 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <numeric>
 #include <boost/format.hpp>
 #include <boost/multi_array.hpp>
 
@@ -49,8 +50,7 @@
 #include "Surface.h"
 #include "neutron.h"
 #include "Detector.h"
-
-extern MTRand RNG;
+#include "RNGStream.h"
 
 namespace Transport
 {
@@ -155,6 +155,28 @@ Detector::operator=(const Detector& A)
   return *this;
 }
 
+Detector&
+Detector::operator+=(const Detector& A)
+  /*!
+    Add the counts of another detector [same binning]
+    \param A :: Detector to add
+    \return *this
+  */
+{
+  ELog::RegMethod RegA("Detector","operator+=");
+
+  const size_t NData(EData.num_elements());
+  if (NData!=A.EData.num_elements())
+    throw ColErr::MisMatch<size_t>(NData,A.EData.num_elements(),
+				   "Detector::operator+=");
+  nps+=A.nps;
+  double* DPtr=EData.data();
+  const double* APtr=A.EData.data();
+  for(size_t i=0;i<NData;i++)
+    DPtr[i]+=APtr[i];
+  return *this;
+}
+
 Detector::~Detector()
   /*!
     Destructor
@@ -288,7 +310,8 @@ Detector::addEvent(const MonteCarlo::neutron& N)
   /*!
     Add a point to the detector
     Tracks from the point to the detector.
-    Added correction for solid angle
+    Added correction for solid angle. The bin update is 
+    atomic so threads can score into the same detector.
     \param N :: Neutron
   */
 {
@@ -311,15 +334,34 @@ Detector::addEvent(const MonteCarlo::neutron& N)
   //           (ii) solid angle
   // Distance is u + travel
   const long int ePoint=calcWavePoint(N.wavelength);
-  if (ePoint>=0 || ePoint<static_cast<long int>(EGrid.size())-1)
+  if (ePoint>=0 && ePoint<nE)
     {
-      EData[vpt][hpt][ePoint]+=
+      const double value=
 	N.weight/((N.travel+u)*(N.travel+u)*fabs(DdotN));
+      double& Item(EData[vpt][hpt][ePoint]);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      Item+=value;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
       nps++;
     }
   return;
 }
 
+double
+Detector::getTotal() const
+  /*!
+    Sum of all the detector bins
+    \return total weight
+  */
+{
+  const double* DPtr=EData.data();
+  return std::accumulate(DPtr,DPtr+EData.num_elements(),0.0);
+}
+
 long int
 Detector::calcWavePoint(const double W) const
   /*!
@@ -333,8 +375,8 @@ Detector::calcWavePoint(const double W) const
 
   if (EGrid.empty()) return 0;
   const double E((0.5*RefCon::h2_mneV*1e20)/(W*W)); 
-  const long int res=indexPos(EGrid,E);
-  if (res<0 || res>=static_cast<long int>(EData.shape()[0]))
+  const long int res=gridIndex(E);
+  if (res<0 || res>=nE)
     {
       ELog::EM<<"Bins failed on : "<<W<<" "<<
 	E<<" == "<<EGrid.front()<<" "<<EGrid.back()<<ELog::endCrit;
@@ -352,7 +394,35 @@ Detector::calcEnergyPoint(const double E) const
   */
 {
   if (EGrid.empty()) return 0;
-  return indexPos(EGrid,E);
+  return gridIndex(E);
+}
+
+long int
+Detector::gridIndex(const double E) const
+  /*!
+    Find the EGrid cell of an energy [same result as indexPos].
+    EGrid is uniform [setEnergy] so the cell is calculated
+    and then checked against the grid points.
+    \param E :: Energy [eV]
+    \return EGrid cell [-1 to EGrid.size()-1]
+  */
+{
+  const long int NG(static_cast<long int>(EGrid.size()));
+  if (NG<2 || E<=EGrid.front()) 
+    return indexPos(EGrid,E);
+  if (E>=EGrid.back())
+    return NG-1;
+
+  long int index=static_cast<long int>
+    (static_cast<double>(NG-1)*(E-EGrid.front())/
+     (EGrid.back()-EGrid.front()));
+  if (index>NG-2) index=NG-2;
+  // Correct for rounding / non-uniform grid
+  while(index>0 && EGrid[static_cast<size_t>(index)]>=E)
+    index--;
+  while(index<NG-2 && EGrid[static_cast<size_t>(index+1)]<E)
+    index++;
+  return index;
 }
 
 void
@@ -383,8 +453,8 @@ Detector::getRandPos() const
     \return Vector Position
   */
 {
-  return Cent+H*hSize*(0.5-RNG.rand())+
-    V*vSize*(0.5-RNG.rand());
+  return Cent+H*hSize*(0.5-randGen().rand())+
+    V*vSize*(0.5-randGen().rand());
 }
 
 void
@@ -62,8 +62,8 @@
 #include "neutMaterial.h"
 #include "DBNeutMaterial.h"
 #include "ObjComponent.h"
-
-extern MTRand RNG;
+#include "RNGStream.h"
+#include "ParticleBank.h"
 
 namespace Transport
 {
@@ -73,11 +73,12 @@ ObjComponent::neutMat(const int matN)
   /*!
     Static function to get the neutMaterial based on the MCNPX
     material number
-    \param matN :: Material number
+    \param matN :: Material number [0 : void]
   */
 {
   ELog::RegMethod RegA("ObjComponent","neutMat");
   
+  if (!matN) return 0;
   return scatterSystem::DBNeutMaterial::Instance().getMat(matN);
 }
 
@@ -134,7 +135,7 @@ ObjComponent::attenuate(const double D,MonteCarlo::neutron& N) const
   */
 {
   if (!MatPtr) return;
-  N.weight*=MatPtr->calcAtten(N.wavelength,D);
+  N.weight*=MatPtr->tableAtten(N.wavelength,D);
   return;
 }  
 
@@ -196,7 +197,7 @@ ObjComponent::TotalCross(const MonteCarlo::neutron& N) const
     \return sigma_total * density
    */
 {
-  return (MatPtr) ? MatPtr->TotalCross(N.wavelength) : 0.0;
+  return (MatPtr) ? MatPtr->tableTotal(N.wavelength) : 0.0;
 }
   
 int
@@ -252,8 +253,8 @@ ObjComponent::trackWeight(MonteCarlo::neutron& N,
     {
 
       // Material to attenuate beam:
-      const double sXsec=MatPtr->ScatCross(N.wavelength);
-      const double aXsec=MatPtr->TotalCross(N.wavelength)-sXsec;
+      const double sXsec=MatPtr->tableScat(N.wavelength);
+      const double aXsec=MatPtr->tableTotal(N.wavelength)-sXsec;
       
       const double DV= -log(R)/sXsec;
       // Neutron did not reach other size
@@ -293,7 +294,7 @@ ObjComponent::trackAttn(MonteCarlo::neutron& N,
   if (MatPtr)    // not-void
     {
       // Material to attenuate beam:
-      const double tXsec=MatPtr->TotalCross(N.wavelength);
+      const double tXsec=MatPtr->tableTotal(N.wavelength);
       N.weight*=exp(-aDist*tXsec);
     }
   // Micro extra to avoid surface boundary
@@ -303,6 +304,85 @@ ObjComponent::trackAttn(MonteCarlo::neutron& N,
   return SN;
 }
 
+void
+ObjComponent::trackEvent(ParticleBank& PB,const size_t startIndex,
+			 const size_t endIndex) const
+  /*!
+    Event based version of trackWeight. All the neutrons 
+    [startIndex,endIndex) of the bank are in this cell. Each 
+    neutron is tracked to a scattering point [SN set to 0]
+    or to the cell exit [SN set to exit surface]. Neutrons 
+    with no exit are lost [Cell set to 0].
+    \param PB :: Particle bank [uses R : sets SN]
+    \param startIndex :: First neutron
+    \param endIndex :: One past last neutron
+  */
+{
+  ELog::RegMethod RegA("ObjComponent","trackEvent");
+
+  if (endIndex<=startIndex) return;
+  const size_t NP(endIndex-startIndex);
+
+  // Distance to boundary:
+  std::vector<double> aDist(NP);
+  std::vector<const Geometry::Surface*> SPtr(NP);
+  MonteCarlo::neutron N(1.0,Geometry::Vec3D(0,0,0),Geometry::Vec3D(1,0,0));
+  for(size_t i=0;i<NP;i++)
+    {
+      PB.setPoint(startIndex+i,N);
+      PB.SN[startIndex+i]=ObjPtr->trackOutCell(N,aDist[i],SPtr[i]);
+      // No exit : neutron lost
+      if (!PB.SN[startIndex+i])
+	{
+	  PB.Cell[startIndex+i]=0;
+	  aDist[i]=0.0;
+	}
+    }
+
+  // Cross section lookup and attenuation:
+  if (MatPtr)
+    {
+      std::vector<double> tXsec(NP);
+      std::vector<double> sXsec(NP);
+      MatPtr->tableCross(&PB.Wave[startIndex],NP,&tXsec[0],&sXsec[0]);
+      for(size_t i=0;i<NP;i++)
+	{
+	  const size_t index(startIndex+i);
+	  if (!PB.Cell[index]) continue;
+	  const double aXsec=tXsec[i]-sXsec[i];
+	  const double DV= -log(PB.R[index])/sXsec[i];
+	  if (DV<aDist[i]-Geometry::shiftTol)
+	    {
+	      PB.Weight[index]*=exp(-DV*aXsec);
+	      aDist[i]=DV;
+	      PB.SN[index]=0;
+	    }
+	  else
+	    {
+	      PB.R[index]=exp(-sXsec[i]*(Geometry::shiftTol+DV-aDist[i]));
+	      PB.Weight[index]*=exp(-aDist[i]*aXsec);
+	    }
+	}
+    }
+  PB.advance(startIndex,endIndex,&aDist[0]);
+
+  // Step over exit surface:
+  for(size_t i=0;i<NP;i++)
+    {
+      const size_t index(startIndex+i);
+      if (PB.SN[index])
+	{
+	  const Geometry::Vec3D Pt(PB.X[index],PB.Y[index],PB.Z[index]);
+	  const Geometry::Vec3D Norm=SPtr[i]->surfaceNormal(Pt)*
+	    (sign(PB.SN[index])*Geometry::shiftTol);
+	  PB.X[index]-=Norm[0];
+	  PB.Y[index]-=Norm[1];
+	  PB.Z[index]-=Norm[2];
+	}
+    }
+  return;
+}
+
 
 void
 ObjComponent::selectEnergy(const MonteCarlo::neutron& NIn,
@@ -317,7 +397,7 @@ ObjComponent::selectEnergy(const MonteCarlo::neutron& NIn,
   if (MatPtr)
     {
       // Choise between elastic and inelastic scattering:
-      const double R=RNG.rand();
+      const double R=randGen().rand();
       const double elasticRatio=MatPtr->ElasticTotalRatio(NIn.wavelength);
       if (R<elasticRatio)
 	return;      
@@ -0,0 +1,330 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   transport/ParticleBank.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "RefCon.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Triple.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "neutron.h"
+#include "ParticleBank.h"
+
+namespace Transport
+{
+
+/*!
+  Functor to order neutrons by cell number. Lost
+  neutrons go to the end.
+*/
+struct cellOrder
+{
+  /// Cells of the bank
+  const std::vector<const MonteCarlo::Object*>& Cell;
+
+  /// Constructor
+  explicit cellOrder(const std::vector<const MonteCarlo::Object*>& C) :
+    Cell(C) {}
+
+  /*!
+    Comparison of two bank indexes
+    \param A :: First index
+    \param B :: Second index
+    \return A before B
+  */
+  bool operator()(const size_t A,const size_t B) const
+    {
+      if (!Cell[B]) return (Cell[A]!=0);
+      if (!Cell[A]) return 0;
+      return Cell[A]->getName()<Cell[B]->getName();
+    }
+};
+
+/*!
+  Reorder a vector by an index list and truncate it
+  \param Index :: New order [old index]
+  \param Vec :: Vector to reorder
+*/
+template<typename T>
+static void
+applyOrder(const std::vector<size_t>& Index,std::vector<T>& Vec)
+{
+  std::vector<T> Out(Index.size());
+  for(size_t i=0;i<Index.size();i++)
+    Out[i]=Vec[Index[i]];
+  Vec.swap(Out);
+  return;
+}
+
+ParticleBank::ParticleBank()
+  /*!
+    Constructor
+  */
+{}
+
+ParticleBank::ParticleBank(const ParticleBank& A) :
+  ID(A.ID),X(A.X),Y(A.Y),Z(A.Z),U(A.U),V(A.V),W(A.W),
+  Weight(A.Weight),Wave(A.Wave),Travel(A.Travel),Time(A.Time),
+  R(A.R),SN(A.SN),Cell(A.Cell)
+  /*!
+    Copy constructor
+    \param A :: ParticleBank to copy
+  */
+{}
+
+ParticleBank&
+ParticleBank::operator=(const ParticleBank& A)
+  /*!
+    Assignment operator
+    \param A :: ParticleBank to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      ID=A.ID;
+      X=A.X;
+      Y=A.Y;
+      Z=A.Z;
+      U=A.U;
+      V=A.V;
+      W=A.W;
+      Weight=A.Weight;
+      Wave=A.Wave;
+      Travel=A.Travel;
+      Time=A.Time;
+      R=A.R;
+      SN=A.SN;
+      Cell=A.Cell;
+    }
+  return *this;
+}
+
+ParticleBank::~ParticleBank()
+  /*!
+    Destructor
+  */
+{}
+
+void
+ParticleBank::clear()
+  /*!
+    Remove all the neutrons
+  */
+{
+  ID.clear();
+  X.clear();
+  Y.clear();
+  Z.clear();
+  U.clear();
+  V.clear();
+  W.clear();
+  Weight.clear();
+  Wave.clear();
+  Travel.clear();
+  Time.clear();
+  R.clear();
+  SN.clear();
+  Cell.clear();
+  return;
+}
+
+void
+ParticleBank::reserve(const size_t N)
+  /*!
+    Reserve space for neutrons
+    \param N :: Number of neutrons
+  */
+{
+  ID.reserve(N);
+  X.reserve(N);
+  Y.reserve(N);
+  Z.reserve(N);
+  U.reserve(N);
+  V.reserve(N);
+  W.reserve(N);
+  Weight.reserve(N);
+  Wave.reserve(N);
+  Travel.reserve(N);
+  Time.reserve(N);
+  R.reserve(N);
+  SN.reserve(N);
+  Cell.reserve(N);
+  return;
+}
+
+void
+ParticleBank::addNeutron(const MonteCarlo::neutron& N,
+			 const MonteCarlo::Object* OPtr)
+  /*!
+    Add a neutron to the bank
+    \param N :: Neutron
+    \param OPtr :: Cell of the neutron
+  */
+{
+  ID.push_back(N.ID);
+  X.push_back(N.Pos[0]);
+  Y.push_back(N.Pos[1]);
+  Z.push_back(N.Pos[2]);
+  U.push_back(N.uVec[0]);
+  V.push_back(N.uVec[1]);
+  W.push_back(N.uVec[2]);
+  Weight.push_back(N.weight);
+  Wave.push_back(N.wavelength);
+  Travel.push_back(N.travel);
+  Time.push_back(N.time);
+  R.push_back(0.0);
+  SN.push_back(0);
+  Cell.push_back(OPtr);
+  return;
+}
+
+void
+ParticleBank::setPoint(const size_t i,MonteCarlo::neutron& N) const
+  /*!
+    Set the position/direction/wavelength of a neutron
+    from a bank item [for geometry tracking]
+    \param i :: Bank index
+    \param N :: Neutron to set
+  */
+{
+  N.Pos=Geometry::Vec3D(X[i],Y[i],Z[i]);
+  N.uVec=Geometry::Vec3D(U[i],V[i],W[i]);
+  N.wavelength=Wave[i];
+  return;
+}
+
+MonteCarlo::neutron
+ParticleBank::getNeutron(const size_t i) const
+  /*!
+    Get a bank item as a neutron
+    \param i :: Bank index
+    \return neutron
+  */
+{
+  MonteCarlo::neutron N(Wave[i],Geometry::Vec3D(X[i],Y[i],Z[i]),
+			Geometry::Vec3D(U[i],V[i],W[i]));
+  N.ID=ID[i];
+  N.weight=Weight[i];
+  N.travel=Travel[i];
+  N.time=Time[i];
+  return N;
+}
+
+size_t
+ParticleBank::sortCells()
+  /*!
+    Remove lost neutrons and those in zero importance 
+    cells and group the rest by cell 
+    \return number of neutrons left
+  */
+{
+  ELog::RegMethod RegA("ParticleBank","sortCells");
+
+  for(size_t i=0;i<Cell.size();i++)
+    if (Cell[i] && !Cell[i]->getImp())
+      Cell[i]=0;
+
+  std::vector<size_t> Index(Cell.size());
+  for(size_t i=0;i<Index.size();i++)
+    Index[i]=i;
+  std::stable_sort(Index.begin(),Index.end(),cellOrder(Cell));
+  while(!Index.empty() && !Cell[Index.back()])
+    Index.pop_back();
+
+  applyOrder(Index,ID);
+  applyOrder(Index,X);
+  applyOrder(Index,Y);
+  applyOrder(Index,Z);
+  applyOrder(Index,U);
+  applyOrder(Index,V);
+  applyOrder(Index,W);
+  applyOrder(Index,Weight);
+  applyOrder(Index,Wave);
+  applyOrder(Index,Travel);
+  applyOrder(Index,Time);
+  applyOrder(Index,R);
+  applyOrder(Index,SN);
+  applyOrder(Index,Cell);
+  return Index.size();
+}
+
+void
+ParticleBank::cellGroups(std::vector<size_t>& Group) const
+  /*!
+    Get the start of each cell group [after sortCells]
+    \param Group :: Start index of each group + size() at end
+  */
+{
+  Group.clear();
+  for(size_t i=0;i<Cell.size();i++)
+    if (!i || Cell[i]!=Cell[i-1])
+      Group.push_back(i);
+  Group.push_back(Cell.size());
+  return;
+}
+
+void
+ParticleBank::advance(const size_t startIndex,const size_t endIndex,
+		      const double* D)
+  /*!
+    Move a range of neutrons forward
+    \param startIndex :: First neutron
+    \param endIndex :: One past last neutron
+    \param D :: Distance for each neutron [from startIndex]
+  */
+{
+  const double vScale(1.0/(1e10*RefCon::h_mn));
+  for(size_t i=startIndex;i<endIndex;i++)
+    {
+      const double dist(D[i-startIndex]);
+      X[i]+=U[i]*dist;
+      Y[i]+=V[i]*dist;
+      Z[i]+=W[i]*dist;
+      Travel[i]+=dist;
+      Time[i]+=dist*Wave[i]*vScale;
+    }
+  return;
+}
+
+}  // NAMESPACE Transport
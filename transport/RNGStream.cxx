@@ -0,0 +1,74 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   transport/RNGStream.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "MersenneTwister.h"
+#include "RNGStream.h"
+
+extern MTRand RNG;
+
+namespace Transport
+{
+
+/// Generator of this thread [0 : global RNG]
+static MTRand* threadGen(0);
+#ifdef _OPENMP
+#pragma omp threadprivate(threadGen)
+#endif
+
+MTRand&
+randGen()
+  /*!
+    Access the generator of the calling thread
+    \return generator
+  */
+{
+  return (threadGen) ? *threadGen : RNG;
+}
+
+RNGStream::RNGStream(const unsigned int seed,const size_t stream) :
+  prevPtr(threadGen),Gen(0)
+  /*!
+    Constructor : seed a generator and make it the
+    generator of this thread
+    \param seed :: Base seed
+    \param stream :: Stream number
+  */
+{
+  MTRand::uint32 key[3]=
+    { seed,static_cast<MTRand::uint32>(stream),0x9e3779b9U };
+  Gen=new MTRand(key,3);
+  threadGen=Gen;
+}
+
+RNGStream::~RNGStream()
+  /*!
+    Destructor : restore the previous generator
+  */
+{
+  threadGen=prevPtr;
+  delete Gen;
+}
+
+}  // NAMESPACE Transport
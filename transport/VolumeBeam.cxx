@@ -47,8 +47,7 @@
 #include "Detector.h"
 #include "Beam.h"
 #include "VolumeBeam.h"
-
-extern MTRand RNG;
+#include "RNGStream.h"
 
 namespace Transport
 {
@@ -153,22 +152,22 @@ VolumeBeam::generateNeutron() const
 {
   ELog::RegMethod RegA("VolumeBeam","generateNeutron");
 
-  const double theta=2.0*M_PI*RNG.rand();
-  const double phi=M_PI*RNG.rand();
+  const double theta=2.0*M_PI*randGen().rand();
+  const double phi=M_PI*randGen().rand();
   Geometry::Vec3D uV(cos(theta)*sin(phi),sin(theta)*sin(phi),
 		     cos(phi));
   MonteCarlo::neutron Out(wavelength,Corner,uV);
   // Weighting based on the cos() factors of the centroid probability:
   Geometry::Vec3D NLocal(Corner);   // local position of the neutron
   
-  double xfrac=RNG.rand();
+  double xfrac=randGen().rand();
   Out.weight*=cos( (xfrac-0.5)*M_PI );
   NLocal+=X*xfrac;
-  xfrac=RNG.rand();
+  xfrac=randGen().rand();
   Out.weight*=cos( (xfrac-0.5)*M_PI );
   NLocal+=Z*xfrac;
   // Y is special
-  xfrac=RNG.rand();
+  xfrac=randGen().rand();
   Out.weight*=cos( (xfrac-0.5)*M_PI );
   NLocal+=Y*xfrac;
   if (yBias>0.0)
@@ -48,14 +48,20 @@ class DetGroup
   DetGroup();
   DetGroup(const DetGroup&);
   DetGroup& operator=(const DetGroup&);
+  DetGroup& operator+=(const DetGroup&);
   ~DetGroup();
 
+  /// Number of detectors
+  size_t size() const { return DetVec.size(); }
+
   void clear();
   void manageDetector(Detector*);
   void addDetector(const Detector&);
   
   Detector& getDet(const size_t);
   const Detector& getDet(const size_t) const;
+  void addEvent(const MonteCarlo::neutron&);
+  double getTotal() const;
 
   void write(std::ostream&,const double) const;
 
@@ -31,6 +31,10 @@ namespace Transport
   \version 1.0
   \author S. Ansell
   \date December 2009
+
+  addEvent uses atomic updates so a detector can be
+  shared between threads. Alternatively each thread scores 
+  its own copy and the copies are merged with operator+=.
 */
 
 class Detector
@@ -54,6 +58,8 @@ class Detector
 
   boost::multi_array<double,3> EData;  ///< Energy data set
 
+  long int gridIndex(const double) const;
+
  public:
   
   Detector();
@@ -62,6 +68,7 @@ class Detector
 	   const Geometry::Vec3D&,const double,const double);
   Detector(const Detector&);
   Detector& operator=(const Detector&);
+  Detector& operator+=(const Detector&);
   /// Clone constructor
   virtual Detector* clone() const { return new Detector(*this); }
   virtual ~Detector();
@@ -80,12 +87,17 @@ class Detector
   std::pair<Geometry::Vec3D,Geometry::Vec3D> getAxis() const;
   /// Access Centre
   const Geometry::Vec3D& getCentre() const { return Cent; }
+  /// Access number of scored events
+  long int getNPS() const { return nps; }
+  /// Access data [V : H : E]
+  const boost::multi_array<double,3>& getData() const { return EData; }
 
   Geometry::Vec3D getRandPos() const;
   void project(const MonteCarlo::neutron&,
 	        MonteCarlo::neutron&) const;
   int calcCell(const MonteCarlo::neutron&,int&,int&) const;
   void addEvent(const MonteCarlo::neutron&);
+  double getTotal() const;
 
   void clear();
   void setDataSize(const int,const int,const int);
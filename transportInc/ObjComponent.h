@@ -27,6 +27,7 @@ namespace Transport
   //forward declaration
   class neutron;
   class Track;
+  class ParticleBank;
 
   /*!
     \class ObjComponent 
@@ -70,6 +71,7 @@ class ObjComponent
   int trackWeight(MonteCarlo::neutron&,double&,
 		  const Geometry::Surface*&) const;
   int trackAttn(MonteCarlo::neutron&,const Geometry::Surface*&) const;
+  void trackEvent(ParticleBank&,const size_t,const size_t) const;
 
   void attenuate(const double,MonteCarlo::neutron&) const;
   double getRefractive(const MonteCarlo::neutron&) const;
@@ -0,0 +1,86 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   transportInc/ParticleBank.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef Transport_ParticleBank_h
+#define Transport_ParticleBank_h
+
+namespace Transport
+{
+
+/*!  
+  \class ParticleBank
+  \brief Neutrons stored as arrays [one per component]
+  \version 1.0
+  \author S. Ansell
+  \date October 2013
+
+  Event based transport processes all the neutrons in 
+  a cell together. The bank keeps each neutron component 
+  in its own array so the event kernels are simple loops.
+  sortCells removes dead neutrons and groups the rest by
+  cell [stable, so the order is reproducible].
+*/
+
+class ParticleBank
+{
+ public:
+
+  std::vector<int> ID;           ///< Neutron ID
+  std::vector<double> X;         ///< Position [x]
+  std::vector<double> Y;         ///< Position [y]
+  std::vector<double> Z;         ///< Position [z]
+  std::vector<double> U;         ///< Direction [x]
+  std::vector<double> V;         ///< Direction [y]
+  std::vector<double> W;         ///< Direction [z]
+  std::vector<double> Weight;    ///< Weight
+  std::vector<double> Wave;      ///< Wavelength [A]
+  std::vector<double> Travel;    ///< Distance travelled
+  std::vector<double> Time;      ///< Time travelled
+
+  std::vector<double> R;         ///< Random exponent of event
+  std::vector<int> SN;           ///< Exit surface of event [0 : in cell]
+  /// Cell of each neutron [0 : lost]
+  std::vector<const MonteCarlo::Object*> Cell;
+
+  ParticleBank();
+  ParticleBank(const ParticleBank&);
+  ParticleBank& operator=(const ParticleBank&);
+  ~ParticleBank();
+
+  /// Number of neutrons
+  size_t size() const { return ID.size(); }
+  void clear();
+  void reserve(const size_t);
+
+  void addNeutron(const MonteCarlo::neutron&,
+		  const MonteCarlo::Object*);
+  MonteCarlo::neutron getNeutron(const size_t) const;
+  void setPoint(const size_t,MonteCarlo::neutron&) const;
+
+  size_t sortCells();
+  void cellGroups(std::vector<size_t>&) const;
+  void advance(const size_t,const size_t,const double*);
+
+};
+
+}  // NAMESPACE Transport
+
+#endif
@@ -0,0 +1,67 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   transportInc/RNGStream.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef Transport_RNGStream_h
+#define Transport_RNGStream_h
+
+class MTRand;
+
+namespace Transport
+{
+
+/*!  
+  \class RNGStream
+  \brief Sets the random number generator of this thread
+  \version 1.0
+  \author S. Ansell
+  \date October 2013
+
+  While the object exists randGen() on the creating thread
+  returns a generator seeded from (seed,stream). Otherwise
+  randGen() is the global RNG. A batch of histories run
+  under the same (seed,stream) gives the same result on 
+  any thread.
+*/
+
+class RNGStream
+{
+ private:
+
+  MTRand* prevPtr;             ///< Previous generator of thread
+  MTRand* Gen;                 ///< Generator of the stream
+
+  ///\cond ABSTRACT
+  RNGStream(const RNGStream&);
+  RNGStream& operator=(const RNGStream&);
+  ///\endcond ABSTRACT
+
+ public:
+
+  RNGStream(const unsigned int,const size_t);
+  ~RNGStream();
+
+};
+
+MTRand& randGen();
+
+}  // NAMESPACE Transport
+
+#endif
@@ -0,0 +1,362 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   visit/MatFraction.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cmath>
+#include <complex>
+#include <string>
+#include <sstream>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <boost/shared_ptr.hpp>
+#include <boost/format.hpp>
+#include <boost/multi_array.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Triple.h"
+#include "NRange.h"
+#include "NList.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "KGroup.h"
+#include "Source.h"
+#include "SimProcess.h"
+#include "SurInter.h"
+#include "Simulation.h"
+#include "SimTrack.h"
+#include "BuildContext.h"
+#include "MatFraction.h"
+
+
+std::ostream&
+operator<<(std::ostream& OX,const MatFraction& A)
+  /*!
+    Write to a stream
+    \param OX :: Output stream
+    \param A :: MatFraction to write
+    \return Stream state
+  */
+{
+  A.write(OX);
+  return OX;
+}
+
+MatFraction::MatFraction() : 
+  nPts(1,1,1),nSub(1)
+  /*!
+    Constructor
+  */
+{}
+
+MatFraction::MatFraction(const MatFraction& A) : 
+  Origin(A.Origin),XYZ(A.XYZ),nPts(A.nPts),nSub(A.nSub),
+  VIndex(A.VIndex),Mat(A.Mat),Frac(A.Frac)
+  /*!
+    Copy constructor
+    \param A :: MatFraction to copy
+  */
+{}
+
+MatFraction&
+MatFraction::operator=(const MatFraction& A)
+  /*!
+    Assignment operator
+    \param A :: MatFraction to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      Origin=A.Origin;
+      XYZ=A.XYZ;
+      nPts=A.nPts;
+      nSub=A.nSub;
+      VIndex=A.VIndex;
+      Mat=A.Mat;
+      Frac=A.Frac;
+    }
+  return *this;
+}
+
+MatFraction::~MatFraction()
+  /*!
+    Destructor
+   */
+{}
+
+void 
+MatFraction::setBox(const Geometry::Vec3D& startPt,
+		    const Geometry::Vec3D& endPt)
+  /*!
+    Set the box start and end point
+    \param startPt :: Point on near corner
+    \param endPt :: Point on opposite corner
+  */
+{
+  Origin=startPt;
+  XYZ=endPt-Origin;
+  return;
+}
+
+void
+MatFraction::setIndex(const size_t A,const size_t B,const size_t C)
+  /*!
+    Set the number of voxels, checks to ensure that 
+    they are greater than zero
+    \param A :: Xcoordinate division
+    \param B :: Ycoordinate division
+    \param C :: Zcoordinate division
+  */
+{
+  nPts=Triple<size_t>((A>0) ? A : 1,
+		      (B>0) ? B : 1,
+		      (C>0) ? C : 1);
+  return;
+}
+
+void
+MatFraction::setSubSample(const size_t M)
+  /*!
+    Set the number of sample points on each voxel side
+    \param M :: Sample points [M^3 per voxel]
+  */
+{
+  nSub=(M>0) ? M : 1;
+  return;
+}
+
+Geometry::Vec3D
+MatFraction::point(const double a,const double b,const double c) const
+  /*!
+    Convert a voxel coordinate into a point
+    \param a :: x coordinate [voxel units]
+    \param b :: y coordinate [voxel units]
+    \param c :: z coordinate [voxel units]
+    \return Point 
+  */
+{
+  return Origin+Geometry::Vec3D(XYZ[0]*a/static_cast<double>(nPts[0]),
+				XYZ[1]*b/static_cast<double>(nPts[1]),
+				XYZ[2]*c/static_cast<double>(nPts[2]));
+}
+
+size_t
+MatFraction::voxelIndex(const size_t i,const size_t j,const size_t k) const
+  /*!
+    Index of voxel (i,j,k) [x fastest]
+    \param i :: x index
+    \param j :: y index
+    \param k :: z index
+    \return voxel index
+  */
+{
+  if (i>=nPts[0] || j>=nPts[1] || k>=nPts[2])
+    throw ColErr::IndexError<size_t>(i,nPts[0],"MatFraction::voxelIndex");
+  return i+nPts[0]*(j+nPts[1]*k);
+}
+
+size_t
+MatFraction::getFractions(const size_t VI,std::vector<int>& MVec,
+			  std::vector<double>& FVec) const
+  /*!
+    Get the materials and fractions in a voxel
+    \param VI :: Voxel index
+    \param MVec :: Material numbers
+    \param FVec :: Fractions
+    \return number of materials
+  */
+{
+  if (VI+1>=VIndex.size())
+    throw ColErr::IndexError<size_t>(VI,getNVoxel(),
+				     "MatFraction::getFractions");
+  MVec.assign(Mat.begin()+static_cast<long int>(VIndex[VI]),
+	      Mat.begin()+static_cast<long int>(VIndex[VI+1]));
+  FVec.assign(Frac.begin()+static_cast<long int>(VIndex[VI]),
+	      Frac.begin()+static_cast<long int>(VIndex[VI+1]));
+  return MVec.size();
+}
+
+double
+MatFraction::getFraction(const size_t VI,const int matN) const
+  /*!
+    Get the fraction of a material in a voxel
+    \param VI :: Voxel index
+    \param matN :: Material number
+    \return fraction [0 if not present]
+  */
+{
+  if (VI+1>=VIndex.size())
+    throw ColErr::IndexError<size_t>(VI,getNVoxel(),
+				     "MatFraction::getFraction");
+  for(size_t i=VIndex[VI];i<VIndex[VI+1];i++)
+    if (Mat[i]==matN)
+      return Frac[i];
+  return 0.0;
+}
+
+void
+MatFraction::populate(const Simulation* SimPtr)
+  /*!
+    The big population call. The corner grid is 
+    found first, then only voxels with mixed corners 
+    are sampled.
+    \param SimPtr :: Simulation system
+   */
+{
+  ELog::RegMethod RegA("MatFraction","populate");
+
+  const size_t NC[3]={nPts[0]+1,nPts[1]+1,nPts[2]+1};
+  const size_t NVox(getNVoxel());
+  const long int NCorner(static_cast<long int>(NC[0]*NC[1]*NC[2]));
+  const long int NV(static_cast<long int>(NVox));
+  const double NSample(static_cast<double>(nSub*nSub*nSub));
+  const double dS(1.0/static_cast<double>(nSub));
+
+  std::vector<const MonteCarlo::Object*> Corner(NC[0]*NC[1]*NC[2]);
+  // Material number / count for each voxel
+  std::vector<std::map<int,size_t> > VCount(NVox);
+  size_t nSampled(0);
+#ifdef _OPENMP
+#pragma omp parallel if (NV>1)
+#endif
+  {
+    // Each thread keeps its own findCell cache
+    BuildContext TrackCtx(1);
+    TrackCtx.getSimTrack().addSim(SimPtr);
+    BuildContextGuard TrackGuard(TrackCtx);
+    MonteCarlo::Object* ObjPtr(0);
+    
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for(long int index=0;index<NCorner;index++)
+      {
+	const size_t ci(static_cast<size_t>(index));
+	const Geometry::Vec3D Pt=
+	  point(static_cast<double>(ci % NC[0]),
+		static_cast<double>((ci/NC[0]) % NC[1]),
+		static_cast<double>(ci/(NC[0]*NC[1])));
+	ObjPtr=SimPtr->findCell(Pt,ObjPtr);
+	Corner[ci]=ObjPtr;
+      }
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,16) reduction(+ : nSampled)
+#endif
+    for(long int index=0;index<NV;index++)
+      {
+	const size_t vi(static_cast<size_t>(index));
+	const size_t i(vi % nPts[0]);
+	const size_t j((vi/nPts[0]) % nPts[1]);
+	const size_t k(vi/(nPts[0]*nPts[1]));
+	std::map<int,size_t>& MCount(VCount[vi]);
+
+	// Early exit : all corners in one cell
+	const MonteCarlo::Object* CPtr=Corner[i+NC[0]*(j+NC[1]*k)];
+	bool sameFlag(CPtr!=0);
+	for(size_t cIndex=1;sameFlag && cIndex<8;cIndex++)
+	  {
+	    const size_t ci=(i+(cIndex & 1))+
+	      NC[0]*((j+((cIndex>>1) & 1))+NC[1]*(k+((cIndex>>2) & 1)));
+	    sameFlag=(Corner[ci]==CPtr);
+	  }
+	if (sameFlag)
+	  {
+	    MCount[CPtr->getMat()]=nSub*nSub*nSub;
+	    continue;
+	  }
+	// Stratified sample points
+	nSampled++;
+	for(size_t a=0;a<nSub;a++)
+	  for(size_t b=0;b<nSub;b++)
+	    for(size_t c=0;c<nSub;c++)
+	      {
+		const Geometry::Vec3D Pt=
+		  point(static_cast<double>(i)+(static_cast<double>(a)+0.5)*dS,
+			static_cast<double>(j)+(static_cast<double>(b)+0.5)*dS,
+			static_cast<double>(k)+(static_cast<double>(c)+0.5)*dS);
+		ObjPtr=SimPtr->findCell(Pt,ObjPtr);
+		MCount[(ObjPtr) ? ObjPtr->getMat() : -1]++;
+	      }
+      }
+  }
+
+  // Pack into the sparse table
+  VIndex.resize(NVox+1);
+  Mat.clear();
+  Frac.clear();
+  for(size_t vi=0;vi<NVox;vi++)
+    {
+      VIndex[vi]=Mat.size();
+      std::map<int,size_t>::const_iterator mc;
+      for(mc=VCount[vi].begin();mc!=VCount[vi].end();mc++)
+	{
+	  Mat.push_back(mc->first);
+	  Frac.push_back(static_cast<double>(mc->second)/NSample);
+	}
+    }
+  VIndex[NVox]=Mat.size();
+  ELog::EM<<"Voxels sampled "<<nSampled<<" / "<<NVox<<ELog::endDiag;
+  return;
+}
+
+void 
+MatFraction::write(std::ostream& OX) const
+  /*!
+    Write out the sparse table as i j k mat fraction
+    \param OX :: Output stream
+  */
+{
+  ELog::RegMethod RegA("MatFraction","write");
+
+  boost::format FMT("%1$d %2$d %3$d %4$d %5$.6g");
+  OX<<"# voxels "<<nPts[0]<<" "<<nPts[1]<<" "<<nPts[2]
+    <<" origin "<<Origin<<" extent "<<XYZ<<std::endl;
+  for(size_t vi=0;vi+1<VIndex.size();vi++)
+    {
+      const size_t i(vi % nPts[0]);
+      const size_t j((vi/nPts[0]) % nPts[1]);
+      const size_t k(vi/(nPts[0]*nPts[1]));
+      for(size_t index=VIndex[vi];index<VIndex[vi+1];index++)
+	OX<<(FMT % i % j % k % Mat[index] % Frac[index])<<std::endl;
+    }
+  return;
+}
@@ -188,6 +188,9 @@ Visit::populate(const Simulation* SimPtr,
     ModelSupport::objectRegister::Instance();
   
   const bool aEmptyFlag=Active.empty();
+  // neighbouring voxels are mostly in the same cell
+  int prevCell(0);
+  bool prevActive(0);
 
   double stepXYZ[3];
   for(size_t i=0;i<3;i++)
@@ -207,8 +210,13 @@ Visit::populate(const Simulation* SimPtr,
 	      // Active Set Code:
 	      if (!aEmptyFlag)
 		{
-		  const std::string rangeStr=OR.inRange(ObjPtr->getName());
-		  if (Active.find(rangeStr)!=Active.end())
+		  if (ObjPtr->getName()!=prevCell)
+		    {
+		      prevCell=ObjPtr->getName();
+		      prevActive=(Active.find(OR.inRange(prevCell))!=
+				  Active.end());
+		    }
+		  if (prevActive)
 		    mesh[i][j][k]=getResult(ObjPtr);
 		  else
 		    mesh[i][j][k]=0.0;
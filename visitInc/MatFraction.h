@@ -0,0 +1,90 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   visitInc/MatFraction.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef MatFraction_h
+#define MatFraction_h
+
+class Simulation;
+namespace MonteCarlo
+{
+class Object;
+}
+
+/*!
+  \class MatFraction
+  \brief Material volume fractions in each voxel of a mesh
+  \date October 2013
+  \author S. Ansell
+  \version 1.0
+
+  Each voxel is sampled on an MxMxM grid of stratified
+  points. If all eight corners of a voxel are in the same 
+  cell the voxel is assigned to that material without sampling.
+  Results are a sparse table of (voxel,material,fraction)
+  with the voxel index running x fastest. Material -1 
+  is outside of the model.
+*/
+						
+class MatFraction
+{
+ private:
+  
+  // Input data
+  Geometry::Vec3D Origin;     ///< Origin
+  Geometry::Vec3D XYZ;        ///< XYZ extent
+  Triple<size_t> nPts;        ///< Number of voxels 
+  size_t nSub;                ///< Sample points on voxel side
+  
+  std::vector<size_t> VIndex; ///< Start of voxel in Mat/Frac [NVox+1]
+  std::vector<int> Mat;       ///< Material number
+  std::vector<double> Frac;   ///< Volume fraction
+
+  Geometry::Vec3D point(const double,const double,const double) const;
+  
+ public:
+
+  MatFraction();
+  MatFraction(const MatFraction&);
+  MatFraction& operator=(const MatFraction&);
+  ~MatFraction();
+
+  void setBox(const Geometry::Vec3D&,
+              const Geometry::Vec3D&);
+  void setIndex(const size_t,const size_t,const size_t);
+  void setSubSample(const size_t);
+
+  /// Number of voxels
+  size_t getNVoxel() const { return nPts[0]*nPts[1]*nPts[2]; }
+  /// Number of (voxel,material) entries
+  size_t getNEntry() const { return Mat.size(); }
+  size_t voxelIndex(const size_t,const size_t,const size_t) const;
+  size_t getFractions(const size_t,std::vector<int>&,
+		      std::vector<double>&) const;
+  double getFraction(const size_t,const int) const;
+
+  void populate(const Simulation*);
+  void write(std::ostream&) const;
+};
+
+std::ostream&
+operator<<(std::ostream&,const MatFraction&);
+
+#endif
@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <boost/array.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/multi_array.hpp>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -59,6 +60,7 @@
 #include "WForm.h"
 #include "WItem.h"
 #include "WCells.h"
+#include "WeightMesh.h"
 #include "WeightModification.h"
 #include "KGroup.h"
 #include "Source.h"
@@ -68,6 +70,7 @@
 #include "inputParam.h"
 #include "TallyCreate.h"
 #include "PointWeights.h"
+#include "MeshWeights.h"
 #include "TempWeights.h"
 #include "BasicWWE.h"
 
@@ -94,15 +97,18 @@ simulationWeights(Simulation& System,
 
   const std::string WType=IParam.getValue<std::string>("weightType");
   setWeights(System,WType);
-  if (IParam.flag("weight"))
+  Geometry::Vec3D AimPoint;
+  if (IParam.flag("weight") || IParam.flag("weightMesh"))
     {
-      Geometry::Vec3D AimPoint;
       if (IParam.flag("weightPt"))
 	AimPoint=IParam.getValue<Geometry::Vec3D>("weightPt");
       else 
 	tallySystem::getFarPoint(System,AimPoint);
-      setPointWeights(System,AimPoint,IParam.getValue<double>("weight"));
     }
+  if (IParam.flag("weight"))
+    setPointWeights(System,AimPoint,IParam.getValue<double>("weight"));
+  if (IParam.flag("weightMesh"))
+    meshWeights(System,IParam,AimPoint);
   if (IParam.flag("weightTemp"))
     {
       scaleTempWeights(System,10.0);
@@ -114,6 +120,61 @@ simulationWeights(Simulation& System,
   return;
 }
 
+void
+meshWeights(const Simulation& System,
+	    const mainSystem::inputParam& IParam,
+	    const Geometry::Vec3D& AimPoint)
+  /*!
+    Build a ray-traced weight window mesh on the meshA/meshB 
+    box and write it as a WWINP file. The energy groups are 
+    those of the neutron cell weights.
+    \param System :: Simulation
+    \param IParam :: input stream
+    \param AimPoint :: Point to trace to
+   */
+{
+  ELog::RegMethod RegA("BasicWWE","meshWeights");
+
+  if (!IParam.flag("meshA") || !IParam.flag("meshB") || !IParam.flag("MN"))
+    {
+      ELog::EM<<"Failed to process weightMesh since mesh and nps "
+	      <<"not definded"<<ELog::endErr;
+      return;
+    }
+  WeightSystem::weightManager& WM=
+    WeightSystem::weightManager::Instance();  
+
+  WeightMesh WMesh;
+  WMesh.setEnergy(WM.getParticle('n')->getEnergy());
+  WMesh.setXYZ(IParam.getValue<Geometry::Vec3D>("meshA"),
+	       IParam.getValue<Geometry::Vec3D>("meshB"),
+	       IParam.getValue<size_t>("meshNPS",0),
+	       IParam.getValue<size_t>("meshNPS",1),
+	       IParam.getValue<size_t>("meshNPS",2));
+
+  // Removal cross section [barn] : last value used for higher groups
+  std::vector<double> Sigma;
+  const size_t NSig=(IParam.flag("weightSigma")) ?
+    IParam.itemCnt("weightSigma",0) : 0;
+  for(size_t i=0;i<WMesh.getESize();i++)
+    {
+      if (i<NSig)
+	Sigma.push_back(IParam.getCompValue<double>("weightSigma",0,i));
+      else
+	Sigma.push_back((NSig) ? Sigma.back() : 1.0);
+    }
+  calcMeshWeights(System,WMesh,AimPoint,Sigma);
+
+  const std::string FName=IParam.getValue<std::string>("weightMesh");
+  std::ofstream OX(FName.c_str());
+  if (!OX.good())
+    throw ColErr::FileError(0,FName,"WWINP output");
+  WMesh.writeWWINP(OX);
+  OX.close();
+  ELog::EM<<"Written WWINP file "<<FName<<ELog::endBasic;
+  return;
+}
+
 void
 setWeights(Simulation& System,const std::string& Type)
   /*!
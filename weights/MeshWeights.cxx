@@ -0,0 +1,221 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   weights/MeshWeights.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <fstream>
+#include <complex>
+#include <list>
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <sstream>
+#include <iterator>
+#include <functional>
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/array.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/multi_array.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Triple.h"
+#include "NRange.h"
+#include "NList.h"
+#include "Surface.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "WForm.h"
+#include "WeightMesh.h"
+#include "KGroup.h"
+#include "Source.h"
+#include "SimProcess.h"
+#include "SurInter.h"
+#include "Simulation.h"
+#include "SimTrack.h"
+#include "BuildContext.h"
+#include "LineTrack.h"
+#include "MeshWeights.h"
+
+namespace WeightSystem
+{
+
+double
+voxelDepth(const Simulation& System,
+	   const std::map<int,double>& MatDensity,
+	   const Geometry::Vec3D& Pt,const Geometry::Vec3D& AimPoint)
+  /*!
+    Track from a point to the aim point and sum the 
+    atom density x track length. 
+    \param System :: Simulation component
+    \param MatDensity :: Atom density of each material [Atom/A^3]
+    \param Pt :: Start point
+    \param AimPoint :: Point to track to
+    \return Sum of rho.l [Atom/A^3 cm] / -ve if Pt is void / outside
+  */
+{
+  ELog::RegMethod RegA("F:MeshWeights","voxelDepth");
+
+  const MonteCarlo::Object* OPtr=System.findCell(Pt,0);
+  if (!OPtr || !OPtr->getImp())
+    return -1.0;
+
+  ModelSupport::LineTrack LT(Pt,AimPoint);
+  LT.calculate(System);
+  const std::vector<MonteCarlo::Object*>& OVec=LT.getObjVec();
+  const std::vector<double>& Track=LT.getTrack();
+  double sum(0.0);
+  for(size_t i=0;i<OVec.size();i++)
+    {
+      std::map<int,double>::const_iterator mc=
+	(OVec[i]) ? MatDensity.find(OVec[i]->getMat()) : MatDensity.end();
+      if (mc!=MatDensity.end())
+	sum+=mc->second*Track[i];
+    }
+  return sum;
+}
+
+void
+calcMeshWeights(const Simulation& System,WeightMesh& WMesh,
+		const Geometry::Vec3D& AimPoint,
+		const std::vector<double>& Sigma)
+  /*!
+    Set the mesh weights from the optical depth between
+    each voxel centre and the aim point. The importance
+    in energy group g is exp(-tau_g), with tau_g the sum over the
+    track of atom density x Sigma[g] x length. Each group is 
+    scaled so that the least important voxel has weight 1.0.
+    Voxels in void/outside cells are set to zero (no window).
+    \param System :: Simulation component [cells populated/OSM]
+    \param WMesh :: XYZ mesh with energy groups set
+    \param AimPoint :: Point to centre around
+    \param Sigma :: Removal cross section for each group [barn]
+  */
+{
+  ELog::RegMethod RegA("F:MeshWeights","calcMeshWeights");
+  
+  // Lowest weight allowed relative to the maximum
+  const double minWeight(1e-20);
+
+  const size_t NE(WMesh.getESize());
+  if (Sigma.size()!=NE)
+    throw ColErr::MisMatch<size_t>(Sigma.size(),NE,"Sigma/Energy");
+
+  const size_t NX(WMesh.getXSize());
+  const size_t NY(WMesh.getYSize());
+  const size_t NZ(WMesh.getZSize());
+  const size_t NVox(NX*NY*NZ);
+
+  // Material densities : DBMaterial is not shared by the threads
+  const ModelSupport::DBMaterial& DB=ModelSupport::DBMaterial::Instance();
+  std::map<int,double> MatDensity;
+  const Simulation::OTYPE& Cells=System.getCells();
+  Simulation::OTYPE::const_iterator vc;
+  for(vc=Cells.begin();vc!=Cells.end();vc++)
+    {
+      const int matN=vc->second->getMat();
+      if (matN && MatDensity.find(matN)==MatDensity.end())
+	MatDensity.insert(std::map<int,double>::value_type
+			  (matN,DB.getMaterial(matN).getNumberDensity()));
+    }
+
+  std::vector<double> Depth(NVox,-1.0);
+  std::vector<int> Failed(NVox,0);
+  const long int NV(static_cast<long int>(NVox));
+#ifdef _OPENMP
+#pragma omp parallel if (NV>1)
+#endif
+  {
+    // Each thread keeps its own findCell cache
+    BuildContext TrackCtx(1);
+    TrackCtx.getSimTrack().addSim(&System);
+    BuildContextGuard TrackGuard(TrackCtx);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,16)
+#endif
+    for(long int i=0;i<NV;i++)
+      {
+	const size_t index(static_cast<size_t>(i));
+	try
+	  {
+	    const Geometry::Vec3D Pt=
+	      WMesh.voxelCentre(index % NX,(index/NX) % NY,index/(NX*NY));
+	    Depth[index]=voxelDepth(System,MatDensity,Pt,AimPoint);
+	  }
+	// exceptions cannot leave the parallel region
+	catch (...)
+	  {
+	    Failed[index]=1;
+	  }
+      }
+  }
+  for(size_t index=0;index<NVox;index++)
+    if (Failed[index])       // repeat on this thread [throws again]
+      Depth[index]=voxelDepth
+	(System,MatDensity,
+	 WMesh.voxelCentre(index % NX,(index/NX) % NY,index/(NX*NY)),
+	 AimPoint);
+
+  const double maxDepth=(NVox) ? 
+    *std::max_element(Depth.begin(),Depth.end()) : -1.0;
+  ELog::EM<<"Max rho.l == "<<maxDepth<<" [Atom/A^3 cm]"<<ELog::endDiag;
+
+  for(size_t index=0;index<NVox;index++)
+    {
+      const size_t a(index % NX);
+      const size_t b((index/NX) % NY);
+      const size_t c(index/(NX*NY));
+      for(size_t e=0;e<NE;e++)
+	{
+	  double W(0.0);
+	  if (Depth[index]>=0.0)
+	    {
+	      W=exp(Sigma[e]*(Depth[index]-maxDepth));
+	      if (W<minWeight) W=minWeight;
+	    }
+	  WMesh.setValue(a,b,c,e,W*WMesh.getValue(a,b,c,e));
+	}
+    }
+  return;
+}
+
+}   // NAMESPACE WeightSystem
@@ -135,6 +135,9 @@ WeightMesh::setCylinder(const Geometry::Vec3D& Base,
       throw ColErr::ExitAbort("NR/NZ/NT failure");
     }
 
+  X.clear();
+  Y.clear();
+  Z.clear();
   const double dR=Radius/NR;
   for(int i=0;i<=NR;i++)
     X.push_back(dR*i);
@@ -146,7 +149,63 @@ WeightMesh::setCylinder(const Geometry::Vec3D& Base,
   const double dT=1.0/NT;
   for(int i=0;i<=NT;i++)
     Z.push_back(dT*i);
-  
+
+  resizeMesh();
+  return;
+}
+
+void
+WeightMesh::setXYZ(const Geometry::Vec3D& LowPt,
+		   const Geometry::Vec3D& HighPt,
+		   const size_t NX,const size_t NY,const size_t NZ)
+  /*!
+    Sets up a rectangular mesh aligned with the axes.
+    The energy groups must be set before the mesh is created.
+    \param LowPt :: Lower corner
+    \param HighPt :: Upper corner
+    \param NX :: number of x voxels
+    \param NY :: number of y voxels
+    \param NZ :: number of z voxels
+   */
+{
+  ELog::RegMethod RegA("WeightMesh","setXYZ");
+
+  if (!NX || !NY || !NZ)
+    throw ColErr::IndexError<size_t>(0,1,"NX/NY/NZ zero");
+  for(size_t i=0;i<3;i++)
+    if (HighPt[i]-LowPt[i]<Geometry::zeroTol)
+      throw ColErr::RangeError<double>(HighPt[i],LowPt[i],
+				       LowPt[i]+Geometry::zeroTol,
+				       "HighPt/LowPt");
+  type=XYZ;
+  Origin=LowPt;
+  Axis=Geometry::Vec3D(0,0,1);
+  Vec=Geometry::Vec3D(1,0,0);
+
+  const size_t NPts[3]={NX,NY,NZ};
+  for(size_t i=0;i<3;i++)
+    {
+      std::vector<double>& Coord=((!i) ? X : (i==1) ? Y : Z);
+      Coord.clear();
+      const double step=(HighPt[i]-LowPt[i])/static_cast<double>(NPts[i]);
+      for(size_t j=0;j<NPts[i];j++)
+	Coord.push_back(LowPt[i]+step*static_cast<double>(j));
+      Coord.push_back(HighPt[i]);
+    }
+  resizeMesh();
+  return;
+}
+
+void
+WeightMesh::resizeMesh()
+  /*!
+    Resize the mesh values to the coordinate / energy
+    sizes. All values are set to 1.0
+  */
+{
+  const size_t NE(Energy.empty() ? 1 : Energy.size());
+  Mesh.resize(boost::extents[getXSize()][getYSize()][getZSize()][NE]);
+  std::fill(Mesh.data(),Mesh.data()+Mesh.num_elements(),1.0);
   return;
 }
 
@@ -205,6 +264,86 @@ WeightMesh::point(const size_t a,const size_t b,const size_t c) const
   return Geometry::Vec3D(xc,yc,zc);
 }
 
+Geometry::Vec3D
+WeightMesh::voxelCentre(const size_t a,const size_t b,const size_t c) const
+  /*!
+    Determine the centre of voxel (a,b,c) 
+    \param a :: x index
+    \param b :: y index
+    \param c :: z index
+    \return Vec3D point 
+  */
+{
+  ELog::RegMethod RegA ("WeightMesh","voxelCentre");
+
+  if (type!=XYZ)
+    throw ColErr::AbsObjMethod("Non-XYZ mesh voxelCentre");
+  return (point(a,b,c)+point(a+1,b+1,c+1))/2.0;
+}
+
+double
+WeightMesh::getValue(const size_t a,const size_t b,
+		     const size_t c,const size_t eIndex) const
+  /*!
+    Access a mesh value
+    \param a :: x index
+    \param b :: y index
+    \param c :: z index
+    \param eIndex :: energy index
+    \return mesh value
+  */
+{
+  ELog::RegMethod RegA ("WeightMesh","getValue");
+
+  if (a>=Mesh.shape()[0] || b>=Mesh.shape()[1] || 
+      c>=Mesh.shape()[2] || eIndex>=Mesh.shape()[3])
+    throw ColErr::IndexError<size_t>(a,Mesh.shape()[0],"a/b/c/eIndex");
+  return Mesh[a][b][c][eIndex];
+}
+
+void
+WeightMesh::setValue(const size_t a,const size_t b,
+		     const size_t c,const size_t eIndex,
+		     const double V) 
+  /*!
+    Set a mesh value
+    \param a :: x index
+    \param b :: y index
+    \param c :: z index
+    \param eIndex :: energy index
+    \param V :: Value
+  */
+{
+  ELog::RegMethod RegA ("WeightMesh","setValue");
+
+  if (a>=Mesh.shape()[0] || b>=Mesh.shape()[1] || 
+      c>=Mesh.shape()[2] || eIndex>=Mesh.shape()[3])
+    throw ColErr::IndexError<size_t>(a,Mesh.shape()[0],"a/b/c/eIndex");
+  Mesh[a][b][c][eIndex]=V;
+  return;
+}
+
+void
+WeightMesh::balanceScale(const std::vector<double>& SF)
+  /*!
+    Scale each energy group of the mesh 
+    \param SF :: Scale factor for each energy
+  */
+{
+  ELog::RegMethod RegA ("WeightMesh","balanceScale");
+
+  const size_t NE(Mesh.shape()[3]);
+  if (SF.size()!=NE)
+    throw ColErr::MisMatch<size_t>(SF.size(),NE,"SF/Energy");
+
+  double* VPtr=Mesh.data();
+  const size_t NVox(NE ? Mesh.num_elements()/NE : 0);
+  for(size_t i=0;i<NVox;i++)
+    for(size_t j=0;j<NE;j++)
+      *VPtr++ *= SF[j];
+  return;
+}
+
 void
 WeightMesh::write(std::ostream& OX) const
   /*!
@@ -227,15 +366,100 @@ WeightMesh::write(std::ostream& OX) const
       
       cx.str("");
       cx<<c[i]<<"mesh ";
-      for(vc=X.begin();vc!=X.end();vc++)
+      for(vc=Vec.begin();vc!=Vec.end();vc++)
 	cx<<*vc<<" ";
       StrFunc::writeMCNPX(cx.str(),OX);
+      cx.str("");
       cx<<c[i]<<"ints";
-      for(size_t index=0;index<Vec.size();index++)
+      for(size_t index=1;index<Vec.size();index++)
 	cx<<" 1";
       StrFunc::writeMCNPX(cx.str(),OX);
     }
   return;
 }
 
+void
+WeightMesh::writeWWINPLine(std::ostream& OX,const double V,
+			   size_t& itemCnt)
+  /*!
+    Write a value in the WWINP 6g13.5 format
+    \param OX :: output stream
+    \param V :: Value to write
+    \param itemCnt :: Items on the current line [updated]
+  */
+{
+  OX<<std::setw(13)<<std::setprecision(5)<<std::scientific<<V;
+  if (++itemCnt==6)
+    {
+      OX<<std::endl;
+      itemCnt=0;
+    }
+  return;
+}
+
+void
+WeightMesh::writeWWINP(std::ostream& OX) const
+  /*!
+    Write out the mesh as an MCNPX WWINP file for
+    a single particle. Each voxel is its own coarse mesh.
+    \param OX :: output stream
+  */
+{
+  ELog::RegMethod RegA ("WeightMesh","writeWWINP");
+
+  if (type!=XYZ)
+    throw ColErr::AbsObjMethod("Non-XYZ mesh writeWWINP");
+
+  const size_t NE(Mesh.shape()[3]);
+  const size_t NPts[3]={getXSize(),getYSize(),getZSize()};
+  // Header : if iv ni nr / ne
+  OX<<std::setw(10)<<1<<std::setw(10)<<1
+    <<std::setw(10)<<1<<std::setw(10)<<10<<std::endl;
+  OX<<std::setw(10)<<NE<<std::endl;
+
+  size_t itemCnt(0);
+  for(size_t i=0;i<3;i++)
+    writeWWINPLine(OX,static_cast<double>(NPts[i]),itemCnt);
+  for(size_t i=0;i<3;i++)
+    writeWWINPLine(OX,Origin[i],itemCnt);
+  for(size_t i=0;i<3;i++)
+    writeWWINPLine(OX,static_cast<double>(NPts[i]),itemCnt);
+  writeWWINPLine(OX,1.0,itemCnt);
+  if (itemCnt) OX<<std::endl;
+  
+  // Coarse mesh : x0 (q p s)
+  for(size_t i=0;i<3;i++)
+    {
+      const std::vector<double>& Coord=((!i) ? X : (i==1) ? Y : Z);
+      itemCnt=0;
+      writeWWINPLine(OX,Coord.front(),itemCnt);
+      for(size_t j=1;j<Coord.size();j++)
+	{
+	  writeWWINPLine(OX,1.0,itemCnt);
+	  writeWWINPLine(OX,Coord[j],itemCnt);
+	  writeWWINPLine(OX,1.0,itemCnt);
+	}
+      if (itemCnt) OX<<std::endl;
+    }
+  // Energy upper bounds
+  itemCnt=0;
+  if (Energy.empty())
+    writeWWINPLine(OX,1e36,itemCnt);
+  for(size_t j=0;j<Energy.size();j++)
+    writeWWINPLine(OX,Energy[j],itemCnt);
+  if (itemCnt) OX<<std::endl;
+
+  // Lower weights [x fastest]:
+  for(size_t e=0;e<NE;e++)
+    {
+      itemCnt=0;
+      for(size_t c=0;c<NPts[2];c++)
+	for(size_t b=0;b<NPts[1];b++)
+	  for(size_t a=0;a<NPts[0];a++)
+	    writeWWINPLine(OX,Mesh[a][b][c][e],itemCnt);
+      if (itemCnt) OX<<std::endl;
+    }
+  return;
+}
+
 }   // NAMESPACE WeightSystem
@@ -60,6 +60,12 @@
 namespace WeightSystem
 {
 
+/// Per-thread context registry [0 : use process singleton]
+static weightManager* contextPtr(0);
+#ifdef _OPENMP
+#pragma omp threadprivate(contextPtr)
+#endif
+
 weightManager::weightManager()
   /*!
     Constructor
@@ -83,10 +89,25 @@ weightManager::Instance()
     \return weightManager object
   */
 {
+  if (contextPtr) return *contextPtr;
   static weightManager A;
   return A;
 }
 
+weightManager*
+weightManager::setContext(weightManager* CPtr)
+  /*!
+    Bind the calling thread to a BuildContext registry.
+    Instance() returns CPtr until reset with a null pointer.
+    \param CPtr :: Registry to use [0 for the process singleton]
+    \return previous registry [or 0]
+  */
+{
+  weightManager* prevPtr=contextPtr;
+  contextPtr=CPtr;
+  return prevPtr;
+}
+
 WForm*
 weightManager::getParticle(const char c)
   /*!
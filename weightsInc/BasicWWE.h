@@ -38,6 +38,8 @@ class Simulation;
 namespace WeightSystem
 { 
   void simulationWeights(Simulation&,const mainSystem::inputParam&);
+  void meshWeights(const Simulation&,const mainSystem::inputParam&,
+		   const Geometry::Vec3D&);
 			
   void setWeights(Simulation&,const std::vector<double>&,
 		  const std::vector<double>&,
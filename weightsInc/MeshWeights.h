@@ -0,0 +1,39 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   weightsInc/MeshWeights.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef WeightSystem_MeshWeights_h
+#define WeightSystem_MeshWeights_h
+
+///\file 
+
+class Simulation;
+
+namespace WeightSystem
+{
+  class WeightMesh;
+
+  double voxelDepth(const Simulation&,const std::map<int,double>&,
+		    const Geometry::Vec3D&,const Geometry::Vec3D&);
+  void calcMeshWeights(const Simulation&,WeightMesh&,
+		       const Geometry::Vec3D&,const std::vector<double>&);
+}  
+
+#endif
@@ -33,6 +33,9 @@ namespace WeightSystem
   \author S. Ansell
   \brief A WW-Mesh for neutron importance
 
+  Mesh values are held per voxel and per energy
+  group of WForm::Energy. The XYZ mesh can be written
+  as an MCNPX WWINP file.
 */
 
 class WeightMesh : public WForm
@@ -53,10 +56,12 @@ class WeightMesh : public WForm
   std::vector<double> Y;     ///< Y/Z/phi coordinates
   std::vector<double> Z;     ///< Z/theta coordinates
 
-  /// Mesh values  [Note many for different energy arrangements ???]
-  boost::multi_array<double,3> Mesh;
+  /// Mesh values [x/r : y/z : z/theta : energy]
+  boost::multi_array<double,4> Mesh;
 
   std::string getType() const;
+  void resizeMesh();
+  static void writeWWINPLine(std::ostream&,const double,size_t&);
   
  public:
 
@@ -66,6 +71,21 @@ class WeightMesh : public WForm
   virtual ~WeightMesh() {}   ///< Destructor
 
   Geometry::Vec3D point(const size_t,const size_t,const size_t) const;
+  Geometry::Vec3D voxelCentre(const size_t,const size_t,const size_t) const;
+
+  /// Number of x/r voxels
+  size_t getXSize() const { return (X.empty()) ? 0 : X.size()-1; }
+  /// Number of y/z voxels
+  size_t getYSize() const { return (Y.empty()) ? 0 : Y.size()-1; }
+  /// Number of z/theta voxels
+  size_t getZSize() const { return (Z.empty()) ? 0 : Z.size()-1; }
+  /// Number of energy groups
+  size_t getESize() const { return Mesh.shape()[3]; }
+
+  double getValue(const size_t,const size_t,const size_t,
+		  const size_t) const;
+  void setValue(const size_t,const size_t,const size_t,
+		const size_t,const double);
 
   void setMeshType(const GeomENUM&);
   /// Set reference point
@@ -73,9 +93,21 @@ class WeightMesh : public WForm
   void setCylinder(const Geometry::Vec3D&,const Geometry::Vec3D&,
 		   const Geometry::Vec3D&,const double,
 		   const int,const int,const int);
+  void setXYZ(const Geometry::Vec3D&,const Geometry::Vec3D&,
+	      const size_t,const size_t,const size_t);
 
   void zeroCell(const int) { }      ///< Non-important return
-  void write(std::ostream&) const;
+
+  // Cell based weights do not apply to a mesh
+  virtual void setWeights(const int,const size_t,const double) {}
+  virtual void setWeights(const int,const std::vector<double>&) {}
+  virtual void maskCell(const int) {}
+  virtual void populateCells(const std::map<int,MonteCarlo::Qhull*>&) {}
+  virtual void renumberCell(const int,const int) {}
+  virtual void balanceScale(const std::vector<double>&);
+  virtual void write(std::ostream&) const;
+
+  void writeWWINP(std::ostream&) const;
 };
 
 }  
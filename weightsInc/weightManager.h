@@ -22,6 +22,7 @@
 #ifndef weightManager_h
 #define weightManager_h
 
+class BuildContext;
 class Simulation;
 
 namespace WeightSystem
@@ -45,6 +46,8 @@ class weightManager
  private:  
 
   weightManager();
+  friend class ::BuildContext;
+
   ////\cond SINGLETON
   weightManager(const weightManager&);
   weightManager& operator=(const weightManager&);
@@ -53,6 +56,7 @@ class weightManager
  public:
 
   static weightManager& Instance();
+  static weightManager* setContext(weightManager*);
   ~weightManager();
   
   WForm* getParticle(const char);
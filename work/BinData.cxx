@@ -118,6 +118,74 @@ BinData::addData(const double& W,
   return;
 }
 
+size_t
+BinData::findBin(const double X) const
+  /*!
+    Find the bin containing X [xA<=X<xB]. The bins are
+    sorted. A uniform grid gives the bin directly, otherwise
+    a binary search is used.
+    \param X :: X coordinate
+    \return bin index / ULONG_MAX if outside
+  */
+{
+  if (Yvec.empty() || X<Yvec.front().xA || X>=Yvec.back().xB)
+    return ULONG_MAX;
+
+  const size_t NB(Yvec.size());
+  // Uniform grid guess:
+  size_t index=static_cast<size_t>
+    (static_cast<double>(NB)*(X-Yvec.front().xA)/
+     (Yvec.back().xB-Yvec.front().xA));
+  if (index>=NB) index=NB-1;
+  if (Yvec[index].xA<=X && X<Yvec[index].xB)
+    return index;
+
+  // Irregular grid
+  size_t lo(0);
+  size_t hi(NB);
+  while(hi-lo>1)
+    {
+      const size_t mid((lo+hi)/2);
+      if (Yvec[mid].xA<=X)
+	lo=mid;
+      else
+	hi=mid;
+    }
+  return (X<Yvec[lo].xB) ? lo : ULONG_MAX;
+}
+
+int
+BinData::addPoint(const double X,const double W)
+  /*!
+    Score a weight into the bin containing X.
+    Not thread safe : each thread should score into its
+    own BinData and the results merged with operator+=
+    \param X :: X coordinate
+    \param W :: Weight to add [error W]
+    \return 1 if X is in a bin / 0 if not
+  */
+{
+  const size_t index=findBin(X);
+  if (index==ULONG_MAX) return 0;
+  Yvec[index].Y+=DError::doubleErr(W,W);
+  return 1;
+}
+
+int
+BinData::sameGrid(const BinData& A) const
+  /*!
+    Determine if two BinData have the same bins
+    \param A :: BinData to compare
+    \return 1 if the bins match
+  */
+{
+  if (A.Yvec.size()!=Yvec.size()) return 0;
+  for(size_t i=0;i<Yvec.size();i++)
+    if (Yvec[i].xA!=A.Yvec[i].xA || Yvec[i].xB!=A.Yvec[i].xB)
+      return 0;
+  return 1;
+}
+
 BinData&
 BinData::operator+=(const BinData& A)
   /*!
@@ -421,6 +489,13 @@ BinData::addFactor(const BinData& A,const double Scale)
       this->operator*=(Scale);
       return *this;
     }
+  // Same bins [e.g. merging thread copies]
+  if (sameGrid(A))
+    {
+      for(size_t i=0;i<Yvec.size();i++)
+	Yvec[i]+=A.Yvec[i]*Scale;
+      return *this;
+    }
 
   Boundary XComp;
   XComp.setBoundary(A.Yvec,Yvec);
@@ -486,7 +561,27 @@ BinData::rebin(const std::vector<BUnit>& XOut)
 
   Boundary XComp;
   XComp.setBoundary(Yvec,XOut);
-  // Now XComp 
+  return rebin(XComp,XOut);
+}
+
+BinData&
+BinData::rebin(const Boundary& XComp,const std::vector<BUnit>& XOut)
+ /*!
+   Rebin using a precalculated overlap set
+   [Boundary::setBoundary(Yvec,XOut)]. Throws if the overlap
+   set does not match this spectrum and XOut.
+   \param XComp :: Overlap from this to XOut
+   \param XOut :: Required Bin steps
+   \return rebined(this)
+ */
+{
+  if (XComp.inSize()>Yvec.size() || XComp.outSize()!=XOut.size())
+    {
+      ELog::RegMethod RegA("BinData","rebin(Boundary)");
+      throw ColErr::MisMatch<size_t>(XComp.inSize(),Yvec.size(),
+				     "Boundary/Yvec");
+    }
+
   Boundary::BTYPE::const_iterator xc;
   BItems::FTYPE::const_iterator axc;
 
@@ -508,6 +603,45 @@ BinData::rebin(const std::vector<BUnit>& XOut)
   return *this;
 }
 
+void
+BinData::rebinSet(std::vector<BinData>& BSet,
+		  const std::vector<BUnit>& XOut)
+  /*!
+    Rebin a set of spectra onto XOut. The overlap is 
+    calculated once for each different input grid
+    [normally all the spectra have the same grid].
+    \param BSet :: Spectra to rebin
+    \param XOut :: Required Bin steps
+  */
+{
+  ELog::RegMethod RegA("BinData","rebinSet");
+  if (XOut.empty())
+    throw ColErr::IndexError<size_t>(XOut.size(),0,"XOut");
+
+  std::vector<Boundary> XComp;
+  std::vector<size_t> XIndex(BSet.size());
+  for(size_t i=0;i<BSet.size();i++)
+    {
+      if (!i || !BSet[i].sameGrid(BSet[i-1]))
+	{
+	  XComp.push_back(Boundary());
+	  XComp.back().setBoundary(BSet[i].Yvec,XOut);
+	}
+      XIndex[i]=XComp.size()-1;
+    }
+
+  const long int NB(static_cast<long int>(BSet.size()));
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for(long int i=0;i<NB;i++)
+    {
+      const size_t index(static_cast<size_t>(i));
+      BSet[index].rebin(XComp[XIndex[index]],XOut);
+    }
+  return;
+}
+
 size_t
 BinData::getIndex(const double X,const double Y) const
  /*!
@@ -763,12 +897,21 @@ BinData::integrate(const double xMin,const double xMax) const
   ELog::RegMethod RegA("BinData","integrate");
 
   DError::doubleErr sum;
-  // Get first point
-  size_t i;
-  for(i=0;i<Yvec.size();i++)
+  // Get first point [bins are ordered]
+  size_t lo(0);
+  size_t hi(Yvec.size());
+  while(lo<hi)
+    {
+      const size_t mid((lo+hi)/2);
+      if (Yvec[mid].xB>xMin)
+	hi=mid;
+      else
+	lo=mid+1;
+    }
+  for(size_t i=lo;i<Yvec.size() && Yvec[i].xA<xMax;i++)
     {
       const BUnit& BU(Yvec[i]);
-      if (BU.xB>xMin && BU.xA<xMax)
+      if (BU.xB>xMin)
 	{
 	  const double DV(BU.xB-BU.xA);
 	  if (DV>0.0)
@@ -94,6 +94,12 @@ BItems::addItem(const size_t Index,const double F)
 {
   if (F>0.0)
     {
+      // Items are normally added in order
+      if (FList.empty() || FList.back().first<Index)
+	{
+	  FList.push_back(PTYPE(Index,F));
+	  return;
+	}
       std::vector<PTYPE>::iterator vc;
       vc=lower_bound(FList.begin(),FList.end(),Index,
 		     mathSupport::PairSndLess<size_t,double>());
@@ -139,13 +145,13 @@ BItems::write(std::ostream& OX) const
 //             Boundary
 //---------------------------------------------------------
 
-Boundary::Boundary() : nonEmpty(0),backEmpty(0)
+Boundary::Boundary() : nonEmpty(0),backEmpty(0),nIn(0),nOut(0)
   /// Constructor
 {}
 
 Boundary::Boundary(const Boundary& A) : 
   Components(A.Components),nonEmpty(A.nonEmpty),
-  backEmpty(A.backEmpty)
+  backEmpty(A.backEmpty),nIn(A.nIn),nOut(A.nOut)
   /*!
     Copy Constructor
     \param A :: Object to copy
@@ -165,6 +171,8 @@ Boundary::operator=(const Boundary& A)
       Components=A.Components;
       nonEmpty=A.nonEmpty;
       backEmpty=A.backEmpty;
+      nIn=A.nIn;
+      nOut=A.nOut;
     }
   return *this;
 }
@@ -190,6 +198,8 @@ Boundary::setBoundary(const std::vector<double>& OData,
     }
   Components.clear();
   Components.resize(NRegion.size());
+  nIn=OData.size()-1;
+  nOut=NRegion.size()-1;
   double NA(NRegion.front());
   double NB(NRegion[1]);
   double OA(OData[0]);
@@ -258,7 +268,8 @@ Boundary::setBoundary(const std::vector<BUnit>& OData,
 
   Components.clear();
   Components.resize(NRegion.size());
-
+  nIn=OData.size();
+  nOut=NRegion.size();
   
   size_t initPt(0);
   for(size_t nI=0;nI<NRegion.size();nI++)
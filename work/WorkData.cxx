@@ -685,7 +685,27 @@ WorkData::rebin(const std::vector<double>& XOut)
 
   Boundary XComp;
   XComp.setBoundary(XCoord,XOut);
-  // Now XComp 
+  return rebin(XComp,XOut);
+}
+
+WorkData&
+WorkData::rebin(const Boundary& XComp,const std::vector<double>& XOut)
+  /*!
+    Rebin using a precalculated overlap set 
+    [Boundary::setBoundary(XCoord,XOut)]. Throws if the overlap
+    set does not match this spectrum and XOut.
+    \param XComp :: Overlap from XCoord to XOut
+    \param XOut :: Required Bin steps
+    \return rebined(this)
+  */
+{
+  if (XComp.inSize()>Yvec.size() || XComp.outSize()+1!=XOut.size())
+    {
+      ELog::RegMethod RegA("WorkData","rebin(Boundary)");
+      throw ColErr::MisMatch<size_t>(XComp.inSize(),Yvec.size(),
+				     "Boundary/Yvec");
+    }
+
   Boundary::BTYPE::const_iterator xc;
   BItems::FTYPE::const_iterator axc;
 
@@ -704,6 +724,46 @@ WorkData::rebin(const std::vector<double>& XOut)
   return *this;
 }
 
+void
+WorkData::rebinSet(std::vector<WorkData>& WSet,
+		   const std::vector<double>& XOut)
+  /*!
+    Rebin a set of spectra onto XOut. The overlap is 
+    calculated once for each different input grid
+    [normally all the spectra have the same grid].
+    \param WSet :: Spectra to rebin
+    \param XOut :: Required Bin steps
+  */
+{
+  ELog::RegMethod RegA("WorkData","rebinSet");
+  if (XOut.size()<2)
+    throw ColErr::IndexError<size_t>(XOut.size(),2,"XOut size");
+
+  // Overlap for each spectrum [shared between same grids]
+  std::vector<Boundary> BSet;
+  std::vector<size_t> BIndex(WSet.size());
+  for(size_t i=0;i<WSet.size();i++)
+    {
+      if (!i || WSet[i].XCoord!=WSet[i-1].XCoord)
+	{
+	  BSet.push_back(Boundary());
+	  BSet.back().setBoundary(WSet[i].XCoord,XOut);
+	}
+      BIndex[i]=BSet.size()-1;
+    }
+
+  const long int NW(static_cast<long int>(WSet.size()));
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for(long int i=0;i<NW;i++)
+    {
+      const size_t index(static_cast<size_t>(i));
+      WSet[index].rebin(BSet[BIndex[index]],XOut);
+    }
+  return;
+}
+
 size_t
 WorkData::getIndex(const double X,const double Y) const
   /*!
@@ -926,6 +986,23 @@ WorkData::write(std::ostream& OX) const
   return; 
 }
 
+size_t
+WorkData::firstBin(const double xMin) const
+  /*!
+    Find the first bin with an upper boundary not 
+    below xMin [binary search]
+    \param xMin :: Xmin value
+    \return bin index [Yvec.size() if none]
+  */
+{
+  if (XCoord.size()<2) return Yvec.size();
+  std::vector<double>::const_iterator vc=
+    std::lower_bound(XCoord.begin()+1,XCoord.end(),xMin);
+  const size_t index=
+    static_cast<size_t>(std::distance(XCoord.begin(),vc))-1;
+  return std::min(index,Yvec.size());
+}
+
 DError::doubleErr
 WorkData::integrate(const double xMin,const double xMax) const
   /*!
@@ -944,8 +1021,7 @@ WorkData::integrate(const double xMin,const double xMax) const
 
   DError::doubleErr sum(0,0);
   // Get first point
-  size_t i;
-  for(i=0;i<Yvec.size() && XCoord[i+1]<xMin;i++) ;
+  size_t i=firstBin(xMin);
   if (i!=Yvec.size())   
     {
       // Only one bin:
@@ -982,8 +1058,7 @@ WorkData::integrateX(const double xMin,const double xMax) const
 
   DError::doubleErr sum;
   // Get first point
-  size_t i;
-  for(i=0;i<Yvec.size() && XCoord[i+1]<xMin;i++) ;
+  size_t i=firstBin(xMin);
   if (i!=Yvec.size()) 
     {
       // Only one bin:
@@ -22,6 +22,8 @@
 #ifndef BinData_h
 #define BinData_h
 
+class Boundary;
+
 /*!
   \class BinData
   \brief Base class x-y data
@@ -30,7 +32,10 @@
   \author S. Ansell
  
   Holds a list of all the spectra in a flat array.
-  The class is a modified DataLine from LoqNSwig
+  The class is a modified DataLine from LoqNSwig.
+  Histograms are filled with addPoint. For threads, each 
+  thread fills its own copy and the copies are added 
+  [operator+= has a direct path for identical bins].
 
 */
 
@@ -48,6 +53,7 @@ class BinData
   DataTYPE Yvec;                   ///< Yvalues 
 
   BinData& addFactor(const BinData&,const double);
+  int sameGrid(const BinData&) const;
   int selectColumn(std::istream&,const int,const int,const int,
 		   const int,const int);
 
@@ -80,6 +86,8 @@ class BinData
 
   BinData& rebin(const std::vector<BUnit>&);
   BinData& rebin(const BinData&);
+  BinData& rebin(const Boundary&,const std::vector<BUnit>&);
+  static void rebinSet(std::vector<BinData>&,const std::vector<BUnit>&);
   BinData& binDivide(const double);
   BinData& xScale(const double);
 
@@ -87,6 +95,7 @@ class BinData
   void addData(const double&,const double&,
 	       const double&,const DError::doubleErr&);
   void addData(const double&,const double&,const DError::doubleErr&);
+  int addPoint(const double,const double);
 
   /// Data-Accessor 
   const std::vector<BUnit>& getData() const 
@@ -95,6 +104,7 @@ class BinData
   /// Size accessor
   size_t getSize() const { return Yvec.size(); }   
   size_t getIndex(const double,const double) const;
+  size_t findBin(const double) const;
   size_t getMaxPoint() const;
 
   /// Determine if the workspace contains data
@@ -84,6 +84,8 @@ class Boundary
   std::vector<BItems> Components;
   size_t nonEmpty;                     ///< First component (with data)
   size_t backEmpty;                    ///< Last component+1 (with data)
+  size_t nIn;                          ///< Number of original values
+  size_t nOut;                         ///< Number of new values
 
   double getFrac(const double,const double,
 		 const double,const double) const;
@@ -111,6 +113,10 @@ class Boundary
   BItems::PTYPE getItem(const size_t,const size_t) const;
   /// Accessor to start point
   size_t getIndex() const { return nonEmpty; }
+  /// Number of original values [bins]
+  size_t inSize() const { return nIn; }
+  /// Number of new values [bins]
+  size_t outSize() const { return nOut; }
 };
 
 std::ostream&
@@ -22,6 +22,8 @@
 #ifndef WorkData_h
 #define WorkData_h
 
+class Boundary;
+
 /*!
   \class WorkData
   \brief Base class x-y data
@@ -47,6 +49,7 @@ class WorkData
 
   WorkData& addFactor(const WorkData&,const double);
   int selectColumn(std::istream&,const int,const int,const int,const int);
+  size_t firstBin(const double) const;
 
  public:
  
@@ -77,6 +80,8 @@ class WorkData
 
   WorkData& rebin(const std::vector<double>&);
   WorkData& rebin(const WorkData&);
+  WorkData& rebin(const Boundary&,const std::vector<double>&);
+  static void rebinSet(std::vector<WorkData>&,const std::vector<double>&);
   WorkData& binDivide(const double);
   WorkData& xScale(const double);
 
@@ -0,0 +1,332 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   xml/XMLstream.cxx
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "XMLstream.h"
+
+namespace XML
+{
+
+/*!
+  Determine if a character is XML white space
+  \param C :: Character
+  \return true if space
+*/
+static inline bool
+isSpace(const char C)
+{
+  return (C==' ' || C=='\t' || C=='\n' || C=='\r');
+}
+
+bool
+strView::operator==(const char* S) const
+  /*!
+    Compare with a string
+    \param S :: C-string to compare
+    \return true if the same
+  */
+{
+  const size_t SLen(strlen(S));
+  return (SLen==Len && !strncmp(Ptr,S,Len));
+}
+
+XMLstream::XMLstream(const std::string& FN) :
+  FName(FN),fd(open(FN.c_str(),O_RDONLY)),fileSize(0),Data(0)
+  /*!
+    Constructor : maps the file
+    \param FN :: XML file name
+  */
+{
+  ELog::RegMethod RegA("XMLstream","constructor");
+
+  struct stat SBuf;
+  if (fd<0 || fstat(fd,&SBuf))
+    {
+      if (fd>=0) close(fd);
+      throw ColErr::FileError(0,FName,"XMLstream::XMLstream");
+    }
+  fileSize=static_cast<size_t>(SBuf.st_size);
+  if (fileSize)
+    {
+      void* MPtr=mmap(0,fileSize,PROT_READ,MAP_PRIVATE,fd,0);
+      if (MPtr==MAP_FAILED)
+	{
+	  close(fd);
+	  throw ColErr::FileError(0,FName,"XMLstream::mmap");
+	}
+      Data=static_cast<const char*>(MPtr);
+    }
+}
+
+XMLstream::~XMLstream()
+  /*!
+    Destructor : release map and file
+  */
+{
+  if (Data)
+    munmap(const_cast<char*>(Data),fileSize);
+  close(fd);
+}
+
+void
+XMLstream::parseError(const std::string& Reason,const char* PPtr) const
+  /*!
+    Throw an error for the current point
+    \param Reason :: Error message
+    \param PPtr :: Point in the buffer
+  */
+{
+  size_t lineNum(1);
+  for(const char* LPtr=Data;LPtr!=PPtr;LPtr++)
+    if (*LPtr=='\n') lineNum++;
+  const size_t NLeft(static_cast<size_t>(Data+fileSize-PPtr));
+  throw ColErr::InvalidLine("XMLstream::"+Reason+" : "+FName,
+			    std::string(PPtr,std::min<size_t>(NLeft,40)),
+			    lineNum);
+}
+
+const char*
+XMLstream::skipTo(const char* PPtr,const char* Key) const
+  /*!
+    Find the next Key in the buffer
+    \param PPtr :: Start point
+    \param Key :: String to find
+    \return point after Key
+  */
+{
+  const char* EPtr(Data+fileSize);
+  const size_t KLen(strlen(Key));
+  while(static_cast<size_t>(EPtr-PPtr)>=KLen)
+    {
+      const char* CPtr=static_cast<const char*>
+	(memchr(PPtr,Key[0],static_cast<size_t>(EPtr-PPtr)-KLen+1));
+      if (!CPtr) break;
+      if (!strncmp(CPtr,Key,KLen))
+	return CPtr+KLen;
+      PPtr=CPtr+1;
+    }
+  parseError(std::string("Failed to find ")+Key,PPtr);
+  return EPtr;
+}
+
+const char*
+XMLstream::readTag(const char* PPtr,XMLhandler& XH,
+		   XMLhandler::ATYPE& Attr,
+		   std::vector<strView>& Stack) const
+  /*!
+    Process a tag 
+    \param PPtr :: Point at the opening <
+    \param XH :: Handler 
+    \param Attr :: Work space for attributes
+    \param Stack :: Open elements
+    \return point after the tag
+  */
+{
+  const char* EPtr(Data+fileSize);
+  const size_t NLeft(static_cast<size_t>(EPtr-PPtr));
+
+  if (NLeft>=4 && !strncmp(PPtr,"<!--",4))
+    return skipTo(PPtr+4,"-->");
+  if (NLeft>=9 && !strncmp(PPtr,"<![CDATA[",9))
+    {
+      const char* CPtr=skipTo(PPtr+9,"]]>");
+      if (!Stack.empty())
+	XH.characters(strView(PPtr+9,static_cast<size_t>(CPtr-PPtr)-12));
+      return CPtr;
+    }
+  if (NLeft>=2 && PPtr[1]=='?')
+    return skipTo(PPtr+2,"?>");
+  if (NLeft>=2 && PPtr[1]=='!')
+    return skipTo(PPtr+2,">");
+
+  // Close tag:
+  if (NLeft>=2 && PPtr[1]=='/')
+    {
+      const char* NPtr(PPtr+2);
+      const char* CPtr(NPtr);
+      while(CPtr!=EPtr && !isSpace(*CPtr) && *CPtr!='>') CPtr++;
+      const strView Key(NPtr,static_cast<size_t>(CPtr-NPtr));
+      if (Stack.empty() || Stack.back().Len!=Key.Len ||
+	  strncmp(Stack.back().Ptr,Key.Ptr,Key.Len))
+	parseError("Unmatched close tag",PPtr);
+      CPtr=skipTo(CPtr,">");
+      Stack.pop_back();
+      XH.endElement(Key);
+      return CPtr;
+    }
+
+  // Open tag:
+  const char* NPtr(PPtr+1);
+  const char* CPtr(NPtr);
+  while(CPtr!=EPtr && !isSpace(*CPtr) && *CPtr!='>' && *CPtr!='/') 
+    CPtr++;
+  if (CPtr==NPtr)
+    parseError("Empty tag",PPtr);
+  const strView Key(NPtr,static_cast<size_t>(CPtr-NPtr));
+
+  Attr.clear();
+  for(;;)
+    {
+      while(CPtr!=EPtr && isSpace(*CPtr)) CPtr++;
+      if (CPtr==EPtr)
+	parseError("Unterminated tag",PPtr);
+      if (*CPtr=='>')
+	{
+	  XH.startElement(Key,Attr);
+	  Stack.push_back(Key);
+	  return CPtr+1;
+	}
+      if (*CPtr=='/')
+	{
+	  if (CPtr+1==EPtr || CPtr[1]!='>')
+	    parseError("Bad empty tag",PPtr);
+	  XH.startElement(Key,Attr);
+	  XH.endElement(Key);
+	  return CPtr+2;
+	}
+      // Attribute : key="value"
+      const char* APtr(CPtr);
+      while(CPtr!=EPtr && !isSpace(*CPtr) && *CPtr!='=') CPtr++;
+      const strView AKey(APtr,static_cast<size_t>(CPtr-APtr));
+      while(CPtr!=EPtr && isSpace(*CPtr)) CPtr++;
+      if (CPtr==EPtr || *CPtr!='=')
+	parseError("Attribute without value",APtr);
+      CPtr++;
+      while(CPtr!=EPtr && isSpace(*CPtr)) CPtr++;
+      if (CPtr==EPtr || (*CPtr!='"' && *CPtr!='\''))
+	parseError("Attribute without quote",APtr);
+      const char* VPtr(CPtr+1);
+      const char* QPtr=static_cast<const char*>
+	(memchr(VPtr,*CPtr,static_cast<size_t>(EPtr-VPtr)));
+      if (!QPtr)
+	parseError("Unterminated attribute",APtr);
+      Attr.push_back(std::pair<strView,strView>
+		     (AKey,strView(VPtr,static_cast<size_t>(QPtr-VPtr))));
+      CPtr=QPtr+1;
+    }
+  return EPtr;
+}
+
+void
+XMLstream::parse(XMLhandler& XH) const
+  /*!
+    Parse the whole file with call backs to XH.
+    Text outside the root element is ignored.
+    \param XH :: Handler for the elements
+  */
+{
+  ELog::RegMethod RegA("XMLstream","parse");
+
+  const char* EPtr(Data+fileSize);
+  const char* PPtr(Data);
+  std::vector<strView> Stack;
+  XMLhandler::ATYPE Attr;
+  while(PPtr!=EPtr)
+    {
+      const char* LPtr=static_cast<const char*>
+	(memchr(PPtr,'<',static_cast<size_t>(EPtr-PPtr)));
+      if (!LPtr) LPtr=EPtr;
+      if (LPtr!=PPtr && !Stack.empty())
+	XH.characters(strView(PPtr,static_cast<size_t>(LPtr-PPtr)));
+      if (LPtr==EPtr) break;
+      PPtr=readTag(LPtr,XH,Attr,Stack);
+    }
+  if (!Stack.empty())
+    parseError("Unclosed element "+Stack.back().str(),EPtr);
+  return;
+}
+
+strView
+XMLstream::trim(const strView& SV)
+  /*!
+    Remove leading/trailing white space
+    \param SV :: View to trim
+    \return trimmed view
+  */
+{
+  const char* SPtr(SV.Ptr);
+  const char* EPtr(SV.Ptr+SV.Len);
+  while(SPtr!=EPtr && isSpace(*SPtr)) SPtr++;
+  while(EPtr!=SPtr && isSpace(EPtr[-1])) EPtr--;
+  return strView(SPtr,static_cast<size_t>(EPtr-SPtr));
+}
+
+std::string
+XMLstream::procEntity(const strView& SV)
+  /*!
+    Convert a view to a string replacing the 
+    standard entities [reverse of XML::procString]
+    \param SV :: View to convert
+    \return string
+  */
+{
+  static const char* Entity[]={"&lt;","&gt;","&amp;","&quot;","&apos;"};
+  static const char Sym[]="<>&\"'";
+
+  if (!SV.Len || !memchr(SV.Ptr,'&',SV.Len))
+    return SV.str();
+
+  std::string Out;
+  Out.reserve(SV.Len);
+  const char* EPtr(SV.Ptr+SV.Len);
+  for(const char* CPtr=SV.Ptr;CPtr!=EPtr;CPtr++)
+    {
+      if (*CPtr=='&')
+	{
+	  size_t i;
+	  for(i=0;i<5;i++)
+	    {
+	      const size_t ELen(strlen(Entity[i]));
+	      if (static_cast<size_t>(EPtr-CPtr)>=ELen &&
+		  !strncmp(CPtr,Entity[i],ELen))
+		{
+		  Out+=Sym[i];
+		  CPtr+=ELen-1;
+		  break;
+		}
+	    }
+	  if (i!=5) continue;
+	}
+      Out+=*CPtr;
+    }
+  return Out;
+}
+
+}  // NAMESPACE XML
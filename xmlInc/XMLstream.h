@@ -0,0 +1,131 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   xmlInc/XMLstream.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef XMLstream_h
+#define XMLstream_h
+
+namespace XML
+{
+
+/*!
+  \struct strView
+  \brief Section of a buffer [not owned]
+  \author S. Ansell
+  \date October 2013
+  \version 1.0
+*/
+
+struct strView
+{
+  const char* Ptr;          ///< Start of string
+  size_t Len;               ///< Length of string
+
+  /// Empty constructor
+  strView() : Ptr(0),Len(0) {}
+  /// Constructor
+  strView(const char* P,const size_t L) : Ptr(P),Len(L) {}
+
+  /// Determine if empty
+  bool empty() const { return !Len; }
+  /// Make a string
+  std::string str() const { return std::string(Ptr,Len); }
+  bool operator==(const char*) const;
+  /// Not equal to a string
+  bool operator!=(const char* S) const { return !(*this==S); }
+};
+
+/*!
+  \class XMLhandler
+  \brief Call back interface for XMLstream
+  \author S. Ansell
+  \date October 2013
+  \version 1.0
+
+  The views point into the XMLstream buffer and are 
+  only valid until the stream is closed.
+*/
+
+class XMLhandler
+{
+ public:
+
+  /// Attribute list [key : value]
+  typedef std::vector<std::pair<strView,strView> > ATYPE;
+
+  virtual ~XMLhandler() {}    ///< Destructor
+
+  /// Start of element [key,attributes]
+  virtual void startElement(const strView&,const ATYPE&) =0;
+  /// End of element [key]
+  virtual void endElement(const strView&) =0;
+  /// Text between tags [raw]
+  virtual void characters(const strView&) =0;
+};
+
+/*!
+  \class XMLstream
+  \brief Streaming XML reader 
+  \author S. Ansell
+  \date October 2013
+  \version 1.0
+
+  The file is memory mapped and parsed in one pass
+  with call backs to an XMLhandler. No tree is built.
+  Comments, processing instructions and DOCTYPE are 
+  skipped. CDATA is passed as characters. Used when
+  the file is too large for XMLcollect.
+*/
+
+class XMLstream
+{
+ private:
+
+  std::string FName;          ///< File name
+  int fd;                     ///< File descriptor
+  size_t fileSize;            ///< File size [bytes]
+  const char* Data;           ///< Mapped file
+
+  ///\cond ABSTRACT
+  XMLstream(const XMLstream&);
+  XMLstream& operator=(const XMLstream&);
+  ///\endcond ABSTRACT
+
+  void parseError(const std::string&,const char*) const;
+  const char* skipTo(const char*,const char*) const;
+  const char* readTag(const char*,XMLhandler&,
+		      XMLhandler::ATYPE&,std::vector<strView>&) const;
+
+ public:
+
+  explicit XMLstream(const std::string&);
+  ~XMLstream();
+
+  /// Access file size
+  size_t getSize() const { return fileSize; }
+  void parse(XMLhandler&) const;
+
+  static strView trim(const strView&);
+  static std::string procEntity(const strView&);
+};
+
+}    // NAMESPACE XML
+
+#endif